@@ -36,6 +36,7 @@
 #include "gdata-parsable.h"
 #include "gdata-parser.h"
 #include "gdata-comparable.h"
+#include "gdata-private.h"
 
 static void gdata_category_comparable_init (GDataComparableIface *iface);
 static void gdata_category_finalize (GObject *object);
@@ -46,8 +47,18 @@ static void pre_get_xml (GDataParsable *parsable, GString *xml_string);
 
 struct _GDataCategoryPrivate {
 	gchar *term;
-	gchar *scheme;
+	const gchar *scheme; /* may be one of known_schemes */
 	gchar *label;
+
+	/* Unowned #GDataEntrys whose indices the category is in */
+	GSList *indexing_entries;
+};
+
+/* Schemes which are shared between categories, rather than copied, since almost every category in a feed uses one of them */
+static const gchar * const known_schemes[] = {
+	"http://schemas.google.com/g/2005#kind",
+	"http://schemas.google.com/g/2005/labels",
+	NULL
 };
 
 enum {
@@ -149,14 +160,26 @@ gdata_category_finalize (GObject *object)
 {
 	GDataCategoryPrivate *priv = GDATA_CATEGORY (object)->priv;
 
+	g_slist_free (priv->indexing_entries);
+
 	g_free (priv->term);
-	g_free (priv->scheme);
+	gdata_parser_free_known_string (priv->scheme, known_schemes);
 	g_free (priv->label);
 
 	/* Chain up to the parent class */
 	G_OBJECT_CLASS (gdata_category_parent_class)->finalize (object);
 }
 
+/* Rebuild the indices of all the entries which @self is in, after one of the properties they're keyed by has changed */
+static void
+reindex_entries (GDataCategory *self)
+{
+	GSList *i;
+
+	for (i = self->priv->indexing_entries; i != NULL; i = i->next)
+		_gdata_entry_reindex (GDATA_ENTRY (i->data));
+}
+
 static void
 gdata_category_get_property (GObject *object, guint property_id, GValue *value, GParamSpec *pspec)
 {
@@ -221,7 +244,8 @@ pre_parse_xml (GDataParsable *parsable, xmlDoc *doc, xmlNode *root_node, gpointe
 	}
 
 	self->priv->term = (gchar*) term;
-	self->priv->scheme = (gchar*) scheme;
+	self->priv->scheme = gdata_parser_dup_known_string ((const gchar*) scheme, known_schemes);
+	xmlFree (scheme);
 	self->priv->label = (gchar*) xmlGetProp (root_node, (xmlChar*) "label");
 
 	return TRUE;
@@ -296,6 +320,9 @@ gdata_category_set_term (GDataCategory *self, const gchar *term)
 
 	g_free (self->priv->term);
 	self->priv->term = g_strdup (term);
+
+	reindex_entries (self);
+
 	g_object_notify (G_OBJECT (self), "term");
 }
 
@@ -330,10 +357,13 @@ gdata_category_get_scheme (GDataCategory *self)
 void
 gdata_category_set_scheme (GDataCategory *self, const gchar *scheme)
 {
+	const gchar *old_scheme;
+
 	g_return_if_fail (GDATA_IS_CATEGORY (self));
 
-	g_free (self->priv->scheme);
-	self->priv->scheme = g_strdup (scheme);
+	old_scheme = self->priv->scheme;
+	self->priv->scheme = gdata_parser_dup_known_string (scheme, known_schemes);
+	gdata_parser_free_known_string (old_scheme, known_schemes);
 	g_object_notify (G_OBJECT (self), "scheme");
 }
 
@@ -374,3 +404,25 @@ gdata_category_set_label (GDataCategory *self, const gchar *label)
 	self->priv->label = g_strdup (label);
 	g_object_notify (G_OBJECT (self), "label");
 }
+
+/*
+ * _gdata_category_set_indexed:
+ * @self: a #GDataCategory
+ * @entry: the #GDataEntry whose indices @self has been added to or removed from
+ * @indexed: %TRUE if @self has been added to @entry's indices, %FALSE if it has been removed
+ *
+ * Records whether @self is in the indices of @entry, so that changes to its term can cause @entry to rebuild them.
+ *
+ * Since: 0.19.0
+ */
+void
+_gdata_category_set_indexed (GDataCategory *self, GDataEntry *entry, gboolean indexed)
+{
+	g_return_if_fail (GDATA_IS_CATEGORY (self));
+	g_return_if_fail (GDATA_IS_ENTRY (entry));
+
+	if (indexed == FALSE)
+		self->priv->indexing_entries = g_slist_remove (self->priv->indexing_entries, entry);
+	else if (g_slist_find (self->priv->indexing_entries, entry) == NULL)
+		self->priv->indexing_entries = g_slist_prepend (self->priv->indexing_entries, entry);
+}
@@ -37,6 +37,7 @@
 #include "gdata-parsable.h"
 #include "gdata-parser.h"
 #include "gdata-comparable.h"
+#include "gdata-private.h"
 
 static void gdata_link_comparable_init (GDataComparableIface *iface);
 static void gdata_link_finalize (GObject *object);
@@ -47,11 +48,40 @@ static void pre_get_xml (GDataParsable *parsable, GString *xml_string);
 
 struct _GDataLinkPrivate {
 	gchar *uri;
-	gchar *relation_type;
-	gchar *content_type;
+	const gchar *relation_type; /* may be one of known_relation_types */
+	const gchar *content_type; /* may be one of known_content_types */
 	gchar *language;
 	gchar *title;
 	gint length;
+
+	/* Unowned #GDataEntrys whose indices the link is in */
+	GSList *indexing_entries;
+};
+
+/* Relation and content types which are shared between links, rather than copied, since almost every link in a feed uses one of them. Anything else
+ * comes from the user or the server and is copied, so that it can be freed again. */
+static const gchar * const known_relation_types[] = {
+	GDATA_LINK_ALTERNATE,
+	GDATA_LINK_RELATED,
+	GDATA_LINK_SELF,
+	GDATA_LINK_ENCLOSURE,
+	GDATA_LINK_VIA,
+	GDATA_LINK_EDIT,
+	GDATA_LINK_EDIT_MEDIA,
+	GDATA_LINK_PARENT,
+	"http://www.iana.org/assignments/relation/next",
+	"http://www.iana.org/assignments/relation/previous",
+	"http://schemas.google.com/g/2005#feed",
+	"http://schemas.google.com/g/2005#post",
+	"http://schemas.google.com/g/2005#batch",
+	NULL
+};
+
+static const gchar * const known_content_types[] = {
+	"application/atom+xml",
+	"text/html",
+	"image/jpeg",
+	NULL
 };
 
 enum {
@@ -200,7 +230,7 @@ gdata_link_init (GDataLink *self)
 {
 	self->priv = gdata_link_get_instance_private (self);
 	self->priv->length = -1;
-	self->priv->relation_type = g_strdup (GDATA_LINK_ALTERNATE);
+	self->priv->relation_type = known_relation_types[0]; /* GDATA_LINK_ALTERNATE */
 }
 
 static void
@@ -208,9 +238,11 @@ gdata_link_finalize (GObject *object)
 {
 	GDataLinkPrivate *priv = GDATA_LINK (object)->priv;
 
+	g_slist_free (priv->indexing_entries);
+
 	g_free (priv->uri);
-	g_free (priv->relation_type);
-	g_free (priv->content_type);
+	gdata_parser_free_known_string (priv->relation_type, known_relation_types);
+	gdata_parser_free_known_string (priv->content_type, known_content_types);
 	g_free (priv->language);
 	g_free (priv->title);
 
@@ -218,6 +250,16 @@ gdata_link_finalize (GObject *object)
 	G_OBJECT_CLASS (gdata_link_parent_class)->finalize (object);
 }
 
+/* Rebuild the indices of all the entries which @self is in, after one of the properties they're keyed by has changed */
+static void
+reindex_entries (GDataLink *self)
+{
+	GSList *i;
+
+	for (i = self->priv->indexing_entries; i != NULL; i = i->next)
+		_gdata_entry_reindex (GDATA_ENTRY (i->data));
+}
+
 static void
 gdata_link_get_property (GObject *object, guint property_id, GValue *value, GParamSpec *pspec)
 {
@@ -323,7 +365,8 @@ pre_parse_xml (GDataParsable *parsable, xmlDoc *doc, xmlNode *root_node, gpointe
 	self->priv->uri = (gchar*) uri;
 	gdata_link_set_relation_type (self, (const gchar*) relation_type);
 	xmlFree (relation_type);
-	self->priv->content_type = (gchar*) content_type;
+	self->priv->content_type = gdata_parser_dup_known_string ((const gchar*) content_type, known_content_types);
+	xmlFree (content_type);
 	self->priv->language = (gchar*) language;
 	self->priv->title = (gchar*) xmlGetProp (root_node, (xmlChar*) "title");
 
@@ -416,6 +459,9 @@ gdata_link_set_uri (GDataLink *self, const gchar *uri)
 
 	g_free (self->priv->uri);
 	self->priv->uri = g_strdup (uri);
+
+	reindex_entries (self);
+
 	g_object_notify (G_OBJECT (self), "uri");
 }
 
@@ -451,6 +497,8 @@ gdata_link_get_relation_type (GDataLink *self)
 void
 gdata_link_set_relation_type (GDataLink *self, const gchar *relation_type)
 {
+	const gchar *old_relation_type;
+
 	g_return_if_fail (GDATA_IS_LINK (self));
 	g_return_if_fail (relation_type == NULL || *relation_type != '\0');
 
@@ -458,13 +506,19 @@ gdata_link_set_relation_type (GDataLink *self, const gchar *relation_type)
 	 * by appending it to "http://www.iana.org/assignments/relation/". If it's set and is an IRI, just use the IRI.
 	 * See: http://www.atomenabled.org/developers/syndication/atom-format-spec.php#rel_attribute
 	 */
-	g_free (self->priv->relation_type);
-	if (relation_type == NULL)
-		self->priv->relation_type = g_strdup (GDATA_LINK_ALTERNATE);
-	else if (strchr ((char*) relation_type, ':') == NULL)
-		self->priv->relation_type = g_strconcat ("http://www.iana.org/assignments/relation/", (const gchar*) relation_type, NULL);
-	else
-		self->priv->relation_type = g_strdup ((gchar*) relation_type);
+	old_relation_type = self->priv->relation_type;
+	if (relation_type == NULL) {
+		self->priv->relation_type = known_relation_types[0]; /* GDATA_LINK_ALTERNATE */
+	} else if (strchr ((char*) relation_type, ':') == NULL) {
+		gchar *iri = g_strconcat ("http://www.iana.org/assignments/relation/", (const gchar*) relation_type, NULL);
+		self->priv->relation_type = gdata_parser_dup_known_string (iri, known_relation_types);
+		g_free (iri);
+	} else {
+		self->priv->relation_type = gdata_parser_dup_known_string (relation_type, known_relation_types);
+	}
+	gdata_parser_free_known_string (old_relation_type, known_relation_types);
+
+	reindex_entries (self);
 
 	g_object_notify (G_OBJECT (self), "relation-type");
 }
@@ -500,11 +554,14 @@ gdata_link_get_content_type (GDataLink *self)
 void
 gdata_link_set_content_type (GDataLink *self, const gchar *content_type)
 {
+	const gchar *old_content_type;
+
 	g_return_if_fail (GDATA_IS_LINK (self));
 	g_return_if_fail (content_type == NULL || *content_type != '\0');
 
-	g_free (self->priv->content_type);
-	self->priv->content_type = g_strdup (content_type);
+	old_content_type = self->priv->content_type;
+	self->priv->content_type = gdata_parser_dup_known_string (content_type, known_content_types);
+	gdata_parser_free_known_string (old_content_type, known_content_types);
 	g_object_notify (G_OBJECT (self), "content-type");
 }
 
@@ -622,3 +679,25 @@ gdata_link_set_length (GDataLink *self, gint length)
 	self->priv->length = length;
 	g_object_notify (G_OBJECT (self), "length");
 }
+
+/*
+ * _gdata_link_set_indexed:
+ * @self: a #GDataLink
+ * @entry: the #GDataEntry whose indices @self has been added to or removed from
+ * @indexed: %TRUE if @self has been added to @entry's indices, %FALSE if it has been removed
+ *
+ * Records whether @self is in the indices of @entry, so that changes to its URI or relation type can cause @entry to rebuild them.
+ *
+ * Since: 0.19.0
+ */
+void
+_gdata_link_set_indexed (GDataLink *self, GDataEntry *entry, gboolean indexed)
+{
+	g_return_if_fail (GDATA_IS_LINK (self));
+	g_return_if_fail (GDATA_IS_ENTRY (entry));
+
+	if (indexed == FALSE)
+		self->priv->indexing_entries = g_slist_remove (self->priv->indexing_entries, entry);
+	else if (g_slist_find (self->priv->indexing_entries, entry) == NULL)
+		self->priv->indexing_entries = g_slist_prepend (self->priv->indexing_entries, entry);
+}
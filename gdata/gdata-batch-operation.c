@@ -424,6 +424,7 @@ static void
 operation_free (BatchOperation *op)
 {
 	g_free (op->query_id);
+	g_free (op->upload_uri);
 	if (op->entry != NULL)
 		g_object_unref (op->entry);
 	if (op->error != NULL)
@@ -509,6 +510,41 @@ gdata_batch_operation_add_insertion (GDataBatchOperation *self, GDataEntry *entr
 	return add_operation (self, GDATA_BATCH_OPERATION_INSERTION, entry, callback, user_data);
 }
 
+/**
+ * gdata_batch_operation_add_insertion_to_uri:
+ * @self: a #GDataBatchOperation
+ * @entry: the #GDataEntry to insert
+ * @upload_uri: the URI of the collection to insert @entry into
+ * @callback: (scope async): a #GDataBatchOperationCallback to call when the insertion is finished, or %NULL
+ * @user_data: (closure): data to pass to the @callback function
+ *
+ * Add an entry to the #GDataBatchOperation, to be inserted into the collection at @upload_uri when the operation is run, as with
+ * gdata_service_insert_entry(). Otherwise, this behaves exactly as gdata_batch_operation_add_insertion().
+ *
+ * This is needed for insertions of JSON entries, as the JSON batch protocol sends each operation to its own URI rather than posting them all to
+ * one feed. For XML entries, @upload_uri is ignored and the entry is inserted into the feed at #GDataBatchOperation:feed-uri.
+ *
+ * Return value: operation ID for the added insertion, or <code class="literal">0</code>
+ *
+ * Since: 0.19.0
+ */
+guint
+gdata_batch_operation_add_insertion_to_uri (GDataBatchOperation *self, GDataEntry *entry, const gchar *upload_uri,
+                                            GDataBatchOperationCallback callback, gpointer user_data)
+{
+	guint id;
+
+	g_return_val_if_fail (GDATA_IS_BATCH_OPERATION (self), 0);
+	g_return_val_if_fail (GDATA_IS_ENTRY (entry), 0);
+	g_return_val_if_fail (upload_uri != NULL && *upload_uri != '\0', 0);
+	g_return_val_if_fail (self->priv->has_run == FALSE, 0);
+
+	id = add_operation (self, GDATA_BATCH_OPERATION_INSERTION, entry, callback, user_data);
+	_gdata_batch_operation_get_operation (self, id)->upload_uri = g_strdup (upload_uri);
+
+	return id;
+}
+
 /**
  * gdata_batch_operation_add_update:
  * @self: a #GDataBatchOperation
@@ -569,6 +605,319 @@ gdata_batch_operation_add_deletion (GDataBatchOperation *self, GDataEntry *entry
 	return add_operation (self, GDATA_BATCH_OPERATION_DELETION, entry, callback, user_data);
 }
 
+/* Return the type of the entry which will be returned by @op, and which determines the format the operation is sent in. */
+static GType
+get_operation_entry_type (BatchOperation *op)
+{
+	return (op->type == GDATA_BATCH_OPERATION_QUERY) ? op->entry_type : G_OBJECT_TYPE (op->entry);
+}
+
+static gboolean
+operation_is_json (BatchOperation *op)
+{
+	GDataParsableClass *klass;
+	gboolean is_json;
+
+	klass = g_type_class_ref (get_operation_entry_type (op));
+	g_assert (klass->get_content_type != NULL);
+	is_json = (g_strcmp0 (klass->get_content_type (), "application/json") == 0);
+	g_type_class_unref (klass);
+
+	return is_json;
+}
+
+static GDataOperationType
+get_service_operation_type (GDataBatchOperationType type)
+{
+	switch (type) {
+		case GDATA_BATCH_OPERATION_QUERY:
+			return GDATA_OPERATION_QUERY;
+		case GDATA_BATCH_OPERATION_INSERTION:
+			return GDATA_OPERATION_INSERTION;
+		case GDATA_BATCH_OPERATION_UPDATE:
+			return GDATA_OPERATION_UPDATE;
+		case GDATA_BATCH_OPERATION_DELETION:
+			return GDATA_OPERATION_DELETION;
+		default:
+			g_assert_not_reached ();
+	}
+}
+
+/* Build the application/http body of a single part of a JSON batch request. Returns %NULL if there's no URI to send the operation to. */
+static GBytes *
+build_json_part (BatchOperation *op)
+{
+	GString *part;
+	const gchar *method, *etag = NULL;
+	gchar *uri = NULL, *body = NULL;
+	SoupURI *soup_uri;
+
+	switch (op->type) {
+		case GDATA_BATCH_OPERATION_QUERY: {
+			GDataEntryClass *klass = g_type_class_ref (op->entry_type);
+
+			/* JSON entry IDs are generally not URIs, so fall back to the ID itself only if it happens to be one (e.g. a self link) */
+			if (klass->get_entry_uri != NULL)
+				uri = klass->get_entry_uri (op->query_id);
+			else if (g_str_has_prefix (op->query_id, "https://") || g_str_has_prefix (op->query_id, "http://"))
+				uri = g_strdup (op->query_id);
+
+			g_type_class_unref (klass);
+			method = SOUP_METHOD_GET;
+			break;
+		}
+		case GDATA_BATCH_OPERATION_INSERTION:
+			uri = g_strdup (op->upload_uri);
+			method = SOUP_METHOD_POST;
+			body = gdata_parsable_get_json (GDATA_PARSABLE (op->entry));
+			break;
+		case GDATA_BATCH_OPERATION_UPDATE:
+		case GDATA_BATCH_OPERATION_DELETION: {
+			GDataLink *_link = gdata_entry_look_up_link (op->entry, GDATA_LINK_SELF);
+
+			if (_link != NULL)
+				uri = g_strdup (gdata_link_get_uri (_link));
+
+			etag = gdata_entry_get_etag (op->entry);
+
+			if (op->type == GDATA_BATCH_OPERATION_UPDATE) {
+				method = SOUP_METHOD_PUT;
+				body = gdata_parsable_get_json (GDATA_PARSABLE (op->entry));
+			} else {
+				method = SOUP_METHOD_DELETE;
+			}
+
+			break;
+		}
+		default:
+			g_assert_not_reached ();
+	}
+
+	soup_uri = (uri != NULL) ? soup_uri_new (uri) : NULL;
+	g_free (uri);
+
+	if (soup_uri == NULL) {
+		g_free (body);
+		return NULL;
+	}
+
+	/* Each part is a complete HTTP request, addressed relative to the batch endpoint's host */
+	part = g_string_new (NULL);
+	g_string_append_printf (part, "%s %s%s%s HTTP/1.1\r\n", method, soup_uri->path,
+	                        (soup_uri->query != NULL) ? "?" : "", (soup_uri->query != NULL) ? soup_uri->query : "");
+	soup_uri_free (soup_uri);
+
+	if (etag != NULL)
+		g_string_append_printf (part, "If-Match: %s\r\n", etag);
+
+	if (body != NULL) {
+		g_string_append_printf (part, "Content-Type: application/json; charset=UTF-8\r\nContent-Length: %" G_GSIZE_FORMAT "\r\n\r\n%s",
+		                        strlen (body), body);
+		g_free (body);
+	} else {
+		g_string_append (part, "\r\n");
+	}
+
+	return g_string_free_to_bytes (part);
+}
+
+/* Handle a single application/http part of a JSON batch response, running the callback for the operation it corresponds to. Returns %FALSE if the
+ * part couldn't be matched to an operation. */
+static gboolean
+handle_json_part (GDataBatchOperation *self, SoupMessageHeaders *part_headers, SoupBuffer *part_body)
+{
+	GDataBatchOperationPrivate *priv = self->priv;
+	const gchar *content_id, *header_end, *body;
+	SoupMessageHeaders *headers;
+	BatchOperation *op;
+	guint64 id;
+	guint status;
+	gchar *reason_phrase = NULL;
+	gsize body_length;
+	GError *child_error = NULL;
+
+	/* Responses are labelled with the Content-ID of their request, prefixed with "response-" */
+	content_id = soup_message_headers_get_one (part_headers, "Content-ID");
+	if (content_id == NULL || g_str_has_prefix (content_id, "<response-item") == FALSE)
+		return FALSE;
+
+	id = g_ascii_strtoull (content_id + strlen ("<response-item"), NULL, 10);
+	op = (id <= G_MAXUINT) ? _gdata_batch_operation_get_operation (self, id) : NULL;
+	if (op == NULL || op->has_result == TRUE)
+		return FALSE;
+
+	header_end = g_strstr_len (part_body->data, part_body->length, "\r\n\r\n");
+	if (header_end == NULL)
+		return FALSE;
+
+	headers = soup_message_headers_new (SOUP_MESSAGE_HEADERS_RESPONSE);
+	if (soup_headers_parse_response (part_body->data, header_end + 4 - part_body->data, headers, NULL, &status, &reason_phrase) == FALSE) {
+		soup_message_headers_free (headers);
+		return FALSE;
+	}
+
+	soup_message_headers_free (headers);
+
+	body = header_end + 4;
+	body_length = part_body->data + part_body->length - body;
+
+	if (SOUP_STATUS_IS_SUCCESSFUL (status) == FALSE) {
+		GDataServiceClass *klass = GDATA_SERVICE_GET_CLASS (priv->service);
+
+		g_assert (klass->parse_error_response != NULL);
+		klass->parse_error_response (priv->service, get_service_operation_type (op->type), status, reason_phrase, body, body_length,
+		                             &child_error);
+		_gdata_batch_operation_run_callback (self, op, NULL, child_error);
+	} else if (op->type == GDATA_BATCH_OPERATION_DELETION) {
+		/* Deletions don't return anything */
+		_gdata_batch_operation_run_callback (self, op, NULL, NULL);
+	} else {
+		GDataParsable *entry;
+
+		entry = _gdata_parsable_new_from_json (get_operation_entry_type (op), body, body_length, NULL, &child_error);
+		_gdata_batch_operation_run_callback (self, op, GDATA_ENTRY (entry), child_error);
+		g_clear_object (&entry);
+	}
+
+	g_free (reason_phrase);
+	op->has_result = TRUE;
+
+	return TRUE;
+}
+
+/* Run a batch operation consisting entirely of JSON entries, using the multipart/mixed batch protocol of the newer Google APIs. Each operation is
+ * sent as its own HTTP request in one part of the batch request, and the server replies with one HTTP response per part. */
+static gboolean
+run_json (GDataBatchOperation *self, GCancellable *cancellable, GError **error)
+{
+	GDataBatchOperationPrivate *priv = self->priv;
+	SoupMessage *message;
+	SoupMultipart *multipart;
+	GHashTableIter iter;
+	gpointer op_id;
+	BatchOperation *op;
+	guint status, i, n_parts = 0;
+	GError *child_error = NULL;
+
+	/* Build the request */
+	multipart = soup_multipart_new ("multipart/mixed");
+
+	g_hash_table_iter_init (&iter, priv->operations);
+	while (g_hash_table_iter_next (&iter, &op_id, (gpointer*) &op) == TRUE) {
+		SoupMessageHeaders *part_headers;
+		SoupBuffer *part_body;
+		GBytes *part;
+		gchar *content_id;
+
+		part = build_json_part (op);
+
+		if (part == NULL) {
+			/* There's nowhere to send this operation to, so fail it without failing the whole batch */
+			_gdata_batch_operation_run_callback (self, op, NULL,
+			                                     g_error_new_literal (GDATA_SERVICE_ERROR, GDATA_SERVICE_ERROR_WITH_BATCH_OPERATION,
+			                                                          _("A batch operation had no URI to be sent to.")));
+			op->has_result = TRUE;
+			continue;
+		}
+
+		part_headers = soup_message_headers_new (SOUP_MESSAGE_HEADERS_MULTIPART);
+		soup_message_headers_replace (part_headers, "Content-Type", "application/http");
+		soup_message_headers_replace (part_headers, "Content-Transfer-Encoding", "binary");
+		content_id = g_strdup_printf ("<item%u>", op->id);
+		soup_message_headers_replace (part_headers, "Content-ID", content_id);
+		g_free (content_id);
+
+		part_body = soup_buffer_new_with_owner (g_bytes_get_data (part, NULL), g_bytes_get_size (part), part,
+		                                        (GDestroyNotify) g_bytes_unref);
+		soup_multipart_append_part (multipart, part_headers, part_body);
+
+		soup_buffer_free (part_body);
+		soup_message_headers_free (part_headers);
+		n_parts++;
+	}
+
+	/* Ensure that this GDataBatchOperation can't be run again */
+	priv->has_run = TRUE;
+
+	/* If none of the operations could be sent, every callback has already been called, and there's no point in sending an empty request */
+	if (n_parts == 0) {
+		soup_multipart_free (multipart);
+		return TRUE;
+	}
+
+	message = _gdata_service_build_message (priv->service, priv->authorization_domain, SOUP_METHOD_POST, priv->feed_uri, NULL, TRUE);
+
+	/* Report the request as a batch operation in the service's request metrics, rather than as an insertion */
+	g_object_set_data (G_OBJECT (message), "gdata-operation-type", GUINT_TO_POINTER (GDATA_OPERATION_BATCH));
+
+	soup_multipart_to_message (multipart, message->request_headers, message->request_body);
+	soup_multipart_free (multipart);
+
+	/* Send the message */
+	status = _gdata_service_send_message (priv->service, message, cancellable, &child_error);
+
+	if (status != SOUP_STATUS_OK) {
+		/* Iff status is SOUP_STATUS_NONE or SOUP_STATUS_CANCELLED, child_error has already been set */
+		if (status != SOUP_STATUS_NONE && status != SOUP_STATUS_CANCELLED) {
+			/* Error */
+			GDataServiceClass *klass = GDATA_SERVICE_GET_CLASS (priv->service);
+			g_assert (klass->parse_error_response != NULL);
+			klass->parse_error_response (priv->service, GDATA_OPERATION_BATCH, status, message->reason_phrase, message->response_body->data,
+			                             message->response_body->length, &child_error);
+		}
+		g_object_unref (message);
+
+		goto error;
+	}
+
+	/* Demultiplex the response; the parts may come back in any order */
+	multipart = soup_multipart_new_from_message (message->response_headers, message->response_body);
+	g_object_unref (message);
+
+	if (multipart == NULL) {
+		g_set_error_literal (&child_error, GDATA_SERVICE_ERROR, GDATA_SERVICE_ERROR_PROTOCOL_ERROR,
+		                     _("The server returned a malformed response."));
+		goto error;
+	}
+
+	for (i = 0; i < (guint) soup_multipart_get_length (multipart); i++) {
+		SoupMessageHeaders *part_headers;
+		SoupBuffer *part_body;
+
+		if (soup_multipart_get_part (multipart, i, &part_headers, &part_body) == TRUE)
+			handle_json_part (self, part_headers, part_body);
+	}
+
+	soup_multipart_free (multipart);
+
+	/* Fail any operations the server didn't respond to */
+	g_hash_table_iter_init (&iter, priv->operations);
+	while (g_hash_table_iter_next (&iter, &op_id, (gpointer*) &op) == TRUE) {
+		if (op->has_result == FALSE) {
+			_gdata_batch_operation_run_callback (self, op, NULL,
+			                                     g_error_new_literal (GDATA_SERVICE_ERROR, GDATA_SERVICE_ERROR_PROTOCOL_ERROR,
+			                                                          _("The server returned a malformed response.")));
+			op->has_result = TRUE;
+		}
+	}
+
+	return TRUE;
+
+error:
+	/* Call the callbacks for each of our outstanding operations to notify them of the error */
+	g_hash_table_iter_init (&iter, priv->operations);
+	while (g_hash_table_iter_next (&iter, &op_id, (gpointer*) &op) == TRUE) {
+		if (op->has_result == FALSE) {
+			_gdata_batch_operation_run_callback (self, op, NULL, g_error_copy (child_error));
+			op->has_result = TRUE;
+		}
+	}
+
+	g_propagate_error (error, child_error);
+
+	return FALSE;
+}
+
 /**
  * gdata_batch_operation_run:
  * @self: a #GDataBatchOperation
@@ -588,6 +937,12 @@ gdata_batch_operation_add_deletion (GDataBatchOperation *self, GDataEntry *entry
  * @cancellable can be used to cancel the entire batch operation any time before or during the network activity. If @cancellable is cancelled
  * after network activity has finished, gdata_batch_operation_run() will continue and finish as normal.
  *
+ * If all of the operations are on JSON entries (such as those from the Calendar, Tasks and Drive APIs), the operations are sent using the
+ * <ulink type="http" url="https://developers.google.com/calendar/batch">multipart/mixed batch protocol</ulink>, with each operation as a
+ * separate HTTP request in one part of the batch request. In that case, #GDataBatchOperation:feed-uri should be the API's batch endpoint (e.g.
+ * <literal>https://www.googleapis.com/batch/calendar/v3</literal>), and insertions must be added with
+ * gdata_batch_operation_add_insertion_to_uri(). JSON and XML entries cannot be mixed in a single batch operation.
+ *
  * Return value: %TRUE on success, %FALSE otherwise
  *
  * Since: 0.7.0
@@ -604,6 +959,7 @@ gdata_batch_operation_run (GDataBatchOperation *self, GCancellable *cancellable,
 	GHashTableIter iter;
 	gpointer op_id;
 	BatchOperation *op;
+	guint n_json = 0;
 	GError *child_error = NULL;
 
 	g_return_val_if_fail (GDATA_IS_BATCH_OPERATION (self), FALSE);
@@ -633,10 +989,26 @@ gdata_batch_operation_run (GDataBatchOperation *self, GCancellable *cancellable,
 			               "this service."));
 			return FALSE;
 		}
+
+		if (operation_is_json (op) == TRUE)
+			n_json++;
+	}
+
+	/* JSON entries use a different batch protocol from Atom entries, and the two can't be mixed in one request */
+	if (n_json > 0 && n_json < g_hash_table_size (priv->operations)) {
+		g_set_error (error, GDATA_SERVICE_ERROR,
+		             GDATA_SERVICE_ERROR_WITH_BATCH_OPERATION,
+		             _("Batch operations cannot mix JSON and XML entries."));
+		return FALSE;
+	} else if (n_json > 0) {
+		return run_json (self, cancellable, error);
 	}
 
 	message = _gdata_service_build_message (priv->service, priv->authorization_domain, SOUP_METHOD_POST, priv->feed_uri, NULL, TRUE);
 
+	/* Report the request as a batch operation in the service's request metrics, rather than as an insertion */
+	g_object_set_data (G_OBJECT (message), "gdata-operation-type", GUINT_TO_POINTER (GDATA_OPERATION_BATCH));
+
 	/* Build the request */
 	updated = g_get_real_time () / G_USEC_PER_SEC;
 	feed = _gdata_feed_new (GDATA_TYPE_FEED, "Batch operation feed",
@@ -138,6 +138,8 @@ const gchar *gdata_batch_operation_get_feed_uri (GDataBatchOperation *self) G_GN
 guint gdata_batch_operation_add_query (GDataBatchOperation *self, const gchar *id, GType entry_type,
                                        GDataBatchOperationCallback callback, gpointer user_data);
 guint gdata_batch_operation_add_insertion (GDataBatchOperation *self, GDataEntry *entry, GDataBatchOperationCallback callback, gpointer user_data);
+guint gdata_batch_operation_add_insertion_to_uri (GDataBatchOperation *self, GDataEntry *entry, const gchar *upload_uri,
+                                                  GDataBatchOperationCallback callback, gpointer user_data);
 guint gdata_batch_operation_add_update (GDataBatchOperation *self, GDataEntry *entry, GDataBatchOperationCallback callback, gpointer user_data);
 guint gdata_batch_operation_add_deletion (GDataBatchOperation *self, GDataEntry *entry, GDataBatchOperationCallback callback, gpointer user_data);
 
@@ -34,6 +34,8 @@ typedef struct {
 	GType entry_type; /* only used for queries */
 	GError *error;
 	GDataEntry *entry; /* used for anything except queries, and to store the results of all operations */
+	gchar *upload_uri; /* only used for insertions in JSON batch operations */
+	gboolean has_result; /* TRUE once the operation's callback has been run with its result; only used in JSON batch operations */
 } BatchOperation;
 
 G_GNUC_INTERNAL BatchOperation *_gdata_batch_operation_get_operation (GDataBatchOperation *self, guint id) G_GNUC_PURE;
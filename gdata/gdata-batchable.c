@@ -39,13 +39,15 @@
 GType
 gdata_batchable_get_type (void)
 {
-	static GType batchable_type = 0;
+	static gsize batchable_type = 0;
 
-	if (!batchable_type) {
-		batchable_type = g_type_register_static_simple (G_TYPE_INTERFACE, "GDataBatchable",
-		                                                sizeof (GDataBatchableIface),
-		                                                NULL, 0, NULL, 0);
-		g_type_interface_add_prerequisite (batchable_type, GDATA_TYPE_SERVICE);
+	/* Entries are parsed in worker threads, so this may be called from several threads at once */
+	if (g_once_init_enter (&batchable_type)) {
+		GType type = g_type_register_static_simple (G_TYPE_INTERFACE, "GDataBatchable",
+		                                            sizeof (GDataBatchableIface),
+		                                            NULL, 0, NULL, 0);
+		g_type_interface_add_prerequisite (type, GDATA_TYPE_SERVICE);
+		g_once_init_leave (&batchable_type, type);
 	}
 
 	return batchable_type;
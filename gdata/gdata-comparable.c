@@ -41,12 +41,14 @@
 GType
 gdata_comparable_get_type (void)
 {
-	static GType comparable_type = 0;
+	static gsize comparable_type = 0;
 
-	if (!comparable_type) {
-		comparable_type = g_type_register_static_simple (G_TYPE_INTERFACE, "GDataComparable",
-		                                                 sizeof (GDataComparableIface),
-		                                                 NULL, 0, NULL, 0);
+	/* Entries are parsed in worker threads, so this may be called from several threads at once */
+	if (g_once_init_enter (&comparable_type)) {
+		GType type = g_type_register_static_simple (G_TYPE_INTERFACE, "GDataComparable",
+		                                            sizeof (GDataComparableIface),
+		                                            NULL, 0, NULL, 0);
+		g_once_init_leave (&comparable_type, type);
 	}
 
 	return comparable_type;
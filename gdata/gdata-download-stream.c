@@ -170,6 +170,13 @@ struct _GDataDownloadStreamPrivate {
 	gchar *content_type;
 	gssize content_length;
 	GMutex content_mutex; /* mutex to protect them */
+
+	/* Optional checksum of the data read so far; only touched from the thread calling gdata_download_stream_read() */
+	GChecksum *checksum; /* NULL if checksumming is disabled, or if the stream has been seeked */
+	GChecksumType checksum_type;
+	gchar *expected_checksum;
+	goffset checksum_length; /* number of bytes covered by ->checksum; must equal ->offset for it to be updated */
+	gboolean checksum_finished; /* TRUE once ->checksum covers the whole download */
 };
 
 enum {
@@ -428,6 +435,10 @@ gdata_download_stream_finalize (GObject *object)
 
 	g_free (priv->download_uri);
 	g_free (priv->content_type);
+	g_free (priv->expected_checksum);
+
+	if (priv->checksum != NULL)
+		g_checksum_free (priv->checksum);
 
 	/* Chain up to the parent class */
 	G_OBJECT_CLASS (gdata_download_stream_parent_class)->finalize (object);
@@ -574,6 +585,22 @@ done:
 	if (child_error != NULL)
 		g_propagate_error (error, child_error);
 
+	/* Hash the data as it's handed out, so the caller doesn't have to read it all again to verify it. This only works if the data is read
+	 * sequentially; seeking anywhere else before the end of the data invalidates the checksum. */
+	if (length_read > 0 && priv->checksum != NULL && priv->checksum_finished == FALSE) {
+		if (priv->checksum_length == priv->offset) {
+			g_checksum_update (priv->checksum, buffer, length_read);
+			priv->checksum_length += length_read;
+		} else {
+			g_checksum_free (priv->checksum);
+			priv->checksum = NULL;
+		}
+	}
+
+	if (reached_eof == TRUE && priv->checksum != NULL && priv->checksum_finished == FALSE &&
+	    priv->checksum_length == priv->offset + MAX (length_read, 0))
+		priv->checksum_finished = TRUE;
+
 	/* Update our internal offset */
 	if (length_read > 0) {
 		priv->offset += length_read;
@@ -676,6 +703,15 @@ done:
 
 	g_mutex_unlock (&(priv->finished_mutex));
 
+	/* If the whole download was checksummed, verify it against the checksum the caller expected */
+	if (success == TRUE && priv->checksum_finished == TRUE && priv->expected_checksum != NULL &&
+	    g_ascii_strcasecmp (g_checksum_get_string (priv->checksum), priv->expected_checksum) != 0) {
+		g_set_error (&child_error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA,
+		             _("The downloaded data’s checksum (‘%s’) did not match the expected checksum (‘%s’)."),
+		             g_checksum_get_string (priv->checksum), priv->expected_checksum);
+		success = FALSE;
+	}
+
 	g_assert ((success == TRUE && child_error == NULL) || (success == FALSE && child_error != NULL));
 
 	if (child_error != NULL)
@@ -1097,3 +1133,68 @@ gdata_download_stream_get_cancellable (GDataDownloadStream *self)
 	g_assert (self->priv->cancellable != NULL);
 	return self->priv->cancellable;
 }
+
+/**
+ * gdata_download_stream_set_checksum:
+ * @self: a #GDataDownloadStream
+ * @checksum_type: the type of checksum to compute
+ * @expected_checksum: (allow-none): the checksum the downloaded data is expected to have, as a hexadecimal string, or %NULL
+ *
+ * Enables computing a checksum of the downloaded data as it is read from the stream, so that the data can be verified without having to read it
+ * all again after the download has finished. This must be called before the first read from the stream.
+ *
+ * If @expected_checksum is non-%NULL (for example, the value of gdata_documents_entry_get_md5_checksum()), it is compared against the computed
+ * checksum when the stream is closed, and g_input_stream_close() will fail with %G_IO_ERROR_INVALID_DATA if they differ. The comparison is only
+ * made if all of the data was read, in order, from the start of the stream; the checksum is abandoned if the stream is seeked.
+ *
+ * Since: 0.19.0
+ */
+void
+gdata_download_stream_set_checksum (GDataDownloadStream *self, GChecksumType checksum_type, const gchar *expected_checksum)
+{
+	GDataDownloadStreamPrivate *priv;
+
+	g_return_if_fail (GDATA_IS_DOWNLOAD_STREAM (self));
+
+	priv = self->priv;
+	g_return_if_fail (priv->network_thread == NULL && priv->offset == 0);
+
+	if (priv->checksum != NULL)
+		g_checksum_free (priv->checksum);
+
+	priv->checksum = g_checksum_new (checksum_type);
+	g_return_if_fail (priv->checksum != NULL);
+
+	priv->checksum_type = checksum_type;
+	priv->checksum_length = 0;
+	priv->checksum_finished = FALSE;
+
+	g_free (priv->expected_checksum);
+	priv->expected_checksum = g_strdup (expected_checksum);
+}
+
+/**
+ * gdata_download_stream_get_checksum:
+ * @self: a #GDataDownloadStream
+ * @checksum_type: (out) (optional): return location for the type of the checksum, or %NULL
+ *
+ * Gets the checksum of the downloaded data, as enabled by gdata_download_stream_set_checksum(). The checksum is only available once all of the
+ * data has been read from the stream; before then, or if checksumming wasn't enabled, or if the stream was seeked, %NULL is returned.
+ *
+ * Return value: (allow-none): the checksum of the downloaded data as a hexadecimal string, or %NULL
+ *
+ * Since: 0.19.0
+ */
+const gchar *
+gdata_download_stream_get_checksum (GDataDownloadStream *self, GChecksumType *checksum_type)
+{
+	g_return_val_if_fail (GDATA_IS_DOWNLOAD_STREAM (self), NULL);
+
+	if (self->priv->checksum_finished == FALSE)
+		return NULL;
+
+	if (checksum_type != NULL)
+		*checksum_type = self->priv->checksum_type;
+
+	return g_checksum_get_string (self->priv->checksum);
+}
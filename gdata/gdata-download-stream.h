@@ -82,6 +82,9 @@ const gchar *gdata_download_stream_get_content_type (GDataDownloadStream *self)
 gssize gdata_download_stream_get_content_length (GDataDownloadStream *self) G_GNUC_PURE;
 GCancellable *gdata_download_stream_get_cancellable (GDataDownloadStream *self) G_GNUC_PURE;
 
+void gdata_download_stream_set_checksum (GDataDownloadStream *self, GChecksumType checksum_type, const gchar *expected_checksum);
+const gchar *gdata_download_stream_get_checksum (GDataDownloadStream *self, GChecksumType *checksum_type);
+
 G_END_DECLS
 
 #endif /* !GDATA_DOWNLOAD_STREAM_H */
@@ -0,0 +1,1096 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 8; tab-width: 8 -*- */
+/*
+ * GData Client
+ *
+ * GData Client is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * GData Client is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GData Client.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * SECTION:gdata-entry-mirror
+ * @short_description: GData local mirror of an account's entries
+ * @stability: Unstable
+ * @include: gdata/gdata-entry-mirror.h
+ *
+ * #GDataEntryMirror keeps a local copy of the entries in a feed, such as the files in a Google Drive account or the events in a calendar, so
+ * that common lookups can be answered without going to the network. Entries are indexed by ID, and can be listed by parent folder, by title
+ * prefix and by updated time without parsing any entries other than those returned.
+ *
+ * The mirror is filled and kept up to date with gdata_entry_mirror_refresh(). After the first refresh, refreshes are incremental: they set
+ * #GDataQuery:updated-min to the newest updated time in the mirror, so only the entries which have changed since are downloaded. Entries
+ * which the server reports as deleted (see #GDataEntryClass.is_deleted) are removed from the mirror. Services which don't report deletions
+ * in incremental results (for example, Google Drive omits trashed files unless #GDataDocumentsQuery:show-deleted is set) should be given an
+ * occasional full refresh, which also removes every entry the query no longer returns. When querying Google Calendar, set
+ * #GDataCalendarQuery:show-deleted so that cancelled events are returned.
+ *
+ * gdata_entry_mirror_save() writes the mirror to a file in a compact binary format, and gdata_entry_mirror_load() maps it back into memory.
+ * Loading only builds the indices: each entry is parsed from the file the first time it's returned. The file format is private to
+ * libgdata, and contains the #GType names of the mirrored entries, so it should only be loaded by the program which saved it. Entries fetched by
+ * gdata_entry_mirror_refresh() are saved as the JSON the server returned for them, so everything about them survives a save and load. Entries
+ * added with gdata_entry_mirror_add_entry() are saved as the JSON produced by gdata_parsable_get_json(), which only has the properties needed to
+ * upload the entry, until the next refresh which returns them replaces them.
+ *
+ * A #GDataEntryMirror is not thread safe, and must only be used from one thread at a time.
+ *
+ * <example>
+ * 	<title>Mirroring a Google Drive Account</title>
+ * 	<programlisting>
+ *	GDataEntryMirror *mirror;
+ *	GDataDocumentsQuery *query;
+ *	GFile *file;
+ *	GList *children, *i;
+ *	GError *error = NULL;
+ *
+ *	mirror = gdata_entry_mirror_new (GDATA_TYPE_DOCUMENTS_ENTRY);
+ *	file = g_file_new_for_path ("drive-mirror.bin");
+ *
+ *	/<!-- -->* Load the mirror from the last run, if there is one; otherwise the refresh below is a full one *<!-- -->/
+ *	if (gdata_entry_mirror_load (mirror, file, NULL, &error) == FALSE) {
+ *		g_clear_error (&error);
+ *	}
+ *
+ *	/<!-- -->* Fetch the files which have changed since the last run *<!-- -->/
+ *	query = gdata_documents_query_new_with_limits (NULL, 0, 1000);
+ *	gdata_documents_query_set_show_folders (query, TRUE);
+ *
+ *	if (gdata_entry_mirror_refresh (mirror, GDATA_SERVICE (service), gdata_documents_service_get_primary_authorization_domain (),
+ *	                                "https://www.googleapis.com/drive/v2/files", GDATA_QUERY (query), FALSE, NULL, &error) == FALSE) {
+ *		g_warning ("Error refreshing mirror: %s", error->message);
+ *		g_clear_error (&error);
+ *	}
+ *
+ *	g_object_unref (query);
+ *
+ *	/<!-- -->* List a folder without going to the network *<!-- -->/
+ *	children = gdata_entry_mirror_list_children (mirror, folder_id);
+ *
+ *	for (i = children; i != NULL; i = i->next) {
+ *		/<!-- -->* Do something with the entry here *<!-- -->/
+ *	}
+ *
+ *	g_list_free_full (children, g_object_unref);
+ *
+ *	gdata_entry_mirror_save (mirror, file, NULL, NULL);
+ *
+ *	g_object_unref (file);
+ *	g_object_unref (mirror);
+ * 	</programlisting>
+ * </example>
+ *
+ * Since: 0.19.0
+ */
+
+#include <config.h>
+#include <glib.h>
+#include <glib/gi18n-lib.h>
+#include <string.h>
+#include <json-glib/json-glib.h>
+#include <libsoup/soup.h>
+
+#include "gdata-entry-mirror.h"
+#include "gdata-private.h"
+
+/* Version of the file format written by gdata_entry_mirror_save(); bump it whenever MIRROR_RECORD_TYPE changes */
+#define MIRROR_FILE_VERSION 1
+
+/* Each record is: entry type name, ID, ETag, title, updated time, parent IDs, JSON */
+#define MIRROR_RECORD_TYPE "(ssssxass)"
+
+/* The file is: version, mirror entry type name, records */
+#define MIRROR_FILE_TYPE "(usa" MIRROR_RECORD_TYPE ")"
+
+static void gdata_entry_mirror_finalize (GObject *object);
+static void gdata_entry_mirror_get_property (GObject *object, guint property_id, GValue *value, GParamSpec *pspec);
+static void gdata_entry_mirror_set_property (GObject *object, guint property_id, const GValue *value, GParamSpec *pspec);
+
+typedef struct {
+	GVariant *data; /* MIRROR_RECORD_TYPE; either built from an entry, or a child of a file loaded by gdata_entry_mirror_load() */
+	const gchar *type_name, *id, *etag, *title, *json; /* all borrowed from data */
+	gint64 updated;
+	const gchar **parent_ids; /* the array is owned, but the strings are borrowed from data */
+	GSequenceIter *title_iter;
+	GSequenceIter *updated_iter;
+	GDataEntry *entry; /* parsed from json the first time it's needed */
+} MirrorRecord;
+
+struct _GDataEntryMirrorPrivate {
+	GType entry_type;
+	GHashTable *records; /* entry ID (borrowed from the record) → owned MirrorRecord */
+	GHashTable *children; /* parent ID → set of MirrorRecords */
+	GSequence *by_title; /* MirrorRecords, ordered by title then ID */
+	GSequence *by_updated; /* MirrorRecords, ordered by updated time then ID */
+};
+
+enum {
+	PROP_ENTRY_TYPE = 1,
+};
+
+G_DEFINE_TYPE_WITH_PRIVATE (GDataEntryMirror, gdata_entry_mirror, G_TYPE_OBJECT)
+
+static void
+gdata_entry_mirror_class_init (GDataEntryMirrorClass *klass)
+{
+	GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+
+	gobject_class->get_property = gdata_entry_mirror_get_property;
+	gobject_class->set_property = gdata_entry_mirror_set_property;
+	gobject_class->finalize = gdata_entry_mirror_finalize;
+
+	/**
+	 * GDataEntryMirror:entry-type:
+	 *
+	 * The type of the entries in the mirror. This is passed to gdata_service_query() when refreshing the mirror, and every mirrored entry is
+	 * an instance of it (or of one of its subtypes).
+	 *
+	 * Since: 0.19.0
+	 */
+	g_object_class_install_property (gobject_class, PROP_ENTRY_TYPE,
+	                                 g_param_spec_gtype ("entry-type",
+	                                                     "Entry type", "The type of the entries in the mirror.",
+	                                                     GDATA_TYPE_ENTRY,
+	                                                     G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS));
+}
+
+static MirrorRecord *
+mirror_record_new (GVariant *data)
+{
+	MirrorRecord *record;
+
+	record = g_slice_new0 (MirrorRecord);
+	record->data = g_variant_ref_sink (data);
+	g_variant_get (record->data, "(&s&s&s&sx^a&s&s)", &record->type_name, &record->id, &record->etag, &record->title, &record->updated,
+	               &record->parent_ids, &record->json);
+
+	return record;
+}
+
+/* Build a record for @entry, saving @json as its JSON if it's given. Otherwise, the JSON is built with gdata_parsable_get_json(). */
+static MirrorRecord *
+mirror_record_new_from_entry (GDataEntry *entry, const gchar *json)
+{
+	MirrorRecord *record;
+	gchar **parent_ids;
+	gchar *built_json = NULL;
+
+	parent_ids = _gdata_entry_get_parent_ids (entry);
+
+	if (json == NULL)
+		json = built_json = gdata_parsable_get_json (GDATA_PARSABLE (entry));
+
+	record = mirror_record_new (g_variant_new ("(ssssx^ass)",
+	                                           G_OBJECT_TYPE_NAME (entry),
+	                                           gdata_entry_get_id (entry),
+	                                           (gdata_entry_get_etag (entry) != NULL) ? gdata_entry_get_etag (entry) : "",
+	                                           (gdata_entry_get_title (entry) != NULL) ? gdata_entry_get_title (entry) : "",
+	                                           gdata_entry_get_updated (entry),
+	                                           (const gchar * const *) parent_ids,
+	                                           json));
+	g_free (built_json);
+	g_strfreev (parent_ids);
+
+	record->entry = g_object_ref (entry);
+
+	return record;
+}
+
+static void
+mirror_record_free (MirrorRecord *record)
+{
+	g_clear_object (&record->entry);
+	g_free (record->parent_ids);
+	g_variant_unref (record->data);
+	g_slice_free (MirrorRecord, record);
+}
+
+static gint
+compare_records_by_title (gconstpointer a, gconstpointer b, gpointer user_data)
+{
+	const MirrorRecord *record_a = a, *record_b = b;
+	gint retval;
+
+	retval = strcmp (record_a->title, record_b->title);
+	if (retval != 0)
+		return retval;
+
+	return strcmp (record_a->id, record_b->id);
+}
+
+static gint
+compare_record_pointers_by_title (gconstpointer a, gconstpointer b, gpointer user_data)
+{
+	return compare_records_by_title (*((MirrorRecord * const *) a), *((MirrorRecord * const *) b), user_data);
+}
+
+static gint
+compare_records_by_updated (gconstpointer a, gconstpointer b, gpointer user_data)
+{
+	const MirrorRecord *record_a = a, *record_b = b;
+
+	if (record_a->updated != record_b->updated)
+		return (record_a->updated < record_b->updated) ? -1 : 1;
+
+	return strcmp (record_a->id, record_b->id);
+}
+
+static gboolean
+remove_record (GDataEntryMirror *self, const gchar *id)
+{
+	GDataEntryMirrorPrivate *priv = self->priv;
+	MirrorRecord *record;
+	guint i;
+
+	record = g_hash_table_lookup (priv->records, id);
+	if (record == NULL)
+		return FALSE;
+
+	g_sequence_remove (record->title_iter);
+	g_sequence_remove (record->updated_iter);
+
+	for (i = 0; record->parent_ids[i] != NULL; i++) {
+		GHashTable *children = g_hash_table_lookup (priv->children, record->parent_ids[i]);
+
+		if (children != NULL && g_hash_table_remove (children, record) == TRUE && g_hash_table_size (children) == 0)
+			g_hash_table_remove (priv->children, record->parent_ids[i]);
+	}
+
+	/* This frees the record */
+	g_hash_table_remove (priv->records, record->id);
+
+	return TRUE;
+}
+
+static void
+insert_record (GDataEntryMirror *self, MirrorRecord *record)
+{
+	GDataEntryMirrorPrivate *priv = self->priv;
+	guint i;
+
+	remove_record (self, record->id);
+
+	g_hash_table_insert (priv->records, (gpointer) record->id, record);
+	record->title_iter = g_sequence_insert_sorted (priv->by_title, record, compare_records_by_title, NULL);
+	record->updated_iter = g_sequence_insert_sorted (priv->by_updated, record, compare_records_by_updated, NULL);
+
+	for (i = 0; record->parent_ids[i] != NULL; i++) {
+		GHashTable *children = g_hash_table_lookup (priv->children, record->parent_ids[i]);
+
+		if (children == NULL) {
+			children = g_hash_table_new (g_direct_hash, g_direct_equal);
+			g_hash_table_insert (priv->children, g_strdup (record->parent_ids[i]), children);
+		}
+
+		g_hash_table_add (children, record);
+	}
+}
+
+static void
+clear_records (GDataEntryMirror *self)
+{
+	GDataEntryMirrorPrivate *priv = self->priv;
+
+	g_sequence_remove_range (g_sequence_get_begin_iter (priv->by_title), g_sequence_get_end_iter (priv->by_title));
+	g_sequence_remove_range (g_sequence_get_begin_iter (priv->by_updated), g_sequence_get_end_iter (priv->by_updated));
+	g_hash_table_remove_all (priv->children);
+	g_hash_table_remove_all (priv->records);
+}
+
+static GDataEntry *
+get_record_entry (GDataEntryMirror *self, MirrorRecord *record)
+{
+	GType entry_type;
+	GError *error = NULL;
+
+	if (record->entry != NULL)
+		return record->entry;
+
+	entry_type = g_type_from_name (record->type_name);
+	if (entry_type == G_TYPE_INVALID || g_type_is_a (entry_type, self->priv->entry_type) == FALSE) {
+		g_warning ("Mirrored entry ‘%s’ has unknown type ‘%s’.", record->id, record->type_name);
+		return NULL;
+	}
+
+	record->entry = GDATA_ENTRY (gdata_parsable_new_from_json (entry_type, record->json, -1, &error));
+	if (record->entry == NULL) {
+		g_warning ("Error parsing mirrored entry ‘%s’: %s", record->id, error->message);
+		g_error_free (error);
+		return NULL;
+	}
+
+	/* Not every entry type serialises these the same way it parses them, so restore them from the record */
+	_gdata_entry_set_id (record->entry, record->id);
+	_gdata_entry_set_etag (record->entry, (*record->etag != '\0') ? record->etag : NULL);
+	_gdata_entry_set_updated (record->entry, record->updated);
+
+	return record->entry;
+}
+
+/* Returns a list of references to the entries of the records between @begin and @end, in order */
+static GList *
+list_entries (GDataEntryMirror *self, GSequenceIter *begin, GSequenceIter *end)
+{
+	GSequenceIter *iter;
+	GList *entries = NULL;
+
+	for (iter = begin; iter != end; iter = g_sequence_iter_next (iter)) {
+		GDataEntry *entry = get_record_entry (self, g_sequence_get (iter));
+
+		if (entry != NULL)
+			entries = g_list_prepend (entries, g_object_ref (entry));
+	}
+
+	return g_list_reverse (entries);
+}
+
+static void
+gdata_entry_mirror_init (GDataEntryMirror *self)
+{
+	self->priv = gdata_entry_mirror_get_instance_private (self);
+
+	self->priv->records = g_hash_table_new_full (g_str_hash, g_str_equal, NULL, (GDestroyNotify) mirror_record_free);
+	self->priv->children = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify) g_hash_table_unref);
+	self->priv->by_title = g_sequence_new (NULL);
+	self->priv->by_updated = g_sequence_new (NULL);
+}
+
+static void
+gdata_entry_mirror_finalize (GObject *object)
+{
+	GDataEntryMirrorPrivate *priv = GDATA_ENTRY_MIRROR (object)->priv;
+
+	g_sequence_free (priv->by_updated);
+	g_sequence_free (priv->by_title);
+	g_hash_table_unref (priv->children);
+	g_hash_table_unref (priv->records);
+
+	/* Chain up to the parent class */
+	G_OBJECT_CLASS (gdata_entry_mirror_parent_class)->finalize (object);
+}
+
+static void
+gdata_entry_mirror_get_property (GObject *object, guint property_id, GValue *value, GParamSpec *pspec)
+{
+	GDataEntryMirror *self = GDATA_ENTRY_MIRROR (object);
+
+	switch (property_id) {
+		case PROP_ENTRY_TYPE:
+			g_value_set_gtype (value, self->priv->entry_type);
+			break;
+		default:
+			/* We don't have any other property... */
+			G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+			break;
+	}
+}
+
+static void
+gdata_entry_mirror_set_property (GObject *object, guint property_id, const GValue *value, GParamSpec *pspec)
+{
+	GDataEntryMirror *self = GDATA_ENTRY_MIRROR (object);
+
+	switch (property_id) {
+		case PROP_ENTRY_TYPE:
+			self->priv->entry_type = g_value_get_gtype (value);
+			break;
+		default:
+			/* We don't have any other property... */
+			G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+			break;
+	}
+}
+
+/**
+ * gdata_entry_mirror_new:
+ * @entry_type: the type of the entries to mirror, which must be a subtype of #GDataEntry
+ *
+ * Creates a new, empty #GDataEntryMirror for entries of type @entry_type.
+ *
+ * Return value: (transfer full): a new #GDataEntryMirror; unref with g_object_unref()
+ *
+ * Since: 0.19.0
+ */
+GDataEntryMirror *
+gdata_entry_mirror_new (GType entry_type)
+{
+	g_return_val_if_fail (g_type_is_a (entry_type, GDATA_TYPE_ENTRY), NULL);
+
+	return g_object_new (GDATA_TYPE_ENTRY_MIRROR, "entry-type", entry_type, NULL);
+}
+
+/**
+ * gdata_entry_mirror_get_entry_type:
+ * @self: a #GDataEntryMirror
+ *
+ * Gets the #GDataEntryMirror:entry-type property.
+ *
+ * Return value: the type of the entries in the mirror
+ *
+ * Since: 0.19.0
+ */
+GType
+gdata_entry_mirror_get_entry_type (GDataEntryMirror *self)
+{
+	g_return_val_if_fail (GDATA_IS_ENTRY_MIRROR (self), G_TYPE_INVALID);
+	return self->priv->entry_type;
+}
+
+/**
+ * gdata_entry_mirror_get_n_entries:
+ * @self: a #GDataEntryMirror
+ *
+ * Gets the number of entries in the mirror.
+ *
+ * Return value: the number of mirrored entries
+ *
+ * Since: 0.19.0
+ */
+guint
+gdata_entry_mirror_get_n_entries (GDataEntryMirror *self)
+{
+	g_return_val_if_fail (GDATA_IS_ENTRY_MIRROR (self), 0);
+	return g_hash_table_size (self->priv->records);
+}
+
+/**
+ * gdata_entry_mirror_get_last_updated:
+ * @self: a #GDataEntryMirror
+ *
+ * Gets the newest #GDataEntry:updated time of the entries in the mirror. This is the time from which the next incremental refresh fetches
+ * changes. Since it comes from the server, it isn't affected by any difference between the server's clock and the local one.
+ *
+ * Return value: the UNIX timestamp of the most recently updated entry, or <code class="literal">-1</code> if the mirror is empty
+ *
+ * Since: 0.19.0
+ */
+gint64
+gdata_entry_mirror_get_last_updated (GDataEntryMirror *self)
+{
+	GSequenceIter *last;
+
+	g_return_val_if_fail (GDATA_IS_ENTRY_MIRROR (self), -1);
+
+	last = g_sequence_get_end_iter (self->priv->by_updated);
+	if (g_sequence_iter_is_begin (last) == TRUE)
+		return -1;
+
+	return ((MirrorRecord *) g_sequence_get (g_sequence_iter_prev (last)))->updated;
+}
+
+/**
+ * gdata_entry_mirror_load:
+ * @self: a #GDataEntryMirror
+ * @file: the file to load the mirror from
+ * @cancellable: (allow-none): optional #GCancellable object, or %NULL
+ * @error: a #GError, or %NULL
+ *
+ * Replaces the contents of the mirror with those saved in @file by gdata_entry_mirror_save(). If @file is a local file, it's mapped into memory
+ * rather than read, and the entries are only parsed from it as they're returned by the mirror.
+ *
+ * If @file can't be loaded, or wasn't saved from a mirror with the same #GDataEntryMirror:entry-type, an error is returned and the mirror is left
+ * unchanged.
+ *
+ * Return value: %TRUE on success, %FALSE otherwise
+ *
+ * Since: 0.19.0
+ */
+gboolean
+gdata_entry_mirror_load (GDataEntryMirror *self, GFile *file, GCancellable *cancellable, GError **error)
+{
+	GBytes *bytes;
+	GVariant *root, *records, *record;
+	GVariantIter iter;
+	const gchar *entry_type_name;
+	gchar *path;
+	guint32 version;
+
+	g_return_val_if_fail (GDATA_IS_ENTRY_MIRROR (self), FALSE);
+	g_return_val_if_fail (G_IS_FILE (file), FALSE);
+	g_return_val_if_fail (cancellable == NULL || G_IS_CANCELLABLE (cancellable), FALSE);
+	g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+
+	path = g_file_get_path (file);
+
+	if (path != NULL) {
+		GMappedFile *mapped_file;
+
+		mapped_file = g_mapped_file_new (path, FALSE, error);
+		g_free (path);
+
+		if (mapped_file == NULL)
+			return FALSE;
+
+		bytes = g_mapped_file_get_bytes (mapped_file);
+		g_mapped_file_unref (mapped_file);
+	} else {
+		bytes = g_file_load_bytes (file, cancellable, NULL, error);
+
+		if (bytes == NULL)
+			return FALSE;
+	}
+
+	/* GVariant copes with any malformed data without reading out of bounds, so there's no need to validate the whole file up front. A truncated
+	 * or empty file reads as version 0. */
+	root = g_variant_ref_sink (g_variant_new_from_bytes (G_VARIANT_TYPE (MIRROR_FILE_TYPE), bytes, FALSE));
+	g_bytes_unref (bytes);
+
+	g_variant_get_child (root, 0, "u", &version);
+
+	if (version == GUINT32_SWAP_LE_BE (MIRROR_FILE_VERSION)) {
+		/* Saved on a machine with the opposite byte order */
+		GVariant *swapped = g_variant_byteswap (root);
+		g_variant_unref (root);
+		root = swapped;
+	} else if (version != MIRROR_FILE_VERSION) {
+		g_set_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA,
+		             /* Translators: the parameter is the version number of an unsupported file format. */
+		             _("The mirror file is in an unsupported format (version %u)."), version);
+		g_variant_unref (root);
+		return FALSE;
+	}
+
+	g_variant_get_child (root, 1, "&s", &entry_type_name);
+
+	if (strcmp (entry_type_name, g_type_name (self->priv->entry_type)) != 0) {
+		g_set_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA,
+		             /* Translators: the parameters are the names of entry types, such as "GDataCalendarEvent". */
+		             _("The mirror file contains entries of type ‘%s’ rather than ‘%s’."), entry_type_name, g_type_name (self->priv->entry_type));
+		g_variant_unref (root);
+		return FALSE;
+	}
+
+	clear_records (self);
+
+	/* The records keep the parts of the file they refer to alive, so root can be released straight away */
+	records = g_variant_get_child_value (root, 2);
+	g_variant_iter_init (&iter, records);
+
+	while ((record = g_variant_iter_next_value (&iter)) != NULL) {
+		insert_record (self, mirror_record_new (record));
+		g_variant_unref (record);
+	}
+
+	g_variant_unref (records);
+	g_variant_unref (root);
+
+	return TRUE;
+}
+
+/**
+ * gdata_entry_mirror_save:
+ * @self: a #GDataEntryMirror
+ * @file: the file to save the mirror to
+ * @cancellable: (allow-none): optional #GCancellable object, or %NULL
+ * @error: a #GError, or %NULL
+ *
+ * Saves the contents of the mirror to @file, replacing it atomically if it already exists, so that it can be loaded again later by
+ * gdata_entry_mirror_load(). The file is only readable by the current user.
+ *
+ * Return value: %TRUE on success, %FALSE otherwise
+ *
+ * Since: 0.19.0
+ */
+gboolean
+gdata_entry_mirror_save (GDataEntryMirror *self, GFile *file, GCancellable *cancellable, GError **error)
+{
+	GVariantBuilder records;
+	GSequenceIter *iter;
+	GVariant *root;
+	GBytes *bytes;
+	gboolean success;
+
+	g_return_val_if_fail (GDATA_IS_ENTRY_MIRROR (self), FALSE);
+	g_return_val_if_fail (G_IS_FILE (file), FALSE);
+	g_return_val_if_fail (cancellable == NULL || G_IS_CANCELLABLE (cancellable), FALSE);
+	g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+
+	/* Write the records in updated order, so that saving the same mirror twice gives the same file */
+	g_variant_builder_init (&records, G_VARIANT_TYPE ("a" MIRROR_RECORD_TYPE));
+
+	for (iter = g_sequence_get_begin_iter (self->priv->by_updated); g_sequence_iter_is_end (iter) == FALSE; iter = g_sequence_iter_next (iter))
+		g_variant_builder_add_value (&records, ((MirrorRecord *) g_sequence_get (iter))->data);
+
+	root = g_variant_ref_sink (g_variant_new (MIRROR_FILE_TYPE, MIRROR_FILE_VERSION, g_type_name (self->priv->entry_type), &records));
+	bytes = g_variant_get_data_as_bytes (root);
+
+	success = g_file_replace_contents (file, g_bytes_get_data (bytes, NULL), g_bytes_get_size (bytes), NULL, FALSE, G_FILE_CREATE_PRIVATE, NULL,
+	                                   cancellable, error);
+
+	g_bytes_unref (bytes);
+	g_variant_unref (root);
+
+	return success;
+}
+
+/* Append the JSON of each element of the "items" array of the JSON feed in @data to @entries_json, in order. Leaves @entries_json empty if @data
+ * can't be parsed, which only happens if parsing the feed has failed too. */
+static void
+get_entries_json (const gchar *data, gssize length, GPtrArray *entries_json)
+{
+	JsonParser *parser;
+	JsonNode *root;
+	JsonArray *items;
+	JsonGenerator *generator;
+	guint i;
+
+	parser = json_parser_new ();
+
+	if (json_parser_load_from_data (parser, data, length, NULL) == FALSE ||
+	    (root = json_parser_get_root (parser)) == NULL || JSON_NODE_HOLDS_OBJECT (root) == FALSE ||
+	    json_object_has_member (json_node_get_object (root), "items") == FALSE ||
+	    JSON_NODE_HOLDS_ARRAY (json_object_get_member (json_node_get_object (root), "items")) == FALSE) {
+		g_object_unref (parser);
+		return;
+	}
+
+	items = json_object_get_array_member (json_node_get_object (root), "items");
+	generator = json_generator_new ();
+
+	for (i = 0; i < json_array_get_length (items); i++) {
+		json_generator_set_root (generator, json_array_get_element (items, i));
+		g_ptr_array_add (entries_json, json_generator_to_data (generator, NULL));
+	}
+
+	g_object_unref (generator);
+	g_object_unref (parser);
+}
+
+/* Fetch the next page of results for @query. This sends the request and parses the feed separately, rather than calling gdata_service_query(), so
+ * that it can also keep the JSON the server returned for each entry: that's what's mirrored, as gdata_parsable_get_json() only writes the properties
+ * needed to upload an entry. On success, @entries_json holds the JSON of each of the feed's entries, in order, or is empty if the feed isn't JSON. */
+static GDataFeed *
+query_page (GDataEntryMirror *self, GDataService *service, GDataAuthorizationDomain *domain, const gchar *feed_uri, GDataQuery *query,
+            GCancellable *cancellable, GPtrArray *entries_json, GError **error)
+{
+	GDataServiceClass *klass = GDATA_SERVICE_GET_CLASS (service);
+	SoupMessage *message;
+	GDataFeed *feed;
+
+	message = _gdata_service_query (service, domain, feed_uri, query, cancellable, error);
+	if (message == NULL)
+		return NULL;
+
+	g_assert (klass->parse_feed != NULL);
+	feed = klass->parse_feed (service, domain, query, self->priv->entry_type, message, cancellable, NULL, NULL, error);
+
+	if (feed != NULL &&
+	    g_strcmp0 (soup_message_headers_get_content_type (message->response_headers, NULL), "application/json") == 0) {
+		get_entries_json (message->response_body->data, message->response_body->length, entries_json);
+
+		/* Don't pair the wrong JSON with an entry if the feed somehow didn't have one entry per item */
+		if (entries_json->len != g_list_length (gdata_feed_get_entries (feed)))
+			g_ptr_array_set_size (entries_json, 0);
+	}
+
+	g_object_unref (message);
+
+	return feed;
+}
+
+/**
+ * gdata_entry_mirror_refresh:
+ * @self: a #GDataEntryMirror
+ * @service: the #GDataService to query
+ * @domain: (allow-none): the #GDataAuthorizationDomain to authorize the queries with, or %NULL
+ * @feed_uri: the feed URI to query, such as <code class="literal">https://www.googleapis.com/drive/v2/files</code>
+ * @query: the #GDataQuery to page through
+ * @full: %TRUE to fetch every entry returned by @query, %FALSE to only fetch those updated since the last refresh
+ * @cancellable: (allow-none): optional #GCancellable object, or %NULL
+ * @error: a #GError, or %NULL
+ *
+ * Brings the mirror up to date with the server, by querying @feed_uri with @query and following every page of results.
+ *
+ * If @full is %FALSE and the mirror isn't empty, #GDataQuery:updated-min is set on @query to gdata_entry_mirror_get_last_updated(), so only the
+ * entries which have changed since the last refresh are downloaded. If @full is %TRUE, every entry returned by @query is downloaded, and any
+ * mirrored entries which weren't returned are removed. In either case, returned entries which the server reports as deleted are removed.
+ *
+ * @query's #GDataQuery:updated-min and pagination are restored before this function returns, so it can be reused for the next refresh.
+ *
+ * If an error occurs part of the way through, the changes made by the pages fetched so far are kept. As the mirror's last updated time only
+ * moves forward with the changes, the next incremental refresh still picks up everything which was missed.
+ *
+ * Return value: %TRUE on success, %FALSE otherwise
+ *
+ * Since: 0.19.0
+ */
+gboolean
+gdata_entry_mirror_refresh (GDataEntryMirror *self, GDataService *service, GDataAuthorizationDomain *domain, const gchar *feed_uri,
+                            GDataQuery *query, gboolean full, GCancellable *cancellable, GError **error)
+{
+	GHashTable *seen_ids = NULL;
+	GPtrArray *entries_json;
+	gint64 old_updated_min;
+	guint old_start_index;
+	gboolean success = TRUE;
+
+	g_return_val_if_fail (GDATA_IS_ENTRY_MIRROR (self), FALSE);
+	g_return_val_if_fail (GDATA_IS_SERVICE (service), FALSE);
+	g_return_val_if_fail (domain == NULL || GDATA_IS_AUTHORIZATION_DOMAIN (domain), FALSE);
+	g_return_val_if_fail (feed_uri != NULL, FALSE);
+	g_return_val_if_fail (GDATA_IS_QUERY (query), FALSE);
+	g_return_val_if_fail (cancellable == NULL || G_IS_CANCELLABLE (cancellable), FALSE);
+	g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+
+	old_updated_min = gdata_query_get_updated_min (query);
+	old_start_index = gdata_query_get_start_index (query);
+	_gdata_query_clear_pagination (query);
+
+	if (full == TRUE) {
+		seen_ids = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+	} else if (g_hash_table_size (self->priv->records) > 0) {
+		/* The bound is inclusive, so entries updated in the same second as the newest mirrored one are fetched again rather than missed */
+		gdata_query_set_updated_min (query, gdata_entry_mirror_get_last_updated (self));
+	}
+
+	entries_json = g_ptr_array_new_with_free_func (g_free);
+
+	do {
+		GDataFeed *feed;
+		GList *entries, *i;
+		guint n;
+
+		g_ptr_array_set_size (entries_json, 0);
+
+		feed = query_page (self, service, domain, feed_uri, query, cancellable, entries_json, error);
+		if (feed == NULL) {
+			success = FALSE;
+			break;
+		}
+
+		entries = gdata_feed_get_entries (feed);
+
+		for (i = entries, n = 0; i != NULL; i = i->next, n++) {
+			GDataEntry *entry = GDATA_ENTRY (i->data);
+			const gchar *id = gdata_entry_get_id (entry);
+
+			if (id == NULL)
+				continue;
+
+			if (_gdata_entry_is_deleted (entry) == TRUE) {
+				remove_record (self, id);
+				continue;
+			}
+
+			insert_record (self, mirror_record_new_from_entry (entry, (n < entries_json->len) ? g_ptr_array_index (entries_json, n) : NULL));
+
+			if (seen_ids != NULL)
+				g_hash_table_add (seen_ids, g_strdup (id));
+		}
+
+		g_object_unref (feed);
+
+		/* Indexed pagination never reports that it's finished, so stop at the first empty page */
+		if (entries == NULL)
+			break;
+
+		gdata_query_next_page (query);
+	} while (_gdata_query_is_finished (query) == FALSE);
+
+	g_ptr_array_unref (entries_json);
+
+	/* Only trust the set of returned entries if every page was fetched */
+	if (success == TRUE && seen_ids != NULL) {
+		GHashTableIter iter;
+		MirrorRecord *record;
+		GPtrArray *unseen_ids;
+		guint i;
+
+		unseen_ids = g_ptr_array_new_with_free_func (g_free);
+
+		g_hash_table_iter_init (&iter, self->priv->records);
+		while (g_hash_table_iter_next (&iter, NULL, (gpointer *) &record) == TRUE) {
+			if (g_hash_table_contains (seen_ids, record->id) == FALSE)
+				g_ptr_array_add (unseen_ids, g_strdup (record->id));
+		}
+
+		for (i = 0; i < unseen_ids->len; i++)
+			remove_record (self, g_ptr_array_index (unseen_ids, i));
+
+		g_ptr_array_unref (unseen_ids);
+	}
+
+	if (seen_ids != NULL)
+		g_hash_table_unref (seen_ids);
+
+	_gdata_query_clear_pagination (query);
+	gdata_query_set_start_index (query, old_start_index);
+	gdata_query_set_updated_min (query, old_updated_min);
+
+	return success;
+}
+
+/**
+ * gdata_entry_mirror_add_entry:
+ * @self: a #GDataEntryMirror
+ * @entry: the entry to add
+ *
+ * Adds @entry to the mirror, replacing any mirrored entry with the same ID. This can be used to keep the mirror up to date with changes made by the
+ * program itself, such as the entry returned by gdata_service_update_entry(), without waiting for the next refresh.
+ *
+ * @entry must have an ID, and must be an instance of #GDataEntryMirror:entry-type.
+ *
+ * Since: 0.19.0
+ */
+void
+gdata_entry_mirror_add_entry (GDataEntryMirror *self, GDataEntry *entry)
+{
+	g_return_if_fail (GDATA_IS_ENTRY_MIRROR (self));
+	g_return_if_fail (G_TYPE_CHECK_INSTANCE_TYPE (entry, self->priv->entry_type));
+	g_return_if_fail (gdata_entry_get_id (entry) != NULL);
+
+	insert_record (self, mirror_record_new_from_entry (entry, NULL));
+}
+
+/**
+ * gdata_entry_mirror_remove_entry:
+ * @self: a #GDataEntryMirror
+ * @id: the ID of the entry to remove
+ *
+ * Removes the entry with ID @id from the mirror, if it's there. This can be used to keep the mirror up to date after deleting an entry with
+ * gdata_service_delete_entry().
+ *
+ * Return value: %TRUE if the entry was in the mirror, %FALSE otherwise
+ *
+ * Since: 0.19.0
+ */
+gboolean
+gdata_entry_mirror_remove_entry (GDataEntryMirror *self, const gchar *id)
+{
+	g_return_val_if_fail (GDATA_IS_ENTRY_MIRROR (self), FALSE);
+	g_return_val_if_fail (id != NULL, FALSE);
+
+	return remove_record (self, id);
+}
+
+/**
+ * gdata_entry_mirror_lookup:
+ * @self: a #GDataEntryMirror
+ * @id: the ID of the entry to look up
+ *
+ * Looks up the entry with ID @id in the mirror. This never goes to the network; see gdata_entry_mirror_get_entry() for a version which queries the
+ * server if the entry isn't mirrored.
+ *
+ * Return value: (transfer full) (allow-none): the mirrored entry, or %NULL; unref with g_object_unref()
+ *
+ * Since: 0.19.0
+ */
+GDataEntry *
+gdata_entry_mirror_lookup (GDataEntryMirror *self, const gchar *id)
+{
+	MirrorRecord *record;
+	GDataEntry *entry;
+
+	g_return_val_if_fail (GDATA_IS_ENTRY_MIRROR (self), NULL);
+	g_return_val_if_fail (id != NULL, NULL);
+
+	record = g_hash_table_lookup (self->priv->records, id);
+	if (record == NULL)
+		return NULL;
+
+	entry = get_record_entry (self, record);
+
+	return (entry != NULL) ? g_object_ref (entry) : NULL;
+}
+
+/**
+ * gdata_entry_mirror_get_etag:
+ * @self: a #GDataEntryMirror
+ * @id: the ID of the entry
+ *
+ * Gets the ETag of the mirrored entry with ID @id, without parsing the entry. This can be compared with an ETag from elsewhere to find whether
+ * the mirrored entry is current, or set as #GDataQuery:etag to make a conditional query for the entry.
+ *
+ * Return value: (allow-none): the entry's ETag, or %NULL if the entry isn't mirrored or has no ETag
+ *
+ * Since: 0.19.0
+ */
+const gchar *
+gdata_entry_mirror_get_etag (GDataEntryMirror *self, const gchar *id)
+{
+	MirrorRecord *record;
+
+	g_return_val_if_fail (GDATA_IS_ENTRY_MIRROR (self), NULL);
+	g_return_val_if_fail (id != NULL, NULL);
+
+	record = g_hash_table_lookup (self->priv->records, id);
+	if (record == NULL || *record->etag == '\0')
+		return NULL;
+
+	return record->etag;
+}
+
+/**
+ * gdata_entry_mirror_get_entry:
+ * @self: a #GDataEntryMirror
+ * @service: the #GDataService to query if the entry isn't mirrored
+ * @domain: (allow-none): the #GDataAuthorizationDomain to authorize the query with, or %NULL
+ * @id: the ID of the entry to get
+ * @cancellable: (allow-none): optional #GCancellable object, or %NULL
+ * @error: a #GError, or %NULL
+ *
+ * Gets the entry with ID @id from the mirror if it's there, or queries it with gdata_service_query_single_entry() and adds it to the mirror
+ * otherwise.
+ *
+ * Return value: (transfer full): the entry, or %NULL; unref with g_object_unref()
+ *
+ * Since: 0.19.0
+ */
+GDataEntry *
+gdata_entry_mirror_get_entry (GDataEntryMirror *self, GDataService *service, GDataAuthorizationDomain *domain, const gchar *id,
+                              GCancellable *cancellable, GError **error)
+{
+	GDataEntry *entry;
+
+	g_return_val_if_fail (GDATA_IS_ENTRY_MIRROR (self), NULL);
+	g_return_val_if_fail (GDATA_IS_SERVICE (service), NULL);
+	g_return_val_if_fail (domain == NULL || GDATA_IS_AUTHORIZATION_DOMAIN (domain), NULL);
+	g_return_val_if_fail (id != NULL, NULL);
+	g_return_val_if_fail (cancellable == NULL || G_IS_CANCELLABLE (cancellable), NULL);
+	g_return_val_if_fail (error == NULL || *error == NULL, NULL);
+
+	entry = gdata_entry_mirror_lookup (self, id);
+	if (entry != NULL)
+		return entry;
+
+	entry = gdata_service_query_single_entry (service, domain, id, NULL, self->priv->entry_type, cancellable, error);
+	if (entry != NULL && gdata_entry_get_id (entry) != NULL && _gdata_entry_is_deleted (entry) == FALSE)
+		insert_record (self, mirror_record_new_from_entry (entry));
+
+	return entry;
+}
+
+/**
+ * gdata_entry_mirror_list_children:
+ * @self: a #GDataEntryMirror
+ * @parent_id: the ID of the parent entry, such as a Google Drive folder
+ *
+ * Lists the mirrored entries which have a %GDATA_LINK_PARENT link to the entry with ID @parent_id, ordered by title.
+ *
+ * Return value: (transfer full) (element-type GData.Entry): the child entries; free with g_list_free_full() and g_object_unref()
+ *
+ * Since: 0.19.0
+ */
+GList *
+gdata_entry_mirror_list_children (GDataEntryMirror *self, const gchar *parent_id)
+{
+	GHashTable *children;
+	GHashTableIter iter;
+	MirrorRecord *record;
+	GPtrArray *records;
+	GList *entries = NULL;
+	guint i;
+
+	g_return_val_if_fail (GDATA_IS_ENTRY_MIRROR (self), NULL);
+	g_return_val_if_fail (parent_id != NULL, NULL);
+
+	children = g_hash_table_lookup (self->priv->children, parent_id);
+	if (children == NULL)
+		return NULL;
+
+	records = g_ptr_array_sized_new (g_hash_table_size (children));
+
+	g_hash_table_iter_init (&iter, children);
+	while (g_hash_table_iter_next (&iter, (gpointer *) &record, NULL) == TRUE)
+		g_ptr_array_add (records, record);
+
+	g_ptr_array_sort_with_data (records, compare_record_pointers_by_title, NULL);
+
+	for (i = records->len; i > 0; i--) {
+		GDataEntry *entry = get_record_entry (self, g_ptr_array_index (records, i - 1));
+
+		if (entry != NULL)
+			entries = g_list_prepend (entries, g_object_ref (entry));
+	}
+
+	g_ptr_array_unref (records);
+
+	return entries;
+}
+
+/**
+ * gdata_entry_mirror_list_by_title_prefix:
+ * @self: a #GDataEntryMirror
+ * @prefix: the prefix to match
+ *
+ * Lists the mirrored entries whose #GDataEntry:title starts with @prefix, ordered by title. The match is case sensitive.
+ *
+ * Return value: (transfer full) (element-type GData.Entry): the matching entries; free with g_list_free_full() and g_object_unref()
+ *
+ * Since: 0.19.0
+ */
+GList *
+gdata_entry_mirror_list_by_title_prefix (GDataEntryMirror *self, const gchar *prefix)
+{
+	MirrorRecord key = { NULL, };
+	GSequenceIter *begin, *end;
+	gsize prefix_length;
+
+	g_return_val_if_fail (GDATA_IS_ENTRY_MIRROR (self), NULL);
+	g_return_val_if_fail (prefix != NULL, NULL);
+
+	/* No ID sorts before the empty string, so this finds the first title which is at least the prefix */
+	key.title = prefix;
+	key.id = "";
+	begin = g_sequence_search (self->priv->by_title, &key, compare_records_by_title, NULL);
+
+	prefix_length = strlen (prefix);
+	for (end = begin; g_sequence_iter_is_end (end) == FALSE; end = g_sequence_iter_next (end)) {
+		if (strncmp (((MirrorRecord *) g_sequence_get (end))->title, prefix, prefix_length) != 0)
+			break;
+	}
+
+	return list_entries (self, begin, end);
+}
+
+/**
+ * gdata_entry_mirror_list_by_updated:
+ * @self: a #GDataEntryMirror
+ * @updated_min: the earliest updated time to list (inclusive), or <code class="literal">-1</code>
+ * @updated_max: the latest updated time to list (exclusive), or <code class="literal">-1</code>
+ *
+ * Lists the mirrored entries whose #GDataEntry:updated time is in the given range, from the least to the most recently updated. As with
+ * #GDataQuery:updated-min and #GDataQuery:updated-max, either bound may be <code class="literal">-1</code> to leave that end of the range open.
+ *
+ * Return value: (transfer full) (element-type GData.Entry): the matching entries; free with g_list_free_full() and g_object_unref()
+ *
+ * Since: 0.19.0
+ */
+GList *
+gdata_entry_mirror_list_by_updated (GDataEntryMirror *self, gint64 updated_min, gint64 updated_max)
+{
+	MirrorRecord key = { NULL, };
+	GSequenceIter *begin, *end;
+
+	g_return_val_if_fail (GDATA_IS_ENTRY_MIRROR (self), NULL);
+	g_return_val_if_fail (updated_min >= -1, NULL);
+	g_return_val_if_fail (updated_max >= -1, NULL);
+
+	if (updated_min != -1 && updated_max != -1 && updated_max <= updated_min)
+		return NULL;
+
+	key.id = "";
+
+	if (updated_min == -1) {
+		begin = g_sequence_get_begin_iter (self->priv->by_updated);
+	} else {
+		key.updated = updated_min;
+		begin = g_sequence_search (self->priv->by_updated, &key, compare_records_by_updated, NULL);
+	}
+
+	if (updated_max == -1) {
+		end = g_sequence_get_end_iter (self->priv->by_updated);
+	} else {
+		key.updated = updated_max;
+		end = g_sequence_search (self->priv->by_updated, &key, compare_records_by_updated, NULL);
+	}
+
+	return list_entries (self, begin, end);
+}
@@ -0,0 +1,102 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 8; tab-width: 8 -*- */
+/*
+ * GData Client
+ *
+ * GData Client is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * GData Client is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GData Client.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GDATA_ENTRY_MIRROR_H
+#define GDATA_ENTRY_MIRROR_H
+
+#include <glib.h>
+#include <glib-object.h>
+#include <gio/gio.h>
+
+#include <gdata/gdata-service.h>
+#include <gdata/gdata-authorization-domain.h>
+#include <gdata/gdata-entry.h>
+#include <gdata/gdata-query.h>
+
+G_BEGIN_DECLS
+
+#define GDATA_TYPE_ENTRY_MIRROR			(gdata_entry_mirror_get_type ())
+#define GDATA_ENTRY_MIRROR(o)			(G_TYPE_CHECK_INSTANCE_CAST ((o), GDATA_TYPE_ENTRY_MIRROR, GDataEntryMirror))
+#define GDATA_ENTRY_MIRROR_CLASS(k)		(G_TYPE_CHECK_CLASS_CAST((k), GDATA_TYPE_ENTRY_MIRROR, GDataEntryMirrorClass))
+#define GDATA_IS_ENTRY_MIRROR(o)		(G_TYPE_CHECK_INSTANCE_TYPE ((o), GDATA_TYPE_ENTRY_MIRROR))
+#define GDATA_IS_ENTRY_MIRROR_CLASS(k)		(G_TYPE_CHECK_CLASS_TYPE ((k), GDATA_TYPE_ENTRY_MIRROR))
+#define GDATA_ENTRY_MIRROR_GET_CLASS(o)		(G_TYPE_INSTANCE_GET_CLASS ((o), GDATA_TYPE_ENTRY_MIRROR, GDataEntryMirrorClass))
+
+typedef struct _GDataEntryMirrorPrivate	GDataEntryMirrorPrivate;
+
+/**
+ * GDataEntryMirror:
+ *
+ * All the fields in the #GDataEntryMirror structure are private and should never be accessed directly.
+ *
+ * Since: 0.19.0
+ */
+typedef struct {
+	GObject parent;
+	GDataEntryMirrorPrivate *priv;
+} GDataEntryMirror;
+
+/**
+ * GDataEntryMirrorClass:
+ *
+ * All the fields in the #GDataEntryMirrorClass structure are private and should never be accessed directly.
+ *
+ * Since: 0.19.0
+ */
+typedef struct {
+	/*< private >*/
+	GObjectClass parent;
+
+	/*< private >*/
+	/* Padding for future expansion */
+	void (*_g_reserved0) (void);
+	void (*_g_reserved1) (void);
+	void (*_g_reserved2) (void);
+	void (*_g_reserved3) (void);
+} GDataEntryMirrorClass;
+
+GType gdata_entry_mirror_get_type (void) G_GNUC_CONST;
+G_DEFINE_AUTOPTR_CLEANUP_FUNC (GDataEntryMirror, g_object_unref)
+
+GDataEntryMirror *gdata_entry_mirror_new (GType entry_type) G_GNUC_WARN_UNUSED_RESULT G_GNUC_MALLOC;
+
+GType gdata_entry_mirror_get_entry_type (GDataEntryMirror *self) G_GNUC_PURE;
+guint gdata_entry_mirror_get_n_entries (GDataEntryMirror *self) G_GNUC_PURE;
+gint64 gdata_entry_mirror_get_last_updated (GDataEntryMirror *self) G_GNUC_PURE;
+
+gboolean gdata_entry_mirror_load (GDataEntryMirror *self, GFile *file, GCancellable *cancellable, GError **error);
+gboolean gdata_entry_mirror_save (GDataEntryMirror *self, GFile *file, GCancellable *cancellable, GError **error);
+
+gboolean gdata_entry_mirror_refresh (GDataEntryMirror *self, GDataService *service, GDataAuthorizationDomain *domain, const gchar *feed_uri,
+                                     GDataQuery *query, gboolean full, GCancellable *cancellable, GError **error);
+
+void gdata_entry_mirror_add_entry (GDataEntryMirror *self, GDataEntry *entry);
+gboolean gdata_entry_mirror_remove_entry (GDataEntryMirror *self, const gchar *id);
+
+GDataEntry *gdata_entry_mirror_lookup (GDataEntryMirror *self, const gchar *id) G_GNUC_WARN_UNUSED_RESULT;
+const gchar *gdata_entry_mirror_get_etag (GDataEntryMirror *self, const gchar *id);
+GDataEntry *gdata_entry_mirror_get_entry (GDataEntryMirror *self, GDataService *service, GDataAuthorizationDomain *domain, const gchar *id,
+                                          GCancellable *cancellable, GError **error) G_GNUC_WARN_UNUSED_RESULT;
+
+GList *gdata_entry_mirror_list_children (GDataEntryMirror *self, const gchar *parent_id) G_GNUC_WARN_UNUSED_RESULT;
+GList *gdata_entry_mirror_list_by_title_prefix (GDataEntryMirror *self, const gchar *prefix) G_GNUC_WARN_UNUSED_RESULT;
+GList *gdata_entry_mirror_list_by_updated (GDataEntryMirror *self, gint64 updated_min, gint64 updated_max) G_GNUC_WARN_UNUSED_RESULT;
+
+G_END_DECLS
+
+#endif /* !GDATA_ENTRY_MIRROR_H */
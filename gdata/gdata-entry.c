@@ -56,6 +56,7 @@ static void pre_get_xml (GDataParsable *parsable, GString *xml_string);
 static void get_xml (GDataParsable *parsable, GString *xml_string);
 static void get_namespaces (GDataParsable *parsable, GHashTable *namespaces);
 static gchar *get_entry_uri (const gchar *id) G_GNUC_WARN_UNUSED_RESULT;
+static gchar **get_parent_ids (GDataEntry *self) G_GNUC_WARN_UNUSED_RESULT;
 static gboolean parse_json (GDataParsable *parsable, JsonReader *reader, gpointer user_data, GError **error);
 static void get_json (GDataParsable *parsable, JsonBuilder *builder);
 
@@ -76,6 +77,14 @@ struct _GDataEntryPrivate {
 	/* Batch processing data */
 	GDataBatchOperationType batch_operation_type;
 	guint batch_id;
+
+	/* Indices over @categories and @links, so that de-duplication and look-ups don't have to walk the lists. They're created when the first
+	 * category or link is added, kept up to date by the add and remove functions, and rebuilt from the lists if a category or link in them is
+	 * modified (see _gdata_entry_reindex()). Look-ups never modify them. */
+	GHashTable *categories_index; /* unowned GDataCategory → unowned GList node in @categories */
+	GHashTable *links_index; /* unowned GDataLink → unowned GList node in @links */
+	GHashTable *links_by_rel; /* owned relation type → owned GQueue of unowned GDataLinks, in the same order as in @links */
+	guint links_serial; /* incremented whenever a link is added, removed or modified; see _gdata_entry_get_links_serial() */
 };
 
 enum {
@@ -117,6 +126,7 @@ gdata_entry_class_init (GDataEntryClass *klass)
 	parsable_class->get_json = get_json;
 
 	klass->get_entry_uri = get_entry_uri;
+	klass->get_parent_ids = get_parent_ids;
 
 	/**
 	 * GDataEntry:title:
@@ -297,7 +307,18 @@ gdata_entry_constructed (GObject *object)
 static void
 gdata_entry_dispose (GObject *object)
 {
-	GDataEntryPrivate *priv = GDATA_ENTRY (object)->priv;
+	GDataEntry *self = GDATA_ENTRY (object);
+	GDataEntryPrivate *priv = self->priv;
+	GList *i;
+
+	for (i = priv->categories; i != NULL; i = i->next)
+		_gdata_category_set_indexed (GDATA_CATEGORY (i->data), self, FALSE);
+	for (i = priv->links; i != NULL; i = i->next)
+		_gdata_link_set_indexed (GDATA_LINK (i->data), self, FALSE);
+
+	g_clear_pointer (&priv->categories_index, g_hash_table_destroy);
+	g_clear_pointer (&priv->links_index, g_hash_table_destroy);
+	g_clear_pointer (&priv->links_by_rel, g_hash_table_destroy);
 
 	g_list_free_full (priv->categories, g_object_unref);
 	priv->categories = NULL;
@@ -407,6 +428,130 @@ gdata_entry_set_property (GObject *object, guint property_id, const GValue *valu
 	}
 }
 
+static guint
+category_hash (GDataCategory *category)
+{
+	const gchar *term = gdata_category_get_term (category);
+
+	/* Categories are compared by term only; see gdata-category.c:compare_with(). */
+	return (term != NULL) ? g_str_hash (term) : 0;
+}
+
+static guint
+link_hash (GDataLink *_link)
+{
+	const gchar *uri = gdata_link_get_uri (_link);
+
+	/* Links are compared by URI and relation type; see gdata-link.c:compare_with(). */
+	return ((uri != NULL) ? g_str_hash (uri) : 0) ^ g_str_hash (gdata_link_get_relation_type (_link));
+}
+
+static gboolean
+comparable_equal (GDataComparable *a, GDataComparable *b)
+{
+	return (gdata_comparable_compare (a, b) == 0) ? TRUE : FALSE;
+}
+
+static void
+reverse_links_queue_cb (gpointer key, GQueue *links, gpointer user_data)
+{
+	g_queue_reverse (links);
+}
+
+static void
+index_link (GDataEntry *self, GList *element, gboolean prepended)
+{
+	GDataEntryPrivate *priv = self->priv;
+	GDataLink *_link = GDATA_LINK (element->data);
+	const gchar *rel;
+	GQueue *links;
+
+	/* The first matching link in the list wins, as with g_list_find_custom() */
+	if (g_hash_table_contains (priv->links_index, _link) == FALSE)
+		g_hash_table_insert (priv->links_index, _link, element);
+
+	/* Relation types come from the server, so are keyed by a copy rather than interned, which would never be freed */
+	rel = gdata_link_get_relation_type (_link);
+	links = g_hash_table_lookup (priv->links_by_rel, rel);
+	if (links == NULL) {
+		links = g_queue_new ();
+		g_hash_table_insert (priv->links_by_rel, g_strdup (rel), links);
+	}
+
+	if (prepended == TRUE)
+		g_queue_push_head (links, _link);
+	else
+		g_queue_push_tail (links, _link);
+
+	_gdata_link_set_indexed (_link, self, TRUE);
+}
+
+/* Creates the (empty) category and link indices, if they don't exist yet. */
+static void
+ensure_indices (GDataEntry *self)
+{
+	GDataEntryPrivate *priv = self->priv;
+
+	if (priv->links_index != NULL)
+		return;
+
+	priv->categories_index = g_hash_table_new ((GHashFunc) category_hash, (GEqualFunc) comparable_equal);
+	priv->links_index = g_hash_table_new ((GHashFunc) link_hash, (GEqualFunc) comparable_equal);
+	priv->links_by_rel = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify) g_queue_free);
+}
+
+/*
+ * _gdata_entry_reindex:
+ * @self: a #GDataEntry
+ *
+ * Rebuilds the category and link indices of @self from its lists. This must be called whenever one of the properties a #GDataCategory or
+ * #GDataLink is indexed by is changed after it has been added to @self.
+ *
+ * Since: 0.19.0
+ */
+void
+_gdata_entry_reindex (GDataEntry *self)
+{
+	GDataEntryPrivate *priv = self->priv;
+	GList *i;
+
+	priv->links_serial++;
+
+	if (priv->links_index == NULL)
+		return;
+
+	g_hash_table_remove_all (priv->categories_index);
+	g_hash_table_remove_all (priv->links_index);
+	g_hash_table_remove_all (priv->links_by_rel);
+
+	for (i = priv->categories; i != NULL; i = i->next) {
+		if (g_hash_table_contains (priv->categories_index, i->data) == FALSE)
+			g_hash_table_insert (priv->categories_index, i->data, i);
+	}
+
+	for (i = priv->links; i != NULL; i = i->next)
+		index_link (self, i, FALSE);
+}
+
+/*
+ * _gdata_entry_get_links_serial:
+ * @self: a #GDataEntry
+ *
+ * Gets a number which changes whenever a link is added to or removed from @self, or one of its links is modified. Subclasses can use this to
+ * tell whether data they've derived from the links is still valid.
+ *
+ * Return value: the current link serial number
+ *
+ * Since: 0.19.0
+ */
+guint
+_gdata_entry_get_links_serial (GDataEntry *self)
+{
+	g_return_val_if_fail (GDATA_IS_ENTRY (self), 0);
+
+	return self->priv->links_serial;
+}
+
 static gboolean
 pre_parse_xml (GDataParsable *parsable, xmlDoc *doc, xmlNode *root_node, gpointer user_data, GError **error)
 {
@@ -474,11 +619,14 @@ post_parse_xml (GDataParsable *parsable, gpointer user_data, GError **error)
 	if (priv->updated.tv_sec == 0 && priv->updated.tv_usec == 0)
 		return gdata_parser_error_required_element_missing ("updated", "entry", error);*/
 
-	/* Reverse our lists of stuff */
+	/* Reverse our lists of stuff. The list nodes are preserved, so only the per-relation-type link queues need to be reversed to match. */
 	priv->categories = g_list_reverse (priv->categories);
 	priv->links = g_list_reverse (priv->links);
 	priv->authors = g_list_reverse (priv->authors);
 
+	if (priv->links_by_rel != NULL)
+		g_hash_table_foreach (priv->links_by_rel, (GHFunc) reverse_links_queue_cb, NULL);
+
 	return TRUE;
 }
 
@@ -580,6 +728,31 @@ get_entry_uri (const gchar *id)
 	return g_strdup (id);
 }
 
+static gchar **
+get_parent_ids (GDataEntry *self)
+{
+	GPtrArray *parent_ids;
+	GList *links, *i;
+
+	/* Parent links point at the parent entry, whose ID we assume is the last component of the URI; subclasses can override this if the
+	 * service they implement builds its URIs differently */
+	parent_ids = g_ptr_array_new ();
+	links = gdata_entry_look_up_links (self, GDATA_LINK_PARENT);
+
+	for (i = links; i != NULL; i = i->next) {
+		const gchar *uri, *parent_id;
+
+		uri = gdata_link_get_uri (GDATA_LINK (i->data));
+		parent_id = strrchr (uri, '/');
+		g_ptr_array_add (parent_ids, g_strdup ((parent_id != NULL) ? parent_id + 1 : uri));
+	}
+
+	g_list_free (links);
+	g_ptr_array_add (parent_ids, NULL);
+
+	return (gchar **) g_ptr_array_free (parent_ids, FALSE);
+}
+
 static gboolean
 parse_json (GDataParsable *parsable, JsonReader *reader, gpointer user_data, GError **error)
 {
@@ -844,6 +1017,55 @@ _gdata_entry_set_etag (GDataEntry *self, const gchar *etag)
 	self->priv->etag = g_strdup (etag);
 }
 
+/*
+ * _gdata_entry_is_deleted:
+ * @self: a #GDataEntry
+ *
+ * Returns whether the server has reported @self as deleted, using #GDataEntryClass.is_deleted. Entries whose class doesn't implement it are never
+ * deleted.
+ *
+ * Return value: %TRUE if @self has been deleted on the server, %FALSE otherwise
+ *
+ * Since: 0.19.0
+ */
+gboolean
+_gdata_entry_is_deleted (GDataEntry *self)
+{
+	GDataEntryClass *klass;
+
+	g_return_val_if_fail (GDATA_IS_ENTRY (self), FALSE);
+
+	klass = GDATA_ENTRY_GET_CLASS (self);
+	if (klass->is_deleted == NULL)
+		return FALSE;
+
+	return klass->is_deleted (self);
+}
+
+/*
+ * _gdata_entry_get_parent_ids:
+ * @self: a #GDataEntry
+ *
+ * Gets the IDs of @self's parent entries, using #GDataEntryClass.get_parent_ids. Entries whose class doesn't implement it have no parents.
+ *
+ * Return value: (transfer full): a %NULL-terminated array of parent IDs; free with g_strfreev()
+ *
+ * Since: 0.19.0
+ */
+gchar **
+_gdata_entry_get_parent_ids (GDataEntry *self)
+{
+	GDataEntryClass *klass;
+
+	g_return_val_if_fail (GDATA_IS_ENTRY (self), NULL);
+
+	klass = GDATA_ENTRY_GET_CLASS (self);
+	if (klass->get_parent_ids == NULL)
+		return g_new0 (gchar*, 1);
+
+	return klass->get_parent_ids (self);
+}
+
 /**
  * gdata_entry_get_updated:
  * @self: a #GDataEntry
@@ -936,13 +1158,18 @@ gdata_entry_get_published (GDataEntry *self)
 void
 gdata_entry_add_category (GDataEntry *self, GDataCategory *category)
 {
+	GDataEntryPrivate *priv;
+	GList *element;
+
 	g_return_if_fail (GDATA_IS_ENTRY (self));
 	g_return_if_fail (GDATA_IS_CATEGORY (category));
 
+	priv = self->priv;
+	ensure_indices (self);
+
 	/* Check to see if it's a kind category and if it matches the entry's predetermined kind */
 	if (g_strcmp0 (gdata_category_get_scheme (category), "http://schemas.google.com/g/2005#kind") == 0) {
 		GDataEntryClass *klass = GDATA_ENTRY_GET_CLASS (self);
-		GList *element;
 
 		if (klass->kind_term != NULL && g_strcmp0 (gdata_category_get_term (category), klass->kind_term) != 0) {
 			/* This used to make sense as a warning, but the new
@@ -959,17 +1186,22 @@ gdata_entry_add_category (GDataEntry *self, GDataCategory *category)
 		 * category.
 		 *
 		 * See: https://bugzilla.gnome.org/show_bug.cgi?id=707477 */
-		element = g_list_find_custom (self->priv->categories, category, (GCompareFunc) gdata_comparable_compare);
+		element = g_hash_table_lookup (priv->categories_index, category);
 		if (element != NULL) {
 			g_assert (GDATA_IS_CATEGORY (element->data));
+			g_hash_table_remove (priv->categories_index, element->data);
+			_gdata_category_set_indexed (GDATA_CATEGORY (element->data), self, FALSE);
 			g_object_unref (element->data);
-			self->priv->categories = g_list_delete_link (self->priv->categories, element);
+			priv->categories = g_list_delete_link (priv->categories, element);
 		}
 	}
 
 	/* Add the category if we don't already have it */
-	if (g_list_find_custom (self->priv->categories, category, (GCompareFunc) gdata_comparable_compare) == NULL)
-		self->priv->categories = g_list_prepend (self->priv->categories, g_object_ref (category));
+	if (g_hash_table_contains (priv->categories_index, category) == FALSE) {
+		priv->categories = g_list_prepend (priv->categories, g_object_ref (category));
+		g_hash_table_insert (priv->categories_index, category, priv->categories);
+		_gdata_category_set_indexed (category, self, TRUE);
+	}
 }
 
 /**
@@ -1102,8 +1334,13 @@ gdata_entry_add_link (GDataEntry *self, GDataLink *_link)
 	g_return_if_fail (GDATA_IS_ENTRY (self));
 	g_return_if_fail (GDATA_IS_LINK (_link));
 
-	if (g_list_find_custom (self->priv->links, _link, (GCompareFunc) gdata_comparable_compare) == NULL)
+	ensure_indices (self);
+
+	if (g_hash_table_contains (self->priv->links_index, _link) == FALSE) {
 		self->priv->links = g_list_prepend (self->priv->links, g_object_ref (_link));
+		index_link (self, self->priv->links, TRUE);
+		self->priv->links_serial++;
+	}
 }
 
 /**
@@ -1121,27 +1358,52 @@ gdata_entry_add_link (GDataEntry *self, GDataLink *_link)
 gboolean
 gdata_entry_remove_link (GDataEntry *self, GDataLink *_link)
 {
+	GDataEntryPrivate *priv;
 	GList *i;
+	const gchar *rel;
+	GQueue *links;
 
 	g_return_val_if_fail (GDATA_IS_ENTRY (self), FALSE);
 	g_return_val_if_fail (GDATA_IS_LINK (_link), FALSE);
 
-	i = g_list_find_custom (self->priv->links, _link, (GCompareFunc) gdata_comparable_compare);
+	priv = self->priv;
+
+	if (priv->links == NULL)
+		return FALSE;
+
+	i = g_hash_table_lookup (priv->links_index, _link);
 
 	if (i == NULL) {
 		return FALSE;
 	}
 
-	self->priv->links = g_list_delete_link (self->priv->links, i);
-	g_object_unref (_link);
+	/* Drop the list element from the indices */
+	rel = gdata_link_get_relation_type (GDATA_LINK (i->data));
+	links = g_hash_table_lookup (priv->links_by_rel, rel);
+	g_assert (links != NULL);
+
+	g_queue_remove (links, i->data);
+	if (g_queue_is_empty (links) == TRUE)
+		g_hash_table_remove (priv->links_by_rel, rel);
+
+	g_hash_table_remove (priv->links_index, i->data);
+
+	_gdata_link_set_indexed (GDATA_LINK (i->data), self, FALSE);
+	g_object_unref (i->data);
+	priv->links = g_list_delete_link (priv->links, i);
+	priv->links_serial++;
 
 	return TRUE;
 }
 
-static gint
-link_compare_cb (const GDataLink *_link, const gchar *rel)
+static GQueue *
+look_up_links_queue (GDataEntry *self, const gchar *rel)
 {
-	return strcmp (gdata_link_get_relation_type ((GDataLink*) _link), rel);
+	/* The indices only exist once a link has been added */
+	if (self->priv->links == NULL)
+		return NULL;
+
+	return g_hash_table_lookup (self->priv->links_by_rel, rel);
 }
 
 /**
@@ -1161,15 +1423,15 @@ link_compare_cb (const GDataLink *_link, const gchar *rel)
 GDataLink *
 gdata_entry_look_up_link (GDataEntry *self, const gchar *rel)
 {
-	GList *element;
+	GQueue *links;
 
 	g_return_val_if_fail (GDATA_IS_ENTRY (self), NULL);
 	g_return_val_if_fail (rel != NULL, NULL);
 
-	element = g_list_find_custom (self->priv->links, rel, (GCompareFunc) link_compare_cb);
-	if (element == NULL)
+	links = look_up_links_queue (self, rel);
+	if (links == NULL)
 		return NULL;
-	return GDATA_LINK (element->data);
+	return GDATA_LINK (g_queue_peek_head (links));
 }
 
 /**
@@ -1190,18 +1452,15 @@ gdata_entry_look_up_link (GDataEntry *self, const gchar *rel)
 GList *
 gdata_entry_look_up_links (GDataEntry *self, const gchar *rel)
 {
-	GList *i, *results = NULL;
+	GQueue *links;
 
 	g_return_val_if_fail (GDATA_IS_ENTRY (self), NULL);
 	g_return_val_if_fail (rel != NULL, NULL);
 
-	for (i = self->priv->links; i != NULL; i = i->next) {
-		const gchar *relation_type = gdata_link_get_relation_type (((GDataLink*) i->data));
-		if (strcmp (relation_type, rel) == 0)
-			results = g_list_prepend (results, i->data);
-	}
-
-	return g_list_reverse (results);
+	links = look_up_links_queue (self, rel);
+	if (links == NULL)
+		return NULL;
+	return g_list_copy (links->head);
 }
 
 /**
@@ -55,6 +55,11 @@ typedef struct {
  * @get_entry_uri: a function to build the entry URI for the entry, given its entry ID; free the URI with g_free()
  * @kind_term: the term for this entry's kind category (see the
  * <ulink type="http" url="http://code.google.com/apis/gdata/docs/2.0/elements.html#Introduction">documentation on kinds</ulink>)
+ * @is_deleted: a function to return whether the entry has been deleted (or trashed, or cancelled) on the server, for services which report
+ * deletions in their feeds; not implementing this function is equivalent to returning %FALSE; new in version 0.19.0
+ * @get_parent_ids: a function to return the IDs of the entry's parent entries (such as the folders containing a file) as a %NULL-terminated
+ * array, freed with g_strfreev(); the default implementation takes the last component of the URI of each of the entry's %GDATA_LINK_PARENT links;
+ * new in version 0.19.0
  *
  * The class structure for the #GDataEntry type.
  */
@@ -63,11 +68,11 @@ typedef struct {
 
 	gchar *(*get_entry_uri) (const gchar *id); /* G_GNUC_WARN_UNUSED_RESULT G_GNUC_MALLOC */
 	const gchar *kind_term;
+	gboolean (*is_deleted) (GDataEntry *self);
+	gchar **(*get_parent_ids) (GDataEntry *self); /* G_GNUC_WARN_UNUSED_RESULT G_GNUC_MALLOC */
 
 	/*< private >*/
 	/* Padding for future expansion */
-	void (*_g_reserved0) (void);
-	void (*_g_reserved1) (void);
 	void (*_g_reserved2) (void);
 	void (*_g_reserved3) (void);
 	void (*_g_reserved4) (void);
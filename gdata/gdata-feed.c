@@ -79,6 +79,8 @@ struct _GDataFeedPrivate {
 	guint total_results;
 	gchar *rights;
 	gchar *next_page_token;
+
+	guint n_prebuilt_entries; /* number of upcoming atom:entry elements which have already been built in parallel */
 };
 
 enum {
@@ -431,6 +433,231 @@ pre_parse_xml (GDataParsable *parsable, xmlDoc *doc, xmlNode *root_node, gpointe
 	return TRUE;
 }
 
+/* Feeds with at least this many entries have their entries built across a pool of worker threads. Below it, the cost of handing the
+ * entries out outweighs the cost of building them. */
+#define PARALLEL_PARSE_MIN_ENTRIES 32
+/* The fewest entries each worker is given to build. */
+#define PARALLEL_PARSE_ENTRIES_PER_WORKER 16
+
+/* State shared between the thread parsing a feed and the workers helping it build the feed's entries. The entry subtrees are independent
+ * of each other once the document has been tokenised, so each one can be built on any thread; the parsing thread hands the built entries
+ * on in document order, so progress callbacks keep their order. */
+typedef struct {
+	gint ref_count; /* atomic */
+
+	GMutex lock;
+	GCond cond;
+
+	GType entry_type;
+	gboolean is_json;
+	gpointer *nodes; /* xmlNode or JsonNode, borrowed from the feed being parsed */
+	guint n_nodes;
+
+	/* The fields below are protected by @lock. */
+	guint next_node; /* index of the next node to build */
+	guint n_building; /* number of entries currently being built */
+	GDataEntry **entries; /* built entries, indexed as @nodes */
+	guint error_index; /* index of the first node (in document order) which failed to build, or @n_nodes */
+	GError *error;
+} ParallelParse;
+
+static ParallelParse *
+parallel_parse_new (GType entry_type, gboolean is_json, GPtrArray *nodes)
+{
+	ParallelParse *parse;
+
+	parse = g_slice_new0 (ParallelParse);
+	parse->ref_count = 1;
+	g_mutex_init (&(parse->lock));
+	g_cond_init (&(parse->cond));
+	parse->entry_type = entry_type;
+	parse->is_json = is_json;
+	parse->n_nodes = nodes->len;
+	parse->nodes = (gpointer*) g_ptr_array_free (nodes, FALSE);
+	parse->entries = g_new0 (GDataEntry*, parse->n_nodes);
+	parse->error_index = parse->n_nodes;
+
+	return parse;
+}
+
+static ParallelParse *
+parallel_parse_ref (ParallelParse *parse)
+{
+	g_atomic_int_inc (&(parse->ref_count));
+	return parse;
+}
+
+static void
+parallel_parse_unref (ParallelParse *parse)
+{
+	guint i;
+
+	if (g_atomic_int_dec_and_test (&(parse->ref_count)) == FALSE)
+		return;
+
+	/* Any entries which were built but not handed on (because an earlier one failed) are dropped */
+	for (i = 0; i < parse->n_nodes; i++) {
+		if (parse->entries[i] != NULL)
+			g_object_unref (parse->entries[i]);
+	}
+
+	g_clear_error (&(parse->error));
+	g_free (parse->entries);
+	g_free (parse->nodes);
+	g_cond_clear (&(parse->cond));
+	g_mutex_clear (&(parse->lock));
+	g_slice_free (ParallelParse, parse);
+}
+
+/* Build the entry for node @i. Must be called without @parse->lock held. */
+static GDataEntry *
+parallel_parse_build_entry (ParallelParse *parse, guint i, GError **error)
+{
+	GDataParsable *parsable;
+
+	if (parse->is_json == TRUE) {
+		JsonReader *reader;
+
+		reader = json_reader_new (parse->nodes[i]);
+		parsable = _gdata_parsable_new_from_json_node (parse->entry_type, reader, NULL, error);
+		g_object_unref (reader);
+	} else {
+		xmlNode *node = parse->nodes[i];
+
+		parsable = _gdata_parsable_new_from_xml_node (parse->entry_type, node->doc, node, NULL, error);
+	}
+
+	return (parsable != NULL) ? GDATA_ENTRY (parsable) : NULL;
+}
+
+/* Claim and build one entry. Must be called with @parse->lock held; it's dropped while the entry is built. Returns %FALSE if there were no
+ * entries left to claim. */
+static gboolean
+parallel_parse_build_next (ParallelParse *parse)
+{
+	GDataEntry *entry;
+	GError *child_error = NULL;
+	guint i;
+
+	if (parse->next_node >= parse->error_index)
+		return FALSE;
+
+	i = parse->next_node++;
+	parse->n_building++;
+	g_mutex_unlock (&(parse->lock));
+
+	entry = parallel_parse_build_entry (parse, i, &child_error);
+
+	g_mutex_lock (&(parse->lock));
+	parse->n_building--;
+
+	if (entry != NULL) {
+		parse->entries[i] = entry;
+	} else if (i < parse->error_index) {
+		/* Report the first failure in document order, as a sequential parse would */
+		g_clear_error (&(parse->error));
+		parse->error = child_error;
+		parse->error_index = i;
+	} else {
+		g_clear_error (&child_error);
+	}
+
+	g_cond_broadcast (&(parse->cond));
+
+	return TRUE;
+}
+
+static void
+parallel_parse_worker_cb (gpointer data, gpointer user_data)
+{
+	ParallelParse *parse = data;
+
+	g_mutex_lock (&(parse->lock));
+	while (parallel_parse_build_next (parse) == TRUE);
+	g_mutex_unlock (&(parse->lock));
+
+	parallel_parse_unref (parse);
+}
+
+static GThreadPool *
+get_parallel_parse_pool (void)
+{
+	static gsize pool = 0;
+
+	if (g_once_init_enter (&pool)) {
+		/* Shared between all feeds, so concurrent queries can't oversubscribe the CPUs. This can't fail for a non-exclusive pool. */
+		GThreadPool *_pool = g_thread_pool_new (parallel_parse_worker_cb, NULL, g_get_num_processors (), FALSE, NULL);
+		g_once_init_leave (&pool, (gsize) _pool);
+	}
+
+	return (GThreadPool*) pool;
+}
+
+static gboolean
+should_parse_in_parallel (guint n_entries)
+{
+	return (n_entries >= PARALLEL_PARSE_MIN_ENTRIES && g_get_num_processors () > 1) ? TRUE : FALSE;
+}
+
+/* Build the entries for all the given @nodes (xmlNodes or JsonNodes, according to @is_json) using the shared worker pool, and add them to the
+ * feed in document order, calling the progress callback for each. The calling thread builds entries too, so this makes progress even if all
+ * the pool's threads are busy. Takes ownership of @nodes. */
+static gboolean
+parse_entries_in_parallel (GDataFeed *self, ParseData *data, GType entry_type, gboolean is_json, GPtrArray *nodes, GError **error)
+{
+	ParallelParse *parse;
+	guint i, n_workers, delivered = 0;
+	gboolean success;
+
+	parse = parallel_parse_new (entry_type, is_json, nodes);
+
+	n_workers = MIN ((guint) g_get_num_processors (), parse->n_nodes / PARALLEL_PARSE_ENTRIES_PER_WORKER) - 1;
+	for (i = 0; i < n_workers; i++) {
+		parallel_parse_ref (parse);
+		if (g_thread_pool_push (get_parallel_parse_pool (), parse, NULL) == FALSE) {
+			parallel_parse_unref (parse);
+			break;
+		}
+	}
+
+	g_mutex_lock (&(parse->lock));
+
+	while (delivered < parse->error_index) {
+		GDataEntry *entry = parse->entries[delivered];
+
+		if (entry != NULL) {
+			/* Hand the next entry on, in document order */
+			parse->entries[delivered++] = NULL;
+			g_mutex_unlock (&(parse->lock));
+
+			/* Calls the callbacks in the main thread */
+			if (data != NULL)
+				_gdata_feed_call_progress_callback (self, data, entry);
+			_gdata_feed_add_entry (self, entry);
+			g_object_unref (entry);
+
+			g_mutex_lock (&(parse->lock));
+		} else if (parallel_parse_build_next (parse) == FALSE) {
+			/* Everything's been claimed; wait for the workers to finish the entry we're waiting on */
+			g_cond_wait (&(parse->cond), &(parse->lock));
+		}
+	}
+
+	/* The nodes belong to the caller, so don't return until no worker is still reading them */
+	while (parse->n_building > 0)
+		g_cond_wait (&(parse->cond), &(parse->lock));
+
+	success = (parse->error == NULL) ? TRUE : FALSE;
+	if (success == FALSE)
+		g_propagate_error (error, g_steal_pointer (&(parse->error)));
+
+	g_mutex_unlock (&(parse->lock));
+
+	parallel_parse_unref (parse);
+
+	return success;
+}
+
 typedef struct {
 	GDataQueryProgressCallback progress_callback;
 	gpointer progress_user_data;
@@ -452,9 +679,37 @@ parse_xml (GDataParsable *parsable, xmlDoc *doc, xmlNode *node, gpointer user_da
 			GDataEntry *entry;
 			GType entry_type;
 
+			/* Skip entries which have already been built along with an earlier one */
+			if (self->priv->n_prebuilt_entries > 0) {
+				self->priv->n_prebuilt_entries--;
+				return TRUE;
+			}
+
 			/* Allow @data to be %NULL, and assume we're parsing a vanilla feed, so that we can test #GDataFeed in tests/general.c.
 			 * A little hacky, but not too much so, and valuable for testing. */
 			entry_type = (data != NULL) ? data->entry_type : GDATA_TYPE_ENTRY;
+
+			/* If this is the first entry, and there are a lot of them, build this one and all the following ones at once */
+			if (self->priv->entries == NULL && g_get_num_processors () > 1) {
+				GPtrArray *nodes;
+				xmlNode *sibling;
+
+				nodes = g_ptr_array_new ();
+				for (sibling = node; sibling != NULL; sibling = sibling->next) {
+					if (sibling->type == XML_ELEMENT_NODE && xmlStrcmp (sibling->name, (xmlChar*) "entry") == 0 &&
+					    gdata_parser_is_namespace (sibling, "http://www.w3.org/2005/Atom") == TRUE) {
+						g_ptr_array_add (nodes, sibling);
+					}
+				}
+
+				if (should_parse_in_parallel (nodes->len) == TRUE) {
+					self->priv->n_prebuilt_entries = nodes->len - 1;
+					return parse_entries_in_parallel (self, data, entry_type, FALSE, nodes, error);
+				}
+
+				g_ptr_array_free (nodes, TRUE);
+			}
+
 			entry = GDATA_ENTRY (_gdata_parsable_new_from_xml_node (entry_type, doc, node, NULL, error));
 			if (entry == NULL)
 				return FALSE;
@@ -608,8 +863,26 @@ parse_json (GDataParsable *parsable, JsonReader *reader, gpointer user_data, GEr
 	if (g_strcmp0 (json_reader_get_member_name (reader), "items") == 0) {
 		gint i, elements;
 
+		elements = json_reader_count_elements (reader);
+
+#if JSON_CHECK_VERSION (1, 8, 0)
+		/* Build large pages of entries across the worker pool */
+		if (elements > 0 && should_parse_in_parallel ((guint) elements) == TRUE) {
+			GPtrArray *nodes;
+
+			nodes = g_ptr_array_sized_new ((guint) elements);
+			for (i = 0; i < elements; i++) {
+				json_reader_read_element (reader, i);
+				g_ptr_array_add (nodes, json_reader_get_current_node (reader));
+				json_reader_end_element (reader);
+			}
+
+			return parse_entries_in_parallel (self, data, (data != NULL) ? data->entry_type : GDATA_TYPE_ENTRY, TRUE, nodes, error);
+		}
+#endif /* JSON_CHECK_VERSION (1, 8, 0) */
+
 		/* Loop through the elements array. */
-		for (i = 0, elements = json_reader_count_elements (reader); i < elements; i++) {
+		for (i = 0; i < elements; i++) {
 			GDataEntry *entry;
 			GType entry_type;
 
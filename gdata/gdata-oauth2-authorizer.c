@@ -147,6 +147,7 @@
 #include "gdata-private.h"
 
 static void authorizer_init (GDataAuthorizerInterface *iface);
+static void constructed (GObject *object);
 static void dispose (GObject *object);
 static void finalize (GObject *object);
 static void get_property (GObject *object, guint property_id, GValue *value,
@@ -179,8 +180,10 @@ static void notify_timeout_cb (GObject *gobject, GParamSpec *pspec,
                                GObject *self);
 
 struct _GDataOAuth2AuthorizerPrivate {
-	SoupSession *session;  /* owned */
+	SoupSession *session;  /* owned; possibly shared with services */
+	GBinding *proxy_resolver_binding;  /* owned by session and self */
 	GProxyResolver *proxy_resolver;  /* owned */
+	guint timeout;  /* only used until the session is set up */
 
 	gchar *client_id;  /* owned */
 	gchar *redirect_uri;  /* owned */
@@ -209,6 +212,7 @@ enum {
 	PROP_TIMEOUT,
 	PROP_PROXY_RESOLVER,
 	PROP_REFRESH_TOKEN,
+	PROP_SESSION,
 };
 
 G_DEFINE_TYPE_WITH_CODE (GDataOAuth2Authorizer, gdata_oauth2_authorizer,
@@ -224,6 +228,7 @@ gdata_oauth2_authorizer_class_init (GDataOAuth2AuthorizerClass *klass)
 
 	gobject_class->get_property = get_property;
 	gobject_class->set_property = set_property;
+	gobject_class->constructed = constructed;
 	gobject_class->dispose = dispose;
 	gobject_class->finalize = finalize;
 
@@ -382,6 +387,28 @@ gdata_oauth2_authorizer_class_init (GDataOAuth2AuthorizerClass *klass)
 	                                                      "The server provided refresh token.",
 	                                                      NULL,
 	                                                      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+	/**
+	 * GDataOAuth2Authorizer:session:
+	 *
+	 * The #SoupSession used for requesting and refreshing access tokens.
+	 * If this is %NULL at construction time, the authorizer creates a
+	 * session of its own.
+	 *
+	 * Passing the same session to the #GDataService:session of the
+	 * services using this authorizer lets token refreshes reuse the
+	 * services’ open connections, rather than each refresh making a new
+	 * connection to the authorization server. Everything sharing a session
+	 * shares its timeout and proxy resolver.
+	 *
+	 * Since: 0.19.0
+	 */
+	g_object_class_install_property (gobject_class, PROP_SESSION,
+	                                 g_param_spec_object ("session",
+	                                                      "Session",
+	                                                      "The SoupSession used for network requests.",
+	                                                      SOUP_TYPE_SESSION,
+	                                                      G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS));
 }
 
 static void
@@ -409,18 +436,46 @@ gdata_oauth2_authorizer_init (GDataOAuth2Authorizer *self)
 	                                                            g_direct_equal,
 	                                                            g_object_unref,
 	                                                            NULL);
+}
 
-	/* Set up the session */
-	self->priv->session = _gdata_service_build_session ();
+static void
+constructed (GObject *object)
+{
+	GDataOAuth2AuthorizerPrivate *priv;
+
+	priv = GDATA_OAUTH2_AUTHORIZER (object)->priv;
+
+	/* Chain up to the parent class */
+	G_OBJECT_CLASS (gdata_oauth2_authorizer_parent_class)->constructed (object);
+
+	/* Set up the session, unless we were given one to share. */
+	if (priv->session == NULL)
+		priv->session = _gdata_service_build_session ();
+
+	/* Apply any timeout or proxy resolver set before the session existed,
+	 * so they aren’t overwritten by the session’s own. */
+	if (priv->timeout != 0) {
+		g_object_set (priv->session,
+		              SOUP_SESSION_TIMEOUT, priv->timeout,
+		              NULL);
+	}
+
+	if (priv->proxy_resolver != NULL) {
+		g_object_set (priv->session,
+		              SOUP_SESSION_PROXY_RESOLVER, priv->proxy_resolver,
+		              NULL);
+	}
 
 	/* Proxy the SoupSession’s timeout property. */
-	g_signal_connect (self->priv->session, "notify::timeout",
-	                  (GCallback) notify_timeout_cb, self);
+	g_signal_connect (priv->session, "notify::timeout",
+	                  (GCallback) notify_timeout_cb, object);
 
 	/* Keep our GProxyResolver synchronized with SoupSession’s. */
-	g_object_bind_property (self->priv->session, "proxy-resolver",
-	                        self, "proxy-resolver",
-	                        G_BINDING_BIDIRECTIONAL | G_BINDING_SYNC_CREATE);
+	priv->proxy_resolver_binding =
+		g_object_bind_property (priv->session, "proxy-resolver",
+		                        object, "proxy-resolver",
+		                        G_BINDING_BIDIRECTIONAL |
+		                        G_BINDING_SYNC_CREATE);
 }
 
 static void
@@ -430,6 +485,15 @@ dispose (GObject *object)
 
 	priv = GDATA_OAUTH2_AUTHORIZER (object)->priv;
 
+	/* The session may be shared, so could outlive us. */
+	if (priv->session != NULL) {
+		g_signal_handlers_disconnect_by_func (priv->session,
+		                                      notify_timeout_cb,
+		                                      object);
+		g_binding_unbind (priv->proxy_resolver_binding);
+		priv->proxy_resolver_binding = NULL;
+	}
+
 	g_clear_object (&priv->session);
 	g_clear_object (&priv->proxy_resolver);
 
@@ -495,6 +559,9 @@ get_property (GObject *object, guint property_id, GValue *value,
 		g_value_set_string (value, priv->refresh_token);
 		g_mutex_unlock (&priv->mutex);
 		break;
+	case PROP_SESSION:
+		g_value_set_object (value, priv->session);
+		break;
 	default:
 		/* We don't have any other property... */
 		G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
@@ -540,6 +607,10 @@ set_property (GObject *object, guint property_id, const GValue *value, GParamSpe
 		gdata_oauth2_authorizer_set_refresh_token (self,
 		                                           g_value_get_string (value));
 		break;
+	/* Construct only. */
+	case PROP_SESSION:
+		priv->session = g_value_dup_object (value);
+		break;
 	default:
 		/* We don't have any other property... */
 		G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
@@ -1510,6 +1581,12 @@ gdata_oauth2_authorizer_get_timeout (GDataOAuth2Authorizer *self)
 
 	g_return_val_if_fail (GDATA_IS_OAUTH2_AUTHORIZER (self), 0);
 
+	/* The session doesn’t exist yet if this is called during
+	 * construction. */
+	if (self->priv->session == NULL) {
+		return self->priv->timeout;
+	}
+
 	g_object_get (self->priv->session,
 	              SOUP_SESSION_TIMEOUT, &timeout,
 	              NULL);
@@ -1539,6 +1616,14 @@ gdata_oauth2_authorizer_set_timeout (GDataOAuth2Authorizer *self, guint timeout)
 		return;
 	}
 
+	/* If this is called during construction, the timeout is applied to
+	 * the session once it’s set up in constructed(). */
+	if (self->priv->session == NULL) {
+		self->priv->timeout = timeout;
+		g_object_notify (G_OBJECT (self), "timeout");
+		return;
+	}
+
 	g_object_set (self->priv->session, SOUP_SESSION_TIMEOUT, timeout, NULL);
 }
 
@@ -56,9 +56,12 @@ static gboolean real_parse_json (GDataParsable *parsable, JsonReader *reader, gp
 static const gchar *get_content_type (void);
 
 struct _GDataParsablePrivate {
-	/* XML stuff. */
+	/* XML stuff. Unhandled elements are serialised into @extra_xml as they're parsed, so the parsable never refers to the parsed document
+	 * and is left unchanged by building its XML. @extra_namespaces maps prefixes to hrefs; it's shared with the other parsables from the
+	 * same document while @extra_namespaces_shared is %TRUE, and must be copied before it's modified. */
 	GString *extra_xml;
 	GHashTable *extra_namespaces;
+	gboolean extra_namespaces_shared;
 
 	/* JSON stuff. */
 	GHashTable/*<gchar*, owned JsonNode*>*/ *extra_json;
@@ -104,11 +107,8 @@ gdata_parsable_init (GDataParsable *self)
 {
 	self->priv = gdata_parsable_get_instance_private (self);
 
-	self->priv->extra_xml = g_string_new ("");
-	self->priv->extra_namespaces = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
-
-	self->priv->extra_json = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify) json_node_free);
-
+	/* extra_xml, extra_namespaces and extra_json are only allocated when unhandled XML or JSON is first encountered, since they stay
+	 * empty for the vast majority of parsables. */
 	self->priv->constructed_from_xml = FALSE;
 }
 
@@ -150,47 +150,145 @@ gdata_parsable_finalize (GObject *object)
 {
 	GDataParsablePrivate *priv = GDATA_PARSABLE (object)->priv;
 
-	g_string_free (priv->extra_xml, TRUE);
-	g_hash_table_destroy (priv->extra_namespaces);
-
-	g_hash_table_destroy (priv->extra_json);
+	if (priv->extra_xml != NULL)
+		g_string_free (priv->extra_xml, TRUE);
+	g_clear_pointer (&priv->extra_namespaces, g_hash_table_unref);
+	g_clear_pointer (&priv->extra_json, g_hash_table_destroy);
 
 	/* Chain up to the parent class */
 	G_OBJECT_CLASS (gdata_parsable_parent_class)->finalize (object);
 }
 
-static gboolean
-real_parse_xml (GDataParsable *parsable, xmlDoc *doc, xmlNode *node, gpointer user_data, GError **error)
+/* State kept in the _private field of the documents parsed by _gdata_parsable_new_from_xml(), for as long as their parsables are being built. The
+ * entries of large feeds are built on several threads, so it's protected by @mutex. */
+typedef struct {
+	GMutex mutex;
+	GHashTable *namespaces_by_parent; /* unowned xmlNode → owned GHashTable of the prefixes → hrefs in scope for its children */
+} DocumentData;
+
+/* Build a table of the prefixed namespaces in scope for @node */
+static GHashTable *
+build_namespaces_table (xmlDoc *doc, xmlNode *node)
 {
-	xmlBuffer *buffer;
+	GHashTable *table;
 	xmlNs **namespaces, **namespace;
 
-	/* Unhandled XML */
-	buffer = xmlBufferCreate ();
-	xmlNodeDump (buffer, doc, node, 0, 0);
-	g_string_append (parsable->priv->extra_xml, (gchar*) xmlBufferContent (buffer));
-	g_debug ("Unhandled XML in %s: %s", G_OBJECT_TYPE_NAME (parsable), (gchar*) xmlBufferContent (buffer));
-	xmlBufferFree (buffer);
+	table = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
 
-	/* Get the namespaces */
 	namespaces = xmlGetNsList (doc, node);
 	if (namespaces == NULL)
-		return TRUE;
+		return table;
 
 	for (namespace = namespaces; *namespace != NULL; namespace++) {
-		if ((*namespace)->prefix != NULL) {
-			/* NOTE: These two g_strdup()s leak, but it's probably acceptable, given that it saves us
-			 * g_strdup()ing every other namespace we put in @extra_namespaces. */
-			g_hash_table_insert (parsable->priv->extra_namespaces,
-			                     g_strdup ((gchar*) ((*namespace)->prefix)),
-			                     g_strdup ((gchar*) ((*namespace)->href)));
-		}
+		/* xmlGetNsList() lists the innermost declaration of each prefix first, and that's the one in scope */
+		if ((*namespace)->prefix != NULL && g_hash_table_contains (table, (*namespace)->prefix) == FALSE)
+			g_hash_table_insert (table, g_strdup ((gchar*) ((*namespace)->prefix)), g_strdup ((gchar*) ((*namespace)->href)));
 	}
 	xmlFree (namespaces);
 
+	return table;
+}
+
+/* Returns a new reference to the table of namespaces in scope for @node's parent; any declared on @node itself are output along with it. Unhandled
+ * elements are almost always siblings, so the table is looked up once for each parent element in the document, and shared between all the
+ * parsables built from it. */
+static GHashTable *
+get_namespaces_table (xmlDoc *doc, xmlNode *node)
+{
+	DocumentData *data = doc->_private;
+	GHashTable *table;
+
+	if (node->parent == NULL || node->parent->type != XML_ELEMENT_NODE)
+		return build_namespaces_table (doc, node);
+
+	/* Documents which weren't parsed by _gdata_parsable_new_from_xml() have nowhere to cache the tables */
+	if (data == NULL)
+		return build_namespaces_table (doc, node->parent);
+
+	g_mutex_lock (&data->mutex);
+
+	table = g_hash_table_lookup (data->namespaces_by_parent, node->parent);
+	if (table == NULL) {
+		table = build_namespaces_table (doc, node->parent);
+		g_hash_table_insert (data->namespaces_by_parent, node->parent, table);
+	}
+
+	g_hash_table_ref (table);
+
+	g_mutex_unlock (&data->mutex);
+
+	return table;
+}
+
+static void
+copy_namespace_cb (const gchar *prefix, const gchar *href, GHashTable *table)
+{
+	g_hash_table_replace (table, g_strdup (prefix), g_strdup (href));
+}
+
+static void
+add_extra_namespaces (GDataParsable *parsable, GHashTable *table)
+{
+	GDataParsablePrivate *priv = parsable->priv;
+	GHashTable *unshared;
+
+	/* The first set of namespaces, or the same set again, can just be shared */
+	if (priv->extra_namespaces == NULL) {
+		priv->extra_namespaces = g_hash_table_ref (table);
+		priv->extra_namespaces_shared = TRUE;
+		return;
+	} else if (priv->extra_namespaces == table) {
+		return;
+	}
+
+	/* Otherwise the parsable needs its own copy to merge them into */
+	if (priv->extra_namespaces_shared == TRUE) {
+		unshared = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
+		g_hash_table_foreach (priv->extra_namespaces, (GHFunc) copy_namespace_cb, unshared);
+		g_hash_table_unref (priv->extra_namespaces);
+		priv->extra_namespaces = unshared;
+		priv->extra_namespaces_shared = FALSE;
+	}
+
+	g_hash_table_foreach (table, (GHFunc) copy_namespace_cb, priv->extra_namespaces);
+}
+
+static gboolean
+real_parse_xml (GDataParsable *parsable, xmlDoc *doc, xmlNode *node, gpointer user_data, GError **error)
+{
+	static GPrivate scratch_buffer = G_PRIVATE_INIT ((GDestroyNotify) xmlBufferFree);
+	xmlBuffer *buffer;
+	GHashTable *namespaces;
+
+	/* Unhandled XML. It's copied out now, rather than when the parsable's XML is built, so that the parsable doesn't keep the document alive;
+	 * but each thread reuses one buffer to do so. */
+	buffer = g_private_get (&scratch_buffer);
+	if (buffer == NULL) {
+		buffer = xmlBufferCreate ();
+		g_private_set (&scratch_buffer, buffer);
+	} else {
+		xmlBufferEmpty (buffer);
+	}
+
+	xmlNodeDump (buffer, doc, node, 0, 0);
+	if (parsable->priv->extra_xml == NULL)
+		parsable->priv->extra_xml = g_string_new (NULL);
+	g_string_append_len (parsable->priv->extra_xml, (gchar*) xmlBufferContent (buffer), xmlBufferLength (buffer));
+
+	/* Only log it if anybody's going to see it */
+	if (_gdata_service_get_log_level () != GDATA_LOG_NONE)
+		g_debug ("Unhandled XML in %s: %s", G_OBJECT_TYPE_NAME (parsable), (gchar*) xmlBufferContent (buffer));
+
+	/* Get the namespaces */
+	namespaces = get_namespaces_table (doc, node);
+	if (g_hash_table_size (namespaces) > 0)
+		add_extra_namespaces (parsable, namespaces);
+	g_hash_table_unref (namespaces);
+
 	return TRUE;
 }
 
+#if !JSON_CHECK_VERSION (1, 8, 0)
 /* Extract the member node. This would be a lot easier if JsonReader had an API to return
  * the current node (regardless of whether it's a value, object or array). FIXME: bgo#707100. */
 static JsonNode * /* transfer full */
@@ -245,35 +343,47 @@ _json_reader_dup_current_node (JsonReader *reader)
 
 	return value;
 }
+#endif /* !JSON_CHECK_VERSION (1, 8, 0) */
 
 static gboolean
 real_parse_json (GDataParsable *parsable, JsonReader *reader, gpointer user_data, GError **error)
 {
-	gchar *json, *member_name;
-	JsonGenerator *generator;
+	const gchar *member_name;
 	JsonNode *value;
 
-	/* Unhandled JSON member. Save it and its value to ->extra_xml so that it's not lost if we
+	/* Unhandled JSON member. Save it and its value to ->extra_json so that it's not lost if we
 	 * re-upload this Parsable to the server. */
-	member_name = g_strdup (json_reader_get_member_name (reader));
+	member_name = json_reader_get_member_name (reader);
 	g_assert (member_name != NULL);
 
-	/* Extract a copy of the current node. */
+	/* Extract a copy of the current node. Where possible, this is a shallow copy which shares the member's object or array with the
+	 * parsed document, rather than recursively duplicating the whole subtree. */
+#if JSON_CHECK_VERSION (1, 8, 0)
+	value = json_node_copy (json_reader_get_current_node (reader));
+#else
 	value = _json_reader_dup_current_node (reader);
+#endif
 	g_assert (value != NULL);
 
-	/* Serialise the value for debugging. */
-	generator = json_generator_new ();
-	json_generator_set_root (generator, value);
+	/* Serialise the value for debugging, but only if anybody's going to see it. */
+	if (_gdata_service_get_log_level () != GDATA_LOG_NONE) {
+		JsonGenerator *generator;
+		gchar *json;
 
-	json = json_generator_to_data (generator, NULL);
-	g_debug ("Unhandled JSON member ‘%s’ in %s: %s", member_name, G_OBJECT_TYPE_NAME (parsable), json);
-	g_free (json);
+		generator = json_generator_new ();
+		json_generator_set_root (generator, value);
 
-	g_object_unref (generator);
+		json = json_generator_to_data (generator, NULL);
+		g_debug ("Unhandled JSON member ‘%s’ in %s: %s", member_name, G_OBJECT_TYPE_NAME (parsable), json);
+		g_free (json);
+
+		g_object_unref (generator);
+	}
 
-	/* Save the value. Transfer ownership of the member_name and value. */
-	g_hash_table_replace (parsable->priv->extra_json, (gpointer) member_name, (gpointer) value);
+	/* Save the value. Transfer ownership of the value. */
+	if (parsable->priv->extra_json == NULL)
+		parsable->priv->extra_json = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify) json_node_free);
+	g_hash_table_replace (parsable->priv->extra_json, g_strdup (member_name), (gpointer) value);
 
 	return TRUE;
 }
@@ -322,6 +432,7 @@ _gdata_parsable_new_from_xml (GType parsable_type, const gchar *xml, gint length
 	xmlDoc *doc;
 	xmlNode *node;
 	GDataParsable *parsable;
+	DocumentData document_data;
 	static gboolean libxml_initialised = FALSE;
 
 	g_return_val_if_fail (g_type_is_a (parsable_type, GDATA_TYPE_PARSABLE), NULL);
@@ -341,8 +452,10 @@ _gdata_parsable_new_from_xml (GType parsable_type, const gchar *xml, gint length
 	if (length == -1)
 		length = strlen (xml);
 
-	/* Parse the XML */
-	doc = xmlReadMemory (xml, length, "/dev/null", NULL, 0);
+	/* Parse the XML. The whole tree is freed in one go once the parsable has been built, and is never modified (unhandled elements are
+	 * copied out of it as they're parsed), so we can let libxml store short text content inline in its nodes (XML_PARSE_COMPACT) rather
+	 * than allocating it separately. This saves one allocation for almost every element in a typical feed. */
+	doc = xmlReadMemory (xml, length, "/dev/null", NULL, XML_PARSE_COMPACT);
 	if (doc == NULL) {
 		xmlError *xml_error = xmlGetLastError ();
 		g_set_error (error, GDATA_PARSER_ERROR, GDATA_PARSER_ERROR_PARSING_STRING,
@@ -364,9 +477,19 @@ _gdata_parsable_new_from_xml (GType parsable_type, const gchar *xml, gint length
 		return NULL;
 	}
 
+	/* Cache the namespaces of unhandled elements for the lifetime of the document; see get_namespaces_table() */
+	g_mutex_init (&document_data.mutex);
+	document_data.namespaces_by_parent = g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL, (GDestroyNotify) g_hash_table_unref);
+	doc->_private = &document_data;
+
 	parsable = _gdata_parsable_new_from_xml_node (parsable_type, doc, node, user_data, error);
+
+	doc->_private = NULL;
 	xmlFreeDoc (doc);
 
+	g_hash_table_unref (document_data.namespaces_by_parent);
+	g_mutex_clear (&document_data.mutex);
+
 	return parsable;
 }
 
@@ -571,15 +694,52 @@ gdata_parsable_get_content_type (GDataParsable *self)
 static void
 build_namespaces_cb (gchar *prefix, gchar *href, GString *output)
 {
-	g_string_append_printf (output, " xmlns:%s='%s'", prefix, href);
+	g_string_append (output, " xmlns:");
+	g_string_append (output, prefix);
+	g_string_append (output, "='");
+	g_string_append (output, href);
+	g_string_append_c (output, '\'');
 }
 
-static gboolean
-filter_namespaces_cb (gchar *prefix, gchar *href, GHashTable *canonical_namespaces)
+typedef struct {
+	GString *output;
+	GHashTable *canonical_namespaces;
+} BuildExtraNamespacesData;
+
+static void
+build_extra_namespaces_cb (gchar *prefix, gchar *href, BuildExtraNamespacesData *data)
 {
-	if (g_hash_table_lookup (canonical_namespaces, prefix) != NULL)
-		return TRUE;
-	return FALSE;
+	/* Skip any extra namespaces which duplicate those the class has already declared */
+	if (data->canonical_namespaces != NULL && g_hash_table_contains (data->canonical_namespaces, prefix) == TRUE)
+		return;
+
+	build_namespaces_cb (prefix, href, data->output);
+}
+
+/* Append the opening or closing tag name for @klass to @xml_string, without using printf() */
+static void
+append_element_name (GString *xml_string, GDataParsableClass *klass)
+{
+	if (klass->element_namespace != NULL) {
+		g_string_append (xml_string, klass->element_namespace);
+		g_string_append_c (xml_string, ':');
+	}
+	g_string_append (xml_string, klass->element_name);
+}
+
+static GString *build_xml_string (GDataParsable *self);
+static JsonGenerator *build_json_generator (GDataParsable *self);
+
+/* A running average of the lengths of the XML documents built by gdata_parsable_get_xml() for each type, kept in the type's qdata and used to
+ * pre-size the string for the next one. It's per type so that large feeds don't make small entries over-allocate, and it decays, and is capped,
+ * so that one unusually large document (such as a big batch feed) doesn't cause every later one of its type to over-allocate. It's only a hint,
+ * so concurrent updates may overwrite each other. */
+#define XML_SIZE_HINT_MAX (1024 * 1024)
+
+static GQuark
+xml_size_hint_quark (void)
+{
+	return g_quark_from_static_string ("gdata-parsable-xml-size-hint");
 }
 
 /**
@@ -595,15 +755,32 @@ filter_namespaces_cb (gchar *prefix, gchar *href, GHashTable *canonical_namespac
  */
 gchar *
 gdata_parsable_get_xml (GDataParsable *self)
+{
+	g_return_val_if_fail (GDATA_IS_PARSABLE (self), NULL);
+
+	return g_string_free (build_xml_string (self), FALSE);
+}
+
+/* Build the stand-alone XML document for @self */
+static GString *
+build_xml_string (GDataParsable *self)
 {
 	GString *xml_string;
+	guint size_hint;
 
-	g_return_val_if_fail (GDATA_IS_PARSABLE (self), NULL);
+	/* Pre-size the string using the average length of recently built XML of the same type, to avoid repeatedly reallocating it while building
+	 * large documents such as batch feeds. */
+	size_hint = GPOINTER_TO_UINT (g_type_get_qdata (G_OBJECT_TYPE (self), xml_size_hint_quark ()));
 
-	xml_string = g_string_sized_new (1000);
+	xml_string = g_string_sized_new (MAX (size_hint + size_hint / 8, 1000));
 	g_string_append (xml_string, "<?xml version='1.0' encoding='UTF-8'?>");
 	_gdata_parsable_get_xml (self, xml_string, TRUE);
-	return g_string_free (xml_string, FALSE);
+
+	/* Move the hint a quarter of the way towards this document's length */
+	size_hint = (3 * size_hint + (guint) MIN (xml_string->len, XML_SIZE_HINT_MAX)) / 4;
+	g_type_set_qdata (G_OBJECT_TYPE (self), xml_size_hint_quark (), GUINT_TO_POINTER (size_hint));
+
+	return xml_string;
 }
 
 /*
@@ -638,27 +815,27 @@ _gdata_parsable_get_xml (GDataParsable *self, GString *xml_string, gboolean decl
 	if (declare_namespaces == TRUE && klass->get_namespaces != NULL) {
 		namespaces = g_hash_table_new (g_str_hash, g_str_equal);
 		klass->get_namespaces (self, namespaces);
-
-		/* Remove any duplicate extra namespaces */
-		g_hash_table_foreach_remove (self->priv->extra_namespaces, (GHRFunc) filter_namespaces_cb, namespaces);
 	}
 
 	/* Build up the namespace list */
-	if (klass->element_namespace != NULL)
-		g_string_append_printf (xml_string, "<%s:%s", klass->element_namespace, klass->element_name);
-	else
-		g_string_append_printf (xml_string, "<%s", klass->element_name);
+	g_string_append_c (xml_string, '<');
+	append_element_name (xml_string, klass);
 
 	/* We only include the normal namespaces if we're not at the top level of XML building */
 	if (declare_namespaces == TRUE) {
 		g_string_append (xml_string, " xmlns='http://www.w3.org/2005/Atom'");
-		if (namespaces != NULL) {
+		if (namespaces != NULL)
 			g_hash_table_foreach (namespaces, (GHFunc) build_namespaces_cb, xml_string);
-			g_hash_table_destroy (namespaces);
-		}
 	}
 
-	g_hash_table_foreach (self->priv->extra_namespaces, (GHFunc) build_namespaces_cb, xml_string);
+	/* Add the extra namespaces, skipping any which duplicate the class' own */
+	if (self->priv->extra_namespaces != NULL) {
+		BuildExtraNamespacesData data = { xml_string, namespaces };
+		g_hash_table_foreach (self->priv->extra_namespaces, (GHFunc) build_extra_namespaces_cb, &data);
+	}
+
+	if (namespaces != NULL)
+		g_hash_table_destroy (namespaces);
 
 	/* Add anything the class thinks is suitable */
 	if (klass->pre_get_xml != NULL)
@@ -673,16 +850,17 @@ _gdata_parsable_get_xml (GDataParsable *self, GString *xml_string, gboolean decl
 		klass->get_xml (self, xml_string);
 
 	/* Any extra XML? */
-	if (self->priv->extra_xml != NULL && self->priv->extra_xml->str != NULL)
-		g_string_append (xml_string, self->priv->extra_xml->str);
+	if (self->priv->extra_xml != NULL)
+		g_string_append_len (xml_string, self->priv->extra_xml->str, self->priv->extra_xml->len);
 
 	/* Close the element; either by self-closing the opening tag, or by writing out a closing tag */
-	if (xml_string->len == length)
+	if (xml_string->len == length) {
 		g_string_overwrite (xml_string, length - 1, "/>");
-	else if (klass->element_namespace != NULL)
-		g_string_append_printf (xml_string, "</%s:%s>", klass->element_namespace, klass->element_name);
-	else
-		g_string_append_printf (xml_string, "</%s>", klass->element_name);
+	} else {
+		g_string_append (xml_string, "</");
+		append_element_name (xml_string, klass);
+		g_string_append_c (xml_string, '>');
+	}
 }
 
 /**
@@ -700,26 +878,78 @@ gchar *
 gdata_parsable_get_json (GDataParsable *self)
 {
 	JsonGenerator *generator;
-	JsonBuilder *builder;
-	JsonNode *root;
 	gchar *output;
 
 	g_return_val_if_fail (GDATA_IS_PARSABLE (self), NULL);
 
+	/* Serialise the JSON tree to a string. */
+	generator = build_json_generator (self);
+	output = json_generator_to_data (generator, NULL);
+	g_object_unref (generator);
+
+	return output;
+}
+
+/* Build a #JsonGenerator with the JSON tree for @self as its root */
+static JsonGenerator *
+build_json_generator (GDataParsable *self)
+{
+	JsonGenerator *generator;
+	JsonBuilder *builder;
+	JsonNode *root;
+
 	/* Build the JSON tree. */
 	builder = json_builder_new ();
 	_gdata_parsable_get_json (self, builder);
 	root = json_builder_get_root (builder);
 	g_object_unref (builder);
 
-	/* Serialise it to a string. */
 	generator = json_generator_new ();
 	json_generator_set_root (generator, root);
-	output = json_generator_to_data (generator, NULL);
-	g_object_unref (generator);
-
 	json_node_free (root);
 
+	return generator;
+}
+
+/*
+ * _gdata_parsable_serialise:
+ * @self: a #GDataParsable
+ * @length: (out): return location for the length of the returned data, in bytes
+ *
+ * Builds a representation of the #GDataParsable in the format given by gdata_parsable_get_content_type(), for uploading to the server.
+ * This is equivalent to calling gdata_parsable_get_json() or gdata_parsable_get_xml() as appropriate, but also returns the data's length
+ * so that it doesn't have to be recalculated.
+ *
+ * Return value: (transfer full): the object's JSON or XML; free with g_free()
+ *
+ * Since: 0.19.0
+ */
+gchar *
+_gdata_parsable_serialise (GDataParsable *self, gsize *length)
+{
+	GDataParsableClass *klass;
+	gchar *output;
+
+	g_return_val_if_fail (GDATA_IS_PARSABLE (self), NULL);
+	g_return_val_if_fail (length != NULL, NULL);
+
+	klass = GDATA_PARSABLE_GET_CLASS (self);
+	g_assert (klass->get_content_type != NULL);
+
+	if (g_strcmp0 (klass->get_content_type (), "application/json") == 0) {
+		JsonGenerator *generator;
+
+		generator = build_json_generator (self);
+		output = json_generator_to_data (generator, length);
+		g_object_unref (generator);
+	} else {
+		GString *xml_string;
+
+		xml_string = build_xml_string (self);
+		*length = xml_string->len;
+		output = g_string_free (xml_string, FALSE);
+	}
+
 	return output;
 }
 
@@ -752,10 +982,12 @@ _gdata_parsable_get_json (GDataParsable *self, JsonBuilder *builder)
 		klass->get_json (self, builder);
 
 	/* Any extra JSON which we couldn't parse before? */
-	g_hash_table_iter_init (&iter, self->priv->extra_json);
-	while (g_hash_table_iter_next (&iter, (gpointer *) &member_name, (gpointer *) &value) == TRUE) {
-		json_builder_set_member_name (builder, member_name);
-		json_builder_add_value (builder, json_node_copy (value)); /* transfers ownership */
+	if (self->priv->extra_json != NULL) {
+		g_hash_table_iter_init (&iter, self->priv->extra_json);
+		while (g_hash_table_iter_next (&iter, (gpointer *) &member_name, (gpointer *) &value) == TRUE) {
+			json_builder_set_member_name (builder, member_name);
+			json_builder_add_value (builder, json_node_copy (value)); /* transfers ownership */
+		}
 	}
 
 	json_builder_end_object (builder);
@@ -22,6 +22,7 @@
 
 #include <glib.h>
 #include <glib-object.h>
+#include <gio/gio.h>
 #include <libxml/parser.h>
 #include <json-glib/json-glib.h>
 
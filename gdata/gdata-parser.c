@@ -203,12 +203,201 @@ gdata_parser_error_duplicate_element (xmlNode *element, GError **error)
 	return FALSE;
 }
 
+/* Days in each month of a non-leap year, indexed from 1 */
+static const guint8 days_in_month[] = { 0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+
+static inline gboolean
+is_leap_year (gint year)
+{
+	return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+/* Convert a proleptic Gregorian date to a count of days since 1970-01-01, and back again. These are the civil calendar algorithms from
+ * http://howardhinnant.github.io/date_algorithms.html, and are valid for all dates representable by GDateTime. */
+static gint64
+days_from_civil (gint64 year, guint month, guint day)
+{
+	gint64 era, year_of_era, day_of_year, day_of_era;
+
+	year -= (month <= 2) ? 1 : 0;
+	era = ((year >= 0) ? year : year - 399) / 400;
+	year_of_era = year - era * 400;
+	day_of_year = (153 * (month + ((month > 2) ? -3 : 9)) + 2) / 5 + day - 1;
+	day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+
+	return era * 146097 + day_of_era - 719468;
+}
+
+static void
+civil_from_days (gint64 days, gint64 *year, guint *month, guint *day)
+{
+	gint64 era, day_of_era, year_of_era, day_of_year, mp;
+
+	days += 719468;
+	era = ((days >= 0) ? days : days - 146096) / 146097;
+	day_of_era = days - era * 146097;
+	year_of_era = (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365;
+	day_of_year = day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+	mp = (5 * day_of_year + 2) / 153;
+
+	*day = day_of_year - (153 * mp + 2) / 5 + 1;
+	*month = (mp < 10) ? mp + 3 : mp - 9;
+	*year = year_of_era + era * 400 + ((*month <= 2) ? 1 : 0);
+}
+
+/* Split a UNIX timestamp into its date and time of day, rounding towards negative infinity so that times before the epoch work */
+static void
+split_time (gint64 _time, gint64 *year, guint *month, guint *day, guint *hour, guint *minute, guint *second)
+{
+	gint64 days, seconds_of_day;
+
+	days = _time / 86400;
+	seconds_of_day = _time % 86400;
+	if (seconds_of_day < 0) {
+		seconds_of_day += 86400;
+		days--;
+	}
+
+	civil_from_days (days, year, month, day);
+	*hour = seconds_of_day / 3600;
+	*minute = (seconds_of_day / 60) % 60;
+	*second = seconds_of_day % 60;
+}
+
+/* Parse exactly @n_digits ASCII digits from *@p, advancing it past them */
+static inline gboolean
+parse_digits (const gchar **p, guint n_digits, guint *output)
+{
+	guint value = 0;
+	const gchar *i;
+
+	for (i = *p; i < *p + n_digits; i++) {
+		if (*i < '0' || *i > '9')
+			return FALSE;
+		value = value * 10 + (*i - '0');
+	}
+
+	*p = i;
+	*output = value;
+
+	return TRUE;
+}
+
+/* Parse a date of the form YYYY-MM-DD or YYYYMMDD from *@p, advancing it past the date, and validate it */
+static gboolean
+parse_date (const gchar **p, guint *year, guint *month, guint *day)
+{
+	const gchar *i = *p;
+	gboolean extended;
+
+	if (parse_digits (&i, 4, year) == FALSE)
+		return FALSE;
+
+	extended = (*i == '-');
+	if (extended == TRUE)
+		i++;
+	if (parse_digits (&i, 2, month) == FALSE)
+		return FALSE;
+
+	if (extended == TRUE && *(i++) != '-')
+		return FALSE;
+	if (parse_digits (&i, 2, day) == FALSE)
+		return FALSE;
+
+	/* Validate the date */
+	if (*year < 1 || *month < 1 || *month > 12 || *day < 1 ||
+	    *day > days_in_month[*month] + ((*month == 2 && is_leap_year (*year) == TRUE) ? 1 : 0)) {
+		return FALSE;
+	}
+
+	*p = i;
+
+	return TRUE;
+}
+
+/*
+ * parse_rfc3339:
+ * @date: the timestamp to parse
+ * @_time: return location for the parsed time
+ *
+ * Parses the subset of ISO 8601 used by the GData APIs (i.e. RFC 3339 timestamps, YYYY-MM-DDThh:mm:ss[.sss](Z|±hh:mm), with some
+ * leniency in the offset format) without allocating. Fractional seconds are truncated, as with g_date_time_to_unix().
+ *
+ * Return value: %TRUE if @date was in one of the supported forms and was valid, %FALSE otherwise; @date may still be valid ISO 8601
+ */
+static gboolean
+parse_rfc3339 (const gchar *date, gint64 *_time)
+{
+	const gchar *i = date;
+	guint year, month, day, hour, minute, second;
+	gint64 offset = 0;
+
+	if (parse_date (&i, &year, &month, &day) == FALSE || *(i++) != 'T')
+		return FALSE;
+
+	if (parse_digits (&i, 2, &hour) == FALSE || *(i++) != ':' ||
+	    parse_digits (&i, 2, &minute) == FALSE || *(i++) != ':' ||
+	    parse_digits (&i, 2, &second) == FALSE ||
+	    hour > 23 || minute > 59 || second > 59) {
+		return FALSE;
+	}
+
+	/* Skip fractional seconds */
+	if (*i == '.' || *i == ',') {
+		i++;
+		if (*i < '0' || *i > '9')
+			return FALSE;
+		while (*i >= '0' && *i <= '9')
+			i++;
+	}
+
+	/* Time zone offset. A missing offset means local time, which we leave to GDateTime. */
+	if (*i == 'Z') {
+		i++;
+	} else if (*i == '+' || *i == '-') {
+		gint sign = (*i == '+') ? 1 : -1;
+		guint offset_hours, offset_minutes = 0;
+
+		i++;
+		if (parse_digits (&i, 2, &offset_hours) == FALSE)
+			return FALSE;
+		if (*i != '\0') {
+			if (*i == ':')
+				i++;
+			if (parse_digits (&i, 2, &offset_minutes) == FALSE)
+				return FALSE;
+		}
+		if (offset_hours > 23 || offset_minutes > 59)
+			return FALSE;
+
+		offset = sign * (gint64) (offset_hours * 3600 + offset_minutes * 60);
+	} else {
+		return FALSE;
+	}
+
+	if (*i != '\0')
+		return FALSE;
+
+	*_time = days_from_civil (year, month, day) * 86400 + hour * 3600 + minute * 60 + second - offset;
+
+	return TRUE;
+}
+
 gboolean
 gdata_parser_int64_from_date (const gchar *date, gint64 *_time)
 {
+	const gchar *i = date;
+	guint year, month, day;
 	gchar *iso8601_date;
 	g_autoptr(GDateTime) time_val = NULL;
 
+	/* Try the fast path first, for YYYY-MM-DD and YYYYMMDD */
+	if (parse_date (&i, &year, &month, &day) == TRUE && *i == '\0') {
+		*_time = days_from_civil (year, month, day) * 86400;
+		return TRUE;
+	}
+
+	/* Fall back to GDateTime for the other (week and ordinal) date forms */
 	if (strlen (date) != 10 && strlen (date) != 8)
 		return FALSE;
 
@@ -228,27 +417,32 @@ gdata_parser_int64_from_date (const gchar *date, gint64 *_time)
 gchar *
 gdata_parser_date_from_int64 (gint64 _time)
 {
-	time_t secs;
-	struct tm *tm;
+	gint64 year;
+	guint month, day, hour, minute, second;
 
-	secs = _time;
-	tm = gmtime (&secs);
+	split_time (_time, &year, &month, &day, &hour, &minute, &second);
 
 	/* Note: This doesn't need translating, as it's outputting an ISO 8601 date string */
-	return g_strdup_printf ("%04d-%02d-%02d", tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday);
+	return g_strdup_printf ("%04" G_GINT64_FORMAT "-%02u-%02u", year, month, day);
 }
 
 gchar *
 gdata_parser_int64_to_iso8601 (gint64 _time)
 {
-	g_autoptr(GDateTime) time_val = NULL;
+	gint64 year;
+	guint month, day, hour, minute, second;
+	gchar buf[sizeof ("YYYY-MM-DDThh:mm:ssZ")];
 
-	time_val = g_date_time_new_from_unix_utc (_time);
+	split_time (_time, &year, &month, &day, &hour, &minute, &second);
 
-	if (!time_val)
+	/* Match the range supported by GDateTime */
+	if (year < 1 || year > 9999)
 		return NULL;
 
-	return g_date_time_format_iso8601 (time_val);
+	/* Note: This doesn't need translating, as it's outputting an ISO 8601 time string */
+	g_snprintf (buf, sizeof (buf), "%04u-%02u-%02uT%02u:%02u:%02uZ", (guint) year, month, day, hour, minute, second);
+
+	return g_strdup (buf);
 }
 
 gboolean
@@ -256,6 +450,11 @@ gdata_parser_int64_from_iso8601 (const gchar *date, gint64 *_time)
 {
 	g_autoptr(GDateTime) time_val = NULL;
 
+	/* Try the fast path first. This handles all the timestamps the APIs actually return. */
+	if (parse_rfc3339 (date, _time) == TRUE)
+		return TRUE;
+
+	/* Fall back to GDateTime for all the other forms of ISO 8601 */
 	time_val = g_date_time_new_from_iso8601 (date, NULL);
 	if (time_val) {
 		*_time = g_date_time_to_unix (time_val);
@@ -366,6 +565,57 @@ gdata_parser_boolean_from_property (xmlNode *element, const gchar *property_name
 	return TRUE;
 }
 
+/*
+ * gdata_parser_dup_known_string:
+ * @value: (nullable): the string to copy
+ * @known_values: a %NULL-terminated array of static strings
+ *
+ * Copies @value, unless it's equal to one of @known_values, in which case that static string is returned instead. This avoids duplicating
+ * values such as link relation types, which are mostly one of a handful of constants and are repeated across every element in a feed, while still
+ * freeing arbitrary values supplied by the user or the server.
+ *
+ * Return value: (nullable): @value, or an equal string from @known_values; free with gdata_parser_free_known_string()
+ *
+ * Since: 0.19.0
+ */
+const gchar *
+gdata_parser_dup_known_string (const gchar *value, const gchar * const *known_values)
+{
+	const gchar * const *i;
+
+	if (value == NULL)
+		return NULL;
+
+	for (i = known_values; *i != NULL; i++) {
+		if (strcmp (value, *i) == 0)
+			return *i;
+	}
+
+	return g_strdup (value);
+}
+
+/*
+ * gdata_parser_free_known_string:
+ * @value: (nullable): a string returned by gdata_parser_dup_known_string()
+ * @known_values: the same @known_values passed to gdata_parser_dup_known_string()
+ *
+ * Frees @value, unless it's one of the static strings in @known_values.
+ *
+ * Since: 0.19.0
+ */
+void
+gdata_parser_free_known_string (const gchar *value, const gchar * const *known_values)
+{
+	const gchar * const *i;
+
+	for (i = known_values; value != NULL && *i != NULL; i++) {
+		if (value == *i)
+			return;
+	}
+
+	g_free ((gchar*) value);
+}
+
 /*
  * gdata_parser_is_namespace:
  * @element: the element to check
@@ -438,6 +688,7 @@ gdata_parser_string_from_element (xmlNode *element, const gchar *element_name, G
 		*success = gdata_parser_error_required_content_missing (element, error);
 		return TRUE;
 	} else if (options & P_DEFAULT && (text == NULL || *text == '\0')) {
+		xmlFree (text);
 		text = (xmlChar*) g_strdup ("");
 	}
 
@@ -483,7 +734,6 @@ gdata_parser_int64_time_from_element (xmlNode *element, const gchar *element_nam
                                       gint64 *output, gboolean *success, GError **error)
 {
 	xmlChar *text;
-	g_autoptr(GDateTime) time_val = NULL;
 
 	/* Check it's the right element */
 	if (xmlStrcmp (element->name, (xmlChar*) element_name) != 0)
@@ -503,16 +753,13 @@ gdata_parser_int64_time_from_element (xmlNode *element, const gchar *element_nam
 		return TRUE;
 	}
 
-	/* Attempt to parse the string as a GDateTune */
-	time_val = g_date_time_new_from_iso8601 ((gchar *) text, NULL);
-	if (!time_val) {
+	/* Attempt to parse the string as an ISO 8601 time */
+	if (text == NULL || gdata_parser_int64_from_iso8601 ((gchar*) text, output) == FALSE) {
 		*success = gdata_parser_error_not_iso8601_format (element, (gchar*) text, error);
 		xmlFree (text);
 		return TRUE;
 	}
 
-	*output = g_date_time_to_unix (time_val);
-
 	/* Success! */
 	xmlFree (text);
 	*success = TRUE;
@@ -916,7 +1163,6 @@ gdata_parser_int64_time_from_json_member (JsonReader *reader, const gchar *membe
                                           gint64 *output, gboolean *success, GError **error)
 {
 	const gchar *text;
-	g_autoptr(GDateTime) time_val = NULL;
 	const GError *child_error = NULL;
 
 	/* Check if there's such element */
@@ -940,15 +1186,13 @@ gdata_parser_int64_time_from_json_member (JsonReader *reader, const gchar *membe
 		return TRUE;
 	}
 
-	/* Attempt to parse the string as a GDateTime */
-	time_val = g_date_time_new_from_iso8601 (text, NULL);
-	if (!time_val) {
+	/* Attempt to parse the string as an ISO 8601 time */
+	if (text == NULL || gdata_parser_int64_from_iso8601 (text, output) == FALSE) {
 		*success = gdata_parser_error_not_iso8601_format_json (reader, text, error);
 		return TRUE;
 	}
 
 	/* Success! */
-	*output = g_date_time_to_unix (time_val);
 	*success = TRUE;
 
 	return TRUE;
@@ -1210,71 +1454,152 @@ gdata_parser_color_from_json_member (JsonReader *reader,
 	return TRUE;
 }
 
+/* Classification of bytes for gdata_parser_string_append_escaped() */
+typedef enum {
+	ESCAPE_NONE = 0,
+	ESCAPE_ENTITY, /* escaped as a named entity */
+	ESCAPE_CONTROL, /* a control character, escaped as a character reference */
+	ESCAPE_C1_LEAD, /* the lead byte of a UTF-8 sequence which might be a C1 control character */
+} EscapeType;
+
+#define N ESCAPE_NONE
+#define E ESCAPE_ENTITY
+#define C ESCAPE_CONTROL
+#define L ESCAPE_C1_LEAD
+static const guint8 escape_table[256] = {
+	/* 0x00 */ N, C, C, C, C, C, C, C, C, N, N, C, C, N, C, C,
+	/* 0x10 */ C, C, C, C, C, C, C, C, C, C, C, C, C, C, C, C,
+	/* 0x20 */ N, N, E, N, N, N, E, E, N, N, N, N, N, N, N, N,
+	/* 0x30 */ N, N, N, N, N, N, N, N, N, N, N, N, E, N, E, N,
+	/* 0x40 */ N, N, N, N, N, N, N, N, N, N, N, N, N, N, N, N,
+	/* 0x50 */ N, N, N, N, N, N, N, N, N, N, N, N, N, N, N, N,
+	/* 0x60 */ N, N, N, N, N, N, N, N, N, N, N, N, N, N, N, N,
+	/* 0x70 */ N, N, N, N, N, N, N, N, N, N, N, N, N, N, N, C,
+	/* 0x80 */ N, N, N, N, N, N, N, N, N, N, N, N, N, N, N, N,
+	/* 0x90 */ N, N, N, N, N, N, N, N, N, N, N, N, N, N, N, N,
+	/* 0xa0 */ N, N, N, N, N, N, N, N, N, N, N, N, N, N, N, N,
+	/* 0xb0 */ N, N, N, N, N, N, N, N, N, N, N, N, N, N, N, N,
+	/* 0xc0 */ N, N, L, N, N, N, N, N, N, N, N, N, N, N, N, N,
+	/* 0xd0 */ N, N, N, N, N, N, N, N, N, N, N, N, N, N, N, N,
+	/* 0xe0 */ N, N, N, N, N, N, N, N, N, N, N, N, N, N, N, N,
+	/* 0xf0 */ N, N, N, N, N, N, N, N, N, N, N, N, N, N, N, N,
+};
+#undef N
+#undef E
+#undef C
+#undef L
+
+/* Write a character reference for the control character @c to @buf, returning its length */
+static gsize
+escape_control_character (guint8 c, gchar buf[sizeof ("&#x9f;")])
+{
+	static const gchar hex_digits[] = "0123456789abcdef";
+	gsize i = 0;
+
+	buf[i++] = '&';
+	buf[i++] = '#';
+	buf[i++] = 'x';
+	if (c >= 0x10)
+		buf[i++] = hex_digits[c >> 4];
+	buf[i++] = hex_digits[c & 0xf];
+	buf[i++] = ';';
+
+	return i;
+}
+
 void
 gdata_parser_string_append_escaped (GString *xml_string, const gchar *pre, const gchar *element_content, const gchar *post)
 {
-	/* Allocate 10 extra bytes when reallocating the GString, to try and avoid having to reallocate again, by assuming
-	 * there will be an increase in the length of element_content when escaped of less than 10 characters. */
-/*	#define SIZE_FUZZINESS 10*/
+	gsize pre_length, content_length, post_length, original_length;
+	const guchar *p, *run_start;
 
-/*	guint new_size;*/
-	const gchar *p;
+	pre_length = (pre != NULL) ? strlen (pre) : 0;
+	content_length = (element_content != NULL) ? strlen (element_content) : 0;
+	post_length = (post != NULL) ? strlen (post) : 0;
 
-	/* Expand xml_string as necessary */
-	/* TODO: There is no way to expand the allocation of a GString if you know in advance how much room
-	 * lots of append operations are going to require. */
-/*	new_size = xml_string->len + strlen (pre) + strlen (element_content) + strlen (post) + SIZE_FUZZINESS;
-	if (new_size > xml_string->allocated_len)
-		g_string_set_size (xml_string, new_size);*/
+	/* Expand xml_string as necessary, allowing for a little growth in the content when it's escaped. GString has no API for reserving space,
+	 * but setting its size and truncating it again leaves the allocation in place. */
+	original_length = xml_string->len;
+	g_string_set_size (xml_string, original_length + pre_length + content_length + content_length / 8 + post_length);
+	g_string_truncate (xml_string, original_length);
 
 	/* Append the pre content */
 	if (pre != NULL)
-		g_string_append (xml_string, pre);
+		g_string_append_len (xml_string, pre, pre_length);
 
-	/* Loop through the string to be escaped. Code adapted from GLib's g_markup_escape_text() function.
+	/* Loop through the string to be escaped, copying runs of bytes which don't need escaping in one go. This is equivalent to GLib's
+	 * g_markup_escape_text() function, which this was originally adapted from.
 	 *  Copyright 2000, 2003 Red Hat, Inc.
 	 *  Copyright 2007, 2008 Ryan Lortie <desrt@desrt.ca> */
-	p = element_content;
+	run_start = p = (const guchar*) element_content;
 	while (p != NULL && *p != '\0') {
-		const gchar *next = g_utf8_next_char (p);
+		const gchar *replacement;
+		gsize replacement_length;
+		gchar buf[sizeof ("&#x9f;")];
+
+		/* Find the next byte which might need escaping */
+		if (G_LIKELY (escape_table[*p] == ESCAPE_NONE)) {
+			p++;
+			continue;
+		}
 
-		switch (*p) {
-			case '&':
-				g_string_append (xml_string, "&amp;");
-				break;
-			case '<':
-				g_string_append (xml_string, "&lt;");
-				break;
-			case '>':
-				g_string_append (xml_string, "&gt;");
-				break;
-			case '\'':
-				g_string_append (xml_string, "&apos;");
+		switch (escape_table[*p]) {
+			case ESCAPE_ENTITY:
+				switch (*p) {
+					case '&':
+						replacement = "&amp;";
+						break;
+					case '<':
+						replacement = "&lt;";
+						break;
+					case '>':
+						replacement = "&gt;";
+						break;
+					case '\'':
+						replacement = "&apos;";
+						break;
+					case '"':
+					default:
+						replacement = "&quot;";
+						break;
+				}
+
+				replacement_length = strlen (replacement);
 				break;
-			case '"':
-				g_string_append (xml_string, "&quot;");
+			case ESCAPE_CONTROL:
+				/* Control characters in the range U+0001–U+001F and U+007F */
+				replacement_length = escape_control_character (*p, buf);
+				replacement = buf;
 				break;
-			default: {
-				gunichar c = g_utf8_get_char (p);
-
-				if ((0x1 <= c && c <= 0x8) ||
-				    (0xb <= c && c  <= 0xc) ||
-				    (0xe <= c && c <= 0x1f) ||
-				    (0x7f <= c && c <= 0x84) ||
-				    (0x86 <= c && c <= 0x9f)) {
-					g_string_append_printf (xml_string, "&#x%x;", c);
+			case ESCAPE_C1_LEAD:
+				/* U+0080–U+009F (except U+0085) are encoded as 0xC2 0x80–0x9F in UTF-8 */
+				if (p[1] >= 0x80 && p[1] <= 0x9f && p[1] != 0x85) {
+					g_string_append_len (xml_string, (const gchar*) run_start, p - run_start);
+					g_string_append_len (xml_string, buf, escape_control_character (p[1], buf));
+					p += 2;
+					run_start = p;
 				} else {
-					g_string_append_len (xml_string, p, next - p);
-					break;
+					p++;
 				}
-			}
+
+				continue;
+			case ESCAPE_NONE:
+			default:
+				g_assert_not_reached ();
 		}
-		p = next;
+
+		g_string_append_len (xml_string, (const gchar*) run_start, p - run_start);
+		g_string_append_len (xml_string, replacement, replacement_length);
+		p++;
+		run_start = p;
 	}
 
+	if (p != NULL)
+		g_string_append_len (xml_string, (const gchar*) run_start, p - run_start);
+
 	/* Append the post content */
 	if (post != NULL)
-		g_string_append (xml_string, post);
+		g_string_append_len (xml_string, post, post_length);
 }
 
 /* TODO: Should be perfectly possible to make this modify the string in-place */
@@ -77,6 +77,9 @@ typedef void (*GDataParserSetterFunc) (GDataParsable *parent_parsable, GDataPars
 
 gboolean gdata_parser_boolean_from_property (xmlNode *element, const gchar *property_name, gboolean *output, gint default_output, GError **error);
 
+const gchar *gdata_parser_dup_known_string (const gchar *value, const gchar * const *known_values) G_GNUC_WARN_UNUSED_RESULT;
+void gdata_parser_free_known_string (const gchar *value, const gchar * const *known_values);
+
 gboolean gdata_parser_is_namespace (xmlNode *element, const gchar *namespace_uri);
 
 gboolean gdata_parser_string_from_element (xmlNode *element, const gchar *element_name, GDataParserOptions options,
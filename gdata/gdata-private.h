@@ -50,10 +50,12 @@ typedef enum {
 
 #include "gdata-service.h"
 G_GNUC_INTERNAL SoupSession *_gdata_service_get_session (GDataService *self) G_GNUC_PURE;
+G_GNUC_INTERNAL void _gdata_service_set_session (GDataService *self, SoupSession *session);
 G_GNUC_INTERNAL SoupMessage *_gdata_service_build_message (GDataService *self, GDataAuthorizationDomain *domain, const gchar *method, const gchar *uri,
                                                            const gchar *etag, gboolean etag_if_match);
 G_GNUC_INTERNAL void _gdata_service_actually_send_message (SoupSession *session, SoupMessage *message, GCancellable *cancellable, GError **error);
 G_GNUC_INTERNAL guint _gdata_service_send_message (GDataService *self, SoupMessage *message, GCancellable *cancellable, GError **error);
+G_GNUC_INTERNAL void _gdata_service_set_message_parse_time (SoupMessage *message, gint64 parse_time);
 G_GNUC_INTERNAL SoupMessage *_gdata_service_query (GDataService *self, GDataAuthorizationDomain *domain, const gchar *feed_uri, GDataQuery *query,
                                                    GCancellable *cancellable, GError **error) G_GNUC_WARN_UNUSED_RESULT G_GNUC_MALLOC;
 G_GNUC_INTERNAL const gchar *_gdata_service_get_scheme (void) G_GNUC_CONST;
@@ -82,6 +84,7 @@ G_GNUC_INTERNAL void _gdata_query_clear_q_internal (GDataQuery *self);
 G_GNUC_INTERNAL void _gdata_query_clear_pagination (GDataQuery *self);
 G_GNUC_INTERNAL void _gdata_query_set_pagination_type (GDataQuery               *self,
                                                        GDataQueryPaginationType  type);
+G_GNUC_INTERNAL void _gdata_query_set_append_updated_min (GDataQuery *self, gboolean append_updated_min);
 G_GNUC_INTERNAL void _gdata_query_set_next_page_token (GDataQuery  *self, const gchar *next_page_token);
 G_GNUC_INTERNAL void _gdata_query_set_next_uri (GDataQuery *self, const gchar *next_uri);
 G_GNUC_INTERNAL gboolean _gdata_query_is_finished (GDataQuery *self);
@@ -98,6 +101,7 @@ G_GNUC_INTERNAL GDataParsable *_gdata_parsable_new_from_json_node (GType parsabl
                                                                    GError **error) G_GNUC_WARN_UNUSED_RESULT G_GNUC_MALLOC;
 G_GNUC_INTERNAL void _gdata_parsable_get_xml (GDataParsable *self, GString *xml_string, gboolean declare_namespaces);
 G_GNUC_INTERNAL void _gdata_parsable_get_json (GDataParsable *self, JsonBuilder *builder);
+G_GNUC_INTERNAL gchar *_gdata_parsable_serialise (GDataParsable *self, gsize *length) G_GNUC_WARN_UNUSED_RESULT G_GNUC_MALLOC;
 G_GNUC_INTERNAL void _gdata_parsable_string_append_escaped (GString *xml_string, const gchar *pre, const gchar *element_content, const gchar *post);
 G_GNUC_INTERNAL gboolean _gdata_parsable_is_constructed_from_xml (GDataParsable *self);
 
@@ -128,6 +132,16 @@ G_GNUC_INTERNAL void _gdata_entry_set_published (GDataEntry *self, gint64 publis
 G_GNUC_INTERNAL void _gdata_entry_set_id (GDataEntry *self, const gchar *id);
 G_GNUC_INTERNAL void _gdata_entry_set_etag (GDataEntry *self, const gchar *etag);
 G_GNUC_INTERNAL void _gdata_entry_set_batch_data (GDataEntry *self, guint id, GDataBatchOperationType type);
+G_GNUC_INTERNAL void _gdata_entry_reindex (GDataEntry *self);
+G_GNUC_INTERNAL guint _gdata_entry_get_links_serial (GDataEntry *self);
+G_GNUC_INTERNAL gboolean _gdata_entry_is_deleted (GDataEntry *self);
+G_GNUC_INTERNAL gchar **_gdata_entry_get_parent_ids (GDataEntry *self) G_GNUC_WARN_UNUSED_RESULT G_GNUC_MALLOC;
+
+#include "atom/gdata-category.h"
+G_GNUC_INTERNAL void _gdata_category_set_indexed (GDataCategory *self, GDataEntry *entry, gboolean indexed);
+
+#include "atom/gdata-link.h"
+G_GNUC_INTERNAL void _gdata_link_set_indexed (GDataLink *self, GDataEntry *entry, gboolean indexed);
 
 #include "gdata-access-rule.h"
 G_GNUC_INTERNAL void _gdata_access_rule_set_key (GDataAccessRule *self, const gchar *key);
@@ -0,0 +1,666 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 8; tab-width: 8 -*- */
+/*
+ * GData Client
+ *
+ * GData Client is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * GData Client is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GData Client.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * SECTION:gdata-query-executor
+ * @short_description: GData query executor for running queries across many accounts
+ * @stability: Unstable
+ * @include: gdata/gdata-query-executor.h
+ *
+ * #GDataQueryExecutor runs queries for many #GDataServices — typically one per user account, each with its own #GDataAuthorizer — under a
+ * single set of limits. Queries submitted with gdata_query_executor_query_async() are queued, and run on a pool of at most
+ * #GDataQueryExecutor:max-concurrent-queries threads, started no faster than #GDataQueryExecutor:max-queries-per-second. Queued queries are
+ * scheduled round-robin between authorizers, so an account with a long backlog of queries can't starve the others. Each query's result is
+ * returned to its own #GAsyncReadyCallback as soon as it completes.
+ *
+ * Services added to the executor with gdata_query_executor_add_service() share a single connection pool, rather than each opening its own
+ * connections. This also means they share their #GDataService:timeout and #GDataService:proxy-resolver settings: changing either on one of the
+ * services changes it on all of them.
+ *
+ * <example>
+ * 	<title>Polling Calendars for Many Accounts</title>
+ * 	<programlisting>
+ *	GDataQueryExecutor *executor;
+ *	guint i;
+ *
+ *	executor = gdata_query_executor_new (32);
+ *	gdata_query_executor_set_max_queries_per_second (executor, 50.0);
+ *
+ *	for (i = 0; i < n_accounts; i++) {
+ *		GDataService *service = GDATA_SERVICE (gdata_calendar_service_new (accounts[i].authorizer));
+ *
+ *		gdata_query_executor_add_service (executor, service);
+ *		gdata_query_executor_query_async (executor, service, gdata_calendar_service_get_primary_authorization_domain (),
+ *		                                  "https://www.googleapis.com/calendar/v3/users/me/calendarList", NULL,
+ *		                                  GDATA_TYPE_CALENDAR_CALENDAR, NULL, NULL, NULL, NULL,
+ *		                                  (GAsyncReadyCallback) query_cb, &accounts[i]);
+ *
+ *		g_object_unref (service);
+ *	}
+ *
+ *	g_object_unref (executor);
+ *
+ *	static void
+ *	query_cb (GDataQueryExecutor *executor, GAsyncResult *result, Account *account)
+ *	{
+ *		GDataFeed *feed;
+ *		GError *error = NULL;
+ *
+ *		feed = gdata_query_executor_query_finish (executor, result, &error);
+ *
+ *		if (error != NULL) {
+ *			g_warning ("Error querying calendars for %s: %s", account->name, error->message);
+ *			g_error_free (error);
+ *			return;
+ *		}
+ *
+ *		/<!-- -->* Do something with the feed here *<!-- -->/
+ *
+ *		g_object_unref (feed);
+ *	}
+ * 	</programlisting>
+ * </example>
+ *
+ * Since: 0.19.0
+ */
+
+#include <config.h>
+#include <glib.h>
+#include <libsoup/soup.h>
+
+#include "gdata-query-executor.h"
+#include "gdata-private.h"
+
+static void gdata_query_executor_finalize (GObject *object);
+static void gdata_query_executor_get_property (GObject *object, guint property_id, GValue *value, GParamSpec *pspec);
+static void gdata_query_executor_set_property (GObject *object, guint property_id, const GValue *value, GParamSpec *pspec);
+static void gdata_query_executor_constructed (GObject *object);
+static void run_query_cb (gpointer data, gpointer user_data);
+
+struct _GDataQueryExecutorPrivate {
+	guint max_concurrent_queries;
+	SoupSession *session; /* shared by all services added to the executor */
+	GThreadPool *pool; /* runs at most max_concurrent_queries queries at once */
+
+	/* The fields below are protected by the mutex, as they're accessed from the pool's threads */
+	GMutex mutex;
+	GHashTable *lanes; /* owner (GDataAuthorizer or GDataService, used only as a key) → GQueue of queued GTasks */
+	GQueue ready_lanes; /* owners which have queued queries, in the order they'll next be served */
+	gdouble max_queries_per_second;
+	gint64 next_start_time; /* monotonic time at which the next query may start, for rate limiting */
+};
+
+enum {
+	PROP_MAX_CONCURRENT_QUERIES = 1,
+	PROP_MAX_QUERIES_PER_SECOND,
+};
+
+G_DEFINE_TYPE_WITH_PRIVATE (GDataQueryExecutor, gdata_query_executor, G_TYPE_OBJECT)
+
+static void
+gdata_query_executor_class_init (GDataQueryExecutorClass *klass)
+{
+	GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+
+	gobject_class->constructed = gdata_query_executor_constructed;
+	gobject_class->get_property = gdata_query_executor_get_property;
+	gobject_class->set_property = gdata_query_executor_set_property;
+	gobject_class->finalize = gdata_query_executor_finalize;
+
+	/**
+	 * GDataQueryExecutor:max-concurrent-queries:
+	 *
+	 * The maximum number of queries the executor runs at once, across all of its services. This is also the size of the connection pool shared by
+	 * the services added with gdata_query_executor_add_service().
+	 *
+	 * Since: 0.19.0
+	 */
+	g_object_class_install_property (gobject_class, PROP_MAX_CONCURRENT_QUERIES,
+	                                 g_param_spec_uint ("max-concurrent-queries",
+	                                                    "Maximum concurrent queries", "The maximum number of queries to run at once.",
+	                                                    1, G_MAXINT, 8,
+	                                                    G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS));
+
+	/**
+	 * GDataQueryExecutor:max-queries-per-second:
+	 *
+	 * The maximum rate at which the executor starts queries, across all of its services. If this is <code class="literal">0</code>, queries are
+	 * started as soon as a thread is free to run them.
+	 *
+	 * Since: 0.19.0
+	 */
+	g_object_class_install_property (gobject_class, PROP_MAX_QUERIES_PER_SECOND,
+	                                 g_param_spec_double ("max-queries-per-second",
+	                                                      "Maximum queries per second", "The maximum rate at which to start queries.",
+	                                                      0.0, G_MAXDOUBLE, 0.0,
+	                                                      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+}
+
+static void
+gdata_query_executor_init (GDataQueryExecutor *self)
+{
+	self->priv = gdata_query_executor_get_instance_private (self);
+
+	g_mutex_init (&(self->priv->mutex));
+	self->priv->lanes = g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL, (GDestroyNotify) g_queue_free);
+	g_queue_init (&(self->priv->ready_lanes));
+}
+
+static void
+gdata_query_executor_constructed (GObject *object)
+{
+	GDataQueryExecutorPrivate *priv = GDATA_QUERY_EXECUTOR (object)->priv;
+
+	/* Chain up to the parent class */
+	G_OBJECT_CLASS (gdata_query_executor_parent_class)->constructed (object);
+
+	/* All the queries go to the same few hosts, so allow each of them as many connections as there can be queries in flight */
+	priv->session = _gdata_service_build_session ();
+	g_object_set (priv->session,
+	              SOUP_SESSION_MAX_CONNS, MAX (priv->max_concurrent_queries, 10),
+	              SOUP_SESSION_MAX_CONNS_PER_HOST, priv->max_concurrent_queries,
+	              NULL);
+
+	/* This can't fail for a non-exclusive pool. Each item pushed to the pool is a token which allows one queued query to run; which query runs is
+	 * decided when the token is taken, so that the scheduling stays fair however the queries were submitted. */
+	priv->pool = g_thread_pool_new (run_query_cb, object, priv->max_concurrent_queries, FALSE, NULL);
+}
+
+static void
+gdata_query_executor_finalize (GObject *object)
+{
+	GDataQueryExecutorPrivate *priv = GDATA_QUERY_EXECUTOR (object)->priv;
+
+	/* Every queued query holds a reference to the executor, so the pool is idle by now. Don't wait for its threads: this may be called from one
+	 * of them, as the executor is released at the end of a query. */
+	g_thread_pool_free (priv->pool, FALSE, FALSE);
+	g_object_unref (priv->session);
+
+	g_assert (g_queue_is_empty (&(priv->ready_lanes)) == TRUE);
+	g_hash_table_destroy (priv->lanes);
+	g_mutex_clear (&(priv->mutex));
+
+	/* Chain up to the parent class */
+	G_OBJECT_CLASS (gdata_query_executor_parent_class)->finalize (object);
+}
+
+static void
+gdata_query_executor_get_property (GObject *object, guint property_id, GValue *value, GParamSpec *pspec)
+{
+	GDataQueryExecutor *self = GDATA_QUERY_EXECUTOR (object);
+
+	switch (property_id) {
+		case PROP_MAX_CONCURRENT_QUERIES:
+			g_value_set_uint (value, self->priv->max_concurrent_queries);
+			break;
+		case PROP_MAX_QUERIES_PER_SECOND:
+			g_value_set_double (value, gdata_query_executor_get_max_queries_per_second (self));
+			break;
+		default:
+			/* We don't have any other property... */
+			G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+			break;
+	}
+}
+
+static void
+gdata_query_executor_set_property (GObject *object, guint property_id, const GValue *value, GParamSpec *pspec)
+{
+	GDataQueryExecutor *self = GDATA_QUERY_EXECUTOR (object);
+
+	switch (property_id) {
+		case PROP_MAX_CONCURRENT_QUERIES:
+			self->priv->max_concurrent_queries = g_value_get_uint (value);
+			break;
+		case PROP_MAX_QUERIES_PER_SECOND:
+			gdata_query_executor_set_max_queries_per_second (self, g_value_get_double (value));
+			break;
+		default:
+			/* We don't have any other property... */
+			G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+			break;
+	}
+}
+
+/**
+ * gdata_query_executor_new:
+ * @max_concurrent_queries: the maximum number of queries to run at once
+ *
+ * Creates a new #GDataQueryExecutor which runs at most @max_concurrent_queries queries at once.
+ *
+ * Return value: (transfer full): a new #GDataQueryExecutor; unref with g_object_unref()
+ *
+ * Since: 0.19.0
+ */
+GDataQueryExecutor *
+gdata_query_executor_new (guint max_concurrent_queries)
+{
+	g_return_val_if_fail (max_concurrent_queries > 0, NULL);
+
+	return g_object_new (GDATA_TYPE_QUERY_EXECUTOR, "max-concurrent-queries", max_concurrent_queries, NULL);
+}
+
+/**
+ * gdata_query_executor_get_max_concurrent_queries:
+ * @self: a #GDataQueryExecutor
+ *
+ * Gets the #GDataQueryExecutor:max-concurrent-queries property.
+ *
+ * Return value: the maximum number of queries run at once
+ *
+ * Since: 0.19.0
+ */
+guint
+gdata_query_executor_get_max_concurrent_queries (GDataQueryExecutor *self)
+{
+	g_return_val_if_fail (GDATA_IS_QUERY_EXECUTOR (self), 0);
+	return self->priv->max_concurrent_queries;
+}
+
+/**
+ * gdata_query_executor_get_max_queries_per_second:
+ * @self: a #GDataQueryExecutor
+ *
+ * Gets the #GDataQueryExecutor:max-queries-per-second property.
+ *
+ * Return value: the maximum rate at which queries are started, or <code class="literal">0</code> if it's unlimited
+ *
+ * Since: 0.19.0
+ */
+gdouble
+gdata_query_executor_get_max_queries_per_second (GDataQueryExecutor *self)
+{
+	gdouble max_queries_per_second;
+
+	g_return_val_if_fail (GDATA_IS_QUERY_EXECUTOR (self), 0.0);
+
+	g_mutex_lock (&(self->priv->mutex));
+	max_queries_per_second = self->priv->max_queries_per_second;
+	g_mutex_unlock (&(self->priv->mutex));
+
+	return max_queries_per_second;
+}
+
+/**
+ * gdata_query_executor_set_max_queries_per_second:
+ * @self: a #GDataQueryExecutor
+ * @max_queries_per_second: the maximum rate at which to start queries, or <code class="literal">0</code>
+ *
+ * Sets the #GDataQueryExecutor:max-queries-per-second property. The new rate applies to queries which haven't started yet.
+ *
+ * Since: 0.19.0
+ */
+void
+gdata_query_executor_set_max_queries_per_second (GDataQueryExecutor *self, gdouble max_queries_per_second)
+{
+	g_return_if_fail (GDATA_IS_QUERY_EXECUTOR (self));
+	g_return_if_fail (max_queries_per_second >= 0.0);
+
+	g_mutex_lock (&(self->priv->mutex));
+	self->priv->max_queries_per_second = max_queries_per_second;
+	g_mutex_unlock (&(self->priv->mutex));
+
+	g_object_notify (G_OBJECT (self), "max-queries-per-second");
+}
+
+/**
+ * gdata_query_executor_add_service:
+ * @self: a #GDataQueryExecutor
+ * @service: a #GDataService
+ *
+ * Makes @service use the executor's connection pool for all its network requests, including ones which aren't run through the executor. From then
+ * on, @service shares its #GDataService:timeout and #GDataService:proxy-resolver with all the other services added to the executor.
+ *
+ * This must not be called while @service has operations in progress.
+ *
+ * Since: 0.19.0
+ */
+void
+gdata_query_executor_add_service (GDataQueryExecutor *self, GDataService *service)
+{
+	g_return_if_fail (GDATA_IS_QUERY_EXECUTOR (self));
+	g_return_if_fail (GDATA_IS_SERVICE (service));
+
+	_gdata_service_set_session (service, self->priv->session);
+}
+
+typedef struct {
+	GDataService *service;
+	GDataAuthorizationDomain *domain;
+	gchar *feed_uri;
+	GDataQuery *query;
+	GType entry_type;
+	GDataQueryProgressCallback progress_callback;
+	gpointer progress_user_data;
+	GDestroyNotify destroy_progress_user_data;
+	gpointer owner; /* key of the lane the query's queued in */
+	GSource *cancelled_source; /* owned; dequeues the query if it's cancelled while queued, or NULL if it has no cancellable */
+} QueryData;
+
+static void
+query_data_free (QueryData *data)
+{
+	if (data->destroy_progress_user_data != NULL)
+		data->destroy_progress_user_data (data->progress_user_data);
+
+	g_object_unref (data->service);
+	g_clear_object (&data->domain);
+	g_free (data->feed_uri);
+	g_clear_object (&data->query);
+
+	if (data->cancelled_source != NULL)
+		g_source_unref (data->cancelled_source);
+
+	g_slice_free (QueryData, data);
+}
+
+/* Take the next query to run, serving the owners of queued queries in turn. Returns %NULL if there are none, which happens when queued queries have
+ * been cancelled: they leave their tokens in the pool. Must be called with the mutex held. */
+static GTask *
+pop_next_query (GDataQueryExecutor *self)
+{
+	GDataQueryExecutorPrivate *priv = self->priv;
+	gpointer owner;
+	GQueue *lane;
+	GTask *task;
+
+	owner = g_queue_pop_head (&(priv->ready_lanes));
+	if (owner == NULL)
+		return NULL;
+
+	lane = g_hash_table_lookup (priv->lanes, owner);
+	task = g_queue_pop_head (lane);
+
+	/* Send the owner to the back of the line if it has more queries waiting */
+	if (g_queue_is_empty (lane) == TRUE)
+		g_hash_table_remove (priv->lanes, owner);
+	else
+		g_queue_push_tail (&(priv->ready_lanes), owner);
+
+	return task;
+}
+
+/* Remove @task from its lane if it's still queued, returning %TRUE if it was. Must be called with the mutex held. */
+static gboolean
+remove_queued_query (GDataQueryExecutor *self, GTask *task)
+{
+	GDataQueryExecutorPrivate *priv = self->priv;
+	QueryData *data = g_task_get_task_data (task);
+	GQueue *lane;
+
+	lane = g_hash_table_lookup (priv->lanes, data->owner);
+	if (lane == NULL || g_queue_remove (lane, task) == FALSE)
+		return FALSE;
+
+	if (g_queue_is_empty (lane) == TRUE) {
+		g_hash_table_remove (priv->lanes, data->owner);
+		g_queue_remove (&(priv->ready_lanes), data->owner);
+	}
+
+	return TRUE;
+}
+
+/* Called in the query's #GMainContext when its cancellable is cancelled. If the query's still queued, finish it now rather than when its turn comes;
+ * if it's already been taken by run_query_cb(), that'll notice the cancellation itself. */
+static gboolean
+query_cancelled_cb (GCancellable *cancellable, GTask *task)
+{
+	GDataQueryExecutor *self = g_task_get_source_object (task);
+	gboolean was_queued;
+
+	g_mutex_lock (&(self->priv->mutex));
+	was_queued = remove_queued_query (self, task);
+	g_mutex_unlock (&(self->priv->mutex));
+
+	if (was_queued == TRUE) {
+		g_task_return_error_if_cancelled (task);
+
+		/* Drop the queue's reference; the source still holds one */
+		g_object_unref (task);
+	}
+
+	return G_SOURCE_REMOVE;
+}
+
+/* Work out how long to wait before starting a query, reserving its slot under the rate limit. Must be called with the mutex held. */
+static gint64
+reserve_start_time (GDataQueryExecutor *self)
+{
+	GDataQueryExecutorPrivate *priv = self->priv;
+	gint64 now, start_time;
+
+	if (priv->max_queries_per_second <= 0.0)
+		return 0;
+
+	now = g_get_monotonic_time ();
+	start_time = MAX (now, priv->next_start_time);
+	priv->next_start_time = start_time + (gint64) (G_USEC_PER_SEC / priv->max_queries_per_second);
+
+	return start_time - now;
+}
+
+typedef struct {
+	GMutex mutex;
+	GCond cond;
+	gboolean cancelled;
+} WaitData;
+
+static void
+wait_cancelled_cb (GCancellable *cancellable, WaitData *data)
+{
+	g_mutex_lock (&(data->mutex));
+	data->cancelled = TRUE;
+	g_cond_signal (&(data->cond));
+	g_mutex_unlock (&(data->mutex));
+}
+
+/* Wait @delay microseconds for a query's reserved start time, returning early with an error if @cancellable is cancelled. The query keeps its pool
+ * thread while it waits; the rate limit means no other query could start any sooner in its place. */
+static gboolean
+wait_for_start_time (gint64 delay, GCancellable *cancellable, GError **error)
+{
+	WaitData data;
+	gint64 end_time;
+	gulong handler_id = 0;
+
+	g_mutex_init (&(data.mutex));
+	g_cond_init (&(data.cond));
+	data.cancelled = FALSE;
+
+	end_time = g_get_monotonic_time () + delay;
+
+	if (cancellable != NULL)
+		handler_id = g_cancellable_connect (cancellable, G_CALLBACK (wait_cancelled_cb), &data, NULL);
+
+	g_mutex_lock (&(data.mutex));
+	while (data.cancelled == FALSE && g_cond_wait_until (&(data.cond), &(data.mutex), end_time) == TRUE);
+	g_mutex_unlock (&(data.mutex));
+
+	/* This blocks until any running invocation of wait_cancelled_cb() has finished, so @data can safely be cleared afterwards */
+	if (cancellable != NULL)
+		g_cancellable_disconnect (cancellable, handler_id);
+
+	g_cond_clear (&(data.cond));
+	g_mutex_clear (&(data.mutex));
+
+	return !g_cancellable_set_error_if_cancelled (cancellable, error);
+}
+
+static void
+run_query_cb (gpointer data, gpointer user_data)
+{
+	GDataQueryExecutor *self = GDATA_QUERY_EXECUTOR (user_data);
+	GTask *task;
+	QueryData *query_data;
+	GCancellable *cancellable;
+	GDataFeed *feed = NULL;
+	GError *error = NULL;
+	gint64 delay;
+
+	g_mutex_lock (&(self->priv->mutex));
+	task = pop_next_query (self);
+	delay = (task != NULL) ? reserve_start_time (self) : 0;
+	g_mutex_unlock (&(self->priv->mutex));
+
+	/* The query this token was pushed for was cancelled while queued, and has already finished */
+	if (task == NULL)
+		return;
+
+	query_data = g_task_get_task_data (task);
+
+	/* The query's no longer queued, so query_cancelled_cb() won't touch it any more */
+	if (query_data->cancelled_source != NULL)
+		g_source_destroy (query_data->cancelled_source);
+
+	cancellable = g_task_get_cancellable (task);
+
+	if (delay <= 0 || wait_for_start_time (delay, cancellable, &error) == TRUE) {
+		feed = gdata_service_query (query_data->service, query_data->domain, query_data->feed_uri, query_data->query,
+		                            query_data->entry_type, cancellable, query_data->progress_callback, query_data->progress_user_data,
+		                            &error);
+	}
+
+	if (error != NULL)
+		g_task_return_error (task, error);
+	else
+		g_task_return_pointer (task, feed, g_object_unref);
+
+	/* This may drop the last reference to the executor */
+	g_object_unref (task);
+}
+
+/**
+ * gdata_query_executor_query_async:
+ * @self: a #GDataQueryExecutor
+ * @service: the #GDataService to query
+ * @domain: (allow-none): the #GDataAuthorizationDomain the query falls under, or %NULL
+ * @feed_uri: the feed URI to query, including the host name and protocol
+ * @query: (allow-none): a #GDataQuery with the query parameters, or %NULL
+ * @entry_type: a #GType for the #GDataEntrys to build from the XML
+ * @cancellable: (allow-none): optional #GCancellable object, or %NULL
+ * @progress_callback: (allow-none) (closure progress_user_data): a #GDataQueryProgressCallback to call when an entry is loaded, or %NULL
+ * @progress_user_data: (closure): data to pass to the @progress_callback function
+ * @destroy_progress_user_data: (allow-none): the function to call when @progress_callback will not be called any more, or %NULL. This function will be
+ * called with @progress_user_data as a parameter and can be used to free any memory allocated for it.
+ * @callback: a #GAsyncReadyCallback to call when the query is finished
+ * @user_data: (closure): data to pass to the @callback function
+ *
+ * Queues a query of @service, as with gdata_service_query_async(), to be run once the executor's limits allow. The executor keeps a reference to
+ * itself while any of its queries are queued or running, so the caller may drop its own reference to @self as soon as the query has been queued.
+ *
+ * If @cancellable is cancelled while the query is queued, or while it's waiting to start because of #GDataQueryExecutor:max-queries-per-second,
+ * the query finishes straight away with %G_IO_ERROR_CANCELLED. A query cancelled while queued is removed from the queue without taking a thread
+ * from the pool.
+ *
+ * When the query is finished, @callback will be called in the thread-default #GMainContext of the thread which called this function. You can then
+ * call gdata_query_executor_query_finish() to get the results of the operation.
+ *
+ * Since: 0.19.0
+ */
+void
+gdata_query_executor_query_async (GDataQueryExecutor *self, GDataService *service, GDataAuthorizationDomain *domain, const gchar *feed_uri,
+                                  GDataQuery *query, GType entry_type, GCancellable *cancellable,
+                                  GDataQueryProgressCallback progress_callback, gpointer progress_user_data,
+                                  GDestroyNotify destroy_progress_user_data, GAsyncReadyCallback callback, gpointer user_data)
+{
+	GDataQueryExecutorPrivate *priv;
+	GTask *task;
+	QueryData *data;
+	GDataAuthorizer *authorizer;
+	gpointer owner;
+	GQueue *lane;
+
+	g_return_if_fail (GDATA_IS_QUERY_EXECUTOR (self));
+	g_return_if_fail (GDATA_IS_SERVICE (service));
+	g_return_if_fail (domain == NULL || GDATA_IS_AUTHORIZATION_DOMAIN (domain));
+	g_return_if_fail (feed_uri != NULL);
+	g_return_if_fail (g_type_is_a (entry_type, GDATA_TYPE_ENTRY));
+	g_return_if_fail (cancellable == NULL || G_IS_CANCELLABLE (cancellable));
+	g_return_if_fail (callback != NULL);
+
+	priv = self->priv;
+
+	data = g_slice_new (QueryData);
+	data->service = g_object_ref (service);
+	data->domain = (domain != NULL) ? g_object_ref (domain) : NULL;
+	data->feed_uri = g_strdup (feed_uri);
+	data->query = (query != NULL) ? g_object_ref (query) : NULL;
+	data->entry_type = entry_type;
+	data->progress_callback = progress_callback;
+	data->progress_user_data = progress_user_data;
+	data->destroy_progress_user_data = destroy_progress_user_data;
+	data->cancelled_source = NULL;
+
+	/* Queries are scheduled fairly between accounts, which are identified by their authorizers. Services without an authorizer are each treated
+	 * as their own account. */
+	authorizer = gdata_service_get_authorizer (service);
+	owner = (authorizer != NULL) ? (gpointer) authorizer : (gpointer) service;
+	data->owner = owner;
+
+	task = g_task_new (self, cancellable, callback, user_data);
+	g_task_set_source_tag (task, gdata_query_executor_query_async);
+	g_task_set_task_data (task, data, (GDestroyNotify) query_data_free);
+
+	/* Watch for cancellation from the query's own main context, rather than from a GCancellable::cancelled handler, so that the query can be
+	 * finished without worrying about which thread cancelled it. This has to be set up before the query's queued, as run_query_cb() may take it
+	 * straight away. */
+	if (cancellable != NULL) {
+		data->cancelled_source = g_cancellable_source_new (cancellable);
+		g_task_attach_source (task, data->cancelled_source, (GSourceFunc) query_cancelled_cb);
+	}
+
+	g_mutex_lock (&(priv->mutex));
+
+	lane = g_hash_table_lookup (priv->lanes, owner);
+	if (lane == NULL) {
+		lane = g_queue_new ();
+		g_hash_table_insert (priv->lanes, owner, lane);
+		g_queue_push_tail (&(priv->ready_lanes), owner);
+	}
+
+	g_queue_push_tail (lane, task);
+
+	g_mutex_unlock (&(priv->mutex));
+
+	/* Allow one more query to run; run_query_cb() picks which */
+	g_thread_pool_push (priv->pool, self, NULL);
+}
+
+/**
+ * gdata_query_executor_query_finish:
+ * @self: a #GDataQueryExecutor
+ * @async_result: a #GAsyncResult
+ * @error: a #GError, or %NULL
+ *
+ * Finishes an asynchronous query started with gdata_query_executor_query_async().
+ *
+ * Return value: (transfer full): a #GDataFeed of query results, or %NULL; unref with g_object_unref()
+ *
+ * Since: 0.19.0
+ */
+GDataFeed *
+gdata_query_executor_query_finish (GDataQueryExecutor *self, GAsyncResult *async_result, GError **error)
+{
+	g_return_val_if_fail (GDATA_IS_QUERY_EXECUTOR (self), NULL);
+	g_return_val_if_fail (G_IS_ASYNC_RESULT (async_result), NULL);
+	g_return_val_if_fail (error == NULL || *error == NULL, NULL);
+	g_return_val_if_fail (g_task_is_valid (async_result, self), NULL);
+	g_return_val_if_fail (g_async_result_is_tagged (async_result, gdata_query_executor_query_async), NULL);
+
+	return g_task_propagate_pointer (G_TASK (async_result), error);
+}
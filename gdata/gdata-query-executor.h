@@ -0,0 +1,92 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 8; tab-width: 8 -*- */
+/*
+ * GData Client
+ *
+ * GData Client is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * GData Client is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GData Client.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GDATA_QUERY_EXECUTOR_H
+#define GDATA_QUERY_EXECUTOR_H
+
+#include <glib.h>
+#include <glib-object.h>
+#include <gio/gio.h>
+
+#include <gdata/gdata-service.h>
+#include <gdata/gdata-authorization-domain.h>
+#include <gdata/gdata-feed.h>
+#include <gdata/gdata-query.h>
+
+G_BEGIN_DECLS
+
+#define GDATA_TYPE_QUERY_EXECUTOR		(gdata_query_executor_get_type ())
+#define GDATA_QUERY_EXECUTOR(o)			(G_TYPE_CHECK_INSTANCE_CAST ((o), GDATA_TYPE_QUERY_EXECUTOR, GDataQueryExecutor))
+#define GDATA_QUERY_EXECUTOR_CLASS(k)		(G_TYPE_CHECK_CLASS_CAST((k), GDATA_TYPE_QUERY_EXECUTOR, GDataQueryExecutorClass))
+#define GDATA_IS_QUERY_EXECUTOR(o)		(G_TYPE_CHECK_INSTANCE_TYPE ((o), GDATA_TYPE_QUERY_EXECUTOR))
+#define GDATA_IS_QUERY_EXECUTOR_CLASS(k)	(G_TYPE_CHECK_CLASS_TYPE ((k), GDATA_TYPE_QUERY_EXECUTOR))
+#define GDATA_QUERY_EXECUTOR_GET_CLASS(o)	(G_TYPE_INSTANCE_GET_CLASS ((o), GDATA_TYPE_QUERY_EXECUTOR, GDataQueryExecutorClass))
+
+typedef struct _GDataQueryExecutorPrivate	GDataQueryExecutorPrivate;
+
+/**
+ * GDataQueryExecutor:
+ *
+ * All the fields in the #GDataQueryExecutor structure are private and should never be accessed directly.
+ *
+ * Since: 0.19.0
+ */
+typedef struct {
+	GObject parent;
+	GDataQueryExecutorPrivate *priv;
+} GDataQueryExecutor;
+
+/**
+ * GDataQueryExecutorClass:
+ *
+ * All the fields in the #GDataQueryExecutorClass structure are private and should never be accessed directly.
+ *
+ * Since: 0.19.0
+ */
+typedef struct {
+	/*< private >*/
+	GObjectClass parent;
+
+	/*< private >*/
+	/* Padding for future expansion */
+	void (*_g_reserved0) (void);
+	void (*_g_reserved1) (void);
+	void (*_g_reserved2) (void);
+	void (*_g_reserved3) (void);
+} GDataQueryExecutorClass;
+
+GType gdata_query_executor_get_type (void) G_GNUC_CONST;
+G_DEFINE_AUTOPTR_CLEANUP_FUNC (GDataQueryExecutor, g_object_unref)
+
+GDataQueryExecutor *gdata_query_executor_new (guint max_concurrent_queries) G_GNUC_WARN_UNUSED_RESULT G_GNUC_MALLOC;
+
+guint gdata_query_executor_get_max_concurrent_queries (GDataQueryExecutor *self) G_GNUC_PURE;
+gdouble gdata_query_executor_get_max_queries_per_second (GDataQueryExecutor *self);
+void gdata_query_executor_set_max_queries_per_second (GDataQueryExecutor *self, gdouble max_queries_per_second);
+
+void gdata_query_executor_add_service (GDataQueryExecutor *self, GDataService *service);
+
+void gdata_query_executor_query_async (GDataQueryExecutor *self, GDataService *service, GDataAuthorizationDomain *domain, const gchar *feed_uri,
+                                       GDataQuery *query, GType entry_type, GCancellable *cancellable,
+                                       GDataQueryProgressCallback progress_callback, gpointer progress_user_data,
+                                       GDestroyNotify destroy_progress_user_data, GAsyncReadyCallback callback, gpointer user_data);
+GDataFeed *gdata_query_executor_query_finish (GDataQueryExecutor *self, GAsyncResult *async_result, GError **error) G_GNUC_WARN_UNUSED_RESULT;
+
+G_END_DECLS
+
+#endif /* !GDATA_QUERY_EXECUTOR_H */
@@ -68,6 +68,10 @@ struct _GDataQueryPrivate {
 	gboolean is_strict;
 	guint max_results;
 
+	/* Whether get_query_uri() appends updated_min as the updated-min parameter. Subclasses for services which name the parameter differently
+	 * turn this off in their init() vfunc, and append it themselves. */
+	gboolean append_updated_min;
+
 	/* Pagination management. The type of pagination is set as
 	 * pagination_type, and should be set in the init() vfunc implementation
 	 * of any class derived from GDataQuery. It defaults to
@@ -308,6 +312,7 @@ gdata_query_init (GDataQuery *self)
 	self->priv->updated_max = -1;
 	self->priv->published_min = -1;
 	self->priv->published_max = -1;
+	self->priv->append_updated_min = TRUE;
 
 	_gdata_query_set_pagination_type (self, GDATA_QUERY_PAGINATION_INDEXED);
 }
@@ -455,7 +460,7 @@ get_query_uri (GDataQuery *self, const gchar *feed_uri, GString *query_uri, gboo
 		g_string_append_uri_escaped (query_uri, priv->author, NULL, FALSE);
 	}
 
-	if (priv->updated_min != -1) {
+	if (priv->updated_min != -1 && priv->append_updated_min == TRUE) {
 		gchar *updated_min;
 
 		APPEND_SEP
@@ -1075,6 +1080,13 @@ _gdata_query_set_pagination_type (GDataQuery               *self,
 	self->priv->pagination_type = type;
 }
 
+void
+_gdata_query_set_append_updated_min (GDataQuery *self, gboolean append_updated_min)
+{
+	g_return_if_fail (GDATA_IS_QUERY (self));
+	self->priv->append_updated_min = append_updated_min;
+}
+
 void
 _gdata_query_set_next_page_token (GDataQuery  *self,
                                   const gchar *next_page_token)
@@ -60,6 +60,7 @@ gdata_service_error_quark (void)
 	return g_quark_from_static_string ("gdata-service-error-quark");
 }
 
+static void gdata_service_constructed (GObject *object);
 static void gdata_service_dispose (GObject *object);
 static void gdata_service_finalize (GObject *object);
 static void gdata_service_get_property (GObject *object, guint property_id, GValue *value, GParamSpec *pspec);
@@ -78,6 +79,8 @@ real_parse_feed (GDataService *self,
                  gpointer progress_user_data,
                  GError **error);
 static void notify_timeout_cb (GObject *gobject, GParamSpec *pspec, GObject *self);
+static void connect_session (GDataService *self);
+static void disconnect_session (GDataService *self);
 static void debug_handler (const char *log_domain, GLogLevelFlags log_level, const char *message, gpointer user_data);
 static void soup_log_printer (SoupLogger *logger, SoupLoggerLogLevel level, char direction, const char *data, gpointer user_data);
 
@@ -87,9 +90,17 @@ static GDataFeed *__gdata_service_query (GDataService *self, GDataAuthorizationD
 
 struct _GDataServicePrivate {
 	SoupSession *session;
+	GBinding *proxy_resolver_binding; /* owned by the session and the service */
 	gchar *locale;
 	GDataAuthorizer *authorizer;
 	GProxyResolver *proxy_resolver;
+	guint timeout; /* only used until the session is set up in constructed() */
+
+	/* Request metrics reporting; requests may complete in any thread, so these are protected by the mutex */
+	GMutex metrics_mutex;
+	GDataServiceRequestMetricsCallback metrics_callback;
+	gpointer metrics_user_data;
+	GDestroyNotify metrics_destroy_user_data;
 };
 
 enum {
@@ -97,6 +108,7 @@ enum {
 	PROP_LOCALE,
 	PROP_AUTHORIZER,
 	PROP_PROXY_RESOLVER,
+	PROP_SESSION,
 };
 
 G_DEFINE_TYPE_WITH_PRIVATE (GDataService, gdata_service, G_TYPE_OBJECT)
@@ -108,6 +120,7 @@ gdata_service_class_init (GDataServiceClass *klass)
 
 	gobject_class->set_property = gdata_service_set_property;
 	gobject_class->get_property = gdata_service_get_property;
+	gobject_class->constructed = gdata_service_constructed;
 	gobject_class->dispose = gdata_service_dispose;
 	gobject_class->finalize = gdata_service_finalize;
 
@@ -191,22 +204,92 @@ gdata_service_class_init (GDataServiceClass *klass)
 	                                                      "Proxy Resolver", "A GProxyResolver used to determine a proxy URI.",
 	                                                      G_TYPE_PROXY_RESOLVER,
 	                                                      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+	/**
+	 * GDataService:session:
+	 *
+	 * The #SoupSession used for all of the service's network requests. If this is %NULL at construction time, the service creates a session of its
+	 * own.
+	 *
+	 * A session may be shared between several services, and with the #GDataOAuth2Authorizer:session of the authorizer they use, so that API calls
+	 * and token refreshes are served from one pool of connections. Services and authorizers sharing a session share its #GDataService:timeout and
+	 * #GDataService:proxy-resolver settings: changing either on one of them changes it on all of them.
+	 *
+	 * <example>
+	 *	<title>Sharing Connections Between an Authorizer and Services</title>
+	 *	<programlisting>
+	 *	GDataOAuth2Authorizer *authorizer;
+	 *	GDataService *calendar_service, *tasks_service;
+	 *	SoupSession *session;
+	 *
+	 *	authorizer = gdata_oauth2_authorizer_new (client_id, client_secret, redirect_uri, GDATA_TYPE_CALENDAR_SERVICE);
+	 *	g_object_get (authorizer, "session", &session, NULL);
+	 *
+	 *	calendar_service = g_object_new (GDATA_TYPE_CALENDAR_SERVICE, "authorizer", authorizer, "session", session, NULL);
+	 *	tasks_service = g_object_new (GDATA_TYPE_TASKS_SERVICE, "authorizer", authorizer, "session", session, NULL);
+	 *
+	 *	g_object_unref (session);
+	 *	</programlisting>
+	 * </example>
+	 *
+	 * Since: 0.19.0
+	 */
+	g_object_class_install_property (gobject_class, PROP_SESSION,
+	                                 g_param_spec_object ("session",
+	                                                      "Session", "The SoupSession used for network requests.",
+	                                                      SOUP_TYPE_SESSION,
+	                                                      G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS));
 }
 
 static void
 gdata_service_init (GDataService *self)
 {
 	self->priv = gdata_service_get_instance_private (self);
-	self->priv->session = _gdata_service_build_session ();
+	g_mutex_init (&self->priv->metrics_mutex);
 
 	/* Log handling for all message types except debug */
 	g_log_set_handler (G_LOG_DOMAIN, G_LOG_LEVEL_CRITICAL | G_LOG_LEVEL_ERROR | G_LOG_LEVEL_INFO | G_LOG_LEVEL_MESSAGE | G_LOG_LEVEL_WARNING, (GLogFunc) debug_handler, self);
+}
+
+static void
+gdata_service_constructed (GObject *object)
+{
+	GDataService *self = GDATA_SERVICE (object);
+
+	/* Chain up to the parent class */
+	G_OBJECT_CLASS (gdata_service_parent_class)->constructed (object);
+
+	/* Build our own session unless we were given one to share */
+	if (self->priv->session == NULL)
+		self->priv->session = _gdata_service_build_session ();
+
+	/* Apply any timeout or proxy resolver set before the session existed, so they aren't overwritten by the session's own */
+	if (self->priv->timeout != 0)
+		g_object_set (self->priv->session, SOUP_SESSION_TIMEOUT, self->priv->timeout, NULL);
+	if (self->priv->proxy_resolver != NULL)
+		g_object_set (self->priv->session, SOUP_SESSION_PROXY_RESOLVER, self->priv->proxy_resolver, NULL);
+
+	connect_session (self);
+}
 
+static void
+connect_session (GDataService *self)
+{
 	/* Proxy the SoupSession's timeout property */
 	g_signal_connect (self->priv->session, "notify::timeout", (GCallback) notify_timeout_cb, self);
 
 	/* Keep our GProxyResolver synchronized with SoupSession's. */
-	g_object_bind_property (self->priv->session, "proxy-resolver", self, "proxy-resolver", G_BINDING_BIDIRECTIONAL | G_BINDING_SYNC_CREATE);
+	self->priv->proxy_resolver_binding = g_object_bind_property (self->priv->session, "proxy-resolver", self, "proxy-resolver",
+	                                                             G_BINDING_BIDIRECTIONAL | G_BINDING_SYNC_CREATE);
+}
+
+static void
+disconnect_session (GDataService *self)
+{
+	/* The session may be shared with other services (see gdata_query_executor_add_service()), so it could outlive us */
+	g_signal_handlers_disconnect_by_func (self->priv->session, notify_timeout_cb, self);
+	g_binding_unbind (self->priv->proxy_resolver_binding);
+	self->priv->proxy_resolver_binding = NULL;
 }
 
 static void
@@ -218,8 +301,10 @@ gdata_service_dispose (GObject *object)
 		g_object_unref (priv->authorizer);
 	priv->authorizer = NULL;
 
-	if (priv->session != NULL)
+	if (priv->session != NULL) {
+		disconnect_session (GDATA_SERVICE (object));
 		g_object_unref (priv->session);
+	}
 	priv->session = NULL;
 
 	g_clear_object (&priv->proxy_resolver);
@@ -235,6 +320,10 @@ gdata_service_finalize (GObject *object)
 
 	g_free (priv->locale);
 
+	if (priv->metrics_destroy_user_data != NULL)
+		priv->metrics_destroy_user_data (priv->metrics_user_data);
+	g_mutex_clear (&priv->metrics_mutex);
+
 	/* Chain up to the parent class */
 	G_OBJECT_CLASS (gdata_service_parent_class)->finalize (object);
 }
@@ -257,6 +346,9 @@ gdata_service_get_property (GObject *object, guint property_id, GValue *value, G
 		case PROP_PROXY_RESOLVER:
 			g_value_set_object (value, priv->proxy_resolver);
 			break;
+		case PROP_SESSION:
+			g_value_set_object (value, priv->session);
+			break;
 		default:
 			/* We don't have any other property... */
 			G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
@@ -280,6 +372,10 @@ gdata_service_set_property (GObject *object, guint property_id, const GValue *va
 		case PROP_PROXY_RESOLVER:
 			gdata_service_set_proxy_resolver (GDATA_SERVICE (object), g_value_get_object (value));
 			break;
+		case PROP_SESSION:
+			/* Construct only */
+			GDATA_SERVICE (object)->priv->session = g_value_dup_object (value);
+			break;
 		default:
 			/* We don't have any other property... */
 			G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
@@ -678,6 +774,203 @@ _gdata_service_actually_send_message (SoupSession *session, SoupMessage *message
 	g_object_unref (session);
 }
 
+/* Metrics for a single request, built up by _gdata_service_send_message() and stored on the #SoupMessage. They're reported to the service's
+ * #GDataServiceRequestMetricsCallback when the message is finalised, which is after its response has been parsed. */
+typedef struct {
+	GDataService *service; /* owned */
+	GDataServiceRequestMetrics metrics;
+	gchar *method;
+	gchar *uri;
+
+	/* Monotonic start times for the phases currently in progress */
+	gint64 start_time;
+	gint64 attempt_start_time;
+	gint64 dns_start_time;
+	gint64 connect_start_time;
+	gint64 tls_start_time;
+} RequestMetricsData;
+
+static void
+request_metrics_data_report_and_free (RequestMetricsData *data)
+{
+	GDataServicePrivate *priv = data->service->priv;
+	GDataServiceRequestMetricsCallback callback;
+	gpointer user_data;
+
+	data->metrics.method = data->method;
+	data->metrics.uri = data->uri;
+
+	/* Only log the timings alongside the full network logs, since there's one line for every request */
+	if (_gdata_service_get_log_level () >= GDATA_LOG_FULL) {
+		g_debug ("Request metrics: %s %s: status %u, %" G_GSIZE_FORMAT " bytes sent, %" G_GSIZE_FORMAT " bytes received, "
+		         "%u redirects, %u authorization retries, DNS %" G_GINT64_FORMAT " µs, connect %" G_GINT64_FORMAT " µs, "
+		         "TLS %" G_GINT64_FORMAT " µs, TTFB %" G_GINT64_FORMAT " µs, total %" G_GINT64_FORMAT " µs, parse %" G_GINT64_FORMAT " µs",
+		         data->method, data->uri, data->metrics.status, data->metrics.request_bytes, data->metrics.response_bytes,
+		         data->metrics.redirects, data->metrics.authorization_retries, data->metrics.dns_time, data->metrics.connect_time,
+		         data->metrics.tls_time, data->metrics.time_to_first_byte, data->metrics.total_time, data->metrics.parse_time);
+	}
+
+	g_mutex_lock (&priv->metrics_mutex);
+	callback = priv->metrics_callback;
+	user_data = priv->metrics_user_data;
+	g_mutex_unlock (&priv->metrics_mutex);
+
+	if (callback != NULL)
+		callback (data->service, &data->metrics, user_data);
+
+	g_clear_object (&data->metrics.authorization_domain);
+	g_free (data->method);
+	g_free (data->uri);
+	g_object_unref (data->service);
+
+	g_slice_free (RequestMetricsData, data);
+}
+
+static void
+add_phase_time (gint64 *phase_time, gint64 start_time)
+{
+	gint64 duration = g_get_monotonic_time () - start_time;
+
+	*phase_time = (*phase_time < 0) ? duration : *phase_time + duration;
+}
+
+static void
+request_metrics_network_event_cb (SoupMessage *message, GSocketClientEvent event, GIOStream *connection, RequestMetricsData *data)
+{
+	switch (event) {
+		case G_SOCKET_CLIENT_RESOLVING:
+			data->dns_start_time = g_get_monotonic_time ();
+			break;
+		case G_SOCKET_CLIENT_RESOLVED:
+			add_phase_time (&data->metrics.dns_time, data->dns_start_time);
+			break;
+		case G_SOCKET_CLIENT_CONNECTING:
+			data->connect_start_time = g_get_monotonic_time ();
+			break;
+		case G_SOCKET_CLIENT_CONNECTED:
+			add_phase_time (&data->metrics.connect_time, data->connect_start_time);
+			break;
+		case G_SOCKET_CLIENT_TLS_HANDSHAKING:
+			data->tls_start_time = g_get_monotonic_time ();
+			break;
+		case G_SOCKET_CLIENT_TLS_HANDSHAKED:
+			add_phase_time (&data->metrics.tls_time, data->tls_start_time);
+			break;
+		default:
+			/* Not interested */
+			break;
+	}
+}
+
+static void
+request_metrics_got_headers_cb (SoupMessage *message, RequestMetricsData *data)
+{
+	data->metrics.time_to_first_byte = g_get_monotonic_time () - data->attempt_start_time;
+}
+
+/* Returns %NULL if nobody is interested in the metrics, so that requests don't pay for them by default. */
+static RequestMetricsData *
+request_metrics_data_new (GDataService *self, SoupMessage *message)
+{
+	RequestMetricsData *data;
+	GDataAuthorizationDomain *domain;
+	gpointer operation_type;
+	gboolean wanted;
+	SoupURI *uri;
+
+	g_mutex_lock (&self->priv->metrics_mutex);
+	wanted = (self->priv->metrics_callback != NULL) ? TRUE : FALSE;
+	g_mutex_unlock (&self->priv->metrics_mutex);
+
+	if (wanted == FALSE && _gdata_service_get_log_level () < GDATA_LOG_FULL)
+		return NULL;
+
+	data = g_slice_new0 (RequestMetricsData);
+	data->service = g_object_ref (self);
+	data->method = g_strdup (message->method);
+
+	/* Strip the query string so that the URI can be used as an aggregation key, and so that we don't report any credentials it contains */
+	uri = soup_uri_copy (soup_message_get_uri (message));
+	soup_uri_set_query (uri, NULL);
+	data->uri = soup_uri_to_string (uri, FALSE);
+	soup_uri_free (uri);
+
+	/* Callers can override the operation type if it can't be inferred from the method; see gdata-batch-operation.c */
+	operation_type = g_object_get_data (G_OBJECT (message), "gdata-operation-type");
+	if (operation_type != NULL)
+		data->metrics.operation_type = GPOINTER_TO_UINT (operation_type);
+	else if (strcmp (message->method, SOUP_METHOD_POST) == 0)
+		data->metrics.operation_type = GDATA_OPERATION_INSERTION;
+	else if (strcmp (message->method, SOUP_METHOD_PUT) == 0)
+		data->metrics.operation_type = GDATA_OPERATION_UPDATE;
+	else if (strcmp (message->method, SOUP_METHOD_DELETE) == 0)
+		data->metrics.operation_type = GDATA_OPERATION_DELETION;
+	else
+		data->metrics.operation_type = GDATA_OPERATION_QUERY;
+
+	domain = g_object_get_data (G_OBJECT (message), "gdata-authorization-domain");
+	data->metrics.authorization_domain = (domain != NULL) ? g_object_ref (domain) : NULL;
+
+	data->metrics.dns_time = -1;
+	data->metrics.connect_time = -1;
+	data->metrics.tls_time = -1;
+	data->metrics.time_to_first_byte = -1;
+	data->metrics.parse_time = -1;
+
+	data->start_time = g_get_monotonic_time ();
+
+	g_signal_connect (message, "network-event", (GCallback) request_metrics_network_event_cb, data);
+	g_signal_connect (message, "got-headers", (GCallback) request_metrics_got_headers_cb, data);
+
+	return data;
+}
+
+static void
+send_message_with_metrics (GDataService *self, SoupMessage *message, GCancellable *cancellable, RequestMetricsData *metrics, GError **error)
+{
+	if (metrics != NULL) {
+		metrics->attempt_start_time = g_get_monotonic_time ();
+		metrics->metrics.request_bytes += message->request_body->length;
+	}
+
+	_gdata_service_actually_send_message (self->priv->session, message, cancellable, error);
+}
+
+static void
+request_metrics_data_finish (RequestMetricsData *data, SoupMessage *message)
+{
+	g_signal_handlers_disconnect_by_data (message, data);
+
+	data->metrics.status = message->status_code;
+	data->metrics.response_bytes = (message->response_body != NULL) ? message->response_body->length : 0;
+	data->metrics.total_time = g_get_monotonic_time () - data->start_time;
+
+	/* Report the metrics once the caller has finished with the message, so that parsing time can be included. */
+	g_object_set_data_full (G_OBJECT (message), "gdata-request-metrics", data, (GDestroyNotify) request_metrics_data_report_and_free);
+}
+
+/*
+ * _gdata_service_set_message_parse_time:
+ * @message: a #SoupMessage which has been sent with _gdata_service_send_message()
+ * @parse_time: the time spent parsing the response to @message, in microseconds
+ *
+ * Records how long it took to parse the response to @message, for inclusion in the #GDataServiceRequestMetrics reported for it. This is a no-op if
+ * metrics aren't being collected.
+ *
+ * Since: 0.19.0
+ */
+void
+_gdata_service_set_message_parse_time (SoupMessage *message, gint64 parse_time)
+{
+	RequestMetricsData *data;
+
+	g_return_if_fail (SOUP_IS_MESSAGE (message));
+
+	data = g_object_get_data (G_OBJECT (message), "gdata-request-metrics");
+	if (data != NULL)
+		data->metrics.parse_time = parse_time;
+}
+
 guint
 _gdata_service_send_message (GDataService *self, SoupMessage *message, GCancellable *cancellable, GError **error)
 {
@@ -687,9 +980,12 @@ _gdata_service_send_message (GDataService *self, SoupMessage *message, GCancella
 	 *
 	 * Copyright (C) 1999-2008 Novell, Inc. (www.novell.com)
 	 */
+	RequestMetricsData *metrics;
+
+	metrics = request_metrics_data_new (self, message);
 
 	soup_message_set_flags (message, SOUP_MESSAGE_NO_REDIRECT);
-	_gdata_service_actually_send_message (self->priv->session, message, cancellable, error);
+	send_message_with_metrics (self, message, cancellable, metrics, error);
 	soup_message_set_flags (message, 0);
 
 	/* Handle redirections specially so we don't lose our custom headers when making the second request */
@@ -698,6 +994,8 @@ _gdata_service_send_message (GDataService *self, SoupMessage *message, GCancella
 		const gchar *new_location;
 
 		new_location = soup_message_headers_get_one (message->response_headers, "Location");
+		if (new_location == NULL && metrics != NULL)
+			request_metrics_data_finish (metrics, message);
 		g_return_val_if_fail (new_location != NULL, SOUP_STATUS_NONE);
 
 		new_uri = soup_uri_new_with_base (soup_message_get_uri (message), new_location);
@@ -707,6 +1005,10 @@ _gdata_service_send_message (GDataService *self, SoupMessage *message, GCancella
 			             /* Translators: the parameter is the URI which is invalid. */
 			             _("Invalid redirect URI: %s"), uri_string);
 			g_free (uri_string);
+
+			if (metrics != NULL)
+				request_metrics_data_finish (metrics, message);
+
 			return SOUP_STATUS_NONE;
 		}
 
@@ -717,7 +1019,10 @@ _gdata_service_send_message (GDataService *self, SoupMessage *message, GCancella
 		soup_uri_free (new_uri);
 
 		/* Send the message again */
-		_gdata_service_actually_send_message (self->priv->session, message, cancellable, error);
+		if (metrics != NULL)
+			metrics->metrics.redirects++;
+
+		send_message_with_metrics (self, message, cancellable, metrics, error);
 	}
 
 	/* Not authorised, or authorisation has expired. If we were authorised in the first place, attempt to refresh the authorisation and
@@ -740,11 +1045,17 @@ _gdata_service_send_message (GDataService *self, SoupMessage *message, GCancella
 			gdata_authorizer_process_request (authorizer, domain, message);
 
 			/* Send the message again */
+			if (metrics != NULL)
+				metrics->metrics.authorization_retries++;
+
 			g_clear_error (error);
-			_gdata_service_actually_send_message (self->priv->session, message, cancellable, error);
+			send_message_with_metrics (self, message, cancellable, metrics, error);
 		}
 	}
 
+	if (metrics != NULL)
+		request_metrics_data_finish (metrics, message);
+
 	return message->status_code;
 }
 
@@ -922,6 +1233,7 @@ __gdata_service_query (GDataService *self, GDataAuthorizationDomain *domain, con
 	GDataServiceClass *klass;
 	SoupMessage *message;
 	GDataFeed *feed;
+	gint64 parse_start_time;
 
 	klass = GDATA_SERVICE_GET_CLASS (self);
 
@@ -941,9 +1253,11 @@ __gdata_service_query (GDataService *self, GDataAuthorizationDomain *domain, con
 	g_assert (klass->parse_feed != NULL);
 
 	/* Parse the response. */
+	parse_start_time = g_get_monotonic_time ();
 	feed = klass->parse_feed (self, domain, query, entry_type,
 	                          message, cancellable, progress_callback,
 	                          progress_user_data, error);
+	_gdata_service_set_message_parse_time (message, g_get_monotonic_time () - parse_start_time);
 
 	g_object_unref (message);
 
@@ -1095,6 +1409,7 @@ gdata_service_query_single_entry (GDataService *self, GDataAuthorizationDomain *
 	SoupMessage *message;
 	SoupMessageHeaders *headers;
 	const gchar *content_type;
+	gint64 parse_start_time;
 
 	g_return_val_if_fail (GDATA_IS_SERVICE (self), NULL);
 	g_return_val_if_fail (domain == NULL || GDATA_IS_AUTHORIZATION_DOMAIN (domain), NULL);
@@ -1122,12 +1437,15 @@ gdata_service_query_single_entry (GDataService *self, GDataAuthorizationDomain *
 	headers = message->response_headers;
 	content_type = soup_message_headers_get_content_type (headers, NULL);
 
+	parse_start_time = g_get_monotonic_time ();
+
 	if (g_strcmp0 (content_type, "application/json") == 0) {
 		entry = GDATA_ENTRY (gdata_parsable_new_from_json (entry_type, message->response_body->data, message->response_body->length, error));
 	} else {
 		entry = GDATA_ENTRY (gdata_parsable_new_from_xml (entry_type, message->response_body->data, message->response_body->length, error));
 	}
 
+	_gdata_service_set_message_parse_time (message, g_get_monotonic_time () - parse_start_time);
 	g_object_unref (message);
 	g_type_class_unref (klass);
 
@@ -1383,8 +1701,11 @@ gdata_service_insert_entry (GDataService *self, GDataAuthorizationDomain *domain
 	GDataEntry *updated_entry;
 	SoupMessage *message;
 	gchar *upload_data;
+	gsize upload_length;
+	gboolean is_json;
 	guint status;
 	GDataParsableClass *klass;
+	gint64 parse_start_time;
 
 	g_return_val_if_fail (GDATA_IS_SERVICE (self), NULL);
 	g_return_val_if_fail (domain == NULL || GDATA_IS_AUTHORIZATION_DOMAIN (domain), NULL);
@@ -1404,13 +1725,9 @@ gdata_service_insert_entry (GDataService *self, GDataAuthorizationDomain *domain
 	/* Append the data */
 	klass = GDATA_PARSABLE_GET_CLASS (entry);
 	g_assert (klass->get_content_type != NULL);
-	if (g_strcmp0 (klass->get_content_type (), "application/json") == 0) {
-		upload_data = gdata_parsable_get_json (GDATA_PARSABLE (entry));
-		soup_message_set_request (message, "application/json", SOUP_MEMORY_TAKE, upload_data, strlen (upload_data));
-	} else {
-		upload_data = gdata_parsable_get_xml (GDATA_PARSABLE (entry));
-		soup_message_set_request (message, "application/atom+xml", SOUP_MEMORY_TAKE, upload_data, strlen (upload_data));
-	}
+	is_json = (g_strcmp0 (klass->get_content_type (), "application/json") == 0);
+	upload_data = _gdata_parsable_serialise (GDATA_PARSABLE (entry), &upload_length);
+	soup_message_set_request (message, is_json ? "application/json" : "application/atom+xml", SOUP_MEMORY_TAKE, upload_data, upload_length);
 
 	/* Send the message */
 	status = _gdata_service_send_message (self, message, cancellable, error);
@@ -1431,6 +1748,7 @@ gdata_service_insert_entry (GDataService *self, GDataAuthorizationDomain *domain
 
 	/* Parse the XML or JSON according to GDataEntry type; create and return a new GDataEntry of the same type as @entry */
 	g_assert (message->response_body->data != NULL);
+	parse_start_time = g_get_monotonic_time ();
 	if (g_strcmp0 (klass->get_content_type (), "application/json") == 0) {
 		updated_entry = GDATA_ENTRY (gdata_parsable_new_from_json (G_OBJECT_TYPE (entry), message->response_body->data,
 		                             message->response_body->length, error));
@@ -1438,6 +1756,7 @@ gdata_service_insert_entry (GDataService *self, GDataAuthorizationDomain *domain
 		updated_entry = GDATA_ENTRY (gdata_parsable_new_from_xml (G_OBJECT_TYPE (entry), message->response_body->data,
 		                             message->response_body->length, error));
 	}
+	_gdata_service_set_message_parse_time (message, g_get_monotonic_time () - parse_start_time);
 	g_object_unref (message);
 
 	return updated_entry;
@@ -1575,8 +1894,11 @@ gdata_service_update_entry (GDataService *self, GDataAuthorizationDomain *domain
 	GDataLink *_link;
 	SoupMessage *message;
 	gchar *upload_data;
+	gsize upload_length;
+	gboolean is_json;
 	guint status;
 	GDataParsableClass *klass;
+	gint64 parse_start_time;
 
 	g_return_val_if_fail (GDATA_IS_SERVICE (self), NULL);
 	g_return_val_if_fail (domain == NULL || GDATA_IS_AUTHORIZATION_DOMAIN (domain), NULL);
@@ -1587,21 +1909,14 @@ gdata_service_update_entry (GDataService *self, GDataAuthorizationDomain *domain
 	/* Append the data */
 	klass = GDATA_PARSABLE_GET_CLASS (entry);
 	g_assert (klass->get_content_type != NULL);
-	if (g_strcmp0 (klass->get_content_type (), "application/json") == 0) {
-		/* Get the edit URI */
-		_link = gdata_entry_look_up_link (entry, GDATA_LINK_SELF);
-		g_assert (_link != NULL);
-		message = _gdata_service_build_message (self, domain, SOUP_METHOD_PUT, gdata_link_get_uri (_link), gdata_entry_get_etag (entry), TRUE);
-		upload_data = gdata_parsable_get_json (GDATA_PARSABLE (entry));
-		soup_message_set_request (message, "application/json", SOUP_MEMORY_TAKE, upload_data, strlen (upload_data));
-	} else {
-		/* Get the edit URI */
-		_link = gdata_entry_look_up_link (entry, GDATA_LINK_EDIT);
-		g_assert (_link != NULL);
-		message = _gdata_service_build_message (self, domain, SOUP_METHOD_PUT, gdata_link_get_uri (_link), gdata_entry_get_etag (entry), TRUE);
-		upload_data = gdata_parsable_get_xml (GDATA_PARSABLE (entry));
-		soup_message_set_request (message, "application/atom+xml", SOUP_MEMORY_TAKE, upload_data, strlen (upload_data));
-	}
+	is_json = (g_strcmp0 (klass->get_content_type (), "application/json") == 0);
+
+	/* Get the edit URI */
+	_link = gdata_entry_look_up_link (entry, is_json ? GDATA_LINK_SELF : GDATA_LINK_EDIT);
+	g_assert (_link != NULL);
+	message = _gdata_service_build_message (self, domain, SOUP_METHOD_PUT, gdata_link_get_uri (_link), gdata_entry_get_etag (entry), TRUE);
+	upload_data = _gdata_parsable_serialise (GDATA_PARSABLE (entry), &upload_length);
+	soup_message_set_request (message, is_json ? "application/json" : "application/atom+xml", SOUP_MEMORY_TAKE, upload_data, upload_length);
 
 	/* Send the message */
 	status = _gdata_service_send_message (self, message, cancellable, error);
@@ -1621,6 +1936,7 @@ gdata_service_update_entry (GDataService *self, GDataAuthorizationDomain *domain
 	}
 
 	/* Parse the XML; create and return a new GDataEntry of the same type as @entry */
+	parse_start_time = g_get_monotonic_time ();
 	if (g_strcmp0 (klass->get_content_type (), "application/json") == 0) {
 		updated_entry = GDATA_ENTRY (gdata_parsable_new_from_json (G_OBJECT_TYPE (entry), message->response_body->data,
 		                         message->response_body->length, error));
@@ -1628,6 +1944,7 @@ gdata_service_update_entry (GDataService *self, GDataAuthorizationDomain *domain
 		updated_entry = GDATA_ENTRY (gdata_parsable_new_from_xml (G_OBJECT_TYPE (entry), message->response_body->data,
 		                             message->response_body->length, error));
 	}
+	_gdata_service_set_message_parse_time (message, g_get_monotonic_time () - parse_start_time);
 	g_object_unref (message);
 
 	return updated_entry;
@@ -1871,6 +2188,10 @@ gdata_service_get_timeout (GDataService *self)
 
 	g_return_val_if_fail (GDATA_IS_SERVICE (self), 0);
 
+	/* The session doesn't exist yet if this is called during construction */
+	if (self->priv->session == NULL)
+		return self->priv->timeout;
+
 	g_object_get (self->priv->session, SOUP_SESSION_TIMEOUT, &timeout, NULL);
 
 	return timeout;
@@ -1893,7 +2214,13 @@ void
 gdata_service_set_timeout (GDataService *self, guint timeout)
 {
 	g_return_if_fail (GDATA_IS_SERVICE (self));
-	g_object_set (self->priv->session, SOUP_SESSION_TIMEOUT, timeout, NULL);
+
+	/* If this is called during construction, the timeout is applied to the session once it's set up in constructed() */
+	if (self->priv->session == NULL)
+		self->priv->timeout = timeout;
+	else
+		g_object_set (self->priv->session, SOUP_SESSION_TIMEOUT, timeout, NULL);
+
 	g_object_notify (G_OBJECT (self), "timeout");
 }
 
@@ -1904,6 +2231,35 @@ _gdata_service_get_session (GDataService *self)
 	return self->priv->session;
 }
 
+/*
+ * _gdata_service_set_session:
+ * @self: a #GDataService
+ * @session: the #SoupSession to use
+ *
+ * Replaces the #GDataService:session used for all of @self's network requests after construction, so that it can be shared with other services.
+ * @self takes on @session's timeout and proxy resolver. This must not be called while @self has operations in progress.
+ *
+ * Since: 0.19.0
+ */
+void
+_gdata_service_set_session (GDataService *self, SoupSession *session)
+{
+	g_return_if_fail (GDATA_IS_SERVICE (self));
+	g_return_if_fail (SOUP_IS_SESSION (session));
+
+	if (self->priv->session == session)
+		return;
+
+	disconnect_session (self);
+	g_object_unref (self->priv->session);
+
+	self->priv->session = g_object_ref (session);
+	connect_session (self);
+
+	g_object_notify (G_OBJECT (self), "session");
+	g_object_notify (G_OBJECT (self), "timeout");
+}
+
 /*
  * _gdata_service_get_scheme:
  *
@@ -2184,16 +2540,20 @@ soup_log_printer (SoupLogger *logger, SoupLoggerLogLevel level, char direction,
 GDataLogLevel
 _gdata_service_get_log_level (void)
 {
-	static int level = -1;
+	static gsize level = 0;
 
-	if (level < 0) {
+	/* This is called from threads parsing feeds, so must be initialised exactly once. The level is stored plus one, since
+	 * g_once_init_enter() uses zero to mean uninitialised. */
+	if (g_once_init_enter (&level)) {
 		const gchar *envvar = g_getenv ("LIBGDATA_DEBUG");
+		int _level = 0;
+
 		if (envvar != NULL)
-			level = atoi (envvar);
-		level = MIN (MAX (level, 0), GDATA_LOG_FULL_UNREDACTED);
+			_level = atoi (envvar);
+		g_once_init_leave (&level, MIN (MAX (_level, 0), GDATA_LOG_FULL_UNREDACTED) + 1);
 	}
 
-	return level;
+	return level - 1;
 }
 
 /* Build a User-Agent value to send to the server.
@@ -2315,6 +2675,53 @@ gdata_service_set_locale (GDataService *self, const gchar *locale)
 	g_object_notify (G_OBJECT (self), "locale");
 }
 
+/**
+ * gdata_service_set_request_metrics_callback:
+ * @self: a #GDataService
+ * @callback: (allow-none) (scope notified) (closure user_data): a #GDataServiceRequestMetricsCallback to call for each completed request, or %NULL
+ * @user_data: (closure): data to pass to @callback
+ * @destroy_user_data: (allow-none): the function to call when @callback will not be called any more, or %NULL
+ *
+ * Sets a callback to be called with a #GDataServiceRequestMetrics for each network request made by the service once it has completed (including
+ * parsing its response, if applicable). This can be used to collect latency, size and retry statistics for the service's requests, and to
+ * attribute time to the network or to parsing. Any previously set callback is replaced, and its @destroy_user_data function is called.
+ *
+ * If @callback is %NULL, no metrics are collected, and requests have no overhead from them, unless the
+ * <envar>LIBGDATA_DEBUG</envar> environment variable is at least <code class="literal">3</code>: then a summary of each request's metrics is also
+ * logged.
+ *
+ * Note that requests made by a #GDataUploadStream or #GDataDownloadStream, and those made by authorizers to refresh their authorization, are not
+ * reported.
+ *
+ * Since: 0.19.0
+ */
+void
+gdata_service_set_request_metrics_callback (GDataService *self, GDataServiceRequestMetricsCallback callback, gpointer user_data,
+                                            GDestroyNotify destroy_user_data)
+{
+	GDataServicePrivate *priv;
+	gpointer old_user_data;
+	GDestroyNotify old_destroy_user_data;
+
+	g_return_if_fail (GDATA_IS_SERVICE (self));
+
+	priv = self->priv;
+
+	g_mutex_lock (&priv->metrics_mutex);
+
+	old_user_data = priv->metrics_user_data;
+	old_destroy_user_data = priv->metrics_destroy_user_data;
+
+	priv->metrics_callback = callback;
+	priv->metrics_user_data = user_data;
+	priv->metrics_destroy_user_data = destroy_user_data;
+
+	g_mutex_unlock (&priv->metrics_mutex);
+
+	if (old_destroy_user_data != NULL)
+		old_destroy_user_data (old_user_data);
+}
+
 /*
  * _gdata_service_secure_strdup:
  * @str: string (which may be in pageable memory) to be duplicated, or %NULL
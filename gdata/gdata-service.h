@@ -128,6 +128,63 @@ typedef struct {
 	GDataServicePrivate *priv;
 } GDataService;
 
+/**
+ * GDataServiceRequestMetrics:
+ * @operation_type: the type of operation the request was made for
+ * @authorization_domain: (allow-none): the #GDataAuthorizationDomain the request was authorized against, or %NULL
+ * @method: the HTTP method of the request
+ * @uri: the URI of the request, with its query string removed so that requests for the same resource can be aggregated
+ * @status: the final HTTP status code of the request, or a libsoup transport error status
+ * @request_bytes: the number of body bytes sent, summed over all attempts
+ * @response_bytes: the number of body bytes received in the final response
+ * @redirects: the number of redirects which were followed
+ * @authorization_retries: the number of times the request was re-sent after refreshing the service's authorization
+ * @dns_time: time spent resolving the server's address, in microseconds, or <code class="literal">-1</code> if no lookup was needed
+ * @connect_time: time spent establishing a TCP connection, in microseconds, or <code class="literal">-1</code> if an existing connection was reused
+ * @tls_time: time spent in the TLS handshake, in microseconds, or <code class="literal">-1</code> if an existing connection was reused
+ * @time_to_first_byte: time from the final attempt being sent to its response headers being received, in microseconds, or
+ * <code class="literal">-1</code> if no response was received
+ * @total_time: time spent on the network for the request, including all redirects and retries, in microseconds
+ * @parse_time: time spent parsing the response into a #GDataFeed or #GDataEntry, in microseconds, or <code class="literal">-1</code> if the
+ * response wasn't parsed
+ *
+ * Per-request metrics reported to a #GDataServiceRequestMetricsCallback. See gdata_service_set_request_metrics_callback().
+ *
+ * Since: 0.19.0
+ */
+typedef struct {
+	GDataOperationType operation_type;
+	GDataAuthorizationDomain *authorization_domain;
+	const gchar *method;
+	const gchar *uri;
+	guint status;
+	gsize request_bytes;
+	gsize response_bytes;
+	guint redirects;
+	guint authorization_retries;
+	gint64 dns_time;
+	gint64 connect_time;
+	gint64 tls_time;
+	gint64 time_to_first_byte;
+	gint64 total_time;
+	gint64 parse_time;
+} GDataServiceRequestMetrics;
+
+/**
+ * GDataServiceRequestMetricsCallback:
+ * @service: the #GDataService which made the request
+ * @metrics: the metrics for the request
+ * @user_data: user data passed to gdata_service_set_request_metrics_callback()
+ *
+ * Callback function called once for each completed network request made by a #GDataService. @metrics and all the data it points to are only
+ * valid for the duration of the call.
+ *
+ * It is called in whichever thread finished processing the request, which is typically not the main thread.
+ *
+ * Since: 0.19.0
+ */
+typedef void (*GDataServiceRequestMetricsCallback) (GDataService *service, const GDataServiceRequestMetrics *metrics, gpointer user_data);
+
 /**
  * GDataServiceClass:
  * @parent: the parent class
@@ -237,6 +294,9 @@ void gdata_service_set_timeout (GDataService *self, guint timeout);
 const gchar *gdata_service_get_locale (GDataService *self) G_GNUC_PURE;
 void gdata_service_set_locale (GDataService *self, const gchar *locale);
 
+void gdata_service_set_request_metrics_callback (GDataService *self, GDataServiceRequestMetricsCallback callback, gpointer user_data,
+                                                 GDestroyNotify destroy_user_data);
+
 G_END_DECLS
 
 #endif /* !GDATA_SERVICE_H */
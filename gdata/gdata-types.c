@@ -48,12 +48,14 @@ gdata_color_copy (gpointer color)
 GType
 gdata_color_get_type (void)
 {
-	static GType type_id = 0;
+	static gsize type_id = 0;
 
-	if (type_id == 0) {
-		type_id = g_boxed_type_register_static (g_intern_static_string ("GDataColor"),
-		                                        (GBoxedCopyFunc) gdata_color_copy,
-		                                        (GBoxedFreeFunc) g_free);
+	/* Entries may be parsed on several threads at once, so this has to be thread safe */
+	if (g_once_init_enter (&type_id)) {
+		GType _type_id = g_boxed_type_register_static (g_intern_static_string ("GDataColor"),
+		                                               (GBoxedCopyFunc) gdata_color_copy,
+		                                               (GBoxedFreeFunc) g_free);
+		g_once_init_leave (&type_id, _type_id);
 	}
 
 	return type_id;
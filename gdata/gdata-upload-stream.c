@@ -228,6 +228,9 @@ struct _GDataUploadStreamPrivate {
 	guint response_status; /* set once we finish receiving the response (SOUP_STATUS_NONE otherwise) (protected by response_mutex) */
 	GError *response_error; /* error asynchronously set by the network thread, and picked up by the main thread when appropriate */
 	GMutex response_mutex; /* mutex for ->response_error, ->response_status and ->finished_cond */
+
+	GChecksum *checksum; /* optional checksum of the data written so far; NULL if disabled; only touched from the thread calling write() */
+	GChecksumType checksum_type;
 };
 
 enum {
@@ -456,6 +459,7 @@ gdata_upload_stream_constructed (GObject *object)
 		if (priv->entry != NULL) {
 			gchar *first_part_header, *upload_data;
 			gchar *second_part_header;
+			gsize upload_length;
 			GDataParsableClass *parsable_klass;
 
 			parsable_klass = GDATA_PARSABLE_GET_CLASS (priv->entry);
@@ -463,11 +467,7 @@ gdata_upload_stream_constructed (GObject *object)
 
 			soup_message_headers_set_content_type (priv->message->request_headers, "multipart/related; boundary=" BOUNDARY_STRING, NULL);
 
-			if (g_strcmp0 (parsable_klass->get_content_type (), "application/json") == 0) {
-				upload_data = gdata_parsable_get_json (GDATA_PARSABLE (priv->entry));
-			} else {
-				upload_data = gdata_parsable_get_xml (GDATA_PARSABLE (priv->entry));
-			}
+			upload_data = _gdata_parsable_serialise (GDATA_PARSABLE (priv->entry), &upload_length);
 
 			/* Start by writing out the entry; then the thread has something to write to the network when it's created */
 			first_part_header = g_strdup_printf ("--" BOUNDARY_STRING "\n"
@@ -486,7 +486,7 @@ gdata_upload_stream_constructed (GObject *object)
 			                          strlen (first_part_header));
 			soup_message_body_append (priv->message->request_body,
 			                          SOUP_MEMORY_TAKE, upload_data,
-			                          strlen (upload_data));
+			                          upload_length);
 			soup_message_body_append (priv->message->request_body,
 			                          SOUP_MEMORY_TAKE,
 			                          second_part_header,
@@ -517,15 +517,12 @@ gdata_upload_stream_constructed (GObject *object)
 		if (priv->entry != NULL) {
 			GDataParsableClass *parsable_klass;
 			gchar *content_type, *upload_data;
+			gsize upload_length;
 
 			parsable_klass = GDATA_PARSABLE_GET_CLASS (priv->entry);
 			g_assert (parsable_klass->get_content_type != NULL);
 
-			if (g_strcmp0 (parsable_klass->get_content_type (), "application/json") == 0) {
-				upload_data = gdata_parsable_get_json (GDATA_PARSABLE (priv->entry));
-			} else {
-				upload_data = gdata_parsable_get_xml (GDATA_PARSABLE (priv->entry));
-			}
+			upload_data = _gdata_parsable_serialise (GDATA_PARSABLE (priv->entry), &upload_length);
 
 			content_type = g_strdup_printf ("%s; charset=UTF-8",
 			                                parsable_klass->get_content_type ());
@@ -537,7 +534,7 @@ gdata_upload_stream_constructed (GObject *object)
 			soup_message_body_append (priv->message->request_body,
 			                          SOUP_MEMORY_TAKE,
 			                          upload_data,
-			                          strlen (upload_data));
+			                          upload_length);
 			upload_data = NULL;
 
 			priv->network_bytes_outstanding = priv->message->request_body->length;
@@ -613,6 +610,9 @@ gdata_upload_stream_finalize (GObject *object)
 	g_free (priv->slug);
 	g_free (priv->content_type);
 
+	if (priv->checksum != NULL)
+		g_checksum_free (priv->checksum);
+
 	/* Chain up to the parent class */
 	G_OBJECT_CLASS (gdata_upload_stream_parent_class)->finalize (object);
 }
@@ -755,6 +755,10 @@ gdata_upload_stream_write (GOutputStream *stream, const void *buffer, gsize coun
 	old_total_network_bytes_written = priv->total_network_bytes_written;
 	priv->message_bytes_outstanding += count;
 
+	/* All @count bytes are about to be committed to the buffer, so hash them now; this saves the caller reading the data again to verify it */
+	if (priv->checksum != NULL)
+		g_checksum_update (priv->checksum, buffer, count);
+
 	/* Handle the more common case of the network thread already having been created first */
 	if (priv->network_thread != NULL) {
 		/* Push the new data into the buffer */
@@ -1656,3 +1660,67 @@ gdata_upload_stream_get_cancellable (GDataUploadStream *self)
 	g_assert (self->priv->cancellable != NULL);
 	return self->priv->cancellable;
 }
+
+/**
+ * gdata_upload_stream_set_checksum_type:
+ * @self: a #GDataUploadStream
+ * @checksum_type: the type of checksum to compute
+ *
+ * Enables computing a checksum of the uploaded data as it is written to the stream, so that the upload can be verified against the checksum
+ * reported by the server (such as gdata_documents_entry_get_md5_checksum()) without having to read the data again. This must be called before the
+ * first write to the stream.
+ *
+ * The checksum covers only the data written to the stream, not any metadata sent along with it. It can be retrieved once the stream has been
+ * closed using gdata_upload_stream_get_checksum().
+ *
+ * Since: 0.19.0
+ */
+void
+gdata_upload_stream_set_checksum_type (GDataUploadStream *self, GChecksumType checksum_type)
+{
+	GDataUploadStreamPrivate *priv;
+
+	g_return_if_fail (GDATA_IS_UPLOAD_STREAM (self));
+
+	priv = self->priv;
+	g_return_if_fail (priv->network_thread == NULL);
+
+	if (priv->checksum != NULL)
+		g_checksum_free (priv->checksum);
+
+	priv->checksum = g_checksum_new (checksum_type);
+	priv->checksum_type = checksum_type;
+}
+
+/**
+ * gdata_upload_stream_get_checksum:
+ * @self: a #GDataUploadStream
+ * @checksum_type: (out) (optional): return location for the type of the checksum, or %NULL
+ *
+ * Gets the checksum of the uploaded data, as enabled by gdata_upload_stream_set_checksum_type(). The checksum is only available once the upload
+ * has finished successfully (i.e. once gdata_upload_stream_get_response() returns a response); before then, or if checksumming wasn't enabled,
+ * %NULL is returned.
+ *
+ * Return value: (allow-none): the checksum of the uploaded data as a hexadecimal string, or %NULL
+ *
+ * Since: 0.19.0
+ */
+const gchar *
+gdata_upload_stream_get_checksum (GDataUploadStream *self, GChecksumType *checksum_type)
+{
+	gboolean is_successful;
+
+	g_return_val_if_fail (GDATA_IS_UPLOAD_STREAM (self), NULL);
+
+	g_mutex_lock (&(self->priv->response_mutex));
+	is_successful = SOUP_STATUS_IS_SUCCESSFUL (self->priv->response_status);
+	g_mutex_unlock (&(self->priv->response_mutex));
+
+	if (is_successful == FALSE || self->priv->checksum == NULL)
+		return NULL;
+
+	if (checksum_type != NULL)
+		*checksum_type = self->priv->checksum_type;
+
+	return g_checksum_get_string (self->priv->checksum);
+}
@@ -119,6 +119,9 @@ const gchar *gdata_upload_stream_get_content_type (GDataUploadStream *self) G_GN
 goffset gdata_upload_stream_get_content_length (GDataUploadStream *self) G_GNUC_PURE;
 GCancellable *gdata_upload_stream_get_cancellable (GDataUploadStream *self) G_GNUC_PURE;
 
+void gdata_upload_stream_set_checksum_type (GDataUploadStream *self, GChecksumType checksum_type);
+const gchar *gdata_upload_stream_get_checksum (GDataUploadStream *self, GChecksumType *checksum_type);
+
 G_END_DECLS
 
 #endif /* !GDATA_UPLOAD_STREAM_H */
@@ -22,10 +22,12 @@
 
 /* Core files */
 #include <gdata/gdata-entry.h>
+#include <gdata/gdata-entry-mirror.h>
 #include <gdata/gdata-feed.h>
 #include <gdata/gdata-service.h>
 #include <gdata/gdata-types.h>
 #include <gdata/gdata-query.h>
+#include <gdata/gdata-query-executor.h>
 #include <gdata/gdata-enums.h>
 #include <gdata/gdata-access-handler.h>
 #include <gdata/gdata-access-rule.h>
@@ -102,6 +104,8 @@
 #include <gdata/services/calendar/gdata-calendar-feed.h>
 #include <gdata/services/calendar/gdata-calendar-calendar.h>
 #include <gdata/services/calendar/gdata-calendar-event.h>
+#include <gdata/services/calendar/gdata-calendar-event-index.h>
+#include <gdata/services/calendar/gdata-calendar-event-expander.h>
 #include <gdata/services/calendar/gdata-calendar-query.h>
 #include <gdata/services/calendar/gdata-calendar-access-rule.h>
 
@@ -140,5 +144,6 @@
 #include <gdata/services/tasks/gdata-tasks-query.h>
 #include <gdata/services/tasks/gdata-tasks-tasklist.h>
 #include <gdata/services/tasks/gdata-tasks-task.h>
+#include <gdata/services/tasks/gdata-tasks-enums.h>
 
 #endif /* !GDATA_H */
@@ -0,0 +1,1526 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 8; tab-width: 8 -*- */
+/*
+ * GData Client
+ *
+ * GData Client is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * GData Client is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GData Client.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * SECTION:gdata-calendar-event-expander
+ * @short_description: GData Calendar client-side recurrence expansion
+ * @stability: Unstable
+ * @include: gdata/services/calendar/gdata-calendar-event-expander.h
+ *
+ * #GDataCalendarEventExpander expands the recurrence rules of recurring #GDataCalendarEvents locally, producing a lightweight
+ * #GDataCalendarEventInstance for each occurrence of the event within a requested period.
+ *
+ * By default, gdata_calendar_service_query_events() asks the server to expand recurring events into one #GDataCalendarEvent per occurrence (see
+ * #GDataCalendarQuery:single-events). For long periods, or calendars with many recurring events, this inflates the feed considerably. Setting
+ * #GDataCalendarQuery:single-events to %FALSE instead returns only the recurring (‘master’) events, plus any exceptions to them, and
+ * gdata_calendar_event_expander_expand_events() can then expand them locally into the same set of occurrences.
+ *
+ * Expansions are cached, keyed by the event's ID and ETag and by the requested period, so repeatedly expanding the same events (for example, when
+ * redrawing a calendar view) is cheap. When an event changes on the server its ETag changes, and the cached expansions of its previous version are
+ * discarded the next time it's expanded. Requests for a period inside a cached period are answered from the cache too.
+ *
+ * Recurrences are expanded in the time zone given for the event's start time by the server, so that occurrences stay at the same local time across
+ * daylight saving changes; all-day events, and events with no time zone, are expanded in UTC. The following subset of
+ * <ulink type="http" url="https://tools.ietf.org/html/rfc5545#section-3.8.5">RFC 5545</ulink> is supported, which covers the recurrences
+ * which Google Calendar itself creates:
+ * <itemizedlist>
+ *   <listitem><para><code class="literal">RRULE</code> lines with a <code class="literal">FREQ</code> of <code class="literal">DAILY</code>,
+ *     <code class="literal">WEEKLY</code>, <code class="literal">MONTHLY</code> or <code class="literal">YEARLY</code>, and the
+ *     <code class="literal">INTERVAL</code>, <code class="literal">COUNT</code>, <code class="literal">UNTIL</code>, <code class="literal">BYDAY</code>,
+ *     <code class="literal">BYMONTHDAY</code>, <code class="literal">BYMONTH</code>, <code class="literal">BYSETPOS</code> and
+ *     <code class="literal">WKST</code> parts. Several <code class="literal">RRULE</code> lines are combined.</para></listitem>
+ *   <listitem><para><code class="literal">RDATE</code> and <code class="literal">EXDATE</code> lines with date or date-time values, optionally
+ *     with a <code class="literal">TZID</code> parameter.</para></listitem>
+ * </itemizedlist>
+ * Other recurrence rules (such as ones using <code class="literal">BYHOUR</code> or <code class="literal">EXRULE</code>) result in a
+ * %GDATA_PARSER_ERROR_PARSING_STRING error, and such events should be queried with #GDataCalendarQuery:single-events set to %TRUE instead.
+ *
+ * A #GDataCalendarEventExpander is not thread safe, and must only be used from one thread at a time.
+ *
+ * <example>
+ * 	<title>Expanding Recurring Events for a Week View</title>
+ * 	<programlisting>
+ *	GDataCalendarEventExpander *expander;
+ *	GDataCalendarQuery *query;
+ *	GDataFeed *feed;
+ *	GArray *instances;
+ *	guint i;
+ *	GError *error = NULL;
+ *
+ *	/<!-- -->* Fetch the master events for the week, rather than each occurrence *<!-- -->/
+ *	query = gdata_calendar_query_new_with_limits (NULL, week_start, week_start + 7 * 24 * 60 * 60);
+ *	gdata_calendar_query_set_single_events (query, FALSE);
+ *
+ *	feed = gdata_calendar_service_query_events (service, calendar, GDATA_QUERY (query), NULL, NULL, NULL, &error);
+ *	g_object_unref (query);
+ *
+ *	if (error != NULL) {
+ *		g_error ("Error querying for events: %s", error->message);
+ *		g_error_free (error);
+ *		return;
+ *	}
+ *
+ *	expander = gdata_calendar_event_expander_new ();
+ *	instances = gdata_calendar_event_expander_expand_events (expander, gdata_feed_get_entries (feed), week_start, week_start + 7 * 24 * 60 * 60,
+ *	                                                         &error);
+ *
+ *	if (error != NULL) {
+ *		g_error ("Error expanding events: %s", error->message);
+ *		g_error_free (error);
+ *		g_object_unref (expander);
+ *		g_object_unref (feed);
+ *		return;
+ *	}
+ *
+ *	for (i = 0; i < instances->len; i++) {
+ *		GDataCalendarEventInstance *instance = &g_array_index (instances, GDataCalendarEventInstance, i);
+ *
+ *		/<!-- -->* Draw the instance here *<!-- -->/
+ *		draw_event (gdata_entry_get_title (GDATA_ENTRY (instance->event)), instance->start_time, instance->end_time);
+ *	}
+ *
+ *	g_array_unref (instances);
+ *	g_object_unref (expander);
+ *	g_object_unref (feed);
+ * 	</programlisting>
+ * </example>
+ *
+ * Since: 0.19.0
+ */
+
+#include <config.h>
+#include <glib.h>
+#include <glib/gi18n-lib.h>
+#include <string.h>
+
+#include "gdata-calendar-event-expander.h"
+#include "gdata-calendar-event-private.h"
+#include "gdata-parser.h"
+#include "gdata-private.h"
+
+/* Maximum number of periods cached for each event; the oldest are dropped first */
+#define MAX_CACHED_WINDOWS 4
+
+/* Maximum number of consecutive recurrence periods with no occurrences before giving up; this is enough to span several years of daily periods, so
+ * that rules such as ‘every 29th February’ aren't cut short, while bounding the work done for rules which never match */
+#define MAX_EMPTY_PERIODS 3000
+
+/* Latest year occurrences are generated for; GDateTime can't represent anything later than 9999 */
+#define MAX_YEAR 9998
+
+typedef enum {
+	FREQUENCY_DAILY,
+	FREQUENCY_WEEKLY,
+	FREQUENCY_MONTHLY,
+	FREQUENCY_YEARLY,
+} Frequency;
+
+typedef struct {
+	gint ordinal; /* 0 for every such weekday in the period; otherwise the nth (or -nth from the end) such weekday */
+	GDateWeekday weekday;
+} WeekdayNum;
+
+/* A parsed RRULE */
+typedef struct {
+	Frequency frequency;
+	guint interval;
+	guint64 count; /* 0 if unlimited */
+	gint64 until; /* inclusive; G_MAXINT64 if unlimited */
+	GDateWeekday week_start;
+	guint16 by_month; /* bit n is set if month n is included; 0 if unset */
+	GArray *by_day; /* WeekdayNum, or NULL if unset */
+	GArray *by_month_day; /* gint, or NULL if unset */
+	GArray *by_set_pos; /* gint, or NULL if unset */
+} RecurrenceRule;
+
+/* The event's first occurrence (its DTSTART), broken down in the time zone the recurrence is expanded in */
+typedef struct {
+	GTimeZone *time_zone; /* owned */
+	gint64 start_time;
+	gint64 duration;
+	gboolean is_date;
+	guint32 julian;
+	gint year;
+	gint month;
+	gint day;
+	gint hour;
+	gint minute;
+	gint second;
+} RecurrenceContext;
+
+/* An occurrence of an event, without a reference to the event so that it can be cached */
+typedef struct {
+	gint64 start_time;
+	gint64 end_time;
+	gboolean is_date;
+} Occurrence;
+
+typedef struct {
+	gint64 start_time;
+	gint64 end_time;
+	GArray *occurrences; /* owned; Occurrence */
+} CachedWindow;
+
+typedef struct {
+	gchar *etag; /* owned */
+	GSList *windows; /* owned; CachedWindow, most recently added first */
+} CachedEvent;
+
+static void gdata_calendar_event_expander_finalize (GObject *object);
+
+struct _GDataCalendarEventExpanderPrivate {
+	GHashTable *cache; /* event ID → owned CachedEvent */
+};
+
+G_DEFINE_TYPE_WITH_PRIVATE (GDataCalendarEventExpander, gdata_calendar_event_expander, G_TYPE_OBJECT)
+
+static void
+gdata_calendar_event_expander_class_init (GDataCalendarEventExpanderClass *klass)
+{
+	GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+
+	gobject_class->finalize = gdata_calendar_event_expander_finalize;
+}
+
+static void
+cached_window_free (CachedWindow *window)
+{
+	g_array_unref (window->occurrences);
+	g_slice_free (CachedWindow, window);
+}
+
+static void
+cached_event_free (CachedEvent *cached)
+{
+	g_free (cached->etag);
+	g_slist_free_full (cached->windows, (GDestroyNotify) cached_window_free);
+	g_slice_free (CachedEvent, cached);
+}
+
+static void
+gdata_calendar_event_expander_init (GDataCalendarEventExpander *self)
+{
+	self->priv = gdata_calendar_event_expander_get_instance_private (self);
+	self->priv->cache = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify) cached_event_free);
+}
+
+static void
+gdata_calendar_event_expander_finalize (GObject *object)
+{
+	GDataCalendarEventExpanderPrivate *priv = GDATA_CALENDAR_EVENT_EXPANDER (object)->priv;
+
+	g_hash_table_unref (priv->cache);
+
+	/* Chain up to the parent class */
+	G_OBJECT_CLASS (gdata_calendar_event_expander_parent_class)->finalize (object);
+}
+
+static void
+recurrence_rule_free (RecurrenceRule *rule)
+{
+	if (rule->by_day != NULL)
+		g_array_unref (rule->by_day);
+	if (rule->by_month_day != NULL)
+		g_array_unref (rule->by_month_day);
+	if (rule->by_set_pos != NULL)
+		g_array_unref (rule->by_set_pos);
+
+	g_slice_free (RecurrenceRule, rule);
+}
+
+static gboolean
+set_recurrence_error (GError **error, const gchar *format, ...) G_GNUC_PRINTF (2, 3);
+
+static gboolean
+set_recurrence_error (GError **error, const gchar *format, ...)
+{
+	va_list args;
+	gchar *message;
+
+	va_start (args, format);
+	message = g_strdup_vprintf (format, args);
+	va_end (args);
+
+	g_set_error (error, GDATA_PARSER_ERROR, GDATA_PARSER_ERROR_PARSING_STRING,
+	             /* Translators: the parameter is an error message */
+	             _("Error parsing recurrence: %s"), message);
+	g_free (message);
+
+	return FALSE;
+}
+
+static inline guint32
+julian_from_dmy (gint day, gint month, gint year)
+{
+	GDate date;
+
+	g_date_clear (&date, 1);
+	g_date_set_dmy (&date, day, month, year);
+
+	return g_date_get_julian (&date);
+}
+
+static inline void
+julian_to_dmy (guint32 julian, gint *day, gint *month, gint *year)
+{
+	GDate date;
+
+	g_date_clear (&date, 1);
+	g_date_set_julian (&date, julian);
+
+	*day = g_date_get_day (&date);
+	*month = g_date_get_month (&date);
+	*year = g_date_get_year (&date);
+}
+
+static inline GDateWeekday
+julian_get_weekday (guint32 julian)
+{
+	GDate date;
+
+	g_date_clear (&date, 1);
+	g_date_set_julian (&date, julian);
+
+	return g_date_get_weekday (&date);
+}
+
+/* Parses exactly @n_digits decimal digits from *@str, advancing it past them */
+static gboolean
+parse_digits (const gchar **str, guint n_digits, gint *value)
+{
+	guint i;
+
+	*value = 0;
+
+	for (i = 0; i < n_digits; i++) {
+		if (!g_ascii_isdigit ((*str)[i]))
+			return FALSE;
+
+		*value = *value * 10 + g_ascii_digit_value ((*str)[i]);
+	}
+
+	*str += n_digits;
+
+	return TRUE;
+}
+
+/* Parses an iCalendar DATE (‘20260102’) or DATE-TIME (‘20260102T030405’, or ‘20260102T030405Z’ for UTC) value. Dates and floating date-times are
+ * interpreted in @time_zone. */
+static gboolean
+parse_date_time (const gchar *value, GTimeZone *time_zone, GDateTime **date_time, gboolean *is_date)
+{
+	gint year, month, day, hour = 0, minute = 0, second = 0;
+	gboolean is_utc = FALSE;
+	GTimeZone *utc;
+
+	if (!parse_digits (&value, 4, &year) || !parse_digits (&value, 2, &month) || !parse_digits (&value, 2, &day) ||
+	    !g_date_valid_dmy (day, month, year)) {
+		return FALSE;
+	}
+
+	*is_date = (*value == '\0');
+
+	if (*value == 'T') {
+		value++;
+
+		if (!parse_digits (&value, 2, &hour) || !parse_digits (&value, 2, &minute) || !parse_digits (&value, 2, &second))
+			return FALSE;
+
+		if (*value == 'Z') {
+			is_utc = TRUE;
+			value++;
+		}
+	}
+
+	if (*value != '\0')
+		return FALSE;
+
+	if (is_utc == TRUE) {
+		utc = g_time_zone_new_utc ();
+		*date_time = g_date_time_new (utc, year, month, day, hour, minute, second);
+		g_time_zone_unref (utc);
+	} else {
+		*date_time = g_date_time_new (time_zone, year, month, day, hour, minute, second);
+	}
+
+	return (*date_time != NULL);
+}
+
+/* Returns the time of the occurrence on the given day, at the same local time as the event's first occurrence */
+static gint64
+context_get_time (const RecurrenceContext *context, guint32 julian)
+{
+	GDateTime *date_time;
+	gint day, month, year;
+	gint64 time;
+
+	julian_to_dmy (julian, &day, &month, &year);
+
+	date_time = g_date_time_new (context->time_zone, year, month, day, context->hour, context->minute, context->second);
+	if (date_time == NULL)
+		return G_MAXINT64;
+
+	time = g_date_time_to_unix (date_time);
+	g_date_time_unref (date_time);
+
+	return time;
+}
+
+/* Converts an RDATE, EXDATE or UNTIL value to the start time of the occurrence it refers to. A DATE value refers to the occurrence on that date; for
+ * UNTIL, that means any time up to the end of the date. */
+static gboolean
+context_parse_time (const RecurrenceContext *context, const gchar *value, GTimeZone *time_zone, gboolean is_until, gint64 *time)
+{
+	GDateTime *date_time;
+	gboolean is_date;
+
+	if (!parse_date_time (value, time_zone, &date_time, &is_date))
+		return FALSE;
+
+	if (is_date == TRUE && context->is_date == FALSE) {
+		guint32 julian;
+
+		julian = julian_from_dmy (g_date_time_get_day_of_month (date_time), g_date_time_get_month (date_time), g_date_time_get_year (date_time));
+		*time = (is_until == TRUE) ? context_get_time (context, julian + 1) - 1 : context_get_time (context, julian);
+	} else {
+		*time = g_date_time_to_unix (date_time);
+	}
+
+	g_date_time_unref (date_time);
+
+	return TRUE;
+}
+
+static gboolean
+parse_weekday (const gchar *value, GDateWeekday *weekday)
+{
+	static const gchar *weekdays[] = { "MO", "TU", "WE", "TH", "FR", "SA", "SU" };
+	guint i;
+
+	for (i = 0; i < G_N_ELEMENTS (weekdays); i++) {
+		if (g_ascii_strcasecmp (value, weekdays[i]) == 0) {
+			*weekday = G_DATE_MONDAY + i;
+			return TRUE;
+		}
+	}
+
+	return FALSE;
+}
+
+/* Parses a comma-separated list of integers in the range [-max, max], excluding 0 */
+static gboolean
+parse_integer_list (const gchar *value, gint max, GArray **list)
+{
+	gchar **parts;
+	guint i;
+	gboolean success = TRUE;
+
+	parts = g_strsplit (value, ",", -1);
+	*list = g_array_new (FALSE, FALSE, sizeof (gint));
+
+	for (i = 0; parts[i] != NULL && success == TRUE; i++) {
+		gint64 number;
+
+		if (!g_ascii_string_to_signed (parts[i], 10, -max, max, &number, NULL) || number == 0) {
+			success = FALSE;
+		} else {
+			gint integer = number;
+			g_array_append_val (*list, integer);
+		}
+	}
+
+	g_strfreev (parts);
+
+	if (success == FALSE || (*list)->len == 0) {
+		g_array_unref (*list);
+		*list = NULL;
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+static gboolean
+parse_by_day (const gchar *value, GArray **list)
+{
+	gchar **parts;
+	guint i;
+	gboolean success = TRUE;
+
+	parts = g_strsplit (value, ",", -1);
+	*list = g_array_new (FALSE, FALSE, sizeof (WeekdayNum));
+
+	for (i = 0; parts[i] != NULL && success == TRUE; i++) {
+		WeekdayNum day = { 0, G_DATE_BAD_WEEKDAY };
+		gsize length = strlen (parts[i]);
+
+		if (length < 2 || !parse_weekday (parts[i] + length - 2, &day.weekday)) {
+			success = FALSE;
+		} else if (length > 2) {
+			gchar *ordinal = g_strndup (parts[i], length - 2);
+			gint64 number = 0;
+
+			/* g_ascii_string_to_signed() doesn't accept a leading ‘+’ */
+			success = g_ascii_string_to_signed ((*ordinal == '+') ? ordinal + 1 : ordinal, 10, -53, 53, &number, NULL) && number != 0;
+			day.ordinal = number;
+			g_free (ordinal);
+		}
+
+		if (success == TRUE)
+			g_array_append_val (*list, day);
+	}
+
+	g_strfreev (parts);
+
+	if (success == FALSE || (*list)->len == 0) {
+		g_array_unref (*list);
+		*list = NULL;
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+static RecurrenceRule *
+parse_rule (const RecurrenceContext *context, const gchar *value, GError **error)
+{
+	RecurrenceRule *rule;
+	gchar **parts;
+	guint i;
+	gboolean have_frequency = FALSE;
+
+	rule = g_slice_new0 (RecurrenceRule);
+	rule->interval = 1;
+	rule->until = G_MAXINT64;
+	rule->week_start = G_DATE_MONDAY;
+
+	parts = g_strsplit (value, ";", -1);
+
+	for (i = 0; parts[i] != NULL; i++) {
+		const gchar *part_value;
+		gchar *equals;
+		gboolean success = TRUE;
+
+		if (*parts[i] == '\0')
+			continue;
+
+		equals = strchr (parts[i], '=');
+		if (equals == NULL) {
+			set_recurrence_error (error, "Invalid rule part ‘%s’.", parts[i]);
+			goto error;
+		}
+
+		*equals = '\0';
+		part_value = equals + 1;
+
+		if (g_ascii_strcasecmp (parts[i], "FREQ") == 0) {
+			have_frequency = TRUE;
+
+			if (g_ascii_strcasecmp (part_value, "DAILY") == 0) {
+				rule->frequency = FREQUENCY_DAILY;
+			} else if (g_ascii_strcasecmp (part_value, "WEEKLY") == 0) {
+				rule->frequency = FREQUENCY_WEEKLY;
+			} else if (g_ascii_strcasecmp (part_value, "MONTHLY") == 0) {
+				rule->frequency = FREQUENCY_MONTHLY;
+			} else if (g_ascii_strcasecmp (part_value, "YEARLY") == 0) {
+				rule->frequency = FREQUENCY_YEARLY;
+			} else {
+				set_recurrence_error (error, "Unsupported frequency ‘%s’.", part_value);
+				goto error;
+			}
+		} else if (g_ascii_strcasecmp (parts[i], "INTERVAL") == 0) {
+			guint64 interval;
+
+			success = g_ascii_string_to_unsigned (part_value, 10, 1, G_MAXUINT16, &interval, NULL);
+			rule->interval = interval;
+		} else if (g_ascii_strcasecmp (parts[i], "COUNT") == 0) {
+			success = g_ascii_string_to_unsigned (part_value, 10, 1, G_MAXUINT32, &rule->count, NULL);
+		} else if (g_ascii_strcasecmp (parts[i], "UNTIL") == 0) {
+			success = context_parse_time (context, part_value, context->time_zone, TRUE, &rule->until);
+		} else if (g_ascii_strcasecmp (parts[i], "WKST") == 0) {
+			success = parse_weekday (part_value, &rule->week_start);
+		} else if (g_ascii_strcasecmp (parts[i], "BYDAY") == 0) {
+			success = parse_by_day (part_value, &rule->by_day);
+		} else if (g_ascii_strcasecmp (parts[i], "BYMONTHDAY") == 0) {
+			success = parse_integer_list (part_value, 31, &rule->by_month_day);
+		} else if (g_ascii_strcasecmp (parts[i], "BYSETPOS") == 0) {
+			success = parse_integer_list (part_value, 366, &rule->by_set_pos);
+		} else if (g_ascii_strcasecmp (parts[i], "BYMONTH") == 0) {
+			GArray *months;
+
+			success = parse_integer_list (part_value, 12, &months);
+			if (success == TRUE) {
+				guint j;
+
+				for (j = 0; j < months->len && success == TRUE; j++) {
+					gint month = g_array_index (months, gint, j);
+
+					if (month > 0)
+						rule->by_month |= 1 << month;
+					else
+						success = FALSE;
+				}
+
+				g_array_unref (months);
+			}
+		} else {
+			set_recurrence_error (error, "Unsupported rule part ‘%s’.", parts[i]);
+			goto error;
+		}
+
+		if (success == FALSE) {
+			set_recurrence_error (error, "Invalid value ‘%s’ for rule part ‘%s’.", part_value, parts[i]);
+			goto error;
+		}
+	}
+
+	if (have_frequency == FALSE) {
+		set_recurrence_error (error, "Rule ‘%s’ has no frequency.", value);
+		goto error;
+	}
+
+	/* Weekday ordinals are only meaningful within months and years, and BYMONTHDAY isn't allowed with weekly rules */
+	if (rule->by_day != NULL && (rule->frequency == FREQUENCY_DAILY || rule->frequency == FREQUENCY_WEEKLY)) {
+		for (i = 0; i < rule->by_day->len; i++) {
+			if (g_array_index (rule->by_day, WeekdayNum, i).ordinal != 0) {
+				set_recurrence_error (error, "Rule ‘%s’ has weekday ordinals but isn't monthly or yearly.", value);
+				goto error;
+			}
+		}
+	}
+
+	if (rule->by_month_day != NULL && rule->frequency == FREQUENCY_WEEKLY) {
+		set_recurrence_error (error, "Rule ‘%s’ is weekly but has BYMONTHDAY.", value);
+		goto error;
+	}
+
+	g_strfreev (parts);
+
+	return rule;
+
+error:
+	g_strfreev (parts);
+	recurrence_rule_free (rule);
+
+	return NULL;
+}
+
+static gboolean
+rule_matches_weekday (const RecurrenceRule *rule, GDateWeekday weekday)
+{
+	guint i;
+
+	for (i = 0; i < rule->by_day->len; i++) {
+		if (g_array_index (rule->by_day, WeekdayNum, i).weekday == weekday)
+			return TRUE;
+	}
+
+	return FALSE;
+}
+
+static gboolean
+rule_matches_month_day (const RecurrenceRule *rule, gint day, gint days_in_month)
+{
+	guint i;
+
+	for (i = 0; i < rule->by_month_day->len; i++) {
+		gint month_day = g_array_index (rule->by_month_day, gint, i);
+
+		if (month_day == day || days_in_month + month_day + 1 == day)
+			return TRUE;
+	}
+
+	return FALSE;
+}
+
+/* Returns the day of the nth (or -nth from the end, for negative ordinals) @weekday between @first and @last inclusive, or 0 if there isn't one */
+static guint32
+get_nth_weekday (guint32 first, guint32 last, GDateWeekday weekday, gint ordinal)
+{
+	guint32 julian;
+
+	if (ordinal > 0) {
+		julian = first + ((gint) weekday - (gint) julian_get_weekday (first) + 7) % 7 + (ordinal - 1) * 7;
+		return (julian <= last) ? julian : 0;
+	} else {
+		guint32 offset = ((gint) julian_get_weekday (last) - (gint) weekday + 7) % 7 + (-ordinal - 1) * 7;
+		return (offset <= last - first) ? last - offset : 0;
+	}
+}
+
+/* Appends the days between @first and @last inclusive which match BYDAY, with ordinals relative to that range */
+static void
+rule_add_weekdays (const RecurrenceRule *rule, guint32 first, guint32 last, GArray *days)
+{
+	guint i;
+
+	for (i = 0; i < rule->by_day->len; i++) {
+		const WeekdayNum *day = &g_array_index (rule->by_day, WeekdayNum, i);
+		guint32 julian;
+
+		if (day->ordinal != 0) {
+			julian = get_nth_weekday (first, last, day->weekday, day->ordinal);
+			if (julian != 0)
+				g_array_append_val (days, julian);
+		} else {
+			for (julian = first + ((gint) day->weekday - (gint) julian_get_weekday (first) + 7) % 7; julian <= last; julian += 7)
+				g_array_append_val (days, julian);
+		}
+	}
+}
+
+static gboolean
+rule_matches_weekday_in_range (const RecurrenceRule *rule, guint32 julian, guint32 first, guint32 last)
+{
+	GDateWeekday weekday = julian_get_weekday (julian);
+	guint i;
+
+	for (i = 0; i < rule->by_day->len; i++) {
+		const WeekdayNum *day = &g_array_index (rule->by_day, WeekdayNum, i);
+
+		if (day->weekday == weekday && (day->ordinal == 0 || get_nth_weekday (first, last, weekday, day->ordinal) == julian))
+			return TRUE;
+	}
+
+	return FALSE;
+}
+
+/* Appends the days of the given month which match the rule */
+static void
+rule_add_month_days (const RecurrenceRule *rule, const RecurrenceContext *context, gint year, gint month, GArray *days)
+{
+	gint days_in_month = g_date_get_days_in_month (month, year);
+	guint32 first = julian_from_dmy (1, month, year);
+	guint32 last = first + days_in_month - 1;
+
+	if (rule->by_month_day != NULL) {
+		guint i;
+
+		for (i = 0; i < rule->by_month_day->len; i++) {
+			gint day = g_array_index (rule->by_month_day, gint, i);
+			guint32 julian;
+
+			if (day < 0)
+				day += days_in_month + 1;
+			if (day < 1 || day > days_in_month)
+				continue;
+
+			julian = first + day - 1;
+			if (rule->by_day == NULL || rule_matches_weekday_in_range (rule, julian, first, last))
+				g_array_append_val (days, julian);
+		}
+	} else if (rule->by_day != NULL) {
+		rule_add_weekdays (rule, first, last, days);
+	} else if (context->day <= days_in_month) {
+		guint32 julian = first + context->day - 1;
+		g_array_append_val (days, julian);
+	}
+}
+
+static gint
+compare_days (gconstpointer a, gconstpointer b)
+{
+	guint32 day_a = *((const guint32 *) a), day_b = *((const guint32 *) b);
+
+	return (day_a > day_b) - (day_a < day_b);
+}
+
+/* Sets @days to the days in the @period-th period of the rule which have an occurrence, in order. Returns %FALSE if the period is too far in the
+ * future to represent. */
+static gboolean
+rule_get_period_days (const RecurrenceRule *rule, const RecurrenceContext *context, guint64 period, GArray *days)
+{
+	guint i, j;
+
+	g_array_set_size (days, 0);
+
+	switch (rule->frequency) {
+		case FREQUENCY_DAILY:
+		case FREQUENCY_WEEKLY: {
+			guint64 julian, last;
+			gint day, month, year;
+
+			if (rule->frequency == FREQUENCY_DAILY) {
+				julian = context->julian + period * rule->interval;
+				last = julian;
+			} else {
+				/* Weeks start on WKST */
+				julian = context->julian - ((gint) julian_get_weekday (context->julian) - (gint) rule->week_start + 7) % 7 +
+				         period * rule->interval * 7;
+				last = julian + 6;
+			}
+
+			if (last > julian_from_dmy (31, 12, MAX_YEAR))
+				return FALSE;
+
+			if (rule->frequency == FREQUENCY_WEEKLY && rule->by_day == NULL) {
+				/* Just the DTSTART weekday of the week */
+				julian = context->julian + period * rule->interval * 7;
+				last = julian;
+			}
+
+			for (; julian <= last; julian++) {
+				guint32 day_julian = julian;
+
+				julian_to_dmy (day_julian, &day, &month, &year);
+
+				if ((rule->by_month != 0 && (rule->by_month & (1 << month)) == 0) ||
+				    (rule->by_month_day != NULL && !rule_matches_month_day (rule, day, g_date_get_days_in_month (month, year))) ||
+				    (rule->by_day != NULL && !rule_matches_weekday (rule, julian_get_weekday (day_julian)))) {
+					continue;
+				}
+
+				g_array_append_val (days, day_julian);
+			}
+
+			break;
+		}
+		case FREQUENCY_MONTHLY: {
+			guint64 months = (guint64) context->year * 12 + (context->month - 1) + period * rule->interval;
+			gint year = months / 12, month = months % 12 + 1;
+
+			if (months / 12 > MAX_YEAR)
+				return FALSE;
+
+			if (rule->by_month == 0 || (rule->by_month & (1 << month)) != 0)
+				rule_add_month_days (rule, context, year, month, days);
+
+			break;
+		}
+		case FREQUENCY_YEARLY: {
+			guint64 year = context->year + period * rule->interval;
+			gint month;
+
+			if (year > MAX_YEAR)
+				return FALSE;
+
+			if (rule->by_month != 0 || rule->by_month_day != NULL) {
+				/* BYMONTHDAY without BYMONTH applies to every month */
+				for (month = 1; month <= 12; month++) {
+					if (rule->by_month == 0 || (rule->by_month & (1 << month)) != 0)
+						rule_add_month_days (rule, context, year, month, days);
+				}
+			} else if (rule->by_day != NULL) {
+				/* Ordinals are relative to the whole year */
+				rule_add_weekdays (rule, julian_from_dmy (1, 1, year), julian_from_dmy (31, 12, year), days);
+			} else if (g_date_valid_dmy (context->day, context->month, year)) {
+				guint32 julian = julian_from_dmy (context->day, context->month, year);
+				g_array_append_val (days, julian);
+			}
+
+			break;
+		}
+		default:
+			g_assert_not_reached ();
+	}
+
+	/* Sort and remove duplicates, which can come from overlapping BYDAY or BYMONTHDAY values */
+	g_array_sort (days, compare_days);
+
+	for (i = 0, j = 0; i < days->len; i++) {
+		if (j == 0 || g_array_index (days, guint32, i) != g_array_index (days, guint32, j - 1))
+			g_array_index (days, guint32, j++) = g_array_index (days, guint32, i);
+	}
+
+	g_array_set_size (days, j);
+
+	/* Select from the period's days by position */
+	if (rule->by_set_pos != NULL && days->len > 0) {
+		GArray *selected = g_array_sized_new (FALSE, FALSE, sizeof (guint32), rule->by_set_pos->len);
+
+		for (i = 0; i < rule->by_set_pos->len; i++) {
+			gint position = g_array_index (rule->by_set_pos, gint, i);
+			gint index = (position > 0) ? position - 1 : (gint) days->len + position;
+
+			if (index >= 0 && index < (gint) days->len)
+				g_array_append_val (selected, g_array_index (days, guint32, index));
+		}
+
+		g_array_sort (selected, compare_days);
+
+		g_array_set_size (days, 0);
+		for (i = 0; i < selected->len; i++) {
+			if (i == 0 || g_array_index (selected, guint32, i) != g_array_index (selected, guint32, i - 1))
+				g_array_append_val (days, g_array_index (selected, guint32, i));
+		}
+
+		g_array_unref (selected);
+	}
+
+	return TRUE;
+}
+
+/* Returns a period shortly before the one containing @time, so that expansion can skip the periods before it */
+static guint64
+rule_get_first_period (const RecurrenceRule *rule, const RecurrenceContext *context, gint64 time)
+{
+	GDateTime *utc_date_time, *date_time;
+	guint32 julian;
+	gint year, month;
+	gint64 period;
+
+	if (time <= context->start_time)
+		return 0;
+
+	utc_date_time = g_date_time_new_from_unix_utc (time);
+	if (utc_date_time == NULL)
+		return 0;
+
+	date_time = g_date_time_to_timezone (utc_date_time, context->time_zone);
+	g_date_time_unref (utc_date_time);
+
+	year = g_date_time_get_year (date_time);
+	month = g_date_time_get_month (date_time);
+	julian = julian_from_dmy (g_date_time_get_day_of_month (date_time), month, year);
+	g_date_time_unref (date_time);
+
+	switch (rule->frequency) {
+		case FREQUENCY_DAILY:
+			period = ((gint64) julian - context->julian) / rule->interval;
+			break;
+		case FREQUENCY_WEEKLY:
+			period = ((gint64) julian - context->julian) / (rule->interval * 7);
+			break;
+		case FREQUENCY_MONTHLY:
+			period = ((gint64) (year - context->year) * 12 + (month - context->month)) / rule->interval;
+			break;
+		case FREQUENCY_YEARLY:
+			period = (year - context->year) / rule->interval;
+			break;
+		default:
+			g_assert_not_reached ();
+	}
+
+	return MAX (period - 1, 0);
+}
+
+static inline gboolean
+occurrence_overlaps (gint64 occurrence_start_time, gint64 occurrence_end_time, gint64 start_time, gint64 end_time)
+{
+	/* Instantaneous occurrences overlap the periods which contain them */
+	if (occurrence_start_time == occurrence_end_time)
+		return (occurrence_start_time >= start_time && occurrence_start_time < end_time);
+
+	return (occurrence_start_time < end_time && occurrence_end_time > start_time);
+}
+
+static void
+add_occurrence (const RecurrenceContext *context, gint64 occurrence_start_time, gint64 start_time, gint64 end_time, GArray *occurrences)
+{
+	Occurrence occurrence;
+
+	occurrence.start_time = occurrence_start_time;
+	occurrence.end_time = occurrence_start_time + context->duration;
+	occurrence.is_date = context->is_date;
+
+	if (occurrence_overlaps (occurrence.start_time, occurrence.end_time, start_time, end_time))
+		g_array_append_val (occurrences, occurrence);
+}
+
+/* Appends the rule's occurrences, other than the first occurrence, which overlap the given period */
+static void
+rule_expand (const RecurrenceRule *rule, const RecurrenceContext *context, gint64 start_time, gint64 end_time, GArray *occurrences)
+{
+	GArray *days;
+	guint64 period = 0, n_occurrences = 1; /* the first occurrence is always counted */
+	guint n_empty_periods = 0;
+
+	/* Counted rules have to be expanded from the start; others can skip straight to the requested period */
+	if (rule->count == 0)
+		period = rule_get_first_period (rule, context, start_time - context->duration);
+
+	days = g_array_new (FALSE, FALSE, sizeof (guint32));
+
+	for (; rule_get_period_days (rule, context, period, days) == TRUE; period++) {
+		guint i;
+
+		if (days->len == 0) {
+			if (++n_empty_periods >= MAX_EMPTY_PERIODS)
+				break;
+			continue;
+		}
+
+		n_empty_periods = 0;
+
+		for (i = 0; i < days->len; i++) {
+			gint64 time = context_get_time (context, g_array_index (days, guint32, i));
+
+			/* The first occurrence is added separately */
+			if (time <= context->start_time)
+				continue;
+
+			if (time > rule->until || time >= end_time || (rule->count != 0 && n_occurrences >= rule->count))
+				goto done;
+
+			n_occurrences++;
+			add_occurrence (context, time, start_time, end_time, occurrences);
+		}
+	}
+
+done:
+	g_array_unref (days);
+}
+
+static gint
+compare_occurrences (gconstpointer a, gconstpointer b)
+{
+	const Occurrence *occurrence_a = a, *occurrence_b = b;
+
+	if (occurrence_a->start_time != occurrence_b->start_time)
+		return (occurrence_a->start_time > occurrence_b->start_time) - (occurrence_a->start_time < occurrence_b->start_time);
+
+	return (occurrence_a->end_time > occurrence_b->end_time) - (occurrence_a->end_time < occurrence_b->end_time);
+}
+
+/* Splits a content line such as ‘EXDATE;TZID=Europe/London:20260102T030405’ into its name, its TZID and VALUE parameters, and its value */
+static gboolean
+parse_content_line (gchar *line, gchar **name, gchar **time_zone, gchar **value_type, gchar **value)
+{
+	gchar *colon, *parameter;
+	gboolean in_quotes = FALSE;
+
+	for (colon = line; *colon != '\0' && (*colon != ':' || in_quotes == TRUE); colon++) {
+		if (*colon == '"')
+			in_quotes = !in_quotes;
+	}
+
+	if (*colon != ':')
+		return FALSE;
+
+	*colon = '\0';
+	*value = colon + 1;
+	*time_zone = NULL;
+	*value_type = NULL;
+
+	parameter = strchr (line, ';');
+	if (parameter != NULL)
+		*(parameter++) = '\0';
+	*name = line;
+
+	while (parameter != NULL) {
+		gchar *next = strchr (parameter, ';');
+
+		if (next != NULL)
+			*(next++) = '\0';
+
+		if (g_ascii_strncasecmp (parameter, "TZID=", 5) == 0) {
+			*time_zone = parameter + 5;
+
+			/* Strip any quotes */
+			if (**time_zone == '"') {
+				(*time_zone)++;
+				if (g_str_has_suffix (*time_zone, "\""))
+					(*time_zone)[strlen (*time_zone) - 1] = '\0';
+			}
+		} else if (g_ascii_strncasecmp (parameter, "VALUE=", 6) == 0) {
+			*value_type = parameter + 6;
+		}
+
+		parameter = next;
+	}
+
+	return TRUE;
+}
+
+/* Parses an RDATE or EXDATE line's comma-separated times into @times */
+static gboolean
+parse_times (const RecurrenceContext *context, const gchar *name, const gchar *time_zone_id, const gchar *value_type, const gchar *value,
+             GArray *times, GError **error)
+{
+	GTimeZone *time_zone;
+	gchar **parts;
+	guint i;
+	gboolean success = TRUE;
+
+	if (value_type != NULL && g_ascii_strcasecmp (value_type, "DATE") != 0 && g_ascii_strcasecmp (value_type, "DATE-TIME") != 0)
+		return set_recurrence_error (error, "Unsupported %s value type ‘%s’.", name, value_type);
+
+	time_zone = (time_zone_id != NULL) ? g_time_zone_new (time_zone_id) : g_time_zone_ref (context->time_zone);
+	parts = g_strsplit (value, ",", -1);
+
+	for (i = 0; parts[i] != NULL && success == TRUE; i++) {
+		gint64 time;
+
+		success = context_parse_time (context, parts[i], time_zone, FALSE, &time);
+		if (success == TRUE)
+			g_array_append_val (times, time);
+		else
+			set_recurrence_error (error, "Invalid %s value ‘%s’.", name, parts[i]);
+	}
+
+	g_strfreev (parts);
+	g_time_zone_unref (time_zone);
+
+	return success;
+}
+
+/* Expands the event's recurrence into the Occurrences which overlap the given period, in order */
+static GArray *
+expand_recurrence (GDataCalendarEvent *event, const gchar *recurrence, gint64 start_time, gint64 end_time, GError **error)
+{
+	RecurrenceContext context;
+	GDataGDWhen *when;
+	GDateTime *utc_date_time, *date_time;
+	const gchar *time_zone_id;
+	gchar **lines = NULL;
+	GPtrArray *rules;
+	GArray *rdates, *exdates, *occurrences = NULL;
+	gint64 event_end_time;
+	guint i, j;
+
+	if (gdata_calendar_event_get_primary_time (event, &context.start_time, &event_end_time, &when) == FALSE) {
+		set_recurrence_error (error, "Recurring event ‘%s’ doesn't have a single start time.", gdata_entry_get_id (GDATA_ENTRY (event)));
+		return NULL;
+	}
+
+	context.is_date = gdata_gd_when_is_date (when);
+
+	/* All-day times with no end time last a whole day */
+	if (event_end_time != -1)
+		context.duration = MAX (event_end_time - context.start_time, 0);
+	else
+		context.duration = (context.is_date == TRUE) ? 24 * 60 * 60 : 0;
+
+	/* Expand in the event's own time zone, so that occurrences keep the same local time over daylight saving changes */
+	time_zone_id = _gdata_calendar_event_get_time_zone (event);
+	if (context.is_date == FALSE && time_zone_id != NULL)
+		context.time_zone = g_time_zone_new (time_zone_id);
+	else
+		context.time_zone = g_time_zone_new_utc ();
+
+	utc_date_time = g_date_time_new_from_unix_utc (context.start_time);
+	if (utc_date_time == NULL) {
+		g_time_zone_unref (context.time_zone);
+		set_recurrence_error (error, "Recurring event ‘%s’ has an invalid start time.", gdata_entry_get_id (GDATA_ENTRY (event)));
+		return NULL;
+	}
+
+	date_time = g_date_time_to_timezone (utc_date_time, context.time_zone);
+	g_date_time_unref (utc_date_time);
+
+	g_date_time_get_ymd (date_time, &context.year, &context.month, &context.day);
+	context.hour = g_date_time_get_hour (date_time);
+	context.minute = g_date_time_get_minute (date_time);
+	context.second = g_date_time_get_second (date_time);
+	context.julian = julian_from_dmy (context.day, context.month, context.year);
+	g_date_time_unref (date_time);
+
+	/* Parse the recurrence lines */
+	rules = g_ptr_array_new_with_free_func ((GDestroyNotify) recurrence_rule_free);
+	rdates = g_array_new (FALSE, FALSE, sizeof (gint64));
+	exdates = g_array_new (FALSE, FALSE, sizeof (gint64));
+	lines = g_strsplit (recurrence, "\n", -1);
+
+	for (i = 0; lines[i] != NULL; i++) {
+		gchar *name, *time_zone, *value_type, *value;
+
+		g_strstrip (lines[i]);
+		if (*lines[i] == '\0')
+			continue;
+
+		if (parse_content_line (lines[i], &name, &time_zone, &value_type, &value) == FALSE) {
+			set_recurrence_error (error, "Invalid line ‘%s’.", lines[i]);
+			goto done;
+		}
+
+		if (g_ascii_strcasecmp (name, "RRULE") == 0) {
+			RecurrenceRule *rule = parse_rule (&context, value, error);
+
+			if (rule == NULL)
+				goto done;
+
+			g_ptr_array_add (rules, rule);
+		} else if (g_ascii_strcasecmp (name, "RDATE") == 0) {
+			if (parse_times (&context, name, time_zone, value_type, value, rdates, error) == FALSE)
+				goto done;
+		} else if (g_ascii_strcasecmp (name, "EXDATE") == 0) {
+			if (parse_times (&context, name, time_zone, value_type, value, exdates, error) == FALSE)
+				goto done;
+		} else {
+			set_recurrence_error (error, "Unsupported property ‘%s’.", name);
+			goto done;
+		}
+	}
+
+	/* Expand */
+	occurrences = g_array_new (FALSE, FALSE, sizeof (Occurrence));
+
+	add_occurrence (&context, context.start_time, start_time, end_time, occurrences);
+
+	for (i = 0; i < rules->len; i++)
+		rule_expand (rules->pdata[i], &context, start_time, end_time, occurrences);
+
+	for (i = 0; i < rdates->len; i++)
+		add_occurrence (&context, g_array_index (rdates, gint64, i), start_time, end_time, occurrences);
+
+	/* Sort, and remove duplicates (from overlapping rules and dates) and excluded occurrences */
+	g_array_sort (occurrences, compare_occurrences);
+
+	for (i = 0, j = 0; i < occurrences->len; i++) {
+		const Occurrence *occurrence = &g_array_index (occurrences, Occurrence, i);
+		gboolean is_excluded = FALSE;
+		guint k;
+
+		if (j > 0 && g_array_index (occurrences, Occurrence, j - 1).start_time == occurrence->start_time)
+			continue;
+
+		for (k = 0; k < exdates->len && is_excluded == FALSE; k++)
+			is_excluded = (g_array_index (exdates, gint64, k) == occurrence->start_time);
+
+		if (is_excluded == FALSE)
+			g_array_index (occurrences, Occurrence, j++) = *occurrence;
+	}
+
+	g_array_set_size (occurrences, j);
+
+done:
+	g_strfreev (lines);
+	g_array_unref (exdates);
+	g_array_unref (rdates);
+	g_ptr_array_unref (rules);
+	g_time_zone_unref (context.time_zone);
+
+	return occurrences;
+}
+
+/* Returns the cached occurrences of the event which overlap the given period, or %NULL if they aren't cached. Stale expansions of previous
+ * versions of the event are dropped. */
+static GArray *
+cache_lookup (GDataCalendarEventExpander *self, const gchar *id, const gchar *etag, gint64 start_time, gint64 end_time)
+{
+	CachedEvent *cached;
+	GSList *l;
+
+	cached = g_hash_table_lookup (self->priv->cache, id);
+	if (cached == NULL)
+		return NULL;
+
+	if (g_strcmp0 (cached->etag, etag) != 0) {
+		g_hash_table_remove (self->priv->cache, id);
+		return NULL;
+	}
+
+	/* Any cached period which contains the requested one will do */
+	for (l = cached->windows; l != NULL; l = l->next) {
+		CachedWindow *window = l->data;
+
+		if (window->start_time <= start_time && window->end_time >= end_time)
+			return window->occurrences;
+	}
+
+	return NULL;
+}
+
+static void
+cache_insert (GDataCalendarEventExpander *self, const gchar *id, const gchar *etag, gint64 start_time, gint64 end_time, GArray *occurrences)
+{
+	CachedEvent *cached;
+	CachedWindow *window;
+	GSList *last;
+
+	cached = g_hash_table_lookup (self->priv->cache, id);
+	if (cached == NULL || g_strcmp0 (cached->etag, etag) != 0) {
+		cached = g_slice_new0 (CachedEvent);
+		cached->etag = g_strdup (etag);
+		g_hash_table_insert (self->priv->cache, g_strdup (id), cached);
+	}
+
+	window = g_slice_new (CachedWindow);
+	window->start_time = start_time;
+	window->end_time = end_time;
+	window->occurrences = g_array_ref (occurrences);
+
+	cached->windows = g_slist_prepend (cached->windows, window);
+
+	/* Drop the oldest period if there are too many */
+	if (g_slist_length (cached->windows) > MAX_CACHED_WINDOWS) {
+		last = g_slist_last (cached->windows);
+		cached_window_free (last->data);
+		cached->windows = g_slist_delete_link (cached->windows, last);
+	}
+}
+
+static void
+append_instances (GArray *instances, GDataCalendarEvent *event, GArray *occurrences, gint64 start_time, gint64 end_time,
+                  GHashTable *overridden_start_times)
+{
+	guint i;
+
+	for (i = 0; i < occurrences->len; i++) {
+		const Occurrence *occurrence = &g_array_index (occurrences, Occurrence, i);
+		GDataCalendarEventInstance instance;
+
+		if (!occurrence_overlaps (occurrence->start_time, occurrence->end_time, start_time, end_time) ||
+		    (overridden_start_times != NULL && g_hash_table_contains (overridden_start_times, &occurrence->start_time))) {
+			continue;
+		}
+
+		instance.event = event;
+		instance.start_time = occurrence->start_time;
+		instance.end_time = occurrence->end_time;
+		instance.is_date = occurrence->is_date;
+
+		g_array_append_val (instances, instance);
+	}
+}
+
+static gboolean
+expand_event (GDataCalendarEventExpander *self, GDataCalendarEvent *event, gint64 start_time, gint64 end_time, GHashTable *overridden_start_times,
+              GArray *instances, GError **error)
+{
+	const gchar *recurrence, *id, *etag;
+	GArray *occurrences;
+	GList *l;
+
+	recurrence = gdata_calendar_event_get_recurrence (event);
+
+	/* Events which don't recur occur at their own times */
+	if (recurrence == NULL) {
+		for (l = gdata_calendar_event_get_times (event); l != NULL; l = l->next) {
+			GDataGDWhen *when = l->data;
+			GDataCalendarEventInstance instance;
+
+			instance.event = event;
+			instance.start_time = gdata_gd_when_get_start_time (when);
+			instance.end_time = gdata_gd_when_get_end_time (when);
+			instance.is_date = gdata_gd_when_is_date (when);
+
+			if (instance.end_time == -1)
+				instance.end_time = instance.start_time + ((instance.is_date == TRUE) ? 24 * 60 * 60 : 0);
+
+			if (occurrence_overlaps (instance.start_time, instance.end_time, start_time, end_time))
+				g_array_append_val (instances, instance);
+		}
+
+		return TRUE;
+	}
+
+	/* Events which haven't been inserted yet have no ID or ETag, and can't be cached */
+	id = gdata_entry_get_id (GDATA_ENTRY (event));
+	etag = gdata_entry_get_etag (GDATA_ENTRY (event));
+
+	if (id != NULL && etag != NULL) {
+		occurrences = cache_lookup (self, id, etag, start_time, end_time);
+		if (occurrences != NULL) {
+			append_instances (instances, event, occurrences, start_time, end_time, overridden_start_times);
+			return TRUE;
+		}
+	}
+
+	occurrences = expand_recurrence (event, recurrence, start_time, end_time, error);
+	if (occurrences == NULL)
+		return FALSE;
+
+	if (id != NULL && etag != NULL)
+		cache_insert (self, id, etag, start_time, end_time, occurrences);
+
+	append_instances (instances, event, occurrences, start_time, end_time, overridden_start_times);
+	g_array_unref (occurrences);
+
+	return TRUE;
+}
+
+static gint
+compare_instances (gconstpointer a, gconstpointer b)
+{
+	const GDataCalendarEventInstance *instance_a = a, *instance_b = b;
+
+	if (instance_a->start_time != instance_b->start_time)
+		return (instance_a->start_time > instance_b->start_time) - (instance_a->start_time < instance_b->start_time);
+
+	return (instance_a->end_time > instance_b->end_time) - (instance_a->end_time < instance_b->end_time);
+}
+
+/**
+ * gdata_calendar_event_expander_new:
+ *
+ * Creates a new #GDataCalendarEventExpander with an empty cache.
+ *
+ * Return value: (transfer full): a new #GDataCalendarEventExpander; unref with g_object_unref()
+ *
+ * Since: 0.19.0
+ */
+GDataCalendarEventExpander *
+gdata_calendar_event_expander_new (void)
+{
+	return g_object_new (GDATA_TYPE_CALENDAR_EVENT_EXPANDER, NULL);
+}
+
+/**
+ * gdata_calendar_event_expander_expand:
+ * @self: a #GDataCalendarEventExpander
+ * @event: the #GDataCalendarEvent to expand
+ * @start_time: the start of the period to expand over, as a UNIX timestamp (inclusive)
+ * @end_time: the end of the period to expand over, as a UNIX timestamp (exclusive)
+ * @error: a #GError, or %NULL
+ *
+ * Expands @event's #GDataCalendarEvent:recurrence into the occurrences of @event which overlap the period from @start_time up to (but not
+ * including) @end_time. The first occurrence is always at the event's own start time. If @event doesn't recur, its own times which overlap the
+ * period are returned.
+ *
+ * This doesn't take exceptions to the recurrence into account, since they're separate events; use
+ * gdata_calendar_event_expander_expand_events() to expand recurring events and their exceptions together.
+ *
+ * If the recurrence uses a part of RFC 5545 which isn't supported, a %GDATA_PARSER_ERROR_PARSING_STRING error is returned.
+ *
+ * Return value: (transfer full) (element-type GDataCalendarEventInstance): the occurrences, in order of start time, or %NULL on error; free with
+ * g_array_unref()
+ *
+ * Since: 0.19.0
+ */
+GArray *
+gdata_calendar_event_expander_expand (GDataCalendarEventExpander *self, GDataCalendarEvent *event, gint64 start_time, gint64 end_time,
+                                      GError **error)
+{
+	GArray *instances;
+
+	g_return_val_if_fail (GDATA_IS_CALENDAR_EVENT_EXPANDER (self), NULL);
+	g_return_val_if_fail (GDATA_IS_CALENDAR_EVENT (event), NULL);
+	g_return_val_if_fail (start_time <= end_time, NULL);
+	g_return_val_if_fail (error == NULL || *error == NULL, NULL);
+
+	instances = g_array_new (FALSE, FALSE, sizeof (GDataCalendarEventInstance));
+
+	if (expand_event (self, event, start_time, end_time, NULL, instances, error) == FALSE) {
+		g_array_unref (instances);
+		return NULL;
+	}
+
+	g_array_sort (instances, compare_instances);
+
+	return instances;
+}
+
+/**
+ * gdata_calendar_event_expander_expand_events:
+ * @self: a #GDataCalendarEventExpander
+ * @events: (element-type GDataCalendarEvent): a list of #GDataCalendarEvents
+ * @start_time: the start of the period to expand over, as a UNIX timestamp (inclusive)
+ * @end_time: the end of the period to expand over, as a UNIX timestamp (exclusive)
+ * @error: a #GError, or %NULL
+ *
+ * Expands all of @events over the period from @start_time up to (but not including) @end_time, as with gdata_calendar_event_expander_expand(),
+ * and merges their occurrences. @events would typically be the entries of a #GDataFeed returned by a query with
+ * #GDataCalendarQuery:single-events set to %FALSE (see gdata_feed_get_entries()).
+ *
+ * Exceptions to recurring events in @events replace the occurrences of the recurring event which they're exceptions to, and cancelled exceptions
+ * remove them. Other cancelled events are ignored.
+ *
+ * The occurrences don't reference their events, so @events must be kept alive while the occurrences are in use.
+ *
+ * Return value: (transfer full) (element-type GDataCalendarEventInstance): the occurrences, in order of start time, or %NULL on error; free with
+ * g_array_unref()
+ *
+ * Since: 0.19.0
+ */
+GArray *
+gdata_calendar_event_expander_expand_events (GDataCalendarEventExpander *self, GList *events, gint64 start_time, gint64 end_time, GError **error)
+{
+	GHashTable *overrides; /* recurring event ID → set of original start times (gint64 *) which are overridden by exceptions */
+	GArray *instances;
+	GList *l;
+
+	g_return_val_if_fail (GDATA_IS_CALENDAR_EVENT_EXPANDER (self), NULL);
+	g_return_val_if_fail (start_time <= end_time, NULL);
+	g_return_val_if_fail (error == NULL || *error == NULL, NULL);
+
+	/* Find the exceptions first, so their original occurrences can be skipped when expanding the recurring events */
+	overrides = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify) g_hash_table_unref);
+
+	for (l = events; l != NULL; l = l->next) {
+		GDataCalendarEvent *event;
+		GHashTable *start_times;
+		gchar *original_event_id = NULL;
+		gint64 original_start_time, *key;
+
+		if (!GDATA_IS_CALENDAR_EVENT (l->data))
+			continue;
+
+		event = GDATA_CALENDAR_EVENT (l->data);
+		original_start_time = _gdata_calendar_event_get_original_start_time (event);
+		gdata_calendar_event_get_original_event_details (event, &original_event_id, NULL);
+
+		if (original_event_id == NULL || original_start_time == -1) {
+			g_free (original_event_id);
+			continue;
+		}
+
+		start_times = g_hash_table_lookup (overrides, original_event_id);
+		if (start_times == NULL) {
+			start_times = g_hash_table_new_full (g_int64_hash, g_int64_equal, g_free, NULL);
+			g_hash_table_insert (overrides, original_event_id, start_times);  /* transfer ownership */
+		} else {
+			g_free (original_event_id);
+		}
+
+		key = g_new (gint64, 1);
+		*key = original_start_time;
+		g_hash_table_add (start_times, key);
+	}
+
+	/* Expand everything else */
+	instances = g_array_new (FALSE, FALSE, sizeof (GDataCalendarEventInstance));
+
+	for (l = events; l != NULL; l = l->next) {
+		GDataCalendarEvent *event;
+		GHashTable *overridden_start_times = NULL;
+		const gchar *id;
+
+		if (!GDATA_IS_CALENDAR_EVENT (l->data))
+			continue;
+
+		event = GDATA_CALENDAR_EVENT (l->data);
+
+		/* Cancelled exceptions only remove an occurrence */
+		if (g_strcmp0 (gdata_calendar_event_get_status (event), GDATA_GD_EVENT_STATUS_CANCELED) == 0)
+			continue;
+
+		id = gdata_entry_get_id (GDATA_ENTRY (event));
+		if (id != NULL)
+			overridden_start_times = g_hash_table_lookup (overrides, id);
+
+		if (expand_event (self, event, start_time, end_time, overridden_start_times, instances, error) == FALSE) {
+			g_array_unref (instances);
+			g_hash_table_unref (overrides);
+			return NULL;
+		}
+	}
+
+	g_hash_table_unref (overrides);
+
+	g_array_sort (instances, compare_instances);
+
+	return instances;
+}
+
+/**
+ * gdata_calendar_event_expander_clear_cache:
+ * @self: a #GDataCalendarEventExpander
+ *
+ * Drops all the cached expansions. This isn't needed for correctness, since expansions of an event are discarded when its ETag changes, but frees
+ * the memory used by the expansions of events which are no longer of interest.
+ *
+ * Since: 0.19.0
+ */
+void
+gdata_calendar_event_expander_clear_cache (GDataCalendarEventExpander *self)
+{
+	g_return_if_fail (GDATA_IS_CALENDAR_EVENT_EXPANDER (self));
+
+	g_hash_table_remove_all (self->priv->cache);
+}
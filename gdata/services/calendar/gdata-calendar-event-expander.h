@@ -0,0 +1,100 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 8; tab-width: 8 -*- */
+/*
+ * GData Client
+ *
+ * GData Client is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * GData Client is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GData Client.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GDATA_CALENDAR_EVENT_EXPANDER_H
+#define GDATA_CALENDAR_EVENT_EXPANDER_H
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <gdata/services/calendar/gdata-calendar-event.h>
+
+G_BEGIN_DECLS
+
+/**
+ * GDataCalendarEventInstance:
+ * @event: the event the instance is of; this isn't referenced, so is only valid for as long as the event passed to the expander is
+ * @start_time: the instance's start time, as a UNIX timestamp
+ * @end_time: the instance's end time, as a UNIX timestamp; equal to @start_time for instantaneous events
+ * @is_date: %TRUE if the instance is an all-day one, %FALSE otherwise
+ *
+ * A single occurrence of a #GDataCalendarEvent, as returned by gdata_calendar_event_expander_expand().
+ *
+ * Since: 0.19.0
+ */
+typedef struct {
+	GDataCalendarEvent *event;
+	gint64 start_time;
+	gint64 end_time;
+	gboolean is_date;
+} GDataCalendarEventInstance;
+
+#define GDATA_TYPE_CALENDAR_EVENT_EXPANDER		(gdata_calendar_event_expander_get_type ())
+#define GDATA_CALENDAR_EVENT_EXPANDER(o)		(G_TYPE_CHECK_INSTANCE_CAST ((o), GDATA_TYPE_CALENDAR_EVENT_EXPANDER, GDataCalendarEventExpander))
+#define GDATA_CALENDAR_EVENT_EXPANDER_CLASS(k)		(G_TYPE_CHECK_CLASS_CAST((k), GDATA_TYPE_CALENDAR_EVENT_EXPANDER, GDataCalendarEventExpanderClass))
+#define GDATA_IS_CALENDAR_EVENT_EXPANDER(o)		(G_TYPE_CHECK_INSTANCE_TYPE ((o), GDATA_TYPE_CALENDAR_EVENT_EXPANDER))
+#define GDATA_IS_CALENDAR_EVENT_EXPANDER_CLASS(k)	(G_TYPE_CHECK_CLASS_TYPE ((k), GDATA_TYPE_CALENDAR_EVENT_EXPANDER))
+#define GDATA_CALENDAR_EVENT_EXPANDER_GET_CLASS(o)	(G_TYPE_INSTANCE_GET_CLASS ((o), GDATA_TYPE_CALENDAR_EVENT_EXPANDER, GDataCalendarEventExpanderClass))
+
+typedef struct _GDataCalendarEventExpanderPrivate	GDataCalendarEventExpanderPrivate;
+
+/**
+ * GDataCalendarEventExpander:
+ *
+ * All the fields in the #GDataCalendarEventExpander structure are private and should never be accessed directly.
+ *
+ * Since: 0.19.0
+ */
+typedef struct {
+	GObject parent;
+	GDataCalendarEventExpanderPrivate *priv;
+} GDataCalendarEventExpander;
+
+/**
+ * GDataCalendarEventExpanderClass:
+ *
+ * All the fields in the #GDataCalendarEventExpanderClass structure are private and should never be accessed directly.
+ *
+ * Since: 0.19.0
+ */
+typedef struct {
+	/*< private >*/
+	GObjectClass parent;
+
+	/*< private >*/
+	/* Padding for future expansion */
+	void (*_g_reserved0) (void);
+	void (*_g_reserved1) (void);
+	void (*_g_reserved2) (void);
+	void (*_g_reserved3) (void);
+} GDataCalendarEventExpanderClass;
+
+GType gdata_calendar_event_expander_get_type (void) G_GNUC_CONST;
+G_DEFINE_AUTOPTR_CLEANUP_FUNC (GDataCalendarEventExpander, g_object_unref)
+
+GDataCalendarEventExpander *gdata_calendar_event_expander_new (void) G_GNUC_WARN_UNUSED_RESULT G_GNUC_MALLOC;
+
+GArray *gdata_calendar_event_expander_expand (GDataCalendarEventExpander *self, GDataCalendarEvent *event, gint64 start_time, gint64 end_time,
+                                              GError **error) G_GNUC_WARN_UNUSED_RESULT;
+GArray *gdata_calendar_event_expander_expand_events (GDataCalendarEventExpander *self, GList *events, gint64 start_time, gint64 end_time,
+                                                     GError **error) G_GNUC_WARN_UNUSED_RESULT;
+void gdata_calendar_event_expander_clear_cache (GDataCalendarEventExpander *self);
+
+G_END_DECLS
+
+#endif /* !GDATA_CALENDAR_EVENT_EXPANDER_H */
@@ -0,0 +1,665 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 8; tab-width: 8 -*- */
+/*
+ * GData Client
+ *
+ * GData Client is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * GData Client is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GData Client.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * SECTION:gdata-calendar-event-index
+ * @short_description: GData Calendar event time index
+ * @stability: Unstable
+ * @include: gdata/services/calendar/gdata-calendar-event-index.h
+ *
+ * #GDataCalendarEventIndex indexes a set of #GDataCalendarEvents by their times (see gdata_calendar_event_get_times()), so that questions such
+ * as “which events overlap this period?” or “is this room free?” can be answered without scanning every event. It's typically built from the
+ * #GDataFeed returned by gdata_calendar_service_query_events(), and then kept up to date as the calendar is re-synchronised, using
+ * gdata_calendar_event_index_add_event() and gdata_calendar_event_index_remove_event().
+ *
+ * The index is an interval tree: overlap queries take O(log n + k) time for n indexed times and k results, and
+ * gdata_calendar_event_index_is_free() and gdata_calendar_event_index_get_next_event() take O(log n) time. Adding or removing an event takes
+ * O(log n) time per time of the event.
+ *
+ * Each time of an event covers the half-open period from its start time up to (but not including) its end time. All-day times with no end time
+ * cover a whole day, and other times with no end time are instantaneous: they overlap the periods which contain their start time. Instantaneous times, and
+ * the times of events whose #GDataCalendarEvent:transparency is %GDATA_GD_EVENT_TRANSPARENCY_TRANSPARENT, are returned by overlap queries, but
+ * don't count as busy for gdata_calendar_event_index_is_free() or gdata_calendar_event_index_get_busy_periods(). Cancelled events aren't indexed at all.
+ *
+ * A #GDataCalendarEventIndex is not thread safe, and must only be used from one thread at a time.
+ *
+ * <example>
+ * 	<title>Checking a Room's Availability</title>
+ * 	<programlisting>
+ *	GDataCalendarEventIndex *index;
+ *	GDataCalendarQuery *query;
+ *	GDataFeed *feed;
+ *	GError *error = NULL;
+ *
+ *	/<!-- -->* Fetch the room's events for the next month, including cancelled ones so that re-syncing the index later removes them *<!-- -->/
+ *	query = gdata_calendar_query_new_with_limits (NULL, now, now + 31 * 24 * 60 * 60);
+ *	gdata_calendar_query_set_single_events (query, TRUE);
+ *	gdata_calendar_query_set_show_deleted (query, TRUE);
+ *
+ *	feed = gdata_calendar_service_query_events (service, room_calendar, GDATA_QUERY (query), NULL, NULL, NULL, &error);
+ *	g_object_unref (query);
+ *
+ *	if (error != NULL) {
+ *		g_error ("Error querying for events: %s", error->message);
+ *		g_error_free (error);
+ *		return;
+ *	}
+ *
+ *	index = gdata_calendar_event_index_new (feed);
+ *	g_object_unref (feed);
+ *
+ *	/<!-- -->* Check whether the room is free for an hour from 14:00 *<!-- -->/
+ *	if (gdata_calendar_event_index_is_free (index, two_pm, two_pm + 60 * 60) == TRUE) {
+ *		/<!-- -->* Book the room here *<!-- -->/
+ *	}
+ *
+ *	g_object_unref (index);
+ * 	</programlisting>
+ * </example>
+ *
+ * Since: 0.19.0
+ */
+
+#include <config.h>
+#include <glib.h>
+
+#include "gdata-calendar-event-index.h"
+#include "gdata-private.h"
+
+typedef struct _EventRecord EventRecord;
+typedef struct _IntervalNode IntervalNode;
+
+/* A node of the interval tree, which is a treap ordered by start time and augmented with the greatest end time in each subtree. Each node is one
+ * time of an event. */
+struct _IntervalNode {
+	gint64 start_time; /* inclusive */
+	gint64 end_time; /* exclusive; equal to start_time for instantaneous times */
+	gint64 max_end_time; /* greatest end_time in the subtree rooted at this node */
+	gint64 max_busy_end_time; /* greatest end_time of the busy nodes in the subtree rooted at this node, or G_MININT64 if there are none */
+	guint32 priority; /* random; every node's priority is at least that of its children */
+	gboolean is_busy;
+	EventRecord *record;
+	IntervalNode *left;
+	IntervalNode *right;
+};
+
+struct _EventRecord {
+	GDataCalendarEvent *event; /* owned */
+	GSList *nodes; /* IntervalNodes for each of the event's times; the list is owned, but the nodes are owned by the tree */
+	guint query_serial; /* serial of the last query which returned the event, so that events with several times are only returned once */
+};
+
+static void gdata_calendar_event_index_finalize (GObject *object);
+
+struct _GDataCalendarEventIndexPrivate {
+	GHashTable *events; /* event ID → owned EventRecord */
+	IntervalNode *root;
+	guint query_serial;
+};
+
+G_DEFINE_TYPE_WITH_PRIVATE (GDataCalendarEventIndex, gdata_calendar_event_index, G_TYPE_OBJECT)
+
+static void
+gdata_calendar_event_index_class_init (GDataCalendarEventIndexClass *klass)
+{
+	GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+
+	gobject_class->finalize = gdata_calendar_event_index_finalize;
+}
+
+static void
+event_record_free (EventRecord *record)
+{
+	g_object_unref (record->event);
+	g_slist_free (record->nodes);
+	g_slice_free (EventRecord, record);
+}
+
+static void
+gdata_calendar_event_index_init (GDataCalendarEventIndex *self)
+{
+	self->priv = gdata_calendar_event_index_get_instance_private (self);
+	self->priv->events = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify) event_record_free);
+}
+
+static void
+tree_free (IntervalNode *node)
+{
+	if (node == NULL)
+		return;
+
+	tree_free (node->left);
+	tree_free (node->right);
+	g_slice_free (IntervalNode, node);
+}
+
+static void
+gdata_calendar_event_index_finalize (GObject *object)
+{
+	GDataCalendarEventIndexPrivate *priv = GDATA_CALENDAR_EVENT_INDEX (object)->priv;
+
+	tree_free (priv->root);
+	g_hash_table_unref (priv->events);
+
+	/* Chain up to the parent class */
+	G_OBJECT_CLASS (gdata_calendar_event_index_parent_class)->finalize (object);
+}
+
+/* Nodes are ordered by start time; nodes with the same start time are ordered by address, so that every node has a unique position */
+static inline gboolean
+node_is_before (const IntervalNode *a, const IntervalNode *b)
+{
+	if (a->start_time != b->start_time)
+		return (a->start_time < b->start_time);
+
+	return ((guintptr) a < (guintptr) b);
+}
+
+static inline gboolean
+node_overlaps (const IntervalNode *node, gint64 start_time, gint64 end_time)
+{
+	/* Instantaneous times overlap the periods which contain them */
+	if (node->start_time == node->end_time)
+		return (node->start_time >= start_time && node->start_time < end_time);
+
+	return (node->start_time < end_time && node->end_time > start_time);
+}
+
+static void
+node_update (IntervalNode *node)
+{
+	node->max_end_time = node->end_time;
+	node->max_busy_end_time = (node->is_busy == TRUE) ? node->end_time : G_MININT64;
+
+	if (node->left != NULL) {
+		node->max_end_time = MAX (node->max_end_time, node->left->max_end_time);
+		node->max_busy_end_time = MAX (node->max_busy_end_time, node->left->max_busy_end_time);
+	}
+
+	if (node->right != NULL) {
+		node->max_end_time = MAX (node->max_end_time, node->right->max_end_time);
+		node->max_busy_end_time = MAX (node->max_busy_end_time, node->right->max_busy_end_time);
+	}
+}
+
+static IntervalNode *
+rotate_left (IntervalNode *node)
+{
+	IntervalNode *right = node->right;
+
+	node->right = right->left;
+	right->left = node;
+
+	node_update (node);
+	node_update (right);
+
+	return right;
+}
+
+static IntervalNode *
+rotate_right (IntervalNode *node)
+{
+	IntervalNode *left = node->left;
+
+	node->left = left->right;
+	left->right = node;
+
+	node_update (node);
+	node_update (left);
+
+	return left;
+}
+
+/* Returns the new root of the subtree */
+static IntervalNode *
+tree_insert (IntervalNode *root, IntervalNode *node)
+{
+	if (root == NULL) {
+		node_update (node);
+		return node;
+	}
+
+	if (node_is_before (node, root) == TRUE) {
+		root->left = tree_insert (root->left, node);
+		if (root->left->priority > root->priority)
+			return rotate_right (root);
+	} else {
+		root->right = tree_insert (root->right, node);
+		if (root->right->priority > root->priority)
+			return rotate_left (root);
+	}
+
+	node_update (root);
+
+	return root;
+}
+
+/* Joins two subtrees, where every node in @left is before every node in @right, and returns the new root */
+static IntervalNode *
+tree_merge (IntervalNode *left, IntervalNode *right)
+{
+	if (left == NULL)
+		return right;
+	if (right == NULL)
+		return left;
+
+	if (left->priority > right->priority) {
+		left->right = tree_merge (left->right, right);
+		node_update (left);
+		return left;
+	} else {
+		right->left = tree_merge (left, right->left);
+		node_update (right);
+		return right;
+	}
+}
+
+/* Unlinks @node from the subtree (but doesn't free it), and returns the new root of the subtree */
+static IntervalNode *
+tree_remove (IntervalNode *root, IntervalNode *node)
+{
+	g_assert (root != NULL);
+
+	if (root == node)
+		return tree_merge (node->left, node->right);
+
+	if (node_is_before (node, root) == TRUE)
+		root->left = tree_remove (root->left, node);
+	else
+		root->right = tree_remove (root->right, node);
+
+	node_update (root);
+
+	return root;
+}
+
+/* Appends the nodes overlapping the given period to @nodes, in start time order. If @busy_only is TRUE, only busy nodes are appended. */
+static void
+collect_overlapping (IntervalNode *node, gint64 start_time, gint64 end_time, gboolean busy_only, GPtrArray *nodes)
+{
+	while (node != NULL) {
+		/* Nothing in this subtree ends late enough to overlap */
+		if (((busy_only == TRUE) ? node->max_busy_end_time : node->max_end_time) < start_time)
+			return;
+
+		collect_overlapping (node->left, start_time, end_time, busy_only, nodes);
+
+		/* This node and everything after it start too late to overlap */
+		if (node->start_time >= end_time)
+			return;
+
+		if ((busy_only == FALSE || node->is_busy == TRUE) && node_overlaps (node, start_time, end_time) == TRUE)
+			g_ptr_array_add (nodes, node);
+
+		node = node->right;
+	}
+}
+
+static gboolean
+has_busy_overlap (IntervalNode *node, gint64 start_time, gint64 end_time)
+{
+	while (node != NULL && node->max_busy_end_time >= start_time) {
+		if (has_busy_overlap (node->left, start_time, end_time) == TRUE)
+			return TRUE;
+
+		if (node->start_time >= end_time)
+			return FALSE;
+
+		if (node->is_busy == TRUE && node_overlaps (node, start_time, end_time) == TRUE)
+			return TRUE;
+
+		node = node->right;
+	}
+
+	return FALSE;
+}
+
+/**
+ * gdata_calendar_event_index_new:
+ * @feed: (allow-none): a #GDataFeed of #GDataCalendarEvents to index, or %NULL
+ *
+ * Creates a new #GDataCalendarEventIndex containing the events in @feed, if it's non-%NULL. Entries in @feed which aren't #GDataCalendarEvents
+ * are ignored.
+ *
+ * Return value: (transfer full): a new #GDataCalendarEventIndex; unref with g_object_unref()
+ *
+ * Since: 0.19.0
+ */
+GDataCalendarEventIndex *
+gdata_calendar_event_index_new (GDataFeed *feed)
+{
+	GDataCalendarEventIndex *self;
+
+	g_return_val_if_fail (feed == NULL || GDATA_IS_FEED (feed), NULL);
+
+	self = g_object_new (GDATA_TYPE_CALENDAR_EVENT_INDEX, NULL);
+
+	if (feed != NULL)
+		gdata_calendar_event_index_add_feed (self, feed);
+
+	return self;
+}
+
+/**
+ * gdata_calendar_event_index_add_feed:
+ * @self: a #GDataCalendarEventIndex
+ * @feed: a #GDataFeed of #GDataCalendarEvents
+ *
+ * Adds each of the #GDataCalendarEvents in @feed to the index, as with gdata_calendar_event_index_add_event(). Entries in @feed which aren't
+ * #GDataCalendarEvents are ignored.
+ *
+ * This can be used to apply the results of an incremental re-sync of the calendar (for example, one using #GDataQuery:updated-min and
+ * #GDataCalendarQuery:show-deleted) to the index.
+ *
+ * Since: 0.19.0
+ */
+void
+gdata_calendar_event_index_add_feed (GDataCalendarEventIndex *self, GDataFeed *feed)
+{
+	GList *i;
+
+	g_return_if_fail (GDATA_IS_CALENDAR_EVENT_INDEX (self));
+	g_return_if_fail (GDATA_IS_FEED (feed));
+
+	for (i = gdata_feed_get_entries (feed); i != NULL; i = i->next) {
+		if (GDATA_IS_CALENDAR_EVENT (i->data) == TRUE && gdata_entry_get_id (GDATA_ENTRY (i->data)) != NULL)
+			gdata_calendar_event_index_add_event (self, GDATA_CALENDAR_EVENT (i->data));
+	}
+}
+
+/**
+ * gdata_calendar_event_index_add_event:
+ * @self: a #GDataCalendarEventIndex
+ * @event: the #GDataCalendarEvent to add
+ *
+ * Adds @event to the index, replacing any indexed event with the same #GDataEntry:id. If @event has been cancelled, any indexed event with the
+ * same ID is removed instead, and @event isn't added.
+ *
+ * @event must have an ID. The index keeps a reference to @event, which must not be modified while it's indexed.
+ *
+ * Since: 0.19.0
+ */
+void
+gdata_calendar_event_index_add_event (GDataCalendarEventIndex *self, GDataCalendarEvent *event)
+{
+	GDataCalendarEventIndexPrivate *priv;
+	EventRecord *record;
+	const gchar *id;
+	gboolean is_busy;
+	GList *i;
+
+	g_return_if_fail (GDATA_IS_CALENDAR_EVENT_INDEX (self));
+	g_return_if_fail (GDATA_IS_CALENDAR_EVENT (event));
+
+	priv = self->priv;
+	id = gdata_entry_get_id (GDATA_ENTRY (event));
+	g_return_if_fail (id != NULL);
+
+	gdata_calendar_event_index_remove_event (self, id);
+
+	if (_gdata_entry_is_deleted (GDATA_ENTRY (event)) == TRUE)
+		return;
+
+	record = g_slice_new0 (EventRecord);
+	record->event = g_object_ref (event);
+
+	is_busy = (g_strcmp0 (gdata_calendar_event_get_transparency (event), GDATA_GD_EVENT_TRANSPARENCY_TRANSPARENT) != 0);
+
+	for (i = gdata_calendar_event_get_times (event); i != NULL; i = i->next) {
+		GDataGDWhen *when = GDATA_GD_WHEN (i->data);
+		IntervalNode *node;
+
+		node = g_slice_new0 (IntervalNode);
+		node->start_time = gdata_gd_when_get_start_time (when);
+		node->end_time = gdata_gd_when_get_end_time (when);
+		node->priority = g_random_int ();
+		node->record = record;
+
+		if (node->end_time == -1)
+			node->end_time = node->start_time + ((gdata_gd_when_is_date (when) == TRUE) ? 24 * 60 * 60 : 0);
+		else if (node->end_time < node->start_time)
+			node->end_time = node->start_time;
+
+		/* Instantaneous times don't take up any time */
+		node->is_busy = (is_busy == TRUE && node->end_time > node->start_time);
+
+		record->nodes = g_slist_prepend (record->nodes, node);
+		priv->root = tree_insert (priv->root, node);
+	}
+
+	g_hash_table_insert (priv->events, g_strdup (id), record);
+}
+
+/**
+ * gdata_calendar_event_index_remove_event:
+ * @self: a #GDataCalendarEventIndex
+ * @event_id: the #GDataEntry:id of the event to remove
+ *
+ * Removes the event with ID @event_id from the index, if it's there.
+ *
+ * Return value: %TRUE if the event was in the index, %FALSE otherwise
+ *
+ * Since: 0.19.0
+ */
+gboolean
+gdata_calendar_event_index_remove_event (GDataCalendarEventIndex *self, const gchar *event_id)
+{
+	GDataCalendarEventIndexPrivate *priv;
+	EventRecord *record;
+	GSList *i;
+
+	g_return_val_if_fail (GDATA_IS_CALENDAR_EVENT_INDEX (self), FALSE);
+	g_return_val_if_fail (event_id != NULL, FALSE);
+
+	priv = self->priv;
+	record = g_hash_table_lookup (priv->events, event_id);
+	if (record == NULL)
+		return FALSE;
+
+	for (i = record->nodes; i != NULL; i = i->next) {
+		priv->root = tree_remove (priv->root, i->data);
+		g_slice_free (IntervalNode, i->data);
+	}
+
+	/* This frees the record */
+	g_hash_table_remove (priv->events, event_id);
+
+	return TRUE;
+}
+
+/**
+ * gdata_calendar_event_index_get_n_events:
+ * @self: a #GDataCalendarEventIndex
+ *
+ * Gets the number of events in the index.
+ *
+ * Return value: the number of indexed events
+ *
+ * Since: 0.19.0
+ */
+guint
+gdata_calendar_event_index_get_n_events (GDataCalendarEventIndex *self)
+{
+	g_return_val_if_fail (GDATA_IS_CALENDAR_EVENT_INDEX (self), 0);
+	return g_hash_table_size (self->priv->events);
+}
+
+/**
+ * gdata_calendar_event_index_query_overlapping:
+ * @self: a #GDataCalendarEventIndex
+ * @start_time: the start of the period, as a UNIX timestamp (inclusive)
+ * @end_time: the end of the period, as a UNIX timestamp (exclusive)
+ *
+ * Lists the indexed events which have a time overlapping the period from @start_time up to @end_time, ordered by the start of their first
+ * overlapping time. Each event is only listed once, however many of its times overlap the period.
+ *
+ * Return value: (transfer container) (element-type GDataCalendarEvent): the overlapping events, which are owned by the index; free the list
+ * with g_list_free()
+ *
+ * Since: 0.19.0
+ */
+GList *
+gdata_calendar_event_index_query_overlapping (GDataCalendarEventIndex *self, gint64 start_time, gint64 end_time)
+{
+	GDataCalendarEventIndexPrivate *priv;
+	GPtrArray *nodes;
+	GList *events = NULL;
+	guint i;
+
+	g_return_val_if_fail (GDATA_IS_CALENDAR_EVENT_INDEX (self), NULL);
+	g_return_val_if_fail (start_time <= end_time, NULL);
+
+	priv = self->priv;
+	nodes = g_ptr_array_new ();
+	collect_overlapping (priv->root, start_time, end_time, FALSE, nodes);
+
+	priv->query_serial++;
+
+	for (i = 0; i < nodes->len; i++) {
+		EventRecord *record = ((IntervalNode *) g_ptr_array_index (nodes, i))->record;
+
+		if (record->query_serial != priv->query_serial) {
+			record->query_serial = priv->query_serial;
+			events = g_list_prepend (events, record->event);
+		}
+	}
+
+	g_ptr_array_unref (nodes);
+
+	return g_list_reverse (events);
+}
+
+/**
+ * gdata_calendar_event_index_is_free:
+ * @self: a #GDataCalendarEventIndex
+ * @start_time: the start of the period, as a UNIX timestamp (inclusive)
+ * @end_time: the end of the period, as a UNIX timestamp (exclusive)
+ *
+ * Checks whether no busy event overlaps the period from @start_time up to @end_time. Transparent and instantaneous events don't make the period busy.
+ *
+ * This doesn't allocate any memory, and is the fastest way to check for clashes.
+ *
+ * Return value: %TRUE if the period is free, %FALSE if it's busy
+ *
+ * Since: 0.19.0
+ */
+gboolean
+gdata_calendar_event_index_is_free (GDataCalendarEventIndex *self, gint64 start_time, gint64 end_time)
+{
+	g_return_val_if_fail (GDATA_IS_CALENDAR_EVENT_INDEX (self), FALSE);
+	g_return_val_if_fail (start_time <= end_time, FALSE);
+
+	return !has_busy_overlap (self->priv->root, start_time, end_time);
+}
+
+/**
+ * gdata_calendar_event_index_get_busy_periods:
+ * @self: a #GDataCalendarEventIndex
+ * @start_time: the start of the period, as a UNIX timestamp (inclusive)
+ * @end_time: the end of the period, as a UNIX timestamp (exclusive)
+ *
+ * Lists the busy periods between @start_time and @end_time, as a free/busy lookup would. Overlapping and adjacent busy event times are merged
+ * into a single period, and the periods are clipped to the requested one. Transparent and instantaneous events don't make any time busy.
+ *
+ * Return value: (transfer full) (element-type GDataGDWhen): the busy periods in time order; free with g_list_free_full() and g_object_unref()
+ *
+ * Since: 0.19.0
+ */
+GList *
+gdata_calendar_event_index_get_busy_periods (GDataCalendarEventIndex *self, gint64 start_time, gint64 end_time)
+{
+	GPtrArray *nodes;
+	GList *periods = NULL;
+	gint64 period_start = 0, period_end = 0;
+	gboolean have_period = FALSE;
+	guint i;
+
+	g_return_val_if_fail (GDATA_IS_CALENDAR_EVENT_INDEX (self), NULL);
+	g_return_val_if_fail (start_time <= end_time, NULL);
+
+	nodes = g_ptr_array_new ();
+	collect_overlapping (self->priv->root, start_time, end_time, TRUE, nodes);
+
+	/* The nodes are in start time order, so each one either extends the current period or starts a new one */
+	for (i = 0; i < nodes->len; i++) {
+		IntervalNode *node = g_ptr_array_index (nodes, i);
+		gint64 node_start, node_end;
+
+		node_start = MAX (node->start_time, start_time);
+		node_end = MIN (node->end_time, end_time);
+
+		if (have_period == TRUE && node_start <= period_end) {
+			period_end = MAX (period_end, node_end);
+			continue;
+		}
+
+		if (have_period == TRUE)
+			periods = g_list_prepend (periods, gdata_gd_when_new (period_start, period_end, FALSE));
+
+		period_start = node_start;
+		period_end = node_end;
+		have_period = TRUE;
+	}
+
+	if (have_period == TRUE)
+		periods = g_list_prepend (periods, gdata_gd_when_new (period_start, period_end, FALSE));
+
+	g_ptr_array_unref (nodes);
+
+	return g_list_reverse (periods);
+}
+
+/**
+ * gdata_calendar_event_index_get_next_event:
+ * @self: a #GDataCalendarEventIndex
+ * @time: a UNIX timestamp
+ * @start_time: (out caller-allocates) (allow-none): return location for the start time of the returned event's next time, or %NULL
+ *
+ * Finds the indexed event with the earliest time starting at or after @time. Events which are already in progress at @time aren't returned;
+ * use gdata_calendar_event_index_query_overlapping() to find those.
+ *
+ * If the event has several times, the one which starts first at or after @time is the one whose start time is returned in @start_time.
+ *
+ * Return value: (transfer none) (allow-none): the next event, which is owned by the index, or %NULL if no indexed event starts at or after @time
+ *
+ * Since: 0.19.0
+ */
+GDataCalendarEvent *
+gdata_calendar_event_index_get_next_event (GDataCalendarEventIndex *self, gint64 time, gint64 *start_time)
+{
+	IntervalNode *node, *next = NULL;
+
+	g_return_val_if_fail (GDATA_IS_CALENDAR_EVENT_INDEX (self), NULL);
+
+	for (node = self->priv->root; node != NULL;) {
+		if (node->start_time >= time) {
+			next = node;
+			node = node->left;
+		} else {
+			node = node->right;
+		}
+	}
+
+	if (next == NULL)
+		return NULL;
+
+	if (start_time != NULL)
+		*start_time = next->start_time;
+
+	return next->record->event;
+}
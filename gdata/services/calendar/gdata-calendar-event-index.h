@@ -0,0 +1,87 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 8; tab-width: 8 -*- */
+/*
+ * GData Client
+ *
+ * GData Client is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * GData Client is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GData Client.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GDATA_CALENDAR_EVENT_INDEX_H
+#define GDATA_CALENDAR_EVENT_INDEX_H
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <gdata/gdata-feed.h>
+#include <gdata/services/calendar/gdata-calendar-event.h>
+
+G_BEGIN_DECLS
+
+#define GDATA_TYPE_CALENDAR_EVENT_INDEX		(gdata_calendar_event_index_get_type ())
+#define GDATA_CALENDAR_EVENT_INDEX(o)		(G_TYPE_CHECK_INSTANCE_CAST ((o), GDATA_TYPE_CALENDAR_EVENT_INDEX, GDataCalendarEventIndex))
+#define GDATA_CALENDAR_EVENT_INDEX_CLASS(k)	(G_TYPE_CHECK_CLASS_CAST((k), GDATA_TYPE_CALENDAR_EVENT_INDEX, GDataCalendarEventIndexClass))
+#define GDATA_IS_CALENDAR_EVENT_INDEX(o)	(G_TYPE_CHECK_INSTANCE_TYPE ((o), GDATA_TYPE_CALENDAR_EVENT_INDEX))
+#define GDATA_IS_CALENDAR_EVENT_INDEX_CLASS(k)	(G_TYPE_CHECK_CLASS_TYPE ((k), GDATA_TYPE_CALENDAR_EVENT_INDEX))
+#define GDATA_CALENDAR_EVENT_INDEX_GET_CLASS(o)	(G_TYPE_INSTANCE_GET_CLASS ((o), GDATA_TYPE_CALENDAR_EVENT_INDEX, GDataCalendarEventIndexClass))
+
+typedef struct _GDataCalendarEventIndexPrivate	GDataCalendarEventIndexPrivate;
+
+/**
+ * GDataCalendarEventIndex:
+ *
+ * All the fields in the #GDataCalendarEventIndex structure are private and should never be accessed directly.
+ *
+ * Since: 0.19.0
+ */
+typedef struct {
+	GObject parent;
+	GDataCalendarEventIndexPrivate *priv;
+} GDataCalendarEventIndex;
+
+/**
+ * GDataCalendarEventIndexClass:
+ *
+ * All the fields in the #GDataCalendarEventIndexClass structure are private and should never be accessed directly.
+ *
+ * Since: 0.19.0
+ */
+typedef struct {
+	/*< private >*/
+	GObjectClass parent;
+
+	/*< private >*/
+	/* Padding for future expansion */
+	void (*_g_reserved0) (void);
+	void (*_g_reserved1) (void);
+	void (*_g_reserved2) (void);
+	void (*_g_reserved3) (void);
+} GDataCalendarEventIndexClass;
+
+GType gdata_calendar_event_index_get_type (void) G_GNUC_CONST;
+G_DEFINE_AUTOPTR_CLEANUP_FUNC (GDataCalendarEventIndex, g_object_unref)
+
+GDataCalendarEventIndex *gdata_calendar_event_index_new (GDataFeed *feed) G_GNUC_WARN_UNUSED_RESULT G_GNUC_MALLOC;
+
+void gdata_calendar_event_index_add_feed (GDataCalendarEventIndex *self, GDataFeed *feed);
+void gdata_calendar_event_index_add_event (GDataCalendarEventIndex *self, GDataCalendarEvent *event);
+gboolean gdata_calendar_event_index_remove_event (GDataCalendarEventIndex *self, const gchar *event_id);
+guint gdata_calendar_event_index_get_n_events (GDataCalendarEventIndex *self) G_GNUC_PURE;
+
+GList *gdata_calendar_event_index_query_overlapping (GDataCalendarEventIndex *self, gint64 start_time, gint64 end_time) G_GNUC_WARN_UNUSED_RESULT;
+gboolean gdata_calendar_event_index_is_free (GDataCalendarEventIndex *self, gint64 start_time, gint64 end_time);
+GList *gdata_calendar_event_index_get_busy_periods (GDataCalendarEventIndex *self, gint64 start_time, gint64 end_time) G_GNUC_WARN_UNUSED_RESULT;
+GDataCalendarEvent *gdata_calendar_event_index_get_next_event (GDataCalendarEventIndex *self, gint64 time, gint64 *start_time);
+
+G_END_DECLS
+
+#endif /* !GDATA_CALENDAR_EVENT_INDEX_H */
@@ -0,0 +1,33 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 8; tab-width: 8 -*- */
+/*
+ * GData Client
+ *
+ * GData Client is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * GData Client is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GData Client.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GDATA_CALENDAR_EVENT_PRIVATE_H
+#define GDATA_CALENDAR_EVENT_PRIVATE_H
+
+#include <glib.h>
+
+#include <gdata/services/calendar/gdata-calendar-event.h>
+
+G_BEGIN_DECLS
+
+G_GNUC_INTERNAL const gchar *_gdata_calendar_event_get_time_zone (GDataCalendarEvent *self);
+G_GNUC_INTERNAL gint64 _gdata_calendar_event_get_original_start_time (GDataCalendarEvent *self);
+
+G_END_DECLS
+
+#endif /* !GDATA_CALENDAR_EVENT_PRIVATE_H */
@@ -88,6 +88,7 @@
 #include <string.h>
 
 #include "gdata-calendar-event.h"
+#include "gdata-calendar-event-private.h"
 #include "gdata-private.h"
 #include "gdata-service.h"
 #include "gdata-parser.h"
@@ -100,6 +101,7 @@ static void gdata_calendar_event_finalize (GObject *object);
 static void gdata_calendar_event_get_property (GObject *object, guint property_id, GValue *value, GParamSpec *pspec);
 static void gdata_calendar_event_set_property (GObject *object, guint property_id, const GValue *value, GParamSpec *pspec);
 static void get_json (GDataParsable *parsable, JsonBuilder *builder);
+static gboolean is_deleted (GDataEntry *entry);
 static gboolean parse_json (GDataParsable *parsable, JsonReader *reader, gpointer user_data, GError **error);
 static gboolean post_parse_json (GDataParsable *parsable, gpointer user_data, GError **error);
 static const gchar *get_content_type (void);
@@ -122,6 +124,9 @@ struct _GDataCalendarEventPrivate {
 	gchar *original_event_id;
 	gchar *original_event_uri;
 	gchar *organiser_email;  /* owned */
+	gchar *time_zone;  /* owned */
+	gint64 original_start_time;
+	gboolean original_start_is_date;
 
 	/* Parsing state. */
 	struct {
@@ -171,6 +176,7 @@ gdata_calendar_event_class_init (GDataCalendarEventClass *klass)
 	parsable_class->get_content_type = get_content_type;
 
 	entry_class->kind_term = "calendar#event";
+	entry_class->is_deleted = is_deleted;
 
 	/**
 	 * GDataCalendarEvent:edited:
@@ -362,6 +368,7 @@ gdata_calendar_event_init (GDataCalendarEvent *self)
 {
 	self->priv = gdata_calendar_event_get_instance_private (self);
 	self->priv->edited = -1;
+	self->priv->original_start_time = -1;
 }
 
 static GObject *
@@ -414,6 +421,7 @@ gdata_calendar_event_finalize (GObject *object)
 	g_free (priv->original_event_id);
 	g_free (priv->original_event_uri);
 	g_free (priv->organiser_email);
+	g_free (priv->time_zone);
 
 	/* Chain up to the parent class */
 	G_OBJECT_CLASS (gdata_calendar_event_parent_class)->finalize (object);
@@ -520,6 +528,7 @@ date_object_from_json (JsonReader *reader,
                        GDataParserOptions options,
                        gint64 *date_time_output,
                        gboolean *is_date_output,
+                       gchar **time_zone_output,
                        gboolean *success,
                        GError **error)
 {
@@ -605,12 +614,25 @@ date_object_from_json (JsonReader *reader,
 	}
 	json_reader_end_member (reader);
 
-	/* Ignore timeZone; it should be specified in dateTime. */
 	if (!found_member) {
 		*success = gdata_parser_error_required_json_content_missing (reader, error);
 		return TRUE;
 	}
 
+	/* The offset is already given in dateTime; timeZone is only needed to
+	 * expand recurrences across DST changes, so keep it if asked. */
+	if (time_zone_output != NULL) {
+		if (json_reader_read_member (reader, "timeZone")) {
+			const gchar *time_zone = json_reader_get_string_value (reader);
+
+			if (time_zone != NULL && *time_zone != '\0') {
+				g_free (*time_zone_output);
+				*time_zone_output = g_strdup (time_zone);
+			}
+		}
+		json_reader_end_member (reader);
+	}
+
 	*date_time_output = date_time;
 	*is_date_output = is_date;
 	*success = TRUE;
@@ -651,7 +673,6 @@ parse_json (GDataParsable *parsable, JsonReader *reader, gpointer user_data, GEr
 	 *  - htmlLink
 	 *  - colorId
 	 *  - endTimeUnspecified
-	 *  - originalStartTime
 	 *  - attendeesOmitted
 	 *  - extendedProperties
 	 *  - hangoutLink
@@ -676,8 +697,8 @@ parse_json (GDataParsable *parsable, JsonReader *reader, gpointer user_data, GEr
 	    gdata_parser_string_from_json_member (reader, "iCalUID", P_DEFAULT, &self->priv->uid, &success, error) ||
 	    gdata_parser_int_from_json_member (reader, "sequence", P_DEFAULT, &self->priv->sequence, &success, error) ||
 	    gdata_parser_int64_time_from_json_member (reader, "updated", P_DEFAULT, &self->priv->edited, &success, error) ||
-	    date_object_from_json (reader, "start", P_DEFAULT, &self->priv->parser.start_time, &self->priv->parser.start_is_date, &success, error) ||
-	    date_object_from_json (reader, "end", P_DEFAULT, &self->priv->parser.end_time, &self->priv->parser.end_is_date, &success, error)) {
+	    date_object_from_json (reader, "start", P_DEFAULT, &self->priv->parser.start_time, &self->priv->parser.start_is_date, &self->priv->time_zone, &success, error) ||
+	    date_object_from_json (reader, "end", P_DEFAULT, &self->priv->parser.end_time, &self->priv->parser.end_is_date, NULL, &success, error)) {
 		if (success) {
 			if (self->priv->edited != -1) {
 				_gdata_entry_set_updated (GDATA_ENTRY (parsable),
@@ -704,6 +725,11 @@ parse_json (GDataParsable *parsable, JsonReader *reader, gpointer user_data, GEr
 			}
 		}
 
+		return success;
+	} else if (g_strcmp0 (json_reader_get_member_name (reader), "originalStartTime") == 0) {
+		g_assert (date_object_from_json (reader, "originalStartTime", P_DEFAULT, &priv->original_start_time, &priv->original_start_is_date,
+		                                 NULL, &success, error));
+
 		return success;
 	} else if (g_strcmp0 (json_reader_get_member_name (reader), "transparency") == 0) {
 		gchar *transparency = NULL;  /* owned */
@@ -978,6 +1004,33 @@ post_parse_json (GDataParsable *parsable, gpointer user_data, GError **error)
 	return TRUE;
 }
 
+/* Add a Calendar date object member, as parsed by date_object_from_json(). The time zone is the one the server gave for the event's start, which
+ * is needed to expand its recurrence; the time itself is always given in UTC. */
+static void
+add_date_object_member (JsonBuilder *builder, const gchar *member_name, gint64 time, gboolean is_date, const gchar *time_zone)
+{
+	gchar *val;  /* owned */
+
+	json_builder_set_member_name (builder, member_name);
+	json_builder_begin_object (builder);
+
+	if (is_date) {
+		json_builder_set_member_name (builder, "date");
+		val = gdata_parser_date_from_int64 (time);
+	} else {
+		json_builder_set_member_name (builder, "dateTime");
+		val = gdata_parser_int64_to_iso8601 (time);
+	}
+
+	json_builder_add_string_value (builder, val);
+	g_free (val);
+
+	json_builder_set_member_name (builder, "timeZone");
+	json_builder_add_string_value (builder, (time_zone != NULL) ? time_zone : "UTC");
+
+	json_builder_end_object (builder);
+}
+
 static void
 get_json (GDataParsable *parsable, JsonBuilder *builder)
 {
@@ -1095,60 +1148,26 @@ get_json (GDataParsable *parsable, JsonBuilder *builder)
 		json_builder_add_string_value (builder, priv->original_event_id);
 	}
 
+	if (priv->original_start_time != -1) {
+		add_date_object_member (builder, "originalStartTime", priv->original_start_time, priv->original_start_is_date,
+		                        priv->time_zone);
+	}
+
 	/* Times. */
 	for (l = priv->times; l != NULL; l = l->next) {
 		GDataGDWhen *when;  /* unowned */
-		gchar *val = NULL;  /* owned */
-		const gchar *member_name;
-		gint64 start_time, end_time;
+		gint64 end_time;
 
 		when = l->data;
 
 		/* Start time. */
-		start_time = gdata_gd_when_get_start_time (when);
-		json_builder_set_member_name (builder, "start");
-		json_builder_begin_object (builder);
-
-		if (gdata_gd_when_is_date (when)) {
-			member_name = "date";
-			val = gdata_parser_date_from_int64 (start_time);
-		} else {
-			member_name = "dateTime";
-			val = gdata_parser_int64_to_iso8601 (start_time);
-		}
-
-		json_builder_set_member_name (builder, member_name);
-		json_builder_add_string_value (builder, val);
-		g_free (val);
-
-		json_builder_set_member_name (builder, "timeZone");
-		json_builder_add_string_value (builder, "UTC");
-
-		json_builder_end_object (builder);
+		add_date_object_member (builder, "start", gdata_gd_when_get_start_time (when), gdata_gd_when_is_date (when), priv->time_zone);
 
 		/* End time. */
 		end_time = gdata_gd_when_get_end_time (when);
 
 		if (end_time > -1) {
-			json_builder_set_member_name (builder, "end");
-			json_builder_begin_object (builder);
-
-			if (gdata_gd_when_is_date (when)) {
-				member_name = "date";
-				val = gdata_parser_date_from_int64 (end_time);
-			} else {
-				member_name = "dateTime";
-				val = gdata_parser_int64_to_iso8601 (end_time);
-			}
-
-			json_builder_set_member_name (builder, member_name);
-			json_builder_add_string_value (builder, val);
-			g_free (val);
-
-			json_builder_set_member_name (builder, "timeZone");
-			json_builder_add_string_value (builder, "UTC");
-
-			json_builder_end_object (builder);
+			add_date_object_member (builder, "end", end_time, gdata_gd_when_is_date (when), priv->time_zone);
 		} else {
 			json_builder_set_member_name (builder, "endTimeUnspecified");
 			json_builder_add_boolean_value (builder, TRUE);
@@ -1248,6 +1267,13 @@ get_content_type (void)
 	return "application/json";
 }
 
+static gboolean
+is_deleted (GDataEntry *entry)
+{
+	/* Cancelled events are only returned when the query's GDataCalendarQuery:show-deleted property is set */
+	return (g_strcmp0 (GDATA_CALENDAR_EVENT (entry)->priv->status, GDATA_GD_EVENT_STATUS_CANCELED) == 0);
+}
+
 /**
  * gdata_calendar_event_new:
  * @id: (allow-none): the event's ID, or %NULL
@@ -1811,3 +1837,39 @@ gdata_calendar_event_is_exception (GDataCalendarEvent *self)
 	g_return_val_if_fail (GDATA_IS_CALENDAR_EVENT (self), FALSE);
 	return (self->priv->original_event_id != NULL && self->priv->original_event_uri != NULL) ? TRUE : FALSE;
 }
+
+/*
+ * _gdata_calendar_event_get_time_zone:
+ * @self: a #GDataCalendarEvent
+ *
+ * Gets the IANA time zone name the event's start time was given in by the server, such as
+ * <literal>Europe/London</literal>. This is needed to expand recurrences correctly across daylight saving changes.
+ *
+ * Return value: (allow-none): the event's time zone, or %NULL if none was given
+ *
+ * Since: 0.19.0
+ */
+const gchar *
+_gdata_calendar_event_get_time_zone (GDataCalendarEvent *self)
+{
+	g_return_val_if_fail (GDATA_IS_CALENDAR_EVENT (self), NULL);
+	return self->priv->time_zone;
+}
+
+/*
+ * _gdata_calendar_event_get_original_start_time:
+ * @self: a #GDataCalendarEvent
+ *
+ * Gets the start time of the recurrence instance which @self replaces, if @self is an exception to a
+ * recurring event. This is the time the instance would have had according to the original event's recurrence rules.
+ *
+ * Return value: the original start time as a UNIX timestamp, or <code class="literal">-1</code>
+ *
+ * Since: 0.19.0
+ */
+gint64
+_gdata_calendar_event_get_original_start_time (GDataCalendarEvent *self)
+{
+	g_return_val_if_fail (GDATA_IS_CALENDAR_EVENT (self), -1);
+	return self->priv->original_start_time;
+}
@@ -155,6 +155,9 @@ gdata_calendar_query_class_init (GDataCalendarQueryClass *klass)
 	 * GDataCalendarQuery:single-events:
 	 *
 	 * Indicates whether recurring events should be expanded or represented as a single event.
+	 *
+	 * If this is %FALSE, only the recurring events themselves (and any exceptions to them) are returned, which keeps feeds small over long
+	 * periods; they can then be expanded locally using #GDataCalendarEventExpander.
 	 */
 	g_object_class_install_property (gobject_class, PROP_SINGLE_EVENTS,
 	                                 g_param_spec_boolean ("single-events",
@@ -245,6 +248,9 @@ gdata_calendar_query_init (GDataCalendarQuery *self)
 
 	_gdata_query_set_pagination_type (GDATA_QUERY (self),
 	                                  GDATA_QUERY_PAGINATION_TOKENS);
+
+	/* #GDataQuery:updated-min is appended as updatedMin by get_query_uri() */
+	_gdata_query_set_append_updated_min (GDATA_QUERY (self), FALSE);
 }
 
 static void
@@ -404,6 +410,16 @@ get_query_uri (GDataQuery *self, const gchar *feed_uri, GString *query_uri, gboo
 		g_free (start_max);
 	}
 
+	if (gdata_query_get_updated_min (self) != -1) {
+		gchar *updated_min;
+
+		APPEND_SEP
+		g_string_append (query_uri, "updatedMin=");
+		updated_min = gdata_parser_int64_to_iso8601 (gdata_query_get_updated_min (self));
+		g_string_append (query_uri, updated_min);
+		g_free (updated_min);
+	}
+
 	if (priv->timezone != NULL) {
 		APPEND_SEP
 		g_string_append (query_uri, "timeZone=");
@@ -130,8 +130,12 @@
  * </example>
  *
  * Before version 0.17.2, the Calendar service could be manipulated using
- * batch operations. That is no longer supported, and any batch operations
- * created on the calendar will fail.
+ * Atom batch operations. Those are no longer supported by the server. Since
+ * version 0.19.0, batch operations on calendar events are sent using the
+ * JSON batch protocol instead: create the #GDataBatchOperation with
+ * gdata_batchable_create_operation(), using
+ * <literal>https://www.googleapis.com/batch/calendar/v3</literal> as the feed
+ * URI, and add insertions with gdata_batch_operation_add_insertion_to_uri().
  */
 
 #include <config.h>
@@ -146,6 +150,8 @@
 #include "gdata-private.h"
 #include "gdata-query.h"
 #include "gdata-calendar-feed.h"
+#include "gdata-calendar-query.h"
+#include "gdata-calendar-event-private.h"
 
 /* Standards reference here:
  * https://developers.google.com/google-apps/calendar/v3/reference/ */
@@ -753,6 +759,317 @@ gdata_calendar_service_query_events_async (GDataCalendarService *self, GDataCale
 	g_free (request_uri);
 }
 
+typedef struct {
+	GDataCalendarCalendar *calendar; /* owned */
+	GDataCalendarQuery *query; /* owned; only used by the source's query thread */
+	GQueue events; /* owned GDataCalendarEvents received but not yet passed to the callback, in order */
+	gboolean is_finished; /* TRUE once all the source's pages have been received */
+} MergeSource;
+
+typedef struct {
+	GDataCalendarService *service;
+	GCancellable *cancellable; /* cancelled by the merging thread on error, or by the caller's cancellable */
+	GAsyncQueue *results; /* MergeResult */
+} MergeData;
+
+typedef struct {
+	MergeSource *source;
+	GDataFeed *feed; /* one page of @source's events, or NULL */
+	GError *error;
+	gboolean is_last; /* TRUE for the final result for @source */
+} MergeResult;
+
+static void
+merge_source_free (MergeSource *source)
+{
+	g_object_unref (source->calendar);
+	g_object_unref (source->query);
+	g_queue_clear_full (&source->events, g_object_unref);
+	g_slice_free (MergeSource, source);
+}
+
+static void
+merge_push_result (MergeData *data, MergeSource *source, GDataFeed *feed, GError *error, gboolean is_last)
+{
+	MergeResult *result;
+
+	result = g_slice_new0 (MergeResult);
+	result->source = source;
+	result->feed = feed;
+	result->error = error;
+	result->is_last = is_last;
+
+	g_async_queue_push (data->results, result);
+}
+
+/* Runs in a worker thread: query all the pages of one calendar's events, pushing each page back to the merging thread. */
+static void
+merge_query_calendar_thread (MergeSource *source, MergeData *data)
+{
+	do {
+		GDataFeed *feed;
+		GError *child_error = NULL;
+
+		feed = gdata_calendar_service_query_events (data->service, source->calendar, GDATA_QUERY (source->query), data->cancellable, NULL, NULL,
+		                                            &child_error);
+		if (feed == NULL) {
+			merge_push_result (data, source, NULL, child_error, TRUE);
+			return;
+		}
+
+		gdata_query_next_page (GDATA_QUERY (source->query));
+		merge_push_result (data, source, feed, NULL, _gdata_query_is_finished (GDATA_QUERY (source->query)));
+	} while (_gdata_query_is_finished (GDATA_QUERY (source->query)) == FALSE);
+}
+
+/* Each calendar gets its own copy of the caller's query, since pagination state can't be shared between threads. Every read-write property is copied,
+ * other than #GDataQuery:etag, which identifies the results of one particular feed. The copies always expand recurring events and order them by start
+ * time, so that each calendar's events arrive in order. */
+static GDataCalendarQuery *
+merge_build_query (GDataCalendarQuery *query)
+{
+	GDataCalendarQuery *calendar_query;
+
+	if (query == NULL) {
+		calendar_query = gdata_calendar_query_new (NULL);
+	} else {
+		GParamSpec **properties;
+		guint i, n_properties;
+
+		calendar_query = GDATA_CALENDAR_QUERY (g_object_new (G_OBJECT_TYPE (query), NULL));
+		properties = g_object_class_list_properties (G_OBJECT_GET_CLASS (query), &n_properties);
+
+		for (i = 0; i < n_properties; i++) {
+			GParamSpec *pspec = properties[i];
+			GValue value = G_VALUE_INIT;
+
+			if ((pspec->flags & G_PARAM_READWRITE) != G_PARAM_READWRITE || (pspec->flags & G_PARAM_CONSTRUCT_ONLY) != 0 ||
+			    strcmp (pspec->name, "etag") == 0) {
+				continue;
+			}
+
+			g_value_init (&value, pspec->value_type);
+			g_object_get_property (G_OBJECT (query), pspec->name, &value);
+			g_object_set_property (G_OBJECT (calendar_query), pspec->name, &value);
+			g_value_unset (&value);
+		}
+
+		g_free (properties);
+	}
+
+	gdata_calendar_query_set_single_events (calendar_query, TRUE);
+	gdata_calendar_query_set_order_by (calendar_query, "starttime");
+
+	return calendar_query;
+}
+
+static gint64
+merge_get_start_time (GDataCalendarEvent *event)
+{
+	gint64 start_time;
+
+	if (gdata_calendar_event_get_primary_time (event, &start_time, NULL, NULL) == TRUE)
+		return start_time;
+
+	/* Cancelled occurrences of recurring events have no times of their own, so are ordered by the time they would have started */
+	start_time = _gdata_calendar_event_get_original_start_time (event);
+	if (start_time != -1)
+		return start_time;
+
+	/* Events without any start time (such as other cancelled events) can't be ordered, so are passed on as soon as they reach the head of their
+	 * calendar's results */
+	return G_MININT64;
+}
+
+/* Returns the source whose next event starts first, or %NULL if that can't be known yet because a source which hasn't finished has no events
+ * waiting. Calendar lists are short, so a linear scan of the sources' heads is as fast as a heap. Ties go to the earlier calendar. */
+static MergeSource *
+merge_get_next_source (GPtrArray *sources)
+{
+	MergeSource *next_source = NULL;
+	gint64 next_start_time = G_MAXINT64;
+	guint i;
+
+	for (i = 0; i < sources->len; i++) {
+		MergeSource *source = sources->pdata[i];
+		gint64 start_time;
+
+		if (g_queue_is_empty (&source->events)) {
+			if (source->is_finished == FALSE)
+				return NULL;
+			continue;
+		}
+
+		start_time = merge_get_start_time (g_queue_peek_head (&source->events));
+		if (next_source == NULL || start_time < next_start_time) {
+			next_source = source;
+			next_start_time = start_time;
+		}
+	}
+
+	return next_source;
+}
+
+static void
+merge_cancelled_cb (GCancellable *cancellable, GCancellable *child_cancellable)
+{
+	g_cancellable_cancel (child_cancellable);
+}
+
+/**
+ * gdata_calendar_service_query_events_merged:
+ * @self: a #GDataCalendarService
+ * @calendars: (element-type GDataCalendarCalendar): the #GDataCalendarCalendars to query
+ * @query: (allow-none): a #GDataCalendarQuery with the query parameters shared by all the calendars, or %NULL
+ * @max_concurrent_queries: the maximum number of calendars to query at once, or <code class="literal">0</code> to use a default
+ * @cancellable: (allow-none): optional #GCancellable object, or %NULL
+ * @callback: (scope call) (closure user_data): a #GDataCalendarMergedEventCallback to call for each event
+ * @user_data: (closure): data to pass to the @callback function
+ * @error: a #GError, or %NULL
+ *
+ * Queries the events in all of @calendars which match @query, such as all the events in a given period, and passes them to @callback as a single
+ * stream of events ordered by start time. This is typically used with the calendars returned by gdata_calendar_service_query_all_calendars() to
+ * build an agenda view.
+ *
+ * The calendars are queried in parallel, up to @max_concurrent_queries at once, so the time taken is that of the slowest calendar rather than the
+ * sum of them all, as it would be with a gdata_calendar_service_query_events() call for each calendar. Each calendar's events are requested in
+ * order of start time, and the calendars' results are merged as they arrive: an event is passed to @callback as soon as the first page of results has
+ * been received from every calendar which might have an earlier event. All the result pages are followed, so every matching event is returned.
+ *
+ * Recurring events are always expanded (see #GDataCalendarQuery:single-events), since only individual occurrences can be ordered by start time, and
+ * #GDataCalendarQuery:order-by is ignored. #GDataQuery:etag is ignored too, since an ETag only identifies the results from one calendar. Every other
+ * property of @query applies to each calendar separately: for example, #GDataQuery:max-results sets the size of each calendar's result pages, rather
+ * than limiting the total number of events. @query itself isn't modified.
+ *
+ * Cancelled occurrences of recurring events (returned if #GDataCalendarQuery:show-deleted is set) have no start time of their own, and are ordered by
+ * the start time they originally had. Any other events without a start time are passed to @callback as soon as they're received.
+ *
+ * @callback is always called in the thread which called this function. If any query fails, the others are stopped, %FALSE is returned and @error is
+ * set; @callback will not be called again after that.
+ *
+ * Errors from #GDataServiceError can be returned for exceptional conditions, as determined by the server.
+ *
+ * Return value: %TRUE on success, %FALSE otherwise
+ *
+ * Since: 0.19.0
+ */
+gboolean
+gdata_calendar_service_query_events_merged (GDataCalendarService *self, GList *calendars, GDataCalendarQuery *query, guint max_concurrent_queries,
+                                            GCancellable *cancellable, GDataCalendarMergedEventCallback callback, gpointer user_data,
+                                            GError **error)
+{
+	MergeData data;
+	GThreadPool *pool;
+	GPtrArray *sources;
+	GList *i;
+	guint n_outstanding_queries = 0;
+	gulong cancelled_id = 0;
+	GError *child_error = NULL;
+
+	g_return_val_if_fail (GDATA_IS_CALENDAR_SERVICE (self), FALSE);
+	g_return_val_if_fail (query == NULL || GDATA_IS_CALENDAR_QUERY (query), FALSE);
+	g_return_val_if_fail (cancellable == NULL || G_IS_CANCELLABLE (cancellable), FALSE);
+	g_return_val_if_fail (callback != NULL, FALSE);
+	g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+
+	for (i = calendars; i != NULL; i = i->next)
+		g_return_val_if_fail (GDATA_IS_CALENDAR_CALENDAR (i->data), FALSE);
+
+	/* Ensure we're authenticated first */
+	if (gdata_authorizer_is_authorized_for_domain (gdata_service_get_authorizer (GDATA_SERVICE (self)),
+	                                               get_calendar_authorization_domain ()) == FALSE) {
+		g_set_error_literal (error, GDATA_SERVICE_ERROR, GDATA_SERVICE_ERROR_AUTHENTICATION_REQUIRED,
+		                     _("You must be authenticated to query your own calendars."));
+		return FALSE;
+	}
+
+	if (max_concurrent_queries == 0)
+		max_concurrent_queries = 4;
+
+	data.service = self;
+	data.cancellable = g_cancellable_new ();
+	data.results = g_async_queue_new ();
+
+	if (cancellable != NULL)
+		cancelled_id = g_cancellable_connect (cancellable, (GCallback) merge_cancelled_cb, data.cancellable, NULL);
+
+	pool = g_thread_pool_new ((GFunc) merge_query_calendar_thread, &data, max_concurrent_queries, FALSE, NULL);
+	sources = g_ptr_array_new_with_free_func ((GDestroyNotify) merge_source_free);
+
+	/* Build all the sources before starting any queries, as the merge needs to know about every calendar */
+	for (i = calendars; i != NULL; i = i->next) {
+		MergeSource *source;
+
+		source = g_slice_new0 (MergeSource);
+		source->calendar = g_object_ref (i->data);
+		source->query = merge_build_query (query);
+		g_queue_init (&source->events);
+
+		g_ptr_array_add (sources, source);
+	}
+
+	for (n_outstanding_queries = 0; n_outstanding_queries < sources->len; n_outstanding_queries++)
+		g_thread_pool_push (pool, sources->pdata[n_outstanding_queries], NULL);
+
+	while (n_outstanding_queries > 0) {
+		MergeResult *result;
+		MergeSource *next_source;
+
+		result = g_async_queue_pop (data.results);
+
+		if (result->error != NULL && child_error == NULL) {
+			/* Stop the other queries as soon as possible */
+			child_error = g_steal_pointer (&result->error);
+			g_cancellable_cancel (data.cancellable);
+		} else if (result->feed != NULL && child_error == NULL) {
+			GList *j;
+
+			for (j = gdata_feed_get_entries (result->feed); j != NULL; j = j->next)
+				g_queue_push_tail (&result->source->events, g_object_ref (j->data));
+		}
+
+		if (result->is_last) {
+			result->source->is_finished = TRUE;
+			n_outstanding_queries--;
+		}
+
+		g_clear_object (&result->feed);
+		g_clear_error (&result->error);
+		g_slice_free (MergeResult, result);
+
+		/* Pass on as many events as can be ordered so far; once all the sources have finished, that's all of them */
+		while (child_error == NULL && (next_source = merge_get_next_source (sources)) != NULL) {
+			GDataCalendarEvent *event = g_queue_pop_head (&next_source->events);
+
+			callback (event, next_source->calendar, user_data);
+			g_object_unref (event);
+		}
+	}
+
+	g_thread_pool_free (pool, FALSE, TRUE);
+
+	if (cancelled_id != 0)
+		g_cancellable_disconnect (cancellable, cancelled_id);
+
+	g_ptr_array_unref (sources);
+	g_async_queue_unref (data.results);
+	g_object_unref (data.cancellable);
+
+	if (child_error != NULL) {
+		/* Report cancellation by the caller as such, rather than as whichever query happened to notice it first */
+		if (g_cancellable_is_cancelled (cancellable) == TRUE) {
+			g_clear_error (&child_error);
+			g_cancellable_set_error_if_cancelled (cancellable, &child_error);
+		}
+
+		g_propagate_error (error, child_error);
+
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
 /**
  * gdata_calendar_service_insert_calendar_event:
  * @self: a #GDataCalendarService
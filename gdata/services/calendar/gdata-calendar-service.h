@@ -94,6 +94,24 @@ void gdata_calendar_service_query_events_async (GDataCalendarService *self, GDat
                                                 GDestroyNotify destroy_progress_user_data, GAsyncReadyCallback callback, gpointer user_data);
 
 #include <gdata/services/calendar/gdata-calendar-event.h>
+#include <gdata/services/calendar/gdata-calendar-query.h>
+
+/**
+ * GDataCalendarMergedEventCallback:
+ * @event: the next #GDataCalendarEvent, in order of start time
+ * @calendar: the #GDataCalendarCalendar which @event is in
+ * @user_data: user data passed to the callback
+ *
+ * Callback function called for each event found by gdata_calendar_service_query_events_merged(). @event and @calendar are only valid for the
+ * duration of the call; @event should be reffed if it needs to be kept around afterwards.
+ *
+ * Since: 0.19.0
+ */
+typedef void (*GDataCalendarMergedEventCallback) (GDataCalendarEvent *event, GDataCalendarCalendar *calendar, gpointer user_data);
+
+gboolean gdata_calendar_service_query_events_merged (GDataCalendarService *self, GList *calendars, GDataCalendarQuery *query,
+                                                     guint max_concurrent_queries, GCancellable *cancellable,
+                                                     GDataCalendarMergedEventCallback callback, gpointer user_data, GError **error);
 
 GDataCalendarEvent *
 gdata_calendar_service_insert_calendar_event (GDataCalendarService *self,
@@ -552,3 +552,78 @@ gdata_documents_document_get_thumbnail_uri (GDataDocumentsDocument *self)
 
 	return gdata_link_get_uri (thumbnail_link);
 }
+
+/* Size of the buffer used to read local files in gdata_documents_document_matches_file(); too large to put on the stack */
+#define MATCHES_FILE_BUFFER_SIZE 65536
+
+/**
+ * gdata_documents_document_matches_file:
+ * @self: a #GDataDocumentsDocument
+ * @file: the local file to compare against
+ * @cancellable: (allow-none): optional #GCancellable object, or %NULL
+ * @error: a #GError, or %NULL
+ *
+ * Checks whether the content of @file is the same as the content of the document on the server, by comparing their sizes and then their MD5
+ * checksums (see #GDataDocumentsEntry:md5-checksum). If they match, there's no need to upload @file using
+ * gdata_documents_service_update_document_resumable().
+ *
+ * Only the local file is read; the document's content is never downloaded. @file is not read at all if its size differs from the document's. If
+ * the server hasn't reported a checksum for the document (for example, because it's a Google Docs format document rather than a binary file),
+ * %FALSE is returned, as its content can't be compared.
+ *
+ * If there is an error reading @file, %FALSE is returned and @error is set.
+ *
+ * Return value: %TRUE if the content of @file matches the document, %FALSE otherwise
+ *
+ * Since: 0.19.0
+ */
+gboolean
+gdata_documents_document_matches_file (GDataDocumentsDocument *self, GFile *file, GCancellable *cancellable, GError **error)
+{
+	const gchar *remote_checksum;
+	GFileInfo *info;
+	GFileInputStream *input_stream;
+	GChecksum *checksum;
+	guint8 *buffer;
+	gssize length_read;
+	gboolean matches;
+
+	g_return_val_if_fail (GDATA_IS_DOCUMENTS_DOCUMENT (self), FALSE);
+	g_return_val_if_fail (G_IS_FILE (file), FALSE);
+	g_return_val_if_fail (cancellable == NULL || G_IS_CANCELLABLE (cancellable), FALSE);
+	g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+
+	remote_checksum = gdata_documents_entry_get_md5_checksum (GDATA_DOCUMENTS_ENTRY (self));
+	if (remote_checksum == NULL)
+		return FALSE;
+
+	/* Comparing the sizes first saves hashing files which have obviously changed */
+	info = g_file_query_info (file, G_FILE_ATTRIBUTE_STANDARD_SIZE, G_FILE_QUERY_INFO_NONE, cancellable, error);
+	if (info == NULL)
+		return FALSE;
+
+	matches = (g_file_info_get_size (info) == gdata_documents_entry_get_file_size (GDATA_DOCUMENTS_ENTRY (self)));
+	g_object_unref (info);
+
+	if (matches == FALSE)
+		return FALSE;
+
+	input_stream = g_file_read (file, cancellable, error);
+	if (input_stream == NULL)
+		return FALSE;
+
+	checksum = g_checksum_new (G_CHECKSUM_MD5);
+	buffer = g_malloc (MATCHES_FILE_BUFFER_SIZE);
+
+	while ((length_read = g_input_stream_read (G_INPUT_STREAM (input_stream), buffer, MATCHES_FILE_BUFFER_SIZE, cancellable, error)) > 0)
+		g_checksum_update (checksum, buffer, length_read);
+
+	matches = (length_read == 0 && g_ascii_strcasecmp (g_checksum_get_string (checksum), remote_checksum) == 0);
+
+	g_free (buffer);
+	g_checksum_free (checksum);
+	g_input_stream_close (G_INPUT_STREAM (input_stream), NULL, NULL);
+	g_object_unref (input_stream);
+
+	return matches;
+}
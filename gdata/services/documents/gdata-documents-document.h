@@ -79,6 +79,8 @@ gchar *gdata_documents_document_get_download_uri (GDataDocumentsDocument *self,
 
 const gchar *gdata_documents_document_get_thumbnail_uri (GDataDocumentsDocument *self) G_GNUC_PURE;
 
+gboolean gdata_documents_document_matches_file (GDataDocumentsDocument *self, GFile *file, GCancellable *cancellable, GError **error);
+
 G_END_DECLS
 
 #endif /* !GDATA_DOCUMENTS_DOCUMENT_H */
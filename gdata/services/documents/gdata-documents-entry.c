@@ -97,6 +97,8 @@
 #include <config.h>
 #include <glib.h>
 #include <glib/gi18n-lib.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include "gdata-comparable.h"
 #include "gdata-documents-entry.h"
@@ -125,6 +127,8 @@ static gboolean parse_json (GDataParsable *parsable, JsonReader *reader, gpointe
 static gboolean post_parse_json (GDataParsable *parsable, gpointer user_data, GError **error);
 static void get_json (GDataParsable *parsable, JsonBuilder *builder);
 static gchar *get_entry_uri (const gchar *id);
+static gboolean is_deleted (GDataEntry *entry);
+static gchar **get_parent_ids (GDataEntry *entry);
 
 struct _GDataDocumentsEntryPrivate {
 	gint64 last_viewed;
@@ -134,6 +138,9 @@ struct _GDataDocumentsEntryPrivate {
 	GDataAuthor *last_modified_by;
 	goffset quota_used; /* bytes */
 	goffset file_size; /* bytes */
+	gchar *md5_checksum;
+	gchar *parent_path; /* parent folder IDs from the ‘parents’ member, each followed by ‘/’; NULL if the entry wasn't parsed from JSON */
+	guint parent_path_links_serial; /* the entry's links serial when @parent_path was built; it's stale if the links have changed since */
 	GList *properties; /* GDataDocumentsProperty */
 	gint64 shared_with_me_date;
 	gboolean can_edit;
@@ -149,6 +156,7 @@ enum {
 	PROP_FILE_SIZE,
 	PROP_SHARED_WITH_ME_DATE,
 	PROP_CAN_EDIT,
+	PROP_MD5_CHECKSUM,
 };
 
 G_DEFINE_ABSTRACT_TYPE_WITH_CODE (GDataDocumentsEntry, gdata_documents_entry, GDATA_TYPE_ENTRY,
@@ -174,6 +182,8 @@ gdata_documents_entry_class_init (GDataDocumentsEntryClass *klass)
 	parsable_class->get_namespaces = get_namespaces;
 
 	entry_class->get_entry_uri = get_entry_uri;
+	entry_class->is_deleted = is_deleted;
+	entry_class->get_parent_ids = get_parent_ids;
 
 	/**
 	 * GDataDocumentsEntry:last-viewed:
@@ -308,6 +318,20 @@ gdata_documents_entry_class_init (GDataDocumentsEntryClass *klass)
 	                                                       "Can edit?", "Indicates whether the current user can edit this file.",
 	                                                       FALSE,
 	                                                       G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
+	/**
+	 * GDataDocumentsEntry:md5-checksum:
+	 *
+	 * The MD5 checksum of the file's content, as a lowercase hexadecimal string. Like #GDataDocumentsEntry:file-size, this is only set for
+	 * non-document files; it is %NULL for standard formats such as #GDataDocumentsText, and for folders.
+	 *
+	 * Since: 0.19.0
+	 */
+	g_object_class_install_property (gobject_class, PROP_MD5_CHECKSUM,
+	                                 g_param_spec_string ("md5-checksum",
+	                                                      "MD5 checksum", "The MD5 checksum of the file's content.",
+	                                                      NULL,
+	                                                      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
 }
 
 static gboolean
@@ -396,6 +420,8 @@ gdata_documents_entry_finalize (GObject *object)
 	GDataDocumentsEntryPrivate *priv = GDATA_DOCUMENTS_ENTRY (object)->priv;
 
 	g_free (priv->resource_id);
+	g_free (priv->md5_checksum);
+	g_free (priv->parent_path);
 
 	/* Chain up to the parent class */
 	G_OBJECT_CLASS (gdata_documents_entry_parent_class)->finalize (object);
@@ -434,6 +460,9 @@ gdata_documents_entry_get_property (GObject *object, guint property_id, GValue *
 		case PROP_CAN_EDIT:
 			g_value_set_boolean (value, priv->can_edit);
 			break;
+		case PROP_MD5_CHECKSUM:
+			g_value_set_string (value, priv->md5_checksum);
+			break;
 		default:
 			/* We don't have any other property... */
 			G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
@@ -452,6 +481,7 @@ gdata_documents_entry_set_property (GObject *object, guint property_id, const GV
 			break;
 		case PROP_QUOTA_USED:
 		case PROP_FILE_SIZE:
+		case PROP_MD5_CHECKSUM:
 			/* Read only. */
 		default:
 			/* We don't have any other property... */
@@ -645,6 +675,34 @@ get_kind_and_parent_link (JsonReader *reader, gchar **out_kind, gchar **out_pare
 	g_free (parent_link);
 }
 
+/* Members handled by parse_json(), in strcmp() order. Drive file resources carry a lot of members we don't care about, so these are
+ * looked up once and passed straight to the parent class instead of running through every comparison below. Keep this in sync with
+ * parse_json(); the /documents/document/parse_json/handled_members test checks that every member parse_json() handles is dispatched to it. */
+static const gchar * const handled_members[] = {
+	"alternateLink",
+	"capabilities",
+	"createdDate",
+	"fileSize",
+	"kind",
+	"labels",
+	"lastViewedByMeDate",
+	"md5Checksum",
+	"mimeType",
+	"modifiedDate",
+	"owners",
+	"parents",
+	"properties",
+	"quotaBytesUsed",
+	"shared",
+	"sharedWithMeDate",
+};
+
+static int
+compare_member_names (const void *key, const void *member)
+{
+	return strcmp ((const gchar *) key, *((const gchar * const *) member));
+}
+
 static gboolean
 parse_json (GDataParsable *parsable, JsonReader *reader, gpointer user_data, GError **error)
 {
@@ -660,9 +718,15 @@ parse_json (GDataParsable *parsable, JsonReader *reader, gpointer user_data, GEr
 	gchar *file_size = NULL;
 	gint64 published;
 	gint64 updated;
+	const gchar *member_name;
 
 	/* JSON format: https://developers.google.com/drive/v2/reference/files */
 
+	member_name = json_reader_get_member_name (reader);
+	if (member_name == NULL ||
+	    bsearch (member_name, handled_members, G_N_ELEMENTS (handled_members), sizeof (*handled_members), compare_member_names) == NULL)
+		goto parent;
+
 	if (gdata_parser_string_from_json_member (reader, "alternateLink", P_DEFAULT, &alternate_uri, &success, error) == TRUE) {
 		if (success && alternate_uri != NULL && alternate_uri[0] != '\0') {
 			GDataLink *_link;
@@ -680,6 +744,7 @@ parse_json (GDataParsable *parsable, JsonReader *reader, gpointer user_data, GEr
 		g_free (mime_type);
 		return success;
 	} else if (gdata_parser_int64_time_from_json_member (reader, "lastViewedByMeDate", P_DEFAULT, &(priv->last_viewed), &success, error) == TRUE ||
+		   gdata_parser_string_from_json_member (reader, "md5Checksum", P_DEFAULT | P_NO_DUPES, &(priv->md5_checksum), &success, error) == TRUE ||
 		   gdata_parser_string_from_json_member (reader, "kind", P_REQUIRED | P_NON_EMPTY, &kind, &success, error) == TRUE) {
 		g_free (kind);
 		return success;
@@ -735,6 +800,7 @@ parse_json (GDataParsable *parsable, JsonReader *reader, gpointer user_data, GEr
 
 		for (i = 0, members = (guint) json_reader_count_members (reader); i < members; i++) {
 			gboolean starred;
+			gboolean trashed;
 			gboolean viewed;
 
 			json_reader_read_element (reader, i);
@@ -753,6 +819,9 @@ parse_json (GDataParsable *parsable, JsonReader *reader, gpointer user_data, GEr
 				g_object_unref (category);
 			}
 
+			if (gdata_parser_boolean_from_json_member (reader, "trashed", P_DEFAULT, &trashed, &success, NULL) == TRUE && success)
+				priv->is_deleted = trashed;
+
 			json_reader_end_element (reader);
 		}
 
@@ -812,12 +881,14 @@ parse_json (GDataParsable *parsable, JsonReader *reader, gpointer user_data, GEr
 		continue_owners:
 			g_free (email);
 			g_free (kind);
+			kind = NULL;
 			g_free (name);
 			json_reader_end_element (reader);
 		}
 
 		return success;
 	} else if (g_strcmp0 (json_reader_get_member_name (reader), "parents") == 0) {
+		GString *parent_path;
 		guint i, elements;
 
 		if (json_reader_is_array (reader) == FALSE) {
@@ -828,10 +899,14 @@ parse_json (GDataParsable *parsable, JsonReader *reader, gpointer user_data, GEr
 			return FALSE;
 		}
 
+		/* Extract the parent folder IDs once here, so that gdata_documents_entry_get_path() doesn't have to pick them out of the links */
+		parent_path = g_string_new (NULL);
+
 		/* Loop through the elements array. */
 		for (i = 0, elements = (guint) json_reader_count_elements (reader); success && i < elements; i++) {
 			GDataLink *_link = NULL;
 			const gchar *relation_type = NULL;
+			const gchar *parent_id;
 			gchar *uri = NULL;
 
 			json_reader_read_element (reader, i);
@@ -864,13 +939,25 @@ parse_json (GDataParsable *parsable, JsonReader *reader, gpointer user_data, GEr
 			_link = gdata_link_new (uri, relation_type);
 			gdata_entry_add_link (GDATA_ENTRY (parsable), _link);
 
+			/* gdata_entry_look_up_links() lists the most recently added links first, so prepend to match the order used when the path
+			 * is built from the links */
+			parent_id = gdata_documents_utils_get_id_from_link (_link);
+			if (parent_id != NULL) {
+				g_string_prepend_c (parent_path, '/');
+				g_string_prepend (parent_path, parent_id);
+			}
+
 		continue_parents:
 			g_clear_object (&_link);
 			g_free (kind);
+			kind = NULL;
 			g_free (uri);
 			json_reader_end_element (reader);
 		}
 
+		g_free (priv->parent_path);
+		priv->parent_path = g_string_free (parent_path, FALSE);
+
 		return success;
 	} else if (g_strcmp0 (json_reader_get_member_name (reader), "properties") == 0) {
 		guint i, elements;
@@ -959,6 +1046,7 @@ parse_json (GDataParsable *parsable, JsonReader *reader, gpointer user_data, GEr
 		return success;
 	}
 
+ parent:
 	return GDATA_PARSABLE_CLASS (gdata_documents_entry_parent_class)->parse_json (parsable, reader, user_data, error);
 }
 
@@ -979,6 +1067,9 @@ post_parse_json (GDataParsable *parsable, gpointer user_data, GError **error)
 	g_free (uri);
 	g_object_unref (_link);
 
+	/* All the links have now been parsed, so any changes to them from here on invalidate the parent path */
+	GDATA_DOCUMENTS_ENTRY (parsable)->priv->parent_path_links_serial = _gdata_entry_get_links_serial (GDATA_ENTRY (parsable));
+
 	return TRUE;
 }
 
@@ -1083,6 +1174,52 @@ get_entry_uri (const gchar *id)
 	return g_strconcat ("https://www.googleapis.com/drive/v2/files/", id, "?supportsAllDrives=true", NULL);
 }
 
+static gboolean
+is_deleted (GDataEntry *entry)
+{
+	return GDATA_DOCUMENTS_ENTRY (entry)->priv->is_deleted;
+}
+
+static gchar **
+get_parent_ids (GDataEntry *entry)
+{
+	GDataDocumentsEntryPrivate *priv = GDATA_DOCUMENTS_ENTRY (entry)->priv;
+	GPtrArray *parent_ids;
+	GList *links, *i;
+
+	/* Use the parent folder IDs extracted by parse_json(), unless the parent links have been changed since */
+	if (priv->parent_path != NULL && priv->parent_path_links_serial == _gdata_entry_get_links_serial (entry)) {
+		gchar **retval;
+		guint length;
+
+		/* Each ID in the path is followed by ‘/’, so the last element of the split is always empty */
+		retval = g_strsplit (priv->parent_path, "/", -1);
+		length = g_strv_length (retval);
+		if (length > 0) {
+			g_free (retval[length - 1]);
+			retval[length - 1] = NULL;
+		}
+
+		return retval;
+	}
+
+	parent_ids = g_ptr_array_new ();
+	links = gdata_entry_look_up_links (entry, GDATA_LINK_PARENT);
+
+	for (i = links; i != NULL; i = i->next) {
+		const gchar *parent_id;
+
+		parent_id = gdata_documents_utils_get_id_from_link (GDATA_LINK (i->data));
+		if (parent_id != NULL)
+			g_ptr_array_add (parent_ids, g_strdup (parent_id));
+	}
+
+	g_list_free (links);
+	g_ptr_array_add (parent_ids, NULL);
+
+	return (gchar **) g_ptr_array_free (parent_ids, FALSE);
+}
+
 /**
  * gdata_documents_entry_get_last_viewed:
  * @self: a #GDataDocumentsEntry
@@ -1112,6 +1249,9 @@ gdata_documents_entry_get_last_viewed (GDataDocumentsEntry *self)
  * Note: the path is based on the entry/document IDs of the folders (#GDataEntry:id) and document (#GDataDocumentsEntry:document-id),
  * and not the entries' human-readable names (#GDataEntry:title).
  *
+ * For entries parsed from the server, the parent folder IDs are extracted once during parsing, so building the path only allocates the returned
+ * string. If the entry's links are changed after parsing, the path is built from the links instead.
+ *
  * Return value: the folder hierarchy path containing the document, or %NULL; free with g_free()
  *
  * Since: 0.4.0
@@ -1119,51 +1259,65 @@ gdata_documents_entry_get_last_viewed (GDataDocumentsEntry *self)
 gchar *
 gdata_documents_entry_get_path (GDataDocumentsEntry *self)
 {
+	GDataDocumentsEntryPrivate *priv;
 	GList *element, *parent_folders_list = NULL;
 	GString *path;
 	const gchar *id;
 
 	g_return_val_if_fail (GDATA_IS_DOCUMENTS_ENTRY (self), NULL);
 
+	priv = self->priv;
+	id = gdata_entry_get_id (GDATA_ENTRY (self));
+
+	/* Fast path: the parent folder IDs were already extracted by parse_json(), and the parent links haven't been changed since */
+	if (priv->parent_path != NULL && id != NULL && priv->parent_path_links_serial == _gdata_entry_get_links_serial (GDATA_ENTRY (self))) {
+		gsize parent_path_length = strlen (priv->parent_path);
+		gsize id_length = strlen (id);
+		gchar *retval;
+
+		retval = g_malloc (1 + parent_path_length + id_length + 1);
+		retval[0] = '/';
+		memcpy (retval + 1, priv->parent_path, parent_path_length);
+		memcpy (retval + 1 + parent_path_length, id, id_length + 1);
+
+		return retval;
+	}
+
 	path = g_string_new ("/");
 	parent_folders_list = gdata_entry_look_up_links (GDATA_ENTRY (self), GDATA_LINK_PARENT);
 
 	/* We check all the folders contained that are parents of the GDataDocumentsEntry */
 	for (element = parent_folders_list; element != NULL; element = element->next) {
-		guint i;
-		gchar *folder_id = NULL;
-		gchar **link_href_cut = g_strsplit (gdata_link_get_uri (GDATA_LINK (element->data)), "/", 0);
+		GDataLink *_link = GDATA_LINK (element->data);
+		const gchar *folder_id, *folder_id_end;
 
-		/* Extract the folder ID from the folder URI, which is of the form:
+		/* Extract the folder ID from the folder URI, which is either of the form:
+		 *   https://www.googleapis.com/drive/v2/files/folder_id
+		 * or, for older entries:
 		 *   http://docs.google.com/feeds/documents/private/full/folder%3Afolder_id
 		 * We want the "folder_id" bit. */
-		for (i = 0;; i++) {
-			gchar **path_cut = NULL;
-
-			if (link_href_cut[i] == NULL)
-				break;
-
-			path_cut = g_strsplit (link_href_cut[i], "%3A", 2);
-			if (*path_cut != NULL) {
-				if (strcmp (path_cut[0], "folder") == 0){
-					folder_id = g_strdup (path_cut[1]);
-					g_strfreev (path_cut);
-					break;
-				}
-			}
-			g_strfreev (path_cut);
+		folder_id = gdata_documents_utils_get_id_from_link (_link);
+		if (folder_id != NULL) {
+			folder_id_end = folder_id + strlen (folder_id);
+		} else {
+			folder_id = strstr (gdata_link_get_uri (_link), "/folder%3A");
+			if (folder_id == NULL)
+				continue;
+
+			folder_id += strlen ("/folder%3A");
+			folder_id_end = strchr (folder_id, '/');
+			if (folder_id_end == NULL)
+				folder_id_end = folder_id + strlen (folder_id);
 		}
-		g_strfreev (link_href_cut);
-		g_assert (folder_id != NULL);
 
 		/* Append the folder ID to our path */
-		g_string_append (path, folder_id);
+		g_string_append_len (path, folder_id, folder_id_end - folder_id);
 		g_string_append_c (path, '/');
-		g_free (folder_id);
 	}
 
+	g_list_free (parent_folders_list);
+
 	/* Append the entry ID */
-	id = gdata_entry_get_id (GDATA_ENTRY (self));
 	g_string_append (path, id);
 
 	return g_string_free (path, FALSE);
@@ -1288,6 +1442,24 @@ gdata_documents_entry_get_file_size (GDataDocumentsEntry *self)
 	return self->priv->file_size;
 }
 
+/**
+ * gdata_documents_entry_get_md5_checksum:
+ * @self: a #GDataDocumentsEntry
+ *
+ * Gets the #GDataDocumentsEntry:md5-checksum property.
+ *
+ * Return value: (allow-none): the MD5 checksum of the file's content, or %NULL
+ *
+ * Since: 0.19.0
+ */
+const gchar *
+gdata_documents_entry_get_md5_checksum (GDataDocumentsEntry *self)
+{
+	g_return_val_if_fail (GDATA_IS_DOCUMENTS_ENTRY (self), NULL);
+
+	return self->priv->md5_checksum;
+}
+
 /**
  * gdata_documents_entry_is_deleted:
  * @self: a #GDataDocumentsEntry
@@ -112,6 +112,7 @@ GDataAuthor *gdata_documents_entry_get_last_modified_by (GDataDocumentsEntry *se
 
 goffset gdata_documents_entry_get_quota_used (GDataDocumentsEntry *self) G_GNUC_PURE;
 goffset gdata_documents_entry_get_file_size (GDataDocumentsEntry *self) G_GNUC_PURE;
+const gchar *gdata_documents_entry_get_md5_checksum (GDataDocumentsEntry *self) G_GNUC_PURE;
 
 gboolean gdata_documents_entry_is_deleted (GDataDocumentsEntry *self) G_GNUC_PURE;
 
@@ -392,6 +392,27 @@ get_query_uri (GDataQuery *self, const gchar *feed_uri, GString *query_uri, gboo
 		g_string_free (title_query, TRUE);
 	}
 
+	/* Drive ignores the updated-min and updated-max parameters, so express them as conditions on the modification time instead */
+	if (gdata_query_get_updated_min (self) != -1) {
+		gchar *updated_min, *modified_query;
+
+		updated_min = gdata_parser_int64_to_iso8601 (gdata_query_get_updated_min (self));
+		modified_query = g_strconcat ("modifiedDate >= '", updated_min, "'", NULL);
+		_gdata_query_add_q_internal (self, modified_query);
+		g_free (modified_query);
+		g_free (updated_min);
+	}
+
+	if (gdata_query_get_updated_max (self) != -1) {
+		gchar *updated_max, *modified_query;
+
+		updated_max = gdata_parser_int64_to_iso8601 (gdata_query_get_updated_max (self));
+		modified_query = g_strconcat ("modifiedDate < '", updated_max, "'", NULL);
+		_gdata_query_add_q_internal (self, modified_query);
+		g_free (modified_query);
+		g_free (updated_max);
+	}
+
 	/* Chain up to the parent class */
 	GDATA_QUERY_CLASS (gdata_documents_query_parent_class)->get_query_uri (self, feed_uri, query_uri, params_started);
 
@@ -141,7 +141,9 @@
  *
  * The Drive service can be manipulated using batch operations, too. See the
  * <ulink type="http" url="https://developers.google.com/google-apps/documents-list/#batching_acl_requests">online documentation on batch
- * operations</ulink> for more information.
+ * operations</ulink> for more information. As documents are JSON entries, they are sent using the JSON batch protocol, so the feed URI passed
+ * to gdata_batchable_create_operation() should be <literal>https://www.googleapis.com/batch/drive/v2</literal>, and insertions should be
+ * added with gdata_batch_operation_add_insertion_to_uri().
  *
  * <example>
  * 	<title>Performing a Batch Operation on Documents</title>
@@ -262,6 +264,11 @@
 #include "gdata-documents-service.h"
 #include "gdata-documents-utils.h"
 #include "gdata-documents-drive.h"
+#include "gdata-documents-drawing.h"
+#include "gdata-documents-pdf.h"
+#include "gdata-documents-presentation.h"
+#include "gdata-documents-spreadsheet.h"
+#include "gdata-documents-text.h"
 #include "gdata-batchable.h"
 #include "gdata-service.h"
 #include "gdata-private.h"
@@ -292,6 +299,17 @@ gdata_documents_service_class_init (GDataDocumentsServiceClass *klass)
 	service_class->get_authorization_domains = get_authorization_domains;
 
 	service_class->api_version = "3";
+
+	/* Register the concrete entry types up front, so that serialised entries (such as those in a #GDataEntryMirror) can be rebuilt from
+	 * their type names before the first feed has been parsed. */
+	g_type_ensure (GDATA_TYPE_DOCUMENTS_DOCUMENT);
+	g_type_ensure (GDATA_TYPE_DOCUMENTS_DRAWING);
+	g_type_ensure (GDATA_TYPE_DOCUMENTS_DRIVE);
+	g_type_ensure (GDATA_TYPE_DOCUMENTS_FOLDER);
+	g_type_ensure (GDATA_TYPE_DOCUMENTS_PDF);
+	g_type_ensure (GDATA_TYPE_DOCUMENTS_PRESENTATION);
+	g_type_ensure (GDATA_TYPE_DOCUMENTS_SPREADSHEET);
+	g_type_ensure (GDATA_TYPE_DOCUMENTS_TEXT);
 }
 
 static void
@@ -1084,6 +1102,10 @@ gdata_documents_service_update_document_resumable (GDataDocumentsService *self,
  * when starting the operation, %GDATA_DOCUMENTS_SERVICE_ERROR_INVALID_CONTENT_TYPE will be thrown in @error if the content type of the uploaded data
  * could not be mapped to a document type with which to interpret the response from the server.
  *
+ * If an MD5 checksum of the uploaded data was computed by calling gdata_upload_stream_set_checksum_type() on @upload_stream before writing to it, it
+ * is compared against the #GDataDocumentsEntry:md5-checksum reported by the server, and %G_IO_ERROR_INVALID_DATA is thrown in @error if they
+ * differ. This allows the upload to be verified without reading the uploaded data a second time.
+ *
  * Return value: (transfer full): the new or updated #GDataDocumentsDocument, or %NULL; unref with g_object_unref()
  *
  * Since: 0.8.0
@@ -1093,8 +1115,11 @@ gdata_documents_service_finish_upload (GDataDocumentsService *self, GDataUploadS
 {
 	const gchar *content_type;
 	const gchar *response_body;
+	const gchar *local_checksum, *remote_checksum;
 	gssize response_length;
 	GType new_document_type = G_TYPE_INVALID;
+	GChecksumType checksum_type;
+	GDataDocumentsDocument *document;
 
 	/* Get and parse the response from the server */
 	response_body = gdata_upload_stream_get_response (upload_stream, &response_length);
@@ -1113,7 +1138,409 @@ gdata_documents_service_finish_upload (GDataDocumentsService *self, GDataUploadS
 		return NULL;
 	}
 
-	return GDATA_DOCUMENTS_DOCUMENT (gdata_parsable_new_from_json (new_document_type, response_body, (gint) response_length, error));
+	document = GDATA_DOCUMENTS_DOCUMENT (gdata_parsable_new_from_json (new_document_type, response_body, (gint) response_length, error));
+	if (document == NULL)
+		return NULL;
+
+	/* Verify the upload if the stream was checksumming it. Drive only reports MD5 checksums, and only for non-document files. */
+	local_checksum = gdata_upload_stream_get_checksum (upload_stream, &checksum_type);
+	remote_checksum = gdata_documents_entry_get_md5_checksum (GDATA_DOCUMENTS_ENTRY (document));
+
+	if (local_checksum != NULL && checksum_type == G_CHECKSUM_MD5 && remote_checksum != NULL &&
+	    g_ascii_strcasecmp (local_checksum, remote_checksum) != 0) {
+		g_set_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA,
+		             _("The uploaded data’s checksum (‘%s’) did not match the checksum reported by the server (‘%s’)."),
+		             local_checksum, remote_checksum);
+		g_object_unref (document);
+		return NULL;
+	}
+
+	return document;
+}
+
+static void
+index_folder_list_free (GList *documents)
+{
+	g_list_free_full (documents, g_object_unref);
+}
+
+/**
+ * gdata_documents_service_index_folder:
+ * @self: an authenticated #GDataDocumentsService
+ * @folder: (allow-none): the #GDataDocumentsFolder to index, or %NULL for the root folder
+ * @cancellable: (allow-none): optional #GCancellable object, or %NULL
+ * @error: a #GError, or %NULL
+ *
+ * Builds an index of the files directly inside @folder which have content checksums (see #GDataDocumentsEntry:md5-checksum), mapping each file's
+ * title to a #GList of the #GDataDocumentsDocument<!-- -->s with that title. Drive allows several files in a folder to have the same title, so most
+ * lists will have only one element, but some may have more; they are in the order the server returned them. All the pages of results are fetched,
+ * so this makes one request per 1000 files in @folder.
+ *
+ * This is intended for syncing a local directory with @folder: for each local file, look up its name in the index, and use
+ * gdata_documents_document_matches_file() to decide whether it needs to be uploaded with
+ * gdata_documents_service_update_document_resumable(), without opening any upload streams. Google Docs format documents and subfolders have no
+ * checksums, so are not included.
+ *
+ * Errors from #GDataServiceError can be returned for exceptional conditions, as determined by the server.
+ *
+ * Return value: (transfer full) (element-type utf8 GList<GDataDocumentsDocument>): a hash table mapping file titles to lists of documents, or
+ * %NULL; unref with g_hash_table_unref()
+ *
+ * Since: 0.19.0
+ */
+GHashTable *
+gdata_documents_service_index_folder (GDataDocumentsService *self, GDataDocumentsFolder *folder, GCancellable *cancellable, GError **error)
+{
+	GDataDocumentsQuery *query;
+	GHashTable *index;
+	gchar *q;
+
+	g_return_val_if_fail (GDATA_IS_DOCUMENTS_SERVICE (self), NULL);
+	g_return_val_if_fail (folder == NULL || GDATA_IS_DOCUMENTS_FOLDER (folder), NULL);
+	g_return_val_if_fail (cancellable == NULL || G_IS_CANCELLABLE (cancellable), NULL);
+	g_return_val_if_fail (error == NULL || *error == NULL, NULL);
+
+	/* Only list the folder's direct children, and use the largest page size the server supports to minimise round trips */
+	q = g_strdup_printf ("'%s' in parents", (folder != NULL) ? gdata_entry_get_id (GDATA_ENTRY (folder)) : "root");
+	query = gdata_documents_query_new_with_limits (q, 0, 1000);
+	g_free (q);
+
+	index = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify) index_folder_list_free);
+
+	do {
+		GDataDocumentsFeed *feed;
+		GList *i;
+
+		feed = gdata_documents_service_query_documents (self, query, cancellable, NULL, NULL, error);
+		if (feed == NULL) {
+			g_hash_table_unref (index);
+			index = NULL;
+			break;
+		}
+
+		for (i = gdata_feed_get_entries (GDATA_FEED (feed)); i != NULL; i = i->next) {
+			GDataEntry *entry = GDATA_ENTRY (i->data);
+			GList *documents;
+
+			if (GDATA_IS_DOCUMENTS_DOCUMENT (entry) == FALSE || gdata_documents_entry_get_md5_checksum (GDATA_DOCUMENTS_ENTRY (entry)) == NULL ||
+			    gdata_entry_get_title (entry) == NULL) {
+				continue;
+			}
+
+			/* Titles aren't unique, so append to the list of any documents already indexed under this one. The list head never changes
+			 * once it's in the table, so it doesn't need to be re-inserted. */
+			documents = g_hash_table_lookup (index, gdata_entry_get_title (entry));
+
+			if (documents == NULL)
+				g_hash_table_insert (index, g_strdup (gdata_entry_get_title (entry)), g_list_prepend (NULL, g_object_ref (entry)));
+			else
+				documents = g_list_append (documents, g_object_ref (entry));
+		}
+
+		g_object_unref (feed);
+
+		gdata_query_next_page (GDATA_QUERY (query));
+	} while (_gdata_query_is_finished (GDATA_QUERY (query)) == FALSE);
+
+	g_object_unref (query);
+
+	return index;
+}
+
+/* Maximum number of folders whose children are listed in a single crawl query. Drive limits the length of the ‘q’ parameter, and each
+ * "'<id>' in parents" clause is around 50 characters. */
+#define CRAWL_FOLDERS_PER_QUERY 20
+
+typedef struct {
+	GDataDocumentsService *service;
+	GCancellable *cancellable; /* cancelled by the crawling thread on error, or by the caller's cancellable */
+	GAsyncQueue *results; /* CrawlResult */
+} CrawlData;
+
+typedef struct {
+	gchar **folder_ids; /* the folders queried for this result */
+	GDataDocumentsFeed *feed; /* one page of children of @folder_ids, or NULL */
+	GError *error;
+	gboolean is_last; /* TRUE for the final result of a query, after which no more results will be pushed for @folder_ids */
+} CrawlResult;
+
+static void
+crawl_result_free (CrawlResult *result)
+{
+	if (result->is_last)
+		g_strfreev (result->folder_ids);
+	g_clear_object (&result->feed);
+	g_clear_error (&result->error);
+	g_slice_free (CrawlResult, result);
+}
+
+static void
+crawl_push_result (CrawlData *data, gchar **folder_ids, GDataDocumentsFeed *feed, GError *error, gboolean is_last)
+{
+	CrawlResult *result;
+
+	result = g_slice_new0 (CrawlResult);
+	result->folder_ids = folder_ids;
+	result->feed = feed;
+	result->error = error;
+	result->is_last = is_last;
+
+	g_async_queue_push (data->results, result);
+}
+
+/* Runs in a worker thread: list all the children of the given folders, pushing each page of results back to the crawling thread. */
+static void
+crawl_folders_thread (gchar **folder_ids, CrawlData *data)
+{
+	GDataDocumentsQuery *query;
+	GString *q;
+	guint i;
+
+	/* List the children of all the folders in one query, including subfolders so that they can be crawled in turn */
+	q = g_string_new (NULL);
+
+	for (i = 0; folder_ids[i] != NULL; i++)
+		g_string_append_printf (q, "%s'%s' in parents", (i > 0) ? " or " : "", folder_ids[i]);
+
+	query = gdata_documents_query_new_with_limits (q->str, 0, 1000);
+	gdata_documents_query_set_show_folders (query, TRUE);
+	g_string_free (q, TRUE);
+
+	do {
+		GDataDocumentsFeed *feed;
+		GError *child_error = NULL;
+
+		feed = gdata_documents_service_query_documents (data->service, query, data->cancellable, NULL, NULL, &child_error);
+		if (feed == NULL) {
+			crawl_push_result (data, folder_ids, NULL, child_error, TRUE);
+			g_object_unref (query);
+			return;
+		}
+
+		gdata_query_next_page (GDATA_QUERY (query));
+		crawl_push_result (data, folder_ids, feed, NULL, _gdata_query_is_finished (GDATA_QUERY (query)));
+	} while (_gdata_query_is_finished (GDATA_QUERY (query)) == FALSE);
+
+	g_object_unref (query);
+}
+
+/* Return the ID of the parent of @entry through which it was found by a query on @folder_ids */
+static const gchar *
+crawl_get_parent_id (GDataEntry *entry, gchar **folder_ids)
+{
+	GList *parent_links, *i;
+	const gchar *parent_id = NULL;
+
+	parent_links = gdata_entry_look_up_links (entry, GDATA_LINK_PARENT);
+
+	for (i = parent_links; i != NULL; i = i->next) {
+		const gchar *id = gdata_documents_utils_get_id_from_link (GDATA_LINK (i->data));
+
+		/* Entries with several parents may be listed by the query through any of them which was queried */
+		if (id != NULL && g_strv_contains ((const gchar * const *) folder_ids, id)) {
+			parent_id = id;
+			break;
+		}
+	}
+
+	g_list_free (parent_links);
+
+	/* The root folder is queried by its alias rather than its ID, so its children won't have matched above */
+	if (parent_id == NULL && g_strv_contains ((const gchar * const *) folder_ids, "root"))
+		parent_id = "root";
+
+	return parent_id;
+}
+
+/* Build the root-first chain of folder IDs leading to @parent_id, by walking up @parent_index */
+static gchar **
+crawl_build_parent_chain (GHashTable *parent_index, const gchar *parent_id)
+{
+	GPtrArray *chain;
+	guint i, n_steps;
+
+	chain = g_ptr_array_new ();
+
+	/* Bound the walk by the size of the index, in case the folder structure is cyclic */
+	for (n_steps = 0; parent_id != NULL && n_steps <= g_hash_table_size (parent_index); n_steps++) {
+		g_ptr_array_add (chain, (gpointer) parent_id);
+		parent_id = g_hash_table_lookup (parent_index, parent_id);
+	}
+
+	/* Reverse it in place so it's root-first */
+	for (i = 0; i < chain->len / 2; i++) {
+		gpointer tmp = chain->pdata[i];
+		chain->pdata[i] = chain->pdata[chain->len - 1 - i];
+		chain->pdata[chain->len - 1 - i] = tmp;
+	}
+
+	g_ptr_array_add (chain, NULL);
+
+	return (gchar **) g_ptr_array_free (chain, FALSE);
+}
+
+static void
+crawl_cancelled_cb (GCancellable *cancellable, GCancellable *child_cancellable)
+{
+	g_cancellable_cancel (child_cancellable);
+}
+
+/**
+ * gdata_documents_service_crawl_folder:
+ * @self: an authenticated #GDataDocumentsService
+ * @folder: (allow-none): the #GDataDocumentsFolder to crawl, or %NULL to crawl the root folder
+ * @max_concurrent_queries: the maximum number of queries to run at once, or <code class="literal">0</code> to use a default
+ * @cancellable: (allow-none): optional #GCancellable object, or %NULL
+ * @callback: (scope call) (closure user_data): a #GDataDocumentsCrawlCallback to call for each entry found
+ * @user_data: (closure): data to pass to the @callback function
+ * @error: a #GError, or %NULL
+ *
+ * Recursively enumerates every entry inside @folder, calling @callback for each one with the chain of folders leading to it.
+ *
+ * The folder tree is expanded breadth-first. The children of up to 20 folders are listed in each query, and up to @max_concurrent_queries queries
+ * run in parallel. This is much faster than calling gdata_documents_service_query_documents() once for each folder. @callback is always called in
+ * the thread which called this function, but entries are passed to it in no particular order, apart from every folder being passed before its
+ * children. Each folder is only crawled once, even if it's reachable through several parents.
+ *
+ * The returned parent index maps the ID of every entry found to the ID of the folder it was found in, so the path of any entry can be resolved
+ * with one hash table lookup per level of depth. Entries directly inside @folder map to the ID of @folder, or to <literal>root</literal> if
+ * @folder is %NULL.
+ *
+ * If any query fails, the crawl is stopped, %NULL is returned and @error is set. @callback will not be called again after that.
+ *
+ * Errors from #GDataServiceError can be returned for exceptional conditions, as determined by the server.
+ *
+ * Return value: (transfer full) (element-type utf8 utf8): the parent index, or %NULL; unref with g_hash_table_unref()
+ *
+ * Since: 0.19.0
+ */
+GHashTable *
+gdata_documents_service_crawl_folder (GDataDocumentsService *self, GDataDocumentsFolder *folder, guint max_concurrent_queries,
+                                      GCancellable *cancellable, GDataDocumentsCrawlCallback callback, gpointer user_data, GError **error)
+{
+	CrawlData data;
+	GThreadPool *pool;
+	GHashTable *parent_index;
+	GPtrArray *pending_folders;
+	const gchar *root_id;
+	guint n_outstanding_queries = 0;
+	gulong cancelled_id = 0;
+	GError *child_error = NULL;
+
+	g_return_val_if_fail (GDATA_IS_DOCUMENTS_SERVICE (self), NULL);
+	g_return_val_if_fail (folder == NULL || GDATA_IS_DOCUMENTS_FOLDER (folder), NULL);
+	g_return_val_if_fail (cancellable == NULL || G_IS_CANCELLABLE (cancellable), NULL);
+	g_return_val_if_fail (callback != NULL, NULL);
+	g_return_val_if_fail (error == NULL || *error == NULL, NULL);
+
+	if (max_concurrent_queries == 0)
+		max_concurrent_queries = 4;
+
+	data.service = self;
+	data.cancellable = g_cancellable_new ();
+	data.results = g_async_queue_new ();
+
+	if (cancellable != NULL)
+		cancelled_id = g_cancellable_connect (cancellable, (GCallback) crawl_cancelled_cb, data.cancellable, NULL);
+
+	pool = g_thread_pool_new ((GFunc) crawl_folders_thread, &data, max_concurrent_queries, FALSE, NULL);
+
+	root_id = (folder != NULL) ? gdata_entry_get_id (GDATA_ENTRY (folder)) : "root";
+
+	/* Index the root too (with no parent, which terminates parent chains), so that it's skipped like any other folder we've already seen if the
+	 * folder structure loops back to it. It's removed again before returning. */
+	parent_index = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
+	g_hash_table_insert (parent_index, g_strdup (root_id), NULL);
+
+	pending_folders = g_ptr_array_new_with_free_func (g_free);
+	g_ptr_array_add (pending_folders, g_strdup (root_id));
+
+	do {
+		CrawlResult *result;
+
+		/* Start querying batches of pending folders. Only query a partial batch if nothing else is running; otherwise, wait for more
+		 * folders to be found so that fewer queries are needed. */
+		while (child_error == NULL &&
+		       (pending_folders->len >= CRAWL_FOLDERS_PER_QUERY || (n_outstanding_queries == 0 && pending_folders->len > 0))) {
+			guint n_folders = MIN (pending_folders->len, CRAWL_FOLDERS_PER_QUERY);
+			gchar **folder_ids;
+			guint i;
+
+			folder_ids = g_new0 (gchar*, n_folders + 1);
+			for (i = 0; i < n_folders; i++)
+				folder_ids[i] = g_strdup (pending_folders->pdata[i]);
+			g_ptr_array_remove_range (pending_folders, 0, n_folders);
+
+			g_thread_pool_push (pool, folder_ids, NULL);
+			n_outstanding_queries++;
+		}
+
+		if (n_outstanding_queries == 0)
+			break;
+
+		result = g_async_queue_pop (data.results);
+
+		if (result->error != NULL && child_error == NULL) {
+			/* Stop the other queries as soon as possible */
+			child_error = g_steal_pointer (&result->error);
+			g_cancellable_cancel (data.cancellable);
+		} else if (result->feed != NULL && child_error == NULL) {
+			GList *i;
+
+			for (i = gdata_feed_get_entries (GDATA_FEED (result->feed)); i != NULL; i = i->next) {
+				GDataEntry *entry = GDATA_ENTRY (i->data);
+				const gchar *id, *parent_id;
+				gchar **parent_chain;
+
+				id = gdata_entry_get_id (entry);
+				parent_id = crawl_get_parent_id (entry, result->folder_ids);
+
+				/* Skip entries we've already seen through another parent */
+				if (id == NULL || parent_id == NULL || g_hash_table_contains (parent_index, id))
+					continue;
+
+				g_hash_table_insert (parent_index, g_strdup (id), g_strdup (parent_id));
+
+				if (GDATA_IS_DOCUMENTS_FOLDER (entry))
+					g_ptr_array_add (pending_folders, g_strdup (id));
+
+				parent_chain = crawl_build_parent_chain (parent_index, parent_id);
+				callback (GDATA_DOCUMENTS_ENTRY (entry), (const gchar * const *) parent_chain, user_data);
+				g_free (parent_chain);
+			}
+		}
+
+		if (result->is_last)
+			n_outstanding_queries--;
+
+		crawl_result_free (result);
+	} while (TRUE);
+
+	g_thread_pool_free (pool, FALSE, TRUE);
+
+	if (cancelled_id != 0)
+		g_cancellable_disconnect (cancellable, cancelled_id);
+
+	g_ptr_array_unref (pending_folders);
+	g_async_queue_unref (data.results);
+	g_object_unref (data.cancellable);
+
+	if (child_error != NULL) {
+		/* Report cancellation by the caller as such, rather than as whichever query happened to notice it first */
+		if (g_cancellable_is_cancelled (cancellable) == TRUE) {
+			g_clear_error (&child_error);
+			g_cancellable_set_error_if_cancelled (cancellable, &child_error);
+		}
+
+		g_propagate_error (error, child_error);
+		g_hash_table_unref (parent_index);
+
+		return NULL;
+	}
+
+	g_hash_table_remove (parent_index, root_id);
+
+	return parent_index;
 }
 
 /**
@@ -25,6 +25,7 @@
 #include <gio/gio.h>
 #include <gdata/gdata-service.h>
 #include <gdata/gdata-upload-stream.h>
+#include <gdata/services/documents/gdata-documents-entry.h>
 #include <gdata/services/documents/gdata-documents-query.h>
 #include <gdata/services/documents/gdata-documents-feed.h>
 #include <gdata/services/documents/gdata-documents-metadata.h>
@@ -55,6 +56,20 @@ typedef enum {
 
 typedef struct _GDataDocumentsServicePrivate	GDataDocumentsServicePrivate;
 
+/**
+ * GDataDocumentsCrawlCallback:
+ * @entry: a #GDataDocumentsEntry found by the crawl
+ * @parent_ids: (array zero-terminated=1): the IDs of the folders leading to @entry, starting with the folder being crawled and ending with
+ * @entry's parent
+ * @user_data: user data passed to the callback
+ *
+ * Callback function called for each entry found by gdata_documents_service_crawl_folder(). @entry and @parent_ids are only valid for the
+ * duration of the call; @entry should be reffed if it needs to be kept around afterwards.
+ *
+ * Since: 0.19.0
+ */
+typedef void (*GDataDocumentsCrawlCallback) (GDataDocumentsEntry *entry, const gchar * const *parent_ids, gpointer user_data);
+
 /**
  * GDataDocumentsService:
  *
@@ -143,6 +158,12 @@ GDataUploadStream *gdata_documents_service_update_document_resumable (GDataDocum
 GDataDocumentsDocument *gdata_documents_service_finish_upload (GDataDocumentsService *self, GDataUploadStream *upload_stream,
                                                                GError **error) G_GNUC_WARN_UNUSED_RESULT G_GNUC_MALLOC;
 
+GHashTable *gdata_documents_service_index_folder (GDataDocumentsService *self, GDataDocumentsFolder *folder, GCancellable *cancellable,
+                                                  GError **error) G_GNUC_WARN_UNUSED_RESULT G_GNUC_MALLOC;
+GHashTable *gdata_documents_service_crawl_folder (GDataDocumentsService *self, GDataDocumentsFolder *folder, guint max_concurrent_queries,
+                                                  GCancellable *cancellable, GDataDocumentsCrawlCallback callback, gpointer user_data,
+                                                  GError **error) G_GNUC_WARN_UNUSED_RESULT G_GNUC_MALLOC;
+
 GDataDocumentsDocument *gdata_documents_service_copy_document (GDataDocumentsService *self, GDataDocumentsDocument *document,
                                                                GCancellable *cancellable, GError **error) G_GNUC_WARN_UNUSED_RESULT G_GNUC_MALLOC;
 void gdata_documents_service_copy_document_async (GDataDocumentsService *self, GDataDocumentsDocument *document, GCancellable *cancellable,
@@ -29,6 +29,15 @@
  * For more details of Google Tasks API, see the <ulink type="http" url="https://developers.google.com/google-apps/tasks/v1/reference/">
  * online documentation</ulink>.
  *
+ * Since 0.19.0, the Tasks service can be manipulated using batch operations, which send many insertions, updates and deletions in a single
+ * HTTP request. Create the #GDataBatchOperation with gdata_batchable_create_operation(), using
+ * <literal>https://www.googleapis.com/batch/tasks/v1</literal> as the feed URI, and add insertions with
+ * gdata_batch_operation_add_insertion_to_uri() so that each task is inserted into the right tasklist.
+ *
+ * For bulk changes where tasks are positioned relative to each other, such as importing a whole tasklist, use
+ * gdata_tasks_service_run_mutations(). It works out which insertions and moves depend on which others, and sends independent changes concurrently
+ * and in batches.
+ *
  * Since: 0.15.0
  */
 
@@ -38,6 +47,7 @@
 #include <string.h>
 
 #include "gdata-tasks-service.h"
+#include "gdata-batchable.h"
 #include "gdata-service.h"
 #include "gdata-private.h"
 #include "gdata-query.h"
@@ -53,7 +63,7 @@ static void parse_error_response (GDataService *self,
 static GList *get_authorization_domains (void);
 
 _GDATA_DEFINE_AUTHORIZATION_DOMAIN (tasks, "tasks", "https://www.googleapis.com/auth/tasks")
-G_DEFINE_TYPE (GDataTasksService, gdata_tasks_service, GDATA_TYPE_SERVICE)
+G_DEFINE_TYPE_WITH_CODE (GDataTasksService, gdata_tasks_service, GDATA_TYPE_SERVICE, G_IMPLEMENT_INTERFACE (GDATA_TYPE_BATCHABLE, NULL))
 
 static void
 gdata_tasks_service_class_init (GDataTasksServiceClass *klass)
@@ -870,3 +880,575 @@ gdata_tasks_service_update_tasklist_async (GDataTasksService *self, GDataTasksTa
 	gdata_service_update_entry_async (GDATA_SERVICE (self), get_tasks_authorization_domain (), GDATA_ENTRY (tasklist), cancellable,
 	                                  callback, user_data);
 }
+
+/* The most operations to send in a single batch request. Google recommends batches of at most 50 operations. */
+#define MUTATION_MAX_BATCH_SIZE 50
+
+typedef enum {
+	MUTATION_PENDING = 0, /* waiting for the mutations it depends on */
+	MUTATION_READY, /* queued to be sent, or being sent */
+	MUTATION_FINISHED /* callback has been called */
+} MutationState;
+
+typedef struct _MutationNode MutationNode;
+
+struct _MutationNode {
+	const GDataTasksMutation *mutation;
+	const gchar *key; /* mutation->key, or the ID of mutation->task */
+	MutationState state;
+
+	MutationNode *parent_node; /* node which mutation->parent refers to, or NULL if it's a plain ID */
+	MutationNode *previous_node; /* node which mutation->previous refers to, or NULL if it's a plain ID */
+	GPtrArray *dependents; /* unowned MutationNodes which can't be sent until this one has finished; or NULL */
+	guint n_dependencies; /* number of unfinished nodes this one is waiting for */
+
+	gchar *parent_id; /* owned; resolved server-side ID of the parent, set just before the node is sent */
+	gchar *previous_id; /* owned; resolved server-side ID of the previous sibling, set just before the node is sent */
+
+	GDataTasksTask *result; /* owned; set by the worker thread */
+	GError *error; /* owned; set by the worker thread */
+	gboolean has_batch_result; /* TRUE once the node's batch operation callback has been called; only used by the worker thread */
+};
+
+typedef struct {
+	GDataTasksService *service;
+	gchar *tasks_uri; /* owned; URI of the tasklist's tasks collection */
+	GCancellable *cancellable; /* cancelled by the caller's cancellable */
+	GAsyncQueue *results; /* GPtrArray of the MutationNodes sent together, once they've all finished */
+} MutationData;
+
+static void
+mutation_add_dependency (MutationNode *node, MutationNode *dependency)
+{
+	if (dependency->dependents == NULL)
+		dependency->dependents = g_ptr_array_new ();
+
+	g_ptr_array_add (dependency->dependents, node);
+	node->n_dependencies++;
+}
+
+/* Work out which other mutation, if any, the key or ID @reference refers to, and add the dependency that implies between @node and it. The other
+ * mutation is returned in @other_node, or %NULL is returned there if @reference is a plain ID. */
+static gboolean
+mutation_link_reference (MutationNode *node, const gchar *reference, GHashTable *nodes_by_key, MutationNode **other_node, GError **error)
+{
+	*other_node = NULL;
+
+	if (reference == NULL || (*other_node = g_hash_table_lookup (nodes_by_key, reference)) == NULL)
+		return TRUE;
+
+	switch ((*other_node)->mutation->type) {
+		case GDATA_TASKS_MUTATION_INSERTION:
+		case GDATA_TASKS_MUTATION_MOVE:
+			/* The other task has to be in place before this one can be positioned relative to it */
+			mutation_add_dependency (node, *other_node);
+			break;
+		case GDATA_TASKS_MUTATION_DELETION:
+			/* Whichever order the two were sent in, this task would end up under or after a task which no longer exists */
+			g_set_error (error, GDATA_SERVICE_ERROR, GDATA_SERVICE_ERROR_WITH_BATCH_OPERATION,
+			             /* Translators: the parameter is a task ID, or a key chosen by the application. */
+			             _("A task can’t be placed relative to task ‘%s’, which is being deleted."), reference);
+			return FALSE;
+		case GDATA_TASKS_MUTATION_UPDATE:
+			/* Updates don't change where a task is */
+			break;
+		default:
+			g_assert_not_reached ();
+	}
+
+	return TRUE;
+}
+
+/* Checks that the dependencies between @nodes can be satisfied, using Kahn's algorithm: repeatedly take away nodes which have no unfinished
+ * dependencies. Any nodes left over are on a cycle. */
+static gboolean
+mutation_check_acyclic (MutationNode *nodes, guint n_nodes)
+{
+	guint *n_dependencies;
+	GQueue queue = G_QUEUE_INIT;
+	guint i, n_visited = 0;
+
+	n_dependencies = g_new (guint, n_nodes);
+
+	for (i = 0; i < n_nodes; i++) {
+		n_dependencies[i] = nodes[i].n_dependencies;
+		if (n_dependencies[i] == 0)
+			g_queue_push_tail (&queue, &nodes[i]);
+	}
+
+	while (g_queue_is_empty (&queue) == FALSE) {
+		MutationNode *node = g_queue_pop_head (&queue);
+
+		n_visited++;
+
+		for (i = 0; node->dependents != NULL && i < node->dependents->len; i++) {
+			MutationNode *dependent = node->dependents->pdata[i];
+
+			if (--n_dependencies[dependent - nodes] == 0)
+				g_queue_push_tail (&queue, dependent);
+		}
+	}
+
+	g_free (n_dependencies);
+
+	return (n_visited == n_nodes);
+}
+
+/* Returns the server-side ID of the task referred to by @reference, once @other_node (if non-%NULL) has finished. */
+static gchar *
+mutation_resolve_reference (const gchar *reference, MutationNode *other_node)
+{
+	GDataTasksTask *task;
+
+	if (other_node == NULL)
+		return g_strdup (reference);
+
+	task = (other_node->result != NULL) ? other_node->result : other_node->mutation->task;
+
+	return g_strdup (gdata_entry_get_id (GDATA_ENTRY (task)));
+}
+
+/* Append the parent and previous query parameters understood by the insert and move methods to @base_uri */
+static gchar *
+mutation_build_position_uri (const gchar *base_uri, const gchar *parent_id, const gchar *previous_id)
+{
+	GString *uri;
+
+	uri = g_string_new (base_uri);
+
+	if (parent_id != NULL) {
+		g_string_append (uri, "?parent=");
+		g_string_append_uri_escaped (uri, parent_id, NULL, FALSE);
+	}
+
+	if (previous_id != NULL) {
+		g_string_append (uri, (parent_id != NULL) ? "&previous=" : "?previous=");
+		g_string_append_uri_escaped (uri, previous_id, NULL, FALSE);
+	}
+
+	return g_string_free (uri, FALSE);
+}
+
+/* There's no convenience function for the move method, which takes no request body and returns the moved task */
+static GDataTasksTask *
+mutation_move_task (MutationData *data, MutationNode *node, GError **error)
+{
+	GDataTasksTask *task;
+	SoupMessage *message;
+	gchar *base_uri, *uri;
+	guint status;
+
+	base_uri = _gdata_service_build_uri ("%p/%s/move", data->tasks_uri, gdata_entry_get_id (GDATA_ENTRY (node->mutation->task)));
+	uri = mutation_build_position_uri (base_uri, node->parent_id, node->previous_id);
+	g_free (base_uri);
+
+	message = _gdata_service_build_message (GDATA_SERVICE (data->service), get_tasks_authorization_domain (), SOUP_METHOD_POST, uri, NULL, FALSE);
+	g_free (uri);
+
+	status = _gdata_service_send_message (GDATA_SERVICE (data->service), message, data->cancellable, error);
+
+	if (status == SOUP_STATUS_NONE || status == SOUP_STATUS_CANCELLED) {
+		/* Redirect error or cancelled */
+		g_object_unref (message);
+		return NULL;
+	} else if (status != SOUP_STATUS_OK) {
+		/* Error */
+		GDataServiceClass *klass = GDATA_SERVICE_GET_CLASS (data->service);
+		g_assert (klass->parse_error_response != NULL);
+		klass->parse_error_response (GDATA_SERVICE (data->service), GDATA_OPERATION_UPDATE, status, message->reason_phrase,
+		                             message->response_body->data, message->response_body->length, error);
+		g_object_unref (message);
+		return NULL;
+	}
+
+	g_assert (message->response_body->data != NULL);
+	task = GDATA_TASKS_TASK (gdata_parsable_new_from_json (GDATA_TYPE_TASKS_TASK, message->response_body->data, message->response_body->length,
+	                                                        error));
+	g_object_unref (message);
+
+	return task;
+}
+
+static void
+mutation_run_single (MutationData *data, MutationNode *node)
+{
+	GDataService *service = GDATA_SERVICE (data->service);
+	GDataEntry *entry = GDATA_ENTRY (node->mutation->task);
+
+	switch (node->mutation->type) {
+		case GDATA_TASKS_MUTATION_INSERTION: {
+			gchar *uri;
+
+			uri = mutation_build_position_uri (data->tasks_uri, node->parent_id, node->previous_id);
+			node->result = GDATA_TASKS_TASK (gdata_service_insert_entry (service, get_tasks_authorization_domain (), uri, entry,
+			                                                             data->cancellable, &node->error));
+			g_free (uri);
+			break;
+		}
+		case GDATA_TASKS_MUTATION_UPDATE:
+			node->result = GDATA_TASKS_TASK (gdata_service_update_entry (service, get_tasks_authorization_domain (), entry,
+			                                                             data->cancellable, &node->error));
+			break;
+		case GDATA_TASKS_MUTATION_MOVE:
+			node->result = mutation_move_task (data, node, &node->error);
+			break;
+		case GDATA_TASKS_MUTATION_DELETION:
+			gdata_service_delete_entry (service, get_tasks_authorization_domain (), entry, data->cancellable, &node->error);
+			break;
+		default:
+			g_assert_not_reached ();
+	}
+}
+
+static void
+mutation_batch_cb (guint operation_id, GDataBatchOperationType operation_type, GDataEntry *entry, GError *error, MutationNode *node)
+{
+	if (entry != NULL)
+		node->result = GDATA_TASKS_TASK (g_object_ref (entry));
+	if (error != NULL)
+		node->error = g_error_copy (error);
+
+	node->has_batch_result = TRUE;
+}
+
+/* Send the insertions, updates and deletions in @nodes as a single JSON batch request. Moves have no request body, so can't be batched. */
+static void
+mutation_run_batch (MutationData *data, GPtrArray *nodes)
+{
+	GDataBatchOperation *operation;
+	gchar *batch_uri;
+	guint i;
+	GError *child_error = NULL;
+
+	batch_uri = g_strconcat (_gdata_service_get_scheme (), "://www.googleapis.com/batch/tasks/v1", NULL);
+	operation = gdata_batchable_create_operation (GDATA_BATCHABLE (data->service), get_tasks_authorization_domain (), batch_uri);
+	g_free (batch_uri);
+
+	for (i = 0; i < nodes->len; i++) {
+		MutationNode *node = nodes->pdata[i];
+		GDataEntry *entry = GDATA_ENTRY (node->mutation->task);
+
+		switch (node->mutation->type) {
+			case GDATA_TASKS_MUTATION_INSERTION: {
+				gchar *uri;
+
+				uri = mutation_build_position_uri (data->tasks_uri, node->parent_id, node->previous_id);
+				gdata_batch_operation_add_insertion_to_uri (operation, entry, uri, (GDataBatchOperationCallback) mutation_batch_cb, node);
+				g_free (uri);
+				break;
+			}
+			case GDATA_TASKS_MUTATION_UPDATE:
+				gdata_batch_operation_add_update (operation, entry, (GDataBatchOperationCallback) mutation_batch_cb, node);
+				break;
+			case GDATA_TASKS_MUTATION_DELETION:
+				gdata_batch_operation_add_deletion (operation, entry, (GDataBatchOperationCallback) mutation_batch_cb, node);
+				break;
+			case GDATA_TASKS_MUTATION_MOVE:
+			default:
+				g_assert_not_reached ();
+		}
+	}
+
+	/* If the batch fails before it's sent (such as when it's already been cancelled), some or all of the callbacks aren't called, so those
+	 * mutations get the batch's error */
+	if (gdata_batch_operation_run (operation, data->cancellable, &child_error) == FALSE) {
+		for (i = 0; i < nodes->len; i++) {
+			MutationNode *node = nodes->pdata[i];
+
+			if (node->has_batch_result == FALSE)
+				node->error = g_error_copy (child_error);
+		}
+
+		g_error_free (child_error);
+	}
+
+	g_object_unref (operation);
+}
+
+/* Runs in a worker thread: send a group of independent mutations, then pass them back to the scheduling thread */
+static void
+mutation_run_thread (GPtrArray *nodes, MutationData *data)
+{
+	if (nodes->len == 1)
+		mutation_run_single (data, nodes->pdata[0]);
+	else
+		mutation_run_batch (data, nodes);
+
+	g_async_queue_push (data->results, nodes);
+}
+
+/* Take the next group of ready mutations off @ready to send together. Groups are sized to spread the ready mutations over the free workers,
+ * without exceeding MUTATION_MAX_BATCH_SIZE. */
+static GPtrArray *
+mutation_take_group (GQueue *ready, guint n_free_workers)
+{
+	GPtrArray *nodes;
+	MutationNode *node;
+	guint group_size;
+
+	group_size = MIN ((g_queue_get_length (ready) + n_free_workers - 1) / n_free_workers, MUTATION_MAX_BATCH_SIZE);
+	nodes = g_ptr_array_sized_new (group_size);
+
+	node = g_queue_pop_head (ready);
+	g_ptr_array_add (nodes, node);
+
+	/* Moves can't be batched, so always go on their own */
+	if (node->mutation->type == GDATA_TASKS_MUTATION_MOVE)
+		return nodes;
+
+	while (nodes->len < group_size && (node = g_queue_peek_head (ready)) != NULL && node->mutation->type != GDATA_TASKS_MUTATION_MOVE)
+		g_ptr_array_add (nodes, g_queue_pop_head (ready));
+
+	return nodes;
+}
+
+/* Mark @node as finished, call the user's callback for it, and update its dependents: those whose dependencies have all finished are moved to
+ * @ready, and those which depend on a failed mutation fail in turn. */
+static void
+mutation_finish (MutationNode *node, GQueue *ready, GDataTasksMutationCallback callback, gpointer user_data)
+{
+	guint i;
+
+	g_assert (node->state != MUTATION_FINISHED);
+	node->state = MUTATION_FINISHED;
+
+	callback (node->mutation, (node->error == NULL) ? node->result : NULL, node->error, user_data);
+
+	for (i = 0; node->dependents != NULL && i < node->dependents->len; i++) {
+		MutationNode *dependent = node->dependents->pdata[i];
+
+		if (dependent->state != MUTATION_PENDING)
+			continue;
+
+		if (g_error_matches (node->error, G_IO_ERROR, G_IO_ERROR_CANCELLED) == TRUE) {
+			/* Mutations left waiting on a cancelled one were cancelled too */
+			dependent->error = g_error_copy (node->error);
+			mutation_finish (dependent, ready, callback, user_data);
+		} else if (node->error != NULL) {
+			g_set_error (&dependent->error, GDATA_SERVICE_ERROR, GDATA_SERVICE_ERROR_WITH_BATCH_OPERATION,
+			             _("A task change this one depends on failed."));
+			mutation_finish (dependent, ready, callback, user_data);
+		} else if (--dependent->n_dependencies == 0) {
+			dependent->state = MUTATION_READY;
+			g_queue_push_tail (ready, dependent);
+		}
+	}
+}
+
+static void
+mutation_cancelled_cb (GCancellable *cancellable, GCancellable *child_cancellable)
+{
+	g_cancellable_cancel (child_cancellable);
+}
+
+/**
+ * gdata_tasks_service_run_mutations:
+ * @self: a #GDataTasksService
+ * @tasklist: the #GDataTasksTasklist containing the tasks
+ * @mutations: (array length=n_mutations): the #GDataTasksMutations to make
+ * @n_mutations: the number of elements in @mutations
+ * @max_concurrent_requests: the maximum number of requests to have in flight at once, or <code class="literal">0</code> to use a default
+ * @cancellable: (allow-none): optional #GCancellable object, or %NULL
+ * @callback: (scope call) (closure user_data): a #GDataTasksMutationCallback to call as each mutation finishes
+ * @user_data: (closure): data to pass to the @callback function
+ * @error: a #GError, or %NULL
+ *
+ * Makes many changes to the tasks in @tasklist at once, such as when importing a tasklist from another system. This is much faster than calling
+ * gdata_tasks_service_insert_task() and friends for each change in turn.
+ *
+ * Insertions and moves put their task under the task referred to by the mutation's #GDataTasksMutation.parent, immediately after the sibling
+ * referred to by #GDataTasksMutation.previous. Each of these is either the #GDataTasksMutation.key of another of @mutations (which defaults to the
+ * ID of its task), or the ID of a task already on the server. Keys allow a new task to be placed relative to another task which is being inserted
+ * by the same call, and so doesn't have an ID yet.
+ *
+ * The order of the mutations is worked out from these links: a task is only inserted or moved once the tasks it's placed relative to have been
+ * inserted or moved. Mutations which don't depend on each other are sent concurrently, up to @max_concurrent_requests requests at once, and groups
+ * of them are sent together as a single batch request (see #GDataBatchOperation). Updates and deletions don't depend on anything, so they're sent
+ * straight away. Note that a sequence of siblings which are each placed after the one before still has to be inserted one by one, as the server
+ * requires; but the subtasks of different tasks are inserted in parallel. Siblings which don't specify #GDataTasksMutation.previous are placed in
+ * an unspecified order.
+ *
+ * @callback is called once for each mutation, in the thread which called this function, as soon as it has finished. Updates include the
+ * mutation's ETag, so each task should only be the subject of one mutation. If a mutation fails, its error is passed to @callback and the other
+ * mutations carry on, apart from those which depend on the failed one: they fail with %GDATA_SERVICE_ERROR_WITH_BATCH_OPERATION.
+ *
+ * If the mutations' keys aren't unique, their links form a cycle, or an insertion or move is placed relative to a task which is being deleted,
+ * %GDATA_SERVICE_ERROR_WITH_BATCH_OPERATION is returned before anything is sent and @callback isn't called. If @cancellable is cancelled, the
+ * mutations in progress are stopped and the mutations which haven't finished are passed to @callback with a %G_IO_ERROR_CANCELLED error, and
+ * %G_IO_ERROR_CANCELLED is returned. Otherwise the return value doesn't indicate whether the individual mutations succeeded: %TRUE could be
+ * returned even if they all failed.
+ *
+ * Return value: %TRUE on success, %FALSE otherwise
+ *
+ * Since: 0.19.0
+ */
+gboolean
+gdata_tasks_service_run_mutations (GDataTasksService *self, GDataTasksTasklist *tasklist, const GDataTasksMutation *mutations, guint n_mutations,
+                                   guint max_concurrent_requests, GCancellable *cancellable, GDataTasksMutationCallback callback,
+                                   gpointer user_data, GError **error)
+{
+	MutationData data;
+	MutationNode *nodes;
+	GHashTable *nodes_by_key;
+	GThreadPool *pool;
+	GQueue ready = G_QUEUE_INIT;
+	guint i, n_running_groups = 0;
+	gulong cancelled_id = 0;
+	gboolean success = TRUE;
+
+	g_return_val_if_fail (GDATA_IS_TASKS_SERVICE (self), FALSE);
+	g_return_val_if_fail (GDATA_IS_TASKS_TASKLIST (tasklist), FALSE);
+	g_return_val_if_fail (gdata_entry_get_id (GDATA_ENTRY (tasklist)) != NULL, FALSE);
+	g_return_val_if_fail (mutations != NULL || n_mutations == 0, FALSE);
+	g_return_val_if_fail (cancellable == NULL || G_IS_CANCELLABLE (cancellable), FALSE);
+	g_return_val_if_fail (callback != NULL, FALSE);
+	g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+
+	for (i = 0; i < n_mutations; i++) {
+		g_return_val_if_fail (GDATA_IS_TASKS_TASK (mutations[i].task), FALSE);
+		g_return_val_if_fail (mutations[i].type <= GDATA_TASKS_MUTATION_DELETION, FALSE);
+		g_return_val_if_fail ((mutations[i].type == GDATA_TASKS_MUTATION_INSERTION) ==
+		                      (gdata_entry_get_id (GDATA_ENTRY (mutations[i].task)) == NULL), FALSE);
+	}
+
+	/* Build the dependency graph between the mutations, and check it before sending anything */
+	nodes = g_new0 (MutationNode, n_mutations);
+	nodes_by_key = g_hash_table_new (g_str_hash, g_str_equal);
+
+	for (i = 0; i < n_mutations; i++) {
+		nodes[i].mutation = &mutations[i];
+		nodes[i].key = (mutations[i].key != NULL) ? mutations[i].key : gdata_entry_get_id (GDATA_ENTRY (mutations[i].task));
+
+		if (nodes[i].key == NULL)
+			continue;
+
+		if (g_hash_table_contains (nodes_by_key, nodes[i].key) == TRUE) {
+			g_set_error (error, GDATA_SERVICE_ERROR, GDATA_SERVICE_ERROR_WITH_BATCH_OPERATION,
+			             /* Translators: the parameter is a task ID, or a key chosen by the application. */
+			             _("More than one change was given for task ‘%s’."), nodes[i].key);
+			success = FALSE;
+			goto done;
+		}
+
+		g_hash_table_insert (nodes_by_key, (gpointer) nodes[i].key, &nodes[i]);
+	}
+
+	for (i = 0; i < n_mutations; i++) {
+		if (mutations[i].type != GDATA_TASKS_MUTATION_INSERTION && mutations[i].type != GDATA_TASKS_MUTATION_MOVE)
+			continue;
+
+		if (mutation_link_reference (&nodes[i], mutations[i].parent, nodes_by_key, &nodes[i].parent_node, error) == FALSE ||
+		    mutation_link_reference (&nodes[i], mutations[i].previous, nodes_by_key, &nodes[i].previous_node, error) == FALSE) {
+			success = FALSE;
+			goto done;
+		}
+	}
+
+	if (mutation_check_acyclic (nodes, n_mutations) == FALSE) {
+		g_set_error_literal (error, GDATA_SERVICE_ERROR, GDATA_SERVICE_ERROR_WITH_BATCH_OPERATION,
+		                     _("The task changes can’t be ordered, as their parent and previous tasks form a loop."));
+		success = FALSE;
+		goto done;
+	}
+
+	/* Ensure we're authenticated first */
+	if (gdata_authorizer_is_authorized_for_domain (gdata_service_get_authorizer (GDATA_SERVICE (self)),
+	                                               get_tasks_authorization_domain ()) == FALSE) {
+		g_set_error_literal (error, GDATA_SERVICE_ERROR, GDATA_SERVICE_ERROR_AUTHENTICATION_REQUIRED,
+		                     _("You must be authenticated to change your tasks."));
+		success = FALSE;
+		goto done;
+	}
+
+	if (max_concurrent_requests == 0)
+		max_concurrent_requests = 4;
+
+	data.service = self;
+	data.tasks_uri = _gdata_service_build_uri ("%s://www.googleapis.com/tasks/v1/lists/%s/tasks", _gdata_service_get_scheme (),
+	                                           gdata_entry_get_id (GDATA_ENTRY (tasklist)));
+	data.cancellable = g_cancellable_new ();
+	data.results = g_async_queue_new ();
+
+	if (cancellable != NULL)
+		cancelled_id = g_cancellable_connect (cancellable, (GCallback) mutation_cancelled_cb, data.cancellable, NULL);
+
+	pool = g_thread_pool_new ((GFunc) mutation_run_thread, &data, max_concurrent_requests, FALSE, NULL);
+
+	for (i = 0; i < n_mutations; i++) {
+		if (nodes[i].n_dependencies == 0) {
+			nodes[i].state = MUTATION_READY;
+			g_queue_push_tail (&ready, &nodes[i]);
+		}
+	}
+
+	/* Keep going until nothing is running and nothing more can be sent: finishing the last running group may make more mutations ready */
+	do {
+		/* Send as many of the ready mutations as there are free workers for */
+		while (n_running_groups < max_concurrent_requests && g_queue_is_empty (&ready) == FALSE &&
+		       g_cancellable_is_cancelled (data.cancellable) == FALSE) {
+			GPtrArray *group;
+			guint j;
+
+			group = mutation_take_group (&ready, max_concurrent_requests - n_running_groups);
+
+			for (j = 0; j < group->len; j++) {
+				MutationNode *node = group->pdata[j];
+
+				node->parent_id = mutation_resolve_reference (node->mutation->parent, node->parent_node);
+				node->previous_id = mutation_resolve_reference (node->mutation->previous, node->previous_node);
+			}
+
+			g_thread_pool_push (pool, group, NULL);
+			n_running_groups++;
+		}
+
+		if (n_running_groups > 0) {
+			GPtrArray *group;
+
+			group = g_async_queue_pop (data.results);
+			n_running_groups--;
+
+			for (i = 0; i < group->len; i++)
+				mutation_finish (group->pdata[i], &ready, callback, user_data);
+
+			g_ptr_array_unref (group);
+		}
+	} while (n_running_groups > 0 || (g_queue_is_empty (&ready) == FALSE && g_cancellable_is_cancelled (data.cancellable) == FALSE));
+
+	g_thread_pool_free (pool, FALSE, TRUE);
+
+	if (cancelled_id != 0)
+		g_cancellable_disconnect (cancellable, cancelled_id);
+
+	/* Anything left over was cancelled before it could be sent. Finishing one may finish its dependents too, hence the state check. */
+	for (i = 0; i < n_mutations; i++) {
+		if (nodes[i].state != MUTATION_FINISHED) {
+			g_cancellable_set_error_if_cancelled (data.cancellable, &nodes[i].error);
+			g_assert (nodes[i].error != NULL);
+			mutation_finish (&nodes[i], &ready, callback, user_data);
+		}
+	}
+
+	if (g_cancellable_set_error_if_cancelled (data.cancellable, error) == TRUE)
+		success = FALSE;
+
+	g_async_queue_unref (data.results);
+	g_object_unref (data.cancellable);
+	g_free (data.tasks_uri);
+
+done:
+	for (i = 0; i < n_mutations; i++) {
+		if (nodes[i].dependents != NULL)
+			g_ptr_array_unref (nodes[i].dependents);
+		g_free (nodes[i].parent_id);
+		g_free (nodes[i].previous_id);
+		g_clear_object (&nodes[i].result);
+		g_clear_error (&nodes[i].error);
+	}
+
+	g_hash_table_unref (nodes_by_key);
+	g_queue_clear (&ready);
+	g_free (nodes);
+
+	return success;
+}
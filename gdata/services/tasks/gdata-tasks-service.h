@@ -65,6 +65,64 @@ typedef struct {
 	void (*_g_reserved1) (void);
 } GDataTasksServiceClass;
 
+/**
+ * GDataTasksMutationType:
+ * @GDATA_TASKS_MUTATION_INSERTION: insert a new task, as with gdata_tasks_service_insert_task()
+ * @GDATA_TASKS_MUTATION_UPDATE: update an existing task, as with gdata_tasks_service_update_task()
+ * @GDATA_TASKS_MUTATION_MOVE: move an existing task to a new parent or position in its tasklist
+ * @GDATA_TASKS_MUTATION_DELETION: delete an existing task, as with gdata_tasks_service_delete_task()
+ *
+ * The type of change made by a #GDataTasksMutation.
+ *
+ * Since: 0.19.0
+ */
+typedef enum {
+	GDATA_TASKS_MUTATION_INSERTION = 0,
+	GDATA_TASKS_MUTATION_UPDATE,
+	GDATA_TASKS_MUTATION_MOVE,
+	GDATA_TASKS_MUTATION_DELETION
+} GDataTasksMutationType;
+
+/**
+ * GDataTasksMutation:
+ * @type: the type of change to make
+ * @task: the #GDataTasksTask to insert, update, move or delete
+ * @key: (allow-none): a key which other mutations' @parent and @previous can use to refer to this mutation's task, or %NULL to use the ID of @task
+ * @parent: (allow-none): the key or ID of the task to insert or move @task under, or %NULL to put it at the top level; ignored for updates and
+ * deletions
+ * @previous: (allow-none): the key or ID of the sibling task to insert or move @task after, or %NULL to put it first among its siblings; ignored
+ * for updates and deletions
+ *
+ * A single change to a task, to be made by gdata_tasks_service_run_mutations(). See its documentation for details of how @key, @parent and
+ * @previous are resolved.
+ *
+ * Since: 0.19.0
+ */
+typedef struct {
+	GDataTasksMutationType type;
+	GDataTasksTask *task;
+	const gchar *key;
+	const gchar *parent;
+	const gchar *previous;
+} GDataTasksMutation;
+
+/**
+ * GDataTasksMutationCallback:
+ * @mutation: the #GDataTasksMutation which has been made
+ * @task: (allow-none): the updated #GDataTasksTask returned by the server, or %NULL
+ * @error: (allow-none): a #GError describing why the mutation failed, or %NULL
+ * @user_data: user data passed to the callback
+ *
+ * Callback function called once for each mutation run by gdata_tasks_service_run_mutations(). If the mutation was successful, @error is %NULL and,
+ * unless @mutation is a deletion, @task is the resulting task as returned by the server. Otherwise, @task is %NULL and @error is set.
+ *
+ * If the callback code needs to retain a copy of @task, it must be referenced (with g_object_ref()). Similarly, @error is owned by the calling code,
+ * and must not be freed.
+ *
+ * Since: 0.19.0
+ */
+typedef void (*GDataTasksMutationCallback) (const GDataTasksMutation *mutation, GDataTasksTask *task, GError *error, gpointer user_data);
+
 GType gdata_tasks_service_get_type (void) G_GNUC_CONST;
 
 GDataTasksService *gdata_tasks_service_new (GDataAuthorizer *authorizer) G_GNUC_WARN_UNUSED_RESULT G_GNUC_MALLOC;
@@ -110,6 +168,10 @@ GDataTasksTasklist *gdata_tasks_service_update_tasklist (GDataTasksService *self
 void gdata_tasks_service_update_tasklist_async (GDataTasksService *self, GDataTasksTasklist *tasklist,
                                                 GCancellable *cancellable, GAsyncReadyCallback callback, gpointer user_data);
 
+gboolean gdata_tasks_service_run_mutations (GDataTasksService *self, GDataTasksTasklist *tasklist, const GDataTasksMutation *mutations,
+                                            guint n_mutations, guint max_concurrent_requests, GCancellable *cancellable,
+                                            GDataTasksMutationCallback callback, gpointer user_data, GError **error);
+
 G_END_DECLS
 
 #endif /* !GDATA_TASKS_SERVICE_H */
@@ -584,6 +584,159 @@ G_STMT_START {
 	}
 } G_STMT_END);
 
+/* Pages of events served by query_events_merged_handle_message_cb(), for two calendars. Calendar A's events are split over two pages, and calendar
+ * B has a cancelled occurrence of a recurring event, which has no start time of its own. */
+static const gchar *merged_calendar_a_pages[] = {
+	"{"
+		"\"kind\": \"calendar#events\","
+		"\"nextPageToken\": \"page-2\","
+		"\"items\": ["
+			"{"
+				"\"kind\": \"calendar#event\", \"id\": \"a1\", \"etag\": \"\\\"1\\\"\", \"status\": \"confirmed\","
+				"\"start\": { \"dateTime\": \"2026-05-01T10:00:00Z\" }, \"end\": { \"dateTime\": \"2026-05-01T11:00:00Z\" }"
+			"},"
+			"{"
+				"\"kind\": \"calendar#event\", \"id\": \"a2\", \"etag\": \"\\\"1\\\"\", \"status\": \"confirmed\","
+				"\"start\": { \"dateTime\": \"2026-05-01T12:00:00Z\" }, \"end\": { \"dateTime\": \"2026-05-01T13:00:00Z\" }"
+			"}"
+		"]"
+	"}",
+	"{"
+		"\"kind\": \"calendar#events\","
+		"\"items\": ["
+			"{"
+				"\"kind\": \"calendar#event\", \"id\": \"a3\", \"etag\": \"\\\"1\\\"\", \"status\": \"confirmed\","
+				"\"start\": { \"dateTime\": \"2026-05-01T15:00:00Z\" }, \"end\": { \"dateTime\": \"2026-05-01T16:00:00Z\" }"
+			"}"
+		"]"
+	"}",
+};
+
+static const gchar *merged_calendar_b_page =
+	"{"
+		"\"kind\": \"calendar#events\","
+		"\"items\": ["
+			"{"
+				"\"kind\": \"calendar#event\", \"id\": \"b1\", \"etag\": \"\\\"1\\\"\", \"status\": \"confirmed\","
+				"\"start\": { \"dateTime\": \"2026-05-01T11:00:00Z\" }, \"end\": { \"dateTime\": \"2026-05-01T12:00:00Z\" }"
+			"},"
+			"{"
+				"\"kind\": \"calendar#event\", \"id\": \"b2_20260501T130000Z\", \"etag\": \"\\\"1\\\"\", \"status\": \"cancelled\","
+				"\"recurringEventId\": \"b2\", \"originalStartTime\": { \"dateTime\": \"2026-05-01T13:00:00Z\" }"
+			"},"
+			"{"
+				"\"kind\": \"calendar#event\", \"id\": \"b3\", \"etag\": \"\\\"1\\\"\", \"status\": \"confirmed\","
+				"\"start\": { \"dateTime\": \"2026-05-01T14:00:00Z\" }, \"end\": { \"dateTime\": \"2026-05-01T15:00:00Z\" }"
+			"}"
+		"]"
+	"}";
+
+/* Called in the mock server's thread, one message at a time */
+static gboolean
+query_events_merged_handle_message_cb (UhmServer *server, SoupMessage *message, SoupClientContext *client, guint *n_requests)
+{
+	SoupURI *uri;
+	GHashTable *params;
+	const gchar *path, *page_token, *body;
+
+	uri = soup_message_get_uri (message);
+	path = soup_uri_get_path (uri);
+	params = soup_form_decode (soup_uri_get_query (uri));
+	page_token = g_hash_table_lookup (params, "pageToken");
+
+	/* The caller's query applies to each calendar, apart from its ETag, and each calendar's events are expanded and ordered by start time */
+	g_assert_cmpstr (g_hash_table_lookup (params, "singleEvents"), ==, "true");
+	g_assert_cmpstr (g_hash_table_lookup (params, "orderBy"), ==, "starttime");
+	g_assert_cmpstr (g_hash_table_lookup (params, "showDeleted"), ==, "true");
+	g_assert_cmpstr (g_hash_table_lookup (params, "timeZone"), ==, "UTC");
+	g_assert_cmpstr (g_hash_table_lookup (params, "maxResults"), ==, "3");
+	g_assert (soup_message_headers_get_one (message->request_headers, "If-None-Match") == NULL);
+
+	if (g_strcmp0 (path, "/calendar/v3/calendars/calendar-a/events") == 0) {
+		g_assert (page_token == NULL || g_strcmp0 (page_token, "page-2") == 0);
+		body = merged_calendar_a_pages[(page_token == NULL) ? 0 : 1];
+	} else {
+		g_assert_cmpstr (path, ==, "/calendar/v3/calendars/calendar-b/events");
+		g_assert (page_token == NULL);
+		body = merged_calendar_b_page;
+	}
+
+	g_hash_table_unref (params);
+
+	soup_message_set_status (message, SOUP_STATUS_OK);
+	soup_message_headers_set_content_type (message->response_headers, "application/json", NULL);
+	soup_message_body_append (message->response_body, SOUP_MEMORY_STATIC, body, strlen (body));
+
+	(*n_requests)++;
+
+	return TRUE;
+}
+
+static void
+query_events_merged_cb (GDataCalendarEvent *event, GDataCalendarCalendar *calendar, GString *results)
+{
+	g_string_append_printf (results, "%s/%s ", gdata_entry_get_id (GDATA_ENTRY (calendar)), gdata_entry_get_id (GDATA_ENTRY (event)));
+}
+
+/* Test that events from several calendars, over several pages, are merged in order of start time */
+static void
+test_query_events_merged (gconstpointer service)
+{
+	GDataCalendarCalendar *calendar_a, *calendar_b;
+	GDataCalendarQuery *query;
+	GList *calendars;
+	GString *results;
+	gulong handler_id;
+	guint n_requests = 0;
+	GError *error = NULL;
+
+	/* The responses refer to calendars which don't exist on the real server */
+	if (uhm_server_get_enable_online (mock_server)) {
+		g_test_skip ("Test uses canned responses");
+		return;
+	}
+
+	handler_id = g_signal_connect (mock_server, "handle-message", (GCallback) query_events_merged_handle_message_cb, &n_requests);
+	uhm_server_run (mock_server);
+	gdata_test_set_https_port (mock_server);
+
+	calendar_a = gdata_calendar_calendar_new ("calendar-a");
+	calendar_b = gdata_calendar_calendar_new ("calendar-b");
+	calendars = g_list_prepend (NULL, calendar_b);
+	calendars = g_list_prepend (calendars, calendar_a);
+
+	query = gdata_calendar_query_new (NULL);
+	gdata_calendar_query_set_single_events (query, FALSE);
+	gdata_calendar_query_set_show_deleted (query, TRUE);
+	gdata_calendar_query_set_timezone (query, "UTC");
+	gdata_query_set_max_results (GDATA_QUERY (query), 3);
+	gdata_query_set_etag (GDATA_QUERY (query), "\"some-etag\"");
+
+	results = g_string_new (NULL);
+
+	g_assert (gdata_calendar_service_query_events_merged (GDATA_CALENDAR_SERVICE (service), calendars, query, 0, NULL,
+	                                                      (GDataCalendarMergedEventCallback) query_events_merged_cb, results, &error) == TRUE);
+	g_assert_no_error (error);
+
+	/* The cancelled occurrence is ordered by its original start time */
+	g_assert_cmpuint (n_requests, ==, 3);
+	g_assert_cmpstr (results->str, ==,
+	                 "calendar-a/a1 calendar-b/b1 calendar-a/a2 calendar-b/b2_20260501T130000Z calendar-b/b3 calendar-a/a3 ");
+
+	/* The caller's query isn't modified */
+	g_assert (gdata_calendar_query_get_single_events (query) == FALSE);
+	g_assert_cmpstr (gdata_query_get_etag (GDATA_QUERY (query)), ==, "\"some-etag\"");
+
+	g_string_free (results, TRUE);
+	g_object_unref (query);
+	g_list_free (calendars);
+	g_object_unref (calendar_b);
+	g_object_unref (calendar_a);
+
+	uhm_server_stop (mock_server);
+	g_signal_handler_disconnect (mock_server, handler_id);
+}
+
 static void
 test_event_json (void)
 {
@@ -771,6 +924,15 @@ test_event_json_dates (void)
 			"'dateTime': '2009-04-17T16:00:00Z',"
 			"'timeZone': 'UTC'"
 		"}", FALSE, 1239926400 + 54000, 1239926400 + 54000 + 3600, NULL },
+		/* Full date and time, in a time zone other than UTC. */
+		{ "'start': {"
+			"'dateTime': '2009-04-17T15:00:00Z',"
+			"'timeZone': 'Europe/London'"
+		"},"
+		"'end': {"
+			"'dateTime': '2009-04-17T16:00:00Z',"
+			"'timeZone': 'Europe/London'"
+		"}", FALSE, 1239926400 + 54000, 1239926400 + 54000 + 3600, NULL },
 		/* Start and end time. */
 		{ "'start': {"
 			"'date': '2009-04-27',"
@@ -880,8 +1042,10 @@ static void
 test_event_json_recurrence (void)
 {
 	GDataCalendarEvent *event;
+	JsonParser *parser;
+	JsonObject *original_start_time;
 	GError *error = NULL;
-	gchar *id, *uri;
+	gchar *id, *uri, *json;
 
 	event = GDATA_CALENDAR_EVENT (gdata_parsable_new_from_json (GDATA_TYPE_CALENDAR_EVENT, "{"
 		"'id': 'https://www.googleapis.com/calendar/v3/calendars/libgdata.test@googlemail.com/events/g5928e82rrch95b25f8ud0dlsg_20090429T153000Z',"
@@ -949,9 +1113,639 @@ test_event_json_recurrence (void)
 
 	g_free (id);
 	g_free (uri);
+
+	/* The original start time is written back, so that the exception can still be matched to its instance */
+	json = gdata_parsable_get_json (GDATA_PARSABLE (event));
+	parser = json_parser_new ();
+	g_assert (json_parser_load_from_data (parser, json, -1, &error) == TRUE);
+	g_assert_no_error (error);
+
+	original_start_time = json_object_get_object_member (json_node_get_object (json_parser_get_root (parser)), "originalStartTime");
+	g_assert (original_start_time != NULL);
+	g_assert_cmpstr (json_object_get_string_member (original_start_time, "dateTime"), ==, "2009-04-29T15:30:00Z");
+	g_assert_cmpstr (json_object_get_string_member (original_start_time, "timeZone"), ==, "UTC");
+
+	g_object_unref (parser);
+	g_free (json);
+	g_object_unref (event);
+}
+
+static GDataCalendarEvent *
+build_indexed_event (const gchar *id, gint64 start_time, gint64 end_time, gboolean transparent)
+{
+	GDataCalendarEvent *event;
+	GDataGDWhen *when;
+
+	event = gdata_calendar_event_new (id);
+	when = gdata_gd_when_new (start_time, end_time, FALSE);
+	gdata_calendar_event_add_time (event, when);
+	g_object_unref (when);
+
+	if (transparent == TRUE)
+		gdata_calendar_event_set_transparency (event, GDATA_GD_EVENT_TRANSPARENCY_TRANSPARENT);
+
+	return event;
+}
+
+static void
+add_indexed_event (GDataCalendarEventIndex *index, const gchar *id, gint64 start_time, gint64 end_time, gboolean transparent)
+{
+	GDataCalendarEvent *event;
+
+	event = build_indexed_event (id, start_time, end_time, transparent);
+	gdata_calendar_event_index_add_event (index, event);
 	g_object_unref (event);
 }
 
+static gchar *
+overlapping_event_ids (GDataCalendarEventIndex *index, gint64 start_time, gint64 end_time)
+{
+	GList *events, *i;
+	GString *ids;
+
+	ids = g_string_new (NULL);
+	events = gdata_calendar_event_index_query_overlapping (index, start_time, end_time);
+
+	for (i = events; i != NULL; i = i->next) {
+		if (ids->len > 0)
+			g_string_append_c (ids, ' ');
+		g_string_append (ids, gdata_entry_get_id (GDATA_ENTRY (i->data)));
+	}
+
+	g_list_free (events);
+
+	return g_string_free (ids, FALSE);
+}
+
+#define assert_overlapping(index, start_time, end_time, expected) G_STMT_START { \
+	gchar *__ids = overlapping_event_ids ((index), (start_time), (end_time)); \
+	g_assert_cmpstr (__ids, ==, (expected)); \
+	g_free (__ids); \
+} G_STMT_END
+
+static void
+test_event_index (void)
+{
+	GDataCalendarEventIndex *index;
+	GDataCalendarEvent *event;
+	GDataGDWhen *when;
+	GList *periods;
+	gint64 start_time;
+
+	index = gdata_calendar_event_index_new (NULL);
+
+	add_indexed_event (index, "a", 100, 200, FALSE);
+	add_indexed_event (index, "b", 150, 250, FALSE);
+	add_indexed_event (index, "c", 300, 400, TRUE);
+	add_indexed_event (index, "d", 500, -1, FALSE); /* instantaneous */
+	add_indexed_event (index, "e", 600, 700, FALSE);
+
+	/* An event with two times is only returned once */
+	event = build_indexed_event ("f", 50, 60, FALSE);
+	when = gdata_gd_when_new (180, 190, FALSE);
+	gdata_calendar_event_add_time (event, when);
+	g_object_unref (when);
+	gdata_calendar_event_index_add_event (index, event);
+	g_object_unref (event);
+
+	g_assert_cmpuint (gdata_calendar_event_index_get_n_events (index), ==, 6);
+
+	/* Overlaps; periods are half-open */
+	assert_overlapping (index, 0, 1000, "f a b c d e");
+	assert_overlapping (index, 55, 185, "f a b");
+	assert_overlapping (index, 200, 300, "b");
+	assert_overlapping (index, 250, 300, "");
+	assert_overlapping (index, 500, 501, "d");
+	assert_overlapping (index, 499, 500, "");
+	assert_overlapping (index, 700, 800, "");
+
+	/* Free/busy: transparent and instantaneous events don't count */
+	g_assert (gdata_calendar_event_index_is_free (index, 0, 50) == TRUE);
+	g_assert (gdata_calendar_event_index_is_free (index, 0, 51) == FALSE);
+	g_assert (gdata_calendar_event_index_is_free (index, 250, 600) == TRUE);
+	g_assert (gdata_calendar_event_index_is_free (index, 250, 601) == FALSE);
+
+	periods = gdata_calendar_event_index_get_busy_periods (index, 0, 650);
+	g_assert_cmpuint (g_list_length (periods), ==, 3);
+	g_assert_cmpint (gdata_gd_when_get_start_time (periods->data), ==, 50);
+	g_assert_cmpint (gdata_gd_when_get_end_time (periods->data), ==, 60);
+	g_assert_cmpint (gdata_gd_when_get_start_time (periods->next->data), ==, 100);
+	g_assert_cmpint (gdata_gd_when_get_end_time (periods->next->data), ==, 250);
+	g_assert_cmpint (gdata_gd_when_get_start_time (periods->next->next->data), ==, 600);
+	g_assert_cmpint (gdata_gd_when_get_end_time (periods->next->next->data), ==, 650);
+	g_list_free_full (periods, g_object_unref);
+
+	/* Next event */
+	event = gdata_calendar_event_index_get_next_event (index, 151, &start_time);
+	g_assert_cmpstr (gdata_entry_get_id (GDATA_ENTRY (event)), ==, "f");
+	g_assert_cmpint (start_time, ==, 180);
+	event = gdata_calendar_event_index_get_next_event (index, 501, NULL);
+	g_assert_cmpstr (gdata_entry_get_id (GDATA_ENTRY (event)), ==, "e");
+	g_assert (gdata_calendar_event_index_get_next_event (index, 601, NULL) == NULL);
+
+	/* Re-syncing: updating an event moves it, cancelling an event removes it */
+	add_indexed_event (index, "a", 800, 900, FALSE);
+	assert_overlapping (index, 0, 1000, "f b c d e a");
+
+	event = build_indexed_event ("b", 150, 250, FALSE);
+	gdata_calendar_event_set_status (event, GDATA_GD_EVENT_STATUS_CANCELED);
+	gdata_calendar_event_index_add_event (index, event);
+	g_object_unref (event);
+	assert_overlapping (index, 0, 1000, "f c d e a");
+
+	g_assert (gdata_calendar_event_index_remove_event (index, "f") == TRUE);
+	g_assert (gdata_calendar_event_index_remove_event (index, "f") == FALSE);
+	assert_overlapping (index, 0, 1000, "c d e a");
+	g_assert_cmpuint (gdata_calendar_event_index_get_n_events (index), ==, 4);
+
+	g_object_unref (index);
+}
+
+static void
+test_event_index_random (void)
+{
+	GDataCalendarEventIndex *index;
+	gint64 starts[500], ends[500];
+	guint i, j;
+
+	index = gdata_calendar_event_index_new (NULL);
+
+	for (i = 0; i < G_N_ELEMENTS (starts); i++) {
+		gchar *id = g_strdup_printf ("%u", i);
+
+		starts[i] = g_test_rand_int_range (0, 10000);
+		ends[i] = starts[i] + g_test_rand_int_range (1, 500);
+		add_indexed_event (index, id, starts[i], ends[i], FALSE);
+
+		g_free (id);
+	}
+
+	/* Remove every third event, to exercise deletion from the tree */
+	for (i = 0; i < G_N_ELEMENTS (starts); i += 3) {
+		gchar *id = g_strdup_printf ("%u", i);
+		g_assert (gdata_calendar_event_index_remove_event (index, id) == TRUE);
+		g_free (id);
+	}
+
+	/* Check the index against a linear scan */
+	for (j = 0; j < 200; j++) {
+		gint64 start_time, end_time;
+		guint expected = 0;
+		GList *events, *k;
+
+		start_time = g_test_rand_int_range (-500, 10500);
+		end_time = start_time + g_test_rand_int_range (1, 1000);
+
+		for (i = 0; i < G_N_ELEMENTS (starts); i++) {
+			if (i % 3 != 0 && starts[i] < end_time && ends[i] > start_time)
+				expected++;
+		}
+
+		events = gdata_calendar_event_index_query_overlapping (index, start_time, end_time);
+		g_assert_cmpuint (g_list_length (events), ==, expected);
+
+		for (k = events; k != NULL; k = k->next) {
+			i = (guint) g_ascii_strtoull (gdata_entry_get_id (GDATA_ENTRY (k->data)), NULL, 10);
+			g_assert_cmpint (starts[i], <, end_time);
+			g_assert_cmpint (ends[i], >, start_time);
+
+			if (k->prev != NULL)
+				g_assert_cmpint (starts[g_ascii_strtoull (gdata_entry_get_id (GDATA_ENTRY (k->prev->data)), NULL, 10)], <=, starts[i]);
+		}
+
+		g_list_free (events);
+
+		g_assert (gdata_calendar_event_index_is_free (index, start_time, end_time) == (expected == 0));
+	}
+
+	g_object_unref (index);
+}
+
+static gint64
+london_time (gint year, gint month, gint day, gint hour)
+{
+	GTimeZone *time_zone;
+	GDateTime *date_time;
+	gint64 time;
+
+	time_zone = g_time_zone_new ("Europe/London");
+	date_time = g_date_time_new (time_zone, year, month, day, hour, 0, 0);
+	time = g_date_time_to_unix (date_time);
+	g_date_time_unref (date_time);
+	g_time_zone_unref (time_zone);
+
+	return time;
+}
+
+static void
+assert_instance (GArray *instances, guint i, const gchar *id, gint64 start_time, gint64 end_time)
+{
+	GDataCalendarEventInstance *instance;
+
+	g_assert_cmpuint (i, <, instances->len);
+	instance = &g_array_index (instances, GDataCalendarEventInstance, i);
+
+	g_assert_cmpstr (gdata_entry_get_id (GDATA_ENTRY (instance->event)), ==, id);
+	g_assert_cmpint (instance->start_time, ==, start_time);
+	g_assert_cmpint (instance->end_time, ==, end_time);
+}
+
+static void
+test_event_expander (void)
+{
+	GDataCalendarEventExpander *expander;
+	GDataCalendarEvent *event, *updated_event, *birthday, *invalid_event;
+	GDataCalendarEvent *single_event, *exception, *cancelled_exception;
+	GArray *instances;
+	GList *events;
+	GError *error = NULL;
+
+	expander = gdata_calendar_event_expander_new ();
+
+	/* A weekly event, which should stay at 10:00 local time when daylight saving starts on 29th March */
+	event = GDATA_CALENDAR_EVENT (gdata_parsable_new_from_json (GDATA_TYPE_CALENDAR_EVENT, "{"
+		"'kind': 'calendar#event',"
+		"'id': 'weekly',"
+		"'etag': '\"1\"',"
+		"'summary': 'Team meeting',"
+		"'start': { 'dateTime': '2026-03-16T10:00:00Z', 'timeZone': 'Europe/London' },"
+		"'end': { 'dateTime': '2026-03-16T11:00:00Z', 'timeZone': 'Europe/London' },"
+		"'recurrence': ["
+			"'RRULE:FREQ=WEEKLY;BYDAY=MO;COUNT=6',"
+			"'EXDATE;TZID=Europe/London:20260330T100000'"
+		"]"
+	"}", -1, &error));
+	g_assert_no_error (error);
+
+	instances = gdata_calendar_event_expander_expand (expander, event, london_time (2026, 3, 1, 0), london_time (2026, 5, 1, 0), &error);
+	g_assert_no_error (error);
+	g_assert_cmpuint (instances->len, ==, 5);
+	assert_instance (instances, 0, "weekly", london_time (2026, 3, 16, 10), london_time (2026, 3, 16, 11));
+	assert_instance (instances, 1, "weekly", london_time (2026, 3, 23, 10), london_time (2026, 3, 23, 11));
+	assert_instance (instances, 2, "weekly", london_time (2026, 4, 6, 10), london_time (2026, 4, 6, 11));
+	assert_instance (instances, 3, "weekly", london_time (2026, 4, 13, 10), london_time (2026, 4, 13, 11));
+	assert_instance (instances, 4, "weekly", london_time (2026, 4, 20, 10), london_time (2026, 4, 20, 11));
+	g_array_unref (instances);
+
+	/* A period inside the cached one; periods are half-open */
+	instances = gdata_calendar_event_expander_expand (expander, event, london_time (2026, 4, 6, 11), london_time (2026, 4, 20, 10), &error);
+	g_assert_no_error (error);
+	g_assert_cmpuint (instances->len, ==, 1);
+	assert_instance (instances, 0, "weekly", london_time (2026, 4, 13, 10), london_time (2026, 4, 13, 11));
+	g_array_unref (instances);
+
+	/* A new version of the event replaces the cached expansions of the old one */
+	updated_event = GDATA_CALENDAR_EVENT (gdata_parsable_new_from_json (GDATA_TYPE_CALENDAR_EVENT, "{"
+		"'kind': 'calendar#event',"
+		"'id': 'weekly',"
+		"'etag': '\"2\"',"
+		"'start': { 'dateTime': '2026-03-16T10:00:00Z', 'timeZone': 'Europe/London' },"
+		"'end': { 'dateTime': '2026-03-16T11:00:00Z', 'timeZone': 'Europe/London' },"
+		"'recurrence': [ 'RRULE:FREQ=WEEKLY;COUNT=2' ]"
+	"}", -1, &error));
+	g_assert_no_error (error);
+
+	instances = gdata_calendar_event_expander_expand (expander, updated_event, london_time (2026, 3, 1, 0), london_time (2026, 5, 1, 0), &error);
+	g_assert_no_error (error);
+	g_assert_cmpuint (instances->len, ==, 2);
+	assert_instance (instances, 1, "weekly", london_time (2026, 3, 23, 10), london_time (2026, 3, 23, 11));
+	g_array_unref (instances);
+	g_object_unref (updated_event);
+
+	/* All-day events recur on dates */
+	birthday = GDATA_CALENDAR_EVENT (gdata_parsable_new_from_json (GDATA_TYPE_CALENDAR_EVENT, "{"
+		"'kind': 'calendar#event',"
+		"'id': 'birthday',"
+		"'etag': '\"1\"',"
+		"'start': { 'date': '2024-02-29' },"
+		"'end': { 'date': '2024-03-01' },"
+		"'recurrence': [ 'RRULE:FREQ=YEARLY' ]"
+	"}", -1, &error));
+	g_assert_no_error (error);
+
+	instances = gdata_calendar_event_expander_expand (expander, birthday, 1735689600 /* 2025-01-01 */, 1861920000 /* 2029-01-01 */, &error);
+	g_assert_no_error (error);
+	g_assert_cmpuint (instances->len, ==, 1);
+	assert_instance (instances, 0, "birthday", 1835395200 /* 2028-02-29 */, 1835481600);
+	g_assert (g_array_index (instances, GDataCalendarEventInstance, 0).is_date == TRUE);
+	g_array_unref (instances);
+	g_object_unref (birthday);
+
+	/* Unsupported rules are an error */
+	invalid_event = GDATA_CALENDAR_EVENT (gdata_parsable_new_from_json (GDATA_TYPE_CALENDAR_EVENT, "{"
+		"'kind': 'calendar#event',"
+		"'id': 'hourly',"
+		"'etag': '\"1\"',"
+		"'start': { 'dateTime': '2026-03-16T10:00:00Z' },"
+		"'end': { 'dateTime': '2026-03-16T11:00:00Z' },"
+		"'recurrence': [ 'RRULE:FREQ=HOURLY' ]"
+	"}", -1, &error));
+	g_assert_no_error (error);
+
+	instances = gdata_calendar_event_expander_expand (expander, invalid_event, london_time (2026, 3, 1, 0), london_time (2026, 5, 1, 0), &error);
+	g_assert_error (error, GDATA_PARSER_ERROR, GDATA_PARSER_ERROR_PARSING_STRING);
+	g_assert (instances == NULL);
+	g_clear_error (&error);
+	g_object_unref (invalid_event);
+
+	/* Exceptions replace the occurrences they're exceptions to, and cancelled exceptions remove them */
+	single_event = GDATA_CALENDAR_EVENT (gdata_parsable_new_from_json (GDATA_TYPE_CALENDAR_EVENT, "{"
+		"'kind': 'calendar#event',"
+		"'id': 'single',"
+		"'etag': '\"1\"',"
+		"'start': { 'dateTime': '2026-03-20T12:00:00Z' },"
+		"'end': { 'dateTime': '2026-03-20T13:00:00Z' }"
+	"}", -1, &error));
+	g_assert_no_error (error);
+
+	exception = GDATA_CALENDAR_EVENT (gdata_parsable_new_from_json (GDATA_TYPE_CALENDAR_EVENT, "{"
+		"'kind': 'calendar#event',"
+		"'id': 'weekly_20260406T090000Z',"
+		"'etag': '\"1\"',"
+		"'recurringEventId': 'weekly',"
+		"'originalStartTime': { 'dateTime': '2026-04-06T10:00:00+01:00', 'timeZone': 'Europe/London' },"
+		"'start': { 'dateTime': '2026-04-07T14:00:00+01:00', 'timeZone': 'Europe/London' },"
+		"'end': { 'dateTime': '2026-04-07T15:00:00+01:00', 'timeZone': 'Europe/London' }"
+	"}", -1, &error));
+	g_assert_no_error (error);
+
+	cancelled_exception = GDATA_CALENDAR_EVENT (gdata_parsable_new_from_json (GDATA_TYPE_CALENDAR_EVENT, "{"
+		"'kind': 'calendar#event',"
+		"'id': 'weekly_20260413T090000Z',"
+		"'etag': '\"1\"',"
+		"'status': 'cancelled',"
+		"'recurringEventId': 'weekly',"
+		"'originalStartTime': { 'dateTime': '2026-04-13T10:00:00+01:00', 'timeZone': 'Europe/London' }"
+	"}", -1, &error));
+	g_assert_no_error (error);
+
+	events = g_list_prepend (NULL, cancelled_exception);
+	events = g_list_prepend (events, exception);
+	events = g_list_prepend (events, single_event);
+	events = g_list_prepend (events, event);
+
+	instances = gdata_calendar_event_expander_expand_events (expander, events, london_time (2026, 3, 1, 0), london_time (2026, 5, 1, 0), &error);
+	g_assert_no_error (error);
+	g_assert_cmpuint (instances->len, ==, 5);
+	assert_instance (instances, 0, "weekly", london_time (2026, 3, 16, 10), london_time (2026, 3, 16, 11));
+	assert_instance (instances, 1, "single", london_time (2026, 3, 20, 12), london_time (2026, 3, 20, 13));
+	assert_instance (instances, 2, "weekly", london_time (2026, 3, 23, 10), london_time (2026, 3, 23, 11));
+	assert_instance (instances, 3, "weekly_20260406T090000Z", london_time (2026, 4, 7, 14), london_time (2026, 4, 7, 15));
+	assert_instance (instances, 4, "weekly", london_time (2026, 4, 20, 10), london_time (2026, 4, 20, 11));
+	g_array_unref (instances);
+
+	g_list_free (events);
+	g_object_unref (cancelled_exception);
+	g_object_unref (exception);
+	g_object_unref (single_event);
+	g_object_unref (event);
+	g_object_unref (expander);
+}
+
+static gint64
+utc_time (gint year, gint month, gint day, gint hour)
+{
+	GDateTime *date_time;
+	gint64 time;
+
+	date_time = g_date_time_new_utc (year, month, day, hour, 0, 0);
+	time = g_date_time_to_unix (date_time);
+	g_date_time_unref (date_time);
+
+	return time;
+}
+
+static GDataCalendarEvent *
+parse_expander_event (const gchar *json)
+{
+	GDataCalendarEvent *event;
+	GError *error = NULL;
+
+	event = GDATA_CALENDAR_EVENT (gdata_parsable_new_from_json (GDATA_TYPE_CALENDAR_EVENT, json, -1, &error));
+	g_assert_no_error (error);
+	g_assert (GDATA_IS_CALENDAR_EVENT (event));
+
+	return event;
+}
+
+/* Events with no time zone are expanded in UTC, which keeps the expected times simple */
+static void
+test_event_expander_rules (void)
+{
+	GDataCalendarEventExpander *expander;
+	GDataCalendarEvent *event;
+	GArray *instances;
+	GError *error = NULL;
+
+	expander = gdata_calendar_event_expander_new ();
+
+	/* The last Friday of every month */
+	event = parse_expander_event ("{"
+		"'kind': 'calendar#event',"
+		"'id': 'last-friday',"
+		"'etag': '\"1\"',"
+		"'start': { 'dateTime': '2026-01-30T17:00:00Z' },"
+		"'end': { 'dateTime': '2026-01-30T18:00:00Z' },"
+		"'recurrence': [ 'RRULE:FREQ=MONTHLY;BYDAY=-1FR;COUNT=4' ]"
+	"}");
+
+	instances = gdata_calendar_event_expander_expand (expander, event, utc_time (2026, 1, 1, 0), utc_time (2026, 7, 1, 0), &error);
+	g_assert_no_error (error);
+	g_assert_cmpuint (instances->len, ==, 4);
+	assert_instance (instances, 0, "last-friday", utc_time (2026, 1, 30, 17), utc_time (2026, 1, 30, 18));
+	assert_instance (instances, 1, "last-friday", utc_time (2026, 2, 27, 17), utc_time (2026, 2, 27, 18));
+	assert_instance (instances, 2, "last-friday", utc_time (2026, 3, 27, 17), utc_time (2026, 3, 27, 18));
+	assert_instance (instances, 3, "last-friday", utc_time (2026, 4, 24, 17), utc_time (2026, 4, 24, 18));
+	g_array_unref (instances);
+	g_object_unref (event);
+
+	/* The last weekday of every month, which isn't always a Friday */
+	event = parse_expander_event ("{"
+		"'kind': 'calendar#event',"
+		"'id': 'last-weekday',"
+		"'etag': '\"1\"',"
+		"'start': { 'dateTime': '2026-01-30T09:00:00Z' },"
+		"'end': { 'dateTime': '2026-01-30T10:00:00Z' },"
+		"'recurrence': [ 'RRULE:FREQ=MONTHLY;BYDAY=MO,TU,WE,TH,FR;BYSETPOS=-1' ]"
+	"}");
+
+	instances = gdata_calendar_event_expander_expand (expander, event, utc_time (2026, 2, 1, 0), utc_time (2026, 6, 1, 0), &error);
+	g_assert_no_error (error);
+	g_assert_cmpuint (instances->len, ==, 4);
+	assert_instance (instances, 0, "last-weekday", utc_time (2026, 2, 27, 9), utc_time (2026, 2, 27, 10));
+	assert_instance (instances, 1, "last-weekday", utc_time (2026, 3, 31, 9), utc_time (2026, 3, 31, 10));
+	assert_instance (instances, 2, "last-weekday", utc_time (2026, 4, 30, 9), utc_time (2026, 4, 30, 10));
+	assert_instance (instances, 3, "last-weekday", utc_time (2026, 5, 29, 9), utc_time (2026, 5, 29, 10));
+	g_array_unref (instances);
+	g_object_unref (event);
+
+	/* The last day of every month */
+	event = parse_expander_event ("{"
+		"'kind': 'calendar#event',"
+		"'id': 'month-end',"
+		"'etag': '\"1\"',"
+		"'start': { 'dateTime': '2026-01-31T12:00:00Z' },"
+		"'end': { 'dateTime': '2026-01-31T13:00:00Z' },"
+		"'recurrence': [ 'RRULE:FREQ=MONTHLY;BYMONTHDAY=-1;COUNT=4' ]"
+	"}");
+
+	instances = gdata_calendar_event_expander_expand (expander, event, utc_time (2026, 1, 1, 0), utc_time (2026, 7, 1, 0), &error);
+	g_assert_no_error (error);
+	g_assert_cmpuint (instances->len, ==, 4);
+	assert_instance (instances, 0, "month-end", utc_time (2026, 1, 31, 12), utc_time (2026, 1, 31, 13));
+	assert_instance (instances, 1, "month-end", utc_time (2026, 2, 28, 12), utc_time (2026, 2, 28, 13));
+	assert_instance (instances, 2, "month-end", utc_time (2026, 3, 31, 12), utc_time (2026, 3, 31, 13));
+	assert_instance (instances, 3, "month-end", utc_time (2026, 4, 30, 12), utc_time (2026, 4, 30, 13));
+	g_array_unref (instances);
+	g_object_unref (event);
+
+	/* A DATE-TIME UNTIL is inclusive… */
+	event = parse_expander_event ("{"
+		"'kind': 'calendar#event',"
+		"'id': 'until-date-time',"
+		"'etag': '\"1\"',"
+		"'start': { 'dateTime': '2026-01-01T09:00:00Z' },"
+		"'end': { 'dateTime': '2026-01-01T10:00:00Z' },"
+		"'recurrence': [ 'RRULE:FREQ=DAILY;UNTIL=20260103T090000Z' ]"
+	"}");
+
+	instances = gdata_calendar_event_expander_expand (expander, event, utc_time (2026, 1, 1, 0), utc_time (2026, 2, 1, 0), &error);
+	g_assert_no_error (error);
+	g_assert_cmpuint (instances->len, ==, 3);
+	assert_instance (instances, 2, "until-date-time", utc_time (2026, 1, 3, 9), utc_time (2026, 1, 3, 10));
+	g_array_unref (instances);
+	g_object_unref (event);
+
+	/* …and a DATE UNTIL includes any occurrence on that date */
+	event = parse_expander_event ("{"
+		"'kind': 'calendar#event',"
+		"'id': 'until-date',"
+		"'etag': '\"1\"',"
+		"'start': { 'dateTime': '2026-01-01T09:00:00Z' },"
+		"'end': { 'dateTime': '2026-01-01T10:00:00Z' },"
+		"'recurrence': [ 'RRULE:FREQ=DAILY;UNTIL=20260103' ]"
+	"}");
+
+	instances = gdata_calendar_event_expander_expand (expander, event, utc_time (2026, 1, 1, 0), utc_time (2026, 2, 1, 0), &error);
+	g_assert_no_error (error);
+	g_assert_cmpuint (instances->len, ==, 3);
+	assert_instance (instances, 2, "until-date", utc_time (2026, 1, 3, 9), utc_time (2026, 1, 3, 10));
+	g_array_unref (instances);
+	g_object_unref (event);
+
+	/* All-day occurrences last whole days, and overlap a period which starts part of the way through one */
+	event = parse_expander_event ("{"
+		"'kind': 'calendar#event',"
+		"'id': 'all-day',"
+		"'etag': '\"1\"',"
+		"'start': { 'date': '2026-01-01' },"
+		"'end': { 'date': '2026-01-02' },"
+		"'recurrence': [ 'RRULE:FREQ=DAILY;UNTIL=20260104' ]"
+	"}");
+
+	instances = gdata_calendar_event_expander_expand (expander, event, utc_time (2026, 1, 2, 12), utc_time (2026, 2, 1, 0), &error);
+	g_assert_no_error (error);
+	g_assert_cmpuint (instances->len, ==, 3);
+	assert_instance (instances, 0, "all-day", utc_time (2026, 1, 2, 0), utc_time (2026, 1, 3, 0));
+	assert_instance (instances, 1, "all-day", utc_time (2026, 1, 3, 0), utc_time (2026, 1, 4, 0));
+	assert_instance (instances, 2, "all-day", utc_time (2026, 1, 4, 0), utc_time (2026, 1, 5, 0));
+	g_assert (g_array_index (instances, GDataCalendarEventInstance, 0).is_date == TRUE);
+	g_assert (g_array_index (instances, GDataCalendarEventInstance, 2).is_date == TRUE);
+	g_array_unref (instances);
+	g_object_unref (event);
+
+	/* Extra dates are added to the rule's occurrences, without duplicating them; DATE values take the time of day of the first occurrence */
+	event = parse_expander_event ("{"
+		"'kind': 'calendar#event',"
+		"'id': 'rdate',"
+		"'etag': '\"1\"',"
+		"'start': { 'dateTime': '2026-01-05T09:00:00Z' },"
+		"'end': { 'dateTime': '2026-01-05T10:00:00Z' },"
+		"'recurrence': ["
+			"'RRULE:FREQ=WEEKLY;COUNT=2',"
+			"'RDATE:20260108T150000Z,20260112T090000Z',"
+			"'RDATE;VALUE=DATE:20260110'"
+		"]"
+	"}");
+
+	instances = gdata_calendar_event_expander_expand (expander, event, utc_time (2026, 1, 1, 0), utc_time (2026, 2, 1, 0), &error);
+	g_assert_no_error (error);
+	g_assert_cmpuint (instances->len, ==, 4);
+	assert_instance (instances, 0, "rdate", utc_time (2026, 1, 5, 9), utc_time (2026, 1, 5, 10));
+	assert_instance (instances, 1, "rdate", utc_time (2026, 1, 8, 15), utc_time (2026, 1, 8, 16));
+	assert_instance (instances, 2, "rdate", utc_time (2026, 1, 10, 9), utc_time (2026, 1, 10, 10));
+	assert_instance (instances, 3, "rdate", utc_time (2026, 1, 12, 9), utc_time (2026, 1, 12, 10));
+	g_array_unref (instances);
+	g_object_unref (event);
+
+	g_object_unref (expander);
+}
+
+/* Test that expansions are reused for periods inside a cached one. A second event object with the same ID and ETag but a different rule shows
+ * where the occurrences came from. */
+static void
+test_event_expander_cache (void)
+{
+	GDataCalendarEventExpander *expander;
+	GDataCalendarEvent *event, *same_version;
+	GArray *instances;
+	GError *error = NULL;
+
+	expander = gdata_calendar_event_expander_new ();
+
+	event = parse_expander_event ("{"
+		"'kind': 'calendar#event',"
+		"'id': 'cached',"
+		"'etag': '\"1\"',"
+		"'start': { 'dateTime': '2026-01-05T09:00:00Z' },"
+		"'end': { 'dateTime': '2026-01-05T10:00:00Z' },"
+		"'recurrence': [ 'RRULE:FREQ=WEEKLY;COUNT=10' ]"
+	"}");
+
+	same_version = parse_expander_event ("{"
+		"'kind': 'calendar#event',"
+		"'id': 'cached',"
+		"'etag': '\"1\"',"
+		"'start': { 'dateTime': '2026-01-05T09:00:00Z' },"
+		"'end': { 'dateTime': '2026-01-05T10:00:00Z' },"
+		"'recurrence': [ 'RRULE:FREQ=DAILY;COUNT=3' ]"
+	"}");
+
+	instances = gdata_calendar_event_expander_expand (expander, event, utc_time (2026, 1, 1, 0), utc_time (2026, 3, 1, 0), &error);
+	g_assert_no_error (error);
+	g_assert_cmpuint (instances->len, ==, 8);
+	g_array_unref (instances);
+
+	/* A period inside the cached one is answered from the cache, so has the weekly occurrences */
+	instances = gdata_calendar_event_expander_expand (expander, same_version, utc_time (2026, 1, 10, 0), utc_time (2026, 2, 1, 0), &error);
+	g_assert_no_error (error);
+	g_assert_cmpuint (instances->len, ==, 3);
+	assert_instance (instances, 0, "cached", utc_time (2026, 1, 12, 9), utc_time (2026, 1, 12, 10));
+	assert_instance (instances, 2, "cached", utc_time (2026, 1, 26, 9), utc_time (2026, 1, 26, 10));
+	g_assert (g_array_index (instances, GDataCalendarEventInstance, 0).event == same_version);
+	g_array_unref (instances);
+
+	/* A period which isn't inside a cached one is expanded again */
+	instances = gdata_calendar_event_expander_expand (expander, same_version, utc_time (2026, 1, 1, 0), utc_time (2026, 3, 2, 0), &error);
+	g_assert_no_error (error);
+	g_assert_cmpuint (instances->len, ==, 3);
+	assert_instance (instances, 0, "cached", utc_time (2026, 1, 5, 9), utc_time (2026, 1, 5, 10));
+	assert_instance (instances, 2, "cached", utc_time (2026, 1, 7, 9), utc_time (2026, 1, 7, 10));
+	g_array_unref (instances);
+
+	/* Once the cache is cleared, the original period is expanded again too */
+	gdata_calendar_event_expander_clear_cache (expander);
+
+	instances = gdata_calendar_event_expander_expand (expander, same_version, utc_time (2026, 1, 10, 0), utc_time (2026, 2, 1, 0), &error);
+	g_assert_no_error (error);
+	g_assert_cmpuint (instances->len, ==, 0);
+	g_array_unref (instances);
+
+	g_object_unref (same_version);
+	g_object_unref (event);
+	g_object_unref (expander);
+}
+
 static void
 test_calendar_escaping (void)
 {
@@ -1147,6 +1941,15 @@ test_query_uri (void)
 			                "&showDeleted=true");
 	g_free (query_uri);
 
+	/* #GDataQuery:updated-min is only given in its Calendar form */
+	gdata_query_set_updated_min (GDATA_QUERY (query), 1271516400);
+	query_uri = gdata_query_get_query_uri (GDATA_QUERY (query), "http://example.com");
+	g_assert_cmpstr (query_uri, ==, "http://example.com?q=q&orderBy=startTime&singleEvents=true"
+			                "&timeMin=2009-04-17T15:00:00Z&timeMax=2010-04-17T15:00:00Z&updatedMin=2010-04-17T15:00:00Z"
+			                "&timeZone=America%2FLos_Angeles&maxAttendees=15&showDeleted=true");
+	g_free (query_uri);
+	gdata_query_set_updated_min (GDATA_QUERY (query), -1);
+
 	/* …with a feed URI with a trailing slash */
 	query_uri = gdata_query_get_query_uri (GDATA_QUERY (query), "http://example.com/");
 	g_assert_cmpstr (query_uri, ==, "http://example.com/?q=q&orderBy=startTime&singleEvents=true"
@@ -1537,6 +2340,7 @@ main (int argc, char *argv[])
 	            test_query_events_async_progress_closure, tear_down_query_events);
 	g_test_add ("/calendar/query/events/async/cancellation", GDataAsyncTestData, service, set_up_query_events_async,
 	            test_query_events_async_cancellation, tear_down_query_events_async);
+	g_test_add_data_func ("/calendar/query/events/merged", service, test_query_events_merged);
 
 	g_test_add ("/calendar/event/insert", InsertEventData, service, set_up_insert_event, test_event_insert, tear_down_insert_event);
 	g_test_add ("/calendar/event/insert/async", GDataAsyncTestData, service, set_up_insert_event_async, test_event_insert_async,
@@ -1561,6 +2365,11 @@ main (int argc, char *argv[])
 	g_test_add_func ("/calendar/event/escaping", test_event_escaping);
 	g_test_add_func ("/calendar/event/parser/minimal",
 	                 test_calendar_event_parser_minimal);
+	g_test_add_func ("/calendar/event/index", test_event_index);
+	g_test_add_func ("/calendar/event/index/random", test_event_index_random);
+	g_test_add_func ("/calendar/event/expander", test_event_expander);
+	g_test_add_func ("/calendar/event/expander/rules", test_event_expander_rules);
+	g_test_add_func ("/calendar/event/expander/cache", test_event_expander_cache);
 
 	g_test_add_func ("/calendar/calendar/escaping", test_calendar_escaping);
 
@@ -1630,6 +1630,951 @@ test_access_rule_insert (TempDocumentData *data, gconstpointer service)
 	uhm_server_end_trace (mock_server);
 }
 
+/* Test that paths are built from the parent folders, both for parsed entries and for ones built locally. */
+static void
+test_document_path (void)
+{
+	GDataDocumentsDocument *document;
+	GDataLink *_link;
+	gchar *path;
+	GError *error = NULL;
+
+	document = GDATA_DOCUMENTS_DOCUMENT (gdata_parsable_new_from_json (GDATA_TYPE_DOCUMENTS_DOCUMENT,
+		"{"
+			"\"kind\": \"drive#file\","
+			"\"id\": \"some-file\","
+			"\"mimeType\": \"text/plain\","
+			"\"parents\": ["
+				"{"
+					"\"kind\": \"drive#parentReference\","
+					"\"id\": \"folder1\","
+					"\"parentLink\": \"https://www.googleapis.com/drive/v2/files/folder1\""
+				"},"
+				"{"
+					"\"kind\": \"drive#parentReference\","
+					"\"id\": \"folder2\","
+					"\"parentLink\": \"https://www.googleapis.com/drive/v2/files/folder2\""
+				"}"
+			"]"
+		"}", -1, &error));
+	g_assert_no_error (error);
+	g_assert (GDATA_IS_DOCUMENTS_DOCUMENT (document));
+
+	/* Parent folders are listed most recently added first, whether the path is built from the parsed IDs or from the links */
+	path = gdata_documents_entry_get_path (GDATA_DOCUMENTS_ENTRY (document));
+	g_assert_cmpstr (path, ==, "/folder2/folder1/some-file");
+	g_free (path);
+
+	/* Changing the parent links after parsing should be reflected in the path */
+	_link = gdata_link_new ("https://www.googleapis.com/drive/v2/files/folder3", GDATA_LINK_PARENT);
+	gdata_entry_add_link (GDATA_ENTRY (document), _link);
+	g_object_unref (_link);
+
+	path = gdata_documents_entry_get_path (GDATA_DOCUMENTS_ENTRY (document));
+	g_assert_cmpstr (path, ==, "/folder3/folder2/folder1/some-file");
+	g_free (path);
+
+	_link = gdata_entry_look_up_link (GDATA_ENTRY (document), GDATA_LINK_PARENT);
+	g_assert_cmpstr (gdata_link_get_uri (_link), ==, "https://www.googleapis.com/drive/v2/files/folder3");
+	gdata_link_set_uri (_link, "https://www.googleapis.com/drive/v2/files/folder4");
+
+	path = gdata_documents_entry_get_path (GDATA_DOCUMENTS_ENTRY (document));
+	g_assert_cmpstr (path, ==, "/folder4/folder2/folder1/some-file");
+	g_free (path);
+
+	g_assert (gdata_entry_remove_link (GDATA_ENTRY (document), _link) == TRUE);
+
+	path = gdata_documents_entry_get_path (GDATA_DOCUMENTS_ENTRY (document));
+	g_assert_cmpstr (path, ==, "/folder2/folder1/some-file");
+	g_free (path);
+
+	g_object_unref (document);
+
+	/* A locally built entry, with both styles of parent link */
+	document = gdata_documents_document_new ("other-file");
+
+	_link = gdata_link_new ("https://www.googleapis.com/drive/v2/files/folder1", GDATA_LINK_PARENT);
+	gdata_entry_add_link (GDATA_ENTRY (document), _link);
+	g_object_unref (_link);
+
+	_link = gdata_link_new ("http://docs.google.com/feeds/documents/private/full/folder%3Afolder2", GDATA_LINK_PARENT);
+	gdata_entry_add_link (GDATA_ENTRY (document), _link);
+	g_object_unref (_link);
+
+	path = gdata_documents_entry_get_path (GDATA_DOCUMENTS_ENTRY (document));
+	g_assert_cmpstr (path, ==, "/folder2/folder1/other-file");
+	g_free (path);
+
+	g_object_unref (document);
+}
+
+/* Test that every member handled by GDataDocumentsEntry's parse_json() is actually dispatched to it, rather than being skipped by its
+ * sorted table of handled members and stored as unhandled JSON. Any member added to parse_json() should be added here too. */
+static void
+test_document_parse_json_handled_members (void)
+{
+	GDataDocumentsDocument *document;
+	GDataDocumentsEntry *entry;
+	GDataLink *_link;
+	GDataAuthor *author;
+	GList *authors, *properties, *categories;
+	gboolean starred, shared;
+	gchar *path;
+	GError *error = NULL;
+
+	document = GDATA_DOCUMENTS_DOCUMENT (gdata_parsable_new_from_json (GDATA_TYPE_DOCUMENTS_DOCUMENT,
+		"{"
+			"\"kind\": \"drive#file\","
+			"\"id\": \"some-file\","
+			"\"alternateLink\": \"https://docs.google.com/file/d/some-file/edit\","
+			"\"capabilities\": { \"canEdit\": true },"
+			"\"createdDate\": \"2012-04-14T09:12:19.418Z\","
+			"\"fileSize\": \"1234\","
+			"\"labels\": { \"starred\": true },"
+			"\"lastViewedByMeDate\": \"2012-04-15T10:00:00.000Z\","
+			"\"md5Checksum\": \"d41d8cd98f00b204e9800998ecf8427e\","
+			"\"mimeType\": \"text/plain\","
+			"\"modifiedDate\": \"2012-04-16T11:30:00.000Z\","
+			"\"owners\": ["
+				"{"
+					"\"kind\": \"drive#user\","
+					"\"displayName\": \"libgdata.documents\","
+					"\"emailAddress\": \"libgdata.documents@gmail.com\""
+				"}"
+			"],"
+			"\"parents\": ["
+				"{"
+					"\"kind\": \"drive#parentReference\","
+					"\"id\": \"folder1\","
+					"\"parentLink\": \"https://www.googleapis.com/drive/v2/files/folder1\""
+				"}"
+			"],"
+			"\"properties\": ["
+				"{"
+					"\"kind\": \"drive#property\","
+					"\"key\": \"some-key\","
+					"\"value\": \"some-value\","
+					"\"visibility\": \"PUBLIC\""
+				"}"
+			"],"
+			"\"quotaBytesUsed\": \"5678\","
+			"\"shared\": true,"
+			"\"sharedWithMeDate\": \"2012-04-17T12:45:00.000Z\""
+		"}", -1, &error));
+	g_assert_no_error (error);
+	g_assert (GDATA_IS_DOCUMENTS_DOCUMENT (document));
+	entry = GDATA_DOCUMENTS_ENTRY (document);
+
+	_link = gdata_entry_look_up_link (GDATA_ENTRY (document), GDATA_LINK_ALTERNATE);
+	g_assert (GDATA_IS_LINK (_link));
+	g_assert_cmpstr (gdata_link_get_uri (_link), ==, "https://docs.google.com/file/d/some-file/edit");
+
+	g_assert (gdata_documents_entry_can_edit (entry) == TRUE);
+	g_assert_cmpint (gdata_entry_get_published (GDATA_ENTRY (document)), ==, 1334394739);
+	g_assert_cmpint (gdata_documents_entry_get_file_size (entry), ==, 1234);
+	g_assert_cmpint (gdata_documents_entry_get_last_viewed (entry), ==, 1334484000);
+	g_assert_cmpstr (gdata_documents_entry_get_md5_checksum (entry), ==, "d41d8cd98f00b204e9800998ecf8427e");
+	g_assert_cmpint (gdata_entry_get_updated (GDATA_ENTRY (document)), ==, 1334575800);
+
+	authors = gdata_entry_get_authors (GDATA_ENTRY (document));
+	g_assert_cmpuint (g_list_length (authors), ==, 1);
+	author = GDATA_AUTHOR (authors->data);
+	g_assert_cmpstr (gdata_author_get_name (author), ==, "libgdata.documents");
+	g_assert_cmpstr (gdata_author_get_email_address (author), ==, "libgdata.documents@gmail.com");
+
+	path = gdata_documents_entry_get_path (entry);
+	g_assert_cmpstr (path, ==, "/folder1/some-file");
+	g_free (path);
+
+	properties = gdata_documents_entry_get_document_properties (entry);
+	g_assert_cmpuint (g_list_length (properties), ==, 1);
+	g_assert_cmpstr (gdata_documents_property_get_key (GDATA_DOCUMENTS_PROPERTY (properties->data)), ==, "some-key");
+
+	g_assert_cmpint (gdata_documents_entry_get_quota_used (entry), ==, 5678);
+	g_assert_cmpint (gdata_documents_entry_get_shared_with_me_date (entry), ==, 1334666700);
+
+	/* The labels and the shared flag are turned into categories */
+	starred = shared = FALSE;
+	for (categories = gdata_entry_get_categories (GDATA_ENTRY (document)); categories != NULL; categories = categories->next) {
+		const gchar *term = gdata_category_get_term (GDATA_CATEGORY (categories->data));
+
+		starred = starred || (g_strcmp0 (term, GDATA_CATEGORY_SCHEMA_LABELS_STARRED) == 0);
+		shared = shared || (g_strcmp0 (term, "http://schemas.google.com/g/2005/labels#shared") == 0);
+	}
+	g_assert (starred == TRUE);
+	g_assert (shared == TRUE);
+
+	g_object_unref (document);
+}
+
+static void
+crawl_unauthenticated_cb (GDataDocumentsEntry *entry, const gchar * const *parent_ids, gpointer user_data)
+{
+	g_assert_not_reached ();
+}
+
+/* Test that errors from the crawl's queries are propagated, and the crawl stops cleanly. This doesn't touch the network. */
+static void
+test_crawl_folder_unauthenticated (void)
+{
+	GDataDocumentsService *service;
+	GHashTable *parent_index;
+	GError *error = NULL;
+
+	service = gdata_documents_service_new (NULL);
+
+	parent_index = gdata_documents_service_crawl_folder (service, NULL, 2, NULL, crawl_unauthenticated_cb, NULL, &error);
+	g_assert_error (error, GDATA_SERVICE_ERROR, GDATA_SERVICE_ERROR_AUTHENTICATION_REQUIRED);
+	g_assert (parent_index == NULL);
+	g_clear_error (&error);
+
+	g_object_unref (service);
+}
+
+static void
+append_crawl_item (GString *body, const gchar *id, gboolean is_folder, const gchar * const *parent_ids)
+{
+	guint i;
+
+	g_string_append_printf (body, "%s{\"kind\": \"drive#file\", \"id\": \"%s\", \"title\": \"%s\", \"mimeType\": \"%s\", \"parents\": [",
+	                        (body->str[body->len - 1] == '[') ? "" : ",", id, id,
+	                        is_folder ? "application/vnd.google-apps.folder" : "text/plain");
+
+	for (i = 0; parent_ids[i] != NULL; i++) {
+		g_string_append_printf (body, "%s{\"kind\": \"drive#parentReference\", \"id\": \"%s\", "
+		                        "\"parentLink\": \"https://www.googleapis.com/drive/v2/files/%s\", \"isRoot\": false}",
+		                        (i > 0) ? "," : "", parent_ids[i], parent_ids[i]);
+	}
+
+	g_string_append (body, "]}");
+}
+
+/* Serves the folder tree for test_crawl_folder():
+ *
+ *   crawl-root/
+ *     f1/
+ *       f3/
+ *         y (also in f1 and f2)
+ *         f1 (also in crawl-root; a cycle)
+ *       y
+ *     f2/
+ *       y
+ *       crawl-root (a cycle back to the root)
+ *     x
+ */
+static gboolean
+crawl_folder_handle_message_cb (UhmServer *server, SoupMessage *message, SoupClientContext *client, guint *n_requests)
+{
+	const gchar * const root_parents[] = { "crawl-root", NULL };
+	const gchar * const f1_parents[] = { "crawl-root", "f3", NULL };
+	const gchar * const f2_parents[] = { "crawl-root", NULL };
+	const gchar * const f3_parents[] = { "f1", NULL };
+	const gchar * const y_parents[] = { "f1", "f2", "f3", NULL };
+	const gchar * const cycle_parents[] = { "f2", NULL };
+	GHashTable *params;
+	const gchar *q;
+	GString *body;
+
+	params = soup_form_decode (soup_uri_get_query (soup_message_get_uri (message)));
+	q = g_hash_table_lookup (params, "q");
+	g_assert (q != NULL);
+
+	body = g_string_new ("{\"kind\": \"drive#fileList\", \"items\": [");
+
+	/* f1 and f2 are found by the same query, so their children should be listed by one query */
+	if (strstr (q, "'crawl-root' in parents") != NULL) {
+		append_crawl_item (body, "f1", TRUE, f1_parents);
+		append_crawl_item (body, "f2", TRUE, f2_parents);
+		append_crawl_item (body, "x", FALSE, root_parents);
+	} else if (strstr (q, "'f1' in parents or 'f2' in parents") != NULL) {
+		append_crawl_item (body, "f3", TRUE, f3_parents);
+		append_crawl_item (body, "y", FALSE, y_parents);
+		append_crawl_item (body, "crawl-root", TRUE, cycle_parents);
+	} else if (strstr (q, "'f3' in parents") != NULL) {
+		append_crawl_item (body, "y", FALSE, y_parents);
+		append_crawl_item (body, "f1", TRUE, f1_parents);
+	} else {
+		g_assert_not_reached ();
+	}
+
+	g_string_append (body, "]}");
+	g_hash_table_unref (params);
+
+	soup_message_set_status (message, SOUP_STATUS_OK);
+	soup_message_headers_set_content_type (message->response_headers, "application/json", NULL);
+	soup_message_body_append (message->response_body, SOUP_MEMORY_TAKE, body->str, body->len);
+	g_string_free (body, FALSE);
+
+	(*n_requests)++;
+
+	return TRUE;
+}
+
+static void
+crawl_folder_cb (GDataDocumentsEntry *entry, const gchar * const *parent_ids, GHashTable *found)
+{
+	const gchar *id = gdata_entry_get_id (GDATA_ENTRY (entry));
+	guint n_parent_ids = g_strv_length ((gchar **) parent_ids);
+
+	/* Each entry should be reported once, after its parent, and the root should never be reported */
+	g_assert (g_hash_table_contains (found, id) == FALSE);
+	g_assert_cmpstr (id, !=, "crawl-root");
+	g_assert_cmpuint (n_parent_ids, >, 0);
+	g_assert_cmpstr (parent_ids[0], ==, "crawl-root");
+	g_assert (n_parent_ids == 1 || g_hash_table_contains (found, parent_ids[n_parent_ids - 1]) == TRUE);
+
+	g_hash_table_insert (found, g_strdup (id), g_strjoinv ("/", (gchar **) parent_ids));
+}
+
+/* Test that crawling a folder tree queries each level breadth-first, merging the queries for sibling folders, and copes with entries which have
+ * several parents and with cycles */
+static void
+test_crawl_folder (gconstpointer service)
+{
+	GDataDocumentsFolder *folder;
+	GHashTable *parent_index, *found;
+	gulong handler_id;
+	guint n_requests = 0;
+	GError *error = NULL;
+
+	/* The responses refer to folders which don't exist on the real server */
+	if (uhm_server_get_enable_online (mock_server)) {
+		g_test_skip ("Test uses canned responses");
+		return;
+	}
+
+	handler_id = g_signal_connect (mock_server, "handle-message", (GCallback) crawl_folder_handle_message_cb, &n_requests);
+	uhm_server_run (mock_server);
+	gdata_test_set_https_port (mock_server);
+
+	found = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
+	folder = gdata_documents_folder_new ("crawl-root");
+
+	parent_index = gdata_documents_service_crawl_folder (GDATA_DOCUMENTS_SERVICE (service), folder, 0, NULL,
+	                                                     (GDataDocumentsCrawlCallback) crawl_folder_cb, found, &error);
+	g_assert_no_error (error);
+	g_assert (parent_index != NULL);
+
+	g_object_unref (folder);
+
+	/* One query per level of the tree */
+	g_assert_cmpuint (n_requests, ==, 3);
+
+	g_assert_cmpuint (g_hash_table_size (parent_index), ==, 5);
+	g_assert_cmpstr (g_hash_table_lookup (parent_index, "f1"), ==, "crawl-root");
+	g_assert_cmpstr (g_hash_table_lookup (parent_index, "f2"), ==, "crawl-root");
+	g_assert_cmpstr (g_hash_table_lookup (parent_index, "x"), ==, "crawl-root");
+	g_assert_cmpstr (g_hash_table_lookup (parent_index, "f3"), ==, "f1");
+	g_assert_cmpstr (g_hash_table_lookup (parent_index, "y"), ==, "f1");
+	g_assert (g_hash_table_contains (parent_index, "crawl-root") == FALSE);
+
+	g_assert_cmpuint (g_hash_table_size (found), ==, 5);
+	g_assert_cmpstr (g_hash_table_lookup (found, "f1"), ==, "crawl-root");
+	g_assert_cmpstr (g_hash_table_lookup (found, "x"), ==, "crawl-root");
+	g_assert_cmpstr (g_hash_table_lookup (found, "f3"), ==, "crawl-root/f1");
+	g_assert_cmpstr (g_hash_table_lookup (found, "y"), ==, "crawl-root/f1");
+
+	g_hash_table_unref (found);
+	g_hash_table_unref (parent_index);
+
+	uhm_server_stop (mock_server);
+	g_signal_handler_disconnect (mock_server, handler_id);
+}
+
+/* Test that a document's content can be compared against a local file using its checksum, without downloading it. */
+static void
+test_document_matches_file (void)
+{
+	GDataDocumentsDocument *document;
+	GFileIOStream *io_stream;
+	GFile *file;
+	const gchar *content = "Some file content\n";
+	gchar *json, *checksum;
+	GError *error = NULL;
+
+	checksum = g_compute_checksum_for_string (G_CHECKSUM_MD5, content, -1);
+	json = g_strdup_printf ("{"
+		"\"kind\": \"drive#file\","
+		"\"id\": \"0BzY2jgHHwMwYalFhbjhVT3dyams\","
+		"\"title\": \"file.txt\","
+		"\"mimeType\": \"text/plain\","
+		"\"fileSize\": \"%" G_GSIZE_FORMAT "\","
+		"\"md5Checksum\": \"%s\""
+	"}", strlen (content), checksum);
+
+	document = GDATA_DOCUMENTS_DOCUMENT (gdata_parsable_new_from_json (GDATA_TYPE_DOCUMENTS_DOCUMENT, json, -1, &error));
+	g_assert_no_error (error);
+	g_assert (GDATA_IS_DOCUMENTS_DOCUMENT (document));
+	g_assert_cmpstr (gdata_documents_entry_get_md5_checksum (GDATA_DOCUMENTS_ENTRY (document)), ==, checksum);
+	g_free (json);
+
+	/* Identical content */
+	file = g_file_new_tmp ("libgdata-documents-XXXXXX", &io_stream, &error);
+	g_assert_no_error (error);
+	g_output_stream_write_all (g_io_stream_get_output_stream (G_IO_STREAM (io_stream)), content, strlen (content), NULL, NULL, &error);
+	g_assert_no_error (error);
+	g_io_stream_close (G_IO_STREAM (io_stream), NULL, &error);
+	g_assert_no_error (error);
+	g_object_unref (io_stream);
+
+	g_assert (gdata_documents_document_matches_file (document, file, NULL, &error) == TRUE);
+	g_assert_no_error (error);
+
+	/* Same size, different content */
+	g_file_replace_contents (file, "Some file CONTENT\n", strlen (content), NULL, FALSE, G_FILE_CREATE_NONE, NULL, NULL, &error);
+	g_assert_no_error (error);
+	g_assert (gdata_documents_document_matches_file (document, file, NULL, &error) == FALSE);
+	g_assert_no_error (error);
+
+	/* Different size */
+	g_file_replace_contents (file, "Other content\n", strlen ("Other content\n"), NULL, FALSE, G_FILE_CREATE_NONE, NULL, NULL, &error);
+	g_assert_no_error (error);
+	g_assert (gdata_documents_document_matches_file (document, file, NULL, &error) == FALSE);
+	g_assert_no_error (error);
+
+	g_file_delete (file, NULL, NULL);
+
+	/* Missing file */
+	g_assert (gdata_documents_document_matches_file (document, file, NULL, &error) == FALSE);
+	g_assert_error (error, G_IO_ERROR, G_IO_ERROR_NOT_FOUND);
+	g_clear_error (&error);
+
+	g_object_unref (file);
+	g_object_unref (document);
+	g_free (checksum);
+}
+
+/* Pages of children of "index-folder-id" served by index_folder_handle_message_cb(). The second page has a file with the same title as one on
+ * the first, and there are entries with no checksums on both. */
+static const gchar *index_folder_pages[] = {
+	"{"
+		"\"kind\": \"drive#fileList\","
+		"\"nextPageToken\": \"page-2\","
+		"\"items\": ["
+			"{"
+				"\"kind\": \"drive#file\","
+				"\"id\": \"file-a1\","
+				"\"title\": \"a.txt\","
+				"\"mimeType\": \"text/plain\","
+				"\"fileSize\": \"5\","
+				"\"md5Checksum\": \"0cc175b9c0f1b6a831c399e269772661\""
+			"},"
+			"{"
+				"\"kind\": \"drive#file\","
+				"\"id\": \"file-b\","
+				"\"title\": \"b.txt\","
+				"\"mimeType\": \"text/plain\","
+				"\"fileSize\": \"5\","
+				"\"md5Checksum\": \"92eb5ffee6ae2fec3ad71c777531578f\""
+			"},"
+			"{"
+				"\"kind\": \"drive#file\","
+				"\"id\": \"folder-c\","
+				"\"title\": \"c\","
+				"\"mimeType\": \"application/vnd.google-apps.folder\""
+			"}"
+		"]"
+	"}",
+	"{"
+		"\"kind\": \"drive#fileList\","
+		"\"items\": ["
+			"{"
+				"\"kind\": \"drive#file\","
+				"\"id\": \"file-a2\","
+				"\"title\": \"a.txt\","
+				"\"mimeType\": \"text/plain\","
+				"\"fileSize\": \"7\","
+				"\"md5Checksum\": \"4a8a08f09d37b73795649038408b5f33\""
+			"},"
+			"{"
+				"\"kind\": \"drive#file\","
+				"\"id\": \"document-d\","
+				"\"title\": \"d\","
+				"\"mimeType\": \"application/vnd.google-apps.document\""
+			"}"
+		"]"
+	"}",
+};
+
+static gboolean
+index_folder_handle_message_cb (UhmServer *server, SoupMessage *message, SoupClientContext *client, guint *n_requests)
+{
+	SoupURI *uri;
+	GHashTable *params;
+	const gchar *page_token, *body;
+
+	uri = soup_message_get_uri (message);
+	g_assert_cmpstr (soup_uri_get_path (uri), ==, "/drive/v2/files");
+
+	/* Only the folder's direct children should be listed */
+	params = soup_form_decode (soup_uri_get_query (uri));
+	g_assert (strstr (g_hash_table_lookup (params, "q"), "'index-folder-id' in parents") != NULL);
+
+	page_token = g_hash_table_lookup (params, "pageToken");
+	body = index_folder_pages[(page_token == NULL) ? 0 : 1];
+	g_assert (page_token == NULL || g_strcmp0 (page_token, "page-2") == 0);
+
+	g_hash_table_unref (params);
+
+	soup_message_set_status (message, SOUP_STATUS_OK);
+	soup_message_headers_set_content_type (message->response_headers, "application/json", NULL);
+	soup_message_body_append (message->response_body, SOUP_MEMORY_STATIC, body, strlen (body));
+
+	(*n_requests)++;
+
+	return TRUE;
+}
+
+/* Test that indexing a folder follows all the pages of results, keeps every file with a given title, and skips files without checksums */
+static void
+test_index_folder (gconstpointer service)
+{
+	GDataDocumentsFolder *folder;
+	GHashTable *index;
+	GList *documents;
+	gulong handler_id;
+	guint n_requests = 0;
+	GError *error = NULL;
+
+	/* The responses refer to files which don't exist on the real server */
+	if (uhm_server_get_enable_online (mock_server)) {
+		g_test_skip ("Test uses canned responses");
+		return;
+	}
+
+	handler_id = g_signal_connect (mock_server, "handle-message", (GCallback) index_folder_handle_message_cb, &n_requests);
+	uhm_server_run (mock_server);
+	gdata_test_set_https_port (mock_server);
+
+	folder = gdata_documents_folder_new ("index-folder-id");
+	index = gdata_documents_service_index_folder (GDATA_DOCUMENTS_SERVICE (service), folder, NULL, &error);
+	g_assert_no_error (error);
+	g_assert (index != NULL);
+	g_object_unref (folder);
+
+	g_assert_cmpuint (n_requests, ==, 2);
+	g_assert_cmpuint (g_hash_table_size (index), ==, 2);
+
+	/* Both files titled "a.txt" are indexed, in the order they were listed */
+	documents = g_hash_table_lookup (index, "a.txt");
+	g_assert_cmpuint (g_list_length (documents), ==, 2);
+	g_assert_cmpstr (gdata_entry_get_id (GDATA_ENTRY (documents->data)), ==, "file-a1");
+	g_assert_cmpstr (gdata_entry_get_id (GDATA_ENTRY (documents->next->data)), ==, "file-a2");
+
+	documents = g_hash_table_lookup (index, "b.txt");
+	g_assert_cmpuint (g_list_length (documents), ==, 1);
+	g_assert (GDATA_IS_DOCUMENTS_DOCUMENT (documents->data));
+	g_assert_cmpstr (gdata_entry_get_id (GDATA_ENTRY (documents->data)), ==, "file-b");
+
+	/* The folder and Google Docs document have no checksums */
+	g_assert (g_hash_table_lookup (index, "c") == NULL);
+	g_assert (g_hash_table_lookup (index, "d") == NULL);
+
+	g_hash_table_unref (index);
+
+	uhm_server_stop (mock_server);
+	g_signal_handler_disconnect (mock_server, handler_id);
+}
+
+/* A Drive file with everything GDataDocumentsDocument parses, most of which isn't in the JSON written by gdata_parsable_get_json() */
+#define MIRROR_FILE_JSON \
+		"{" \
+			"\"kind\": \"drive#file\"," \
+			"\"id\": \"mirror-file\"," \
+			"\"etag\": \"\\\"etag-mirror-file\\\"\"," \
+			"\"title\": \"Report.txt\"," \
+			"\"alternateLink\": \"https://docs.google.com/file/d/mirror-file/edit\"," \
+			"\"capabilities\": { \"canEdit\": true }," \
+			"\"createdDate\": \"2012-01-01T00:00:00.000Z\"," \
+			"\"downloadUrl\": \"https://www.googleapis.com/drive/v2/files/mirror-file?alt=media\"," \
+			"\"fileSize\": \"1234\"," \
+			"\"labels\": { \"starred\": true, \"trashed\": false, \"viewed\": true }," \
+			"\"lastViewedByMeDate\": \"2012-02-02T00:00:00.000Z\"," \
+			"\"md5Checksum\": \"d41d8cd98f00b204e9800998ecf8427e\"," \
+			"\"mimeType\": \"text/plain\"," \
+			"\"modifiedDate\": \"2012-02-01T00:00:00.000Z\"," \
+			"\"owners\": [" \
+				"{" \
+					"\"kind\": \"drive#user\"," \
+					"\"displayName\": \"libgdata.documents\"," \
+					"\"emailAddress\": \"libgdata.documents@gmail.com\"" \
+				"}" \
+			"]," \
+			"\"parents\": [" \
+				"{" \
+					"\"kind\": \"drive#parentReference\"," \
+					"\"id\": \"folder1\"," \
+					"\"parentLink\": \"https://www.googleapis.com/drive/v2/files/folder1\"" \
+				"}," \
+				"{" \
+					"\"kind\": \"drive#parentReference\"," \
+					"\"id\": \"folder2\"," \
+					"\"parentLink\": \"https://www.googleapis.com/drive/v2/files/folder2\"" \
+				"}" \
+			"]," \
+			"\"quotaBytesUsed\": \"2048\"," \
+			"\"shared\": true," \
+			"\"sharedWithMeDate\": \"2012-02-02T00:00:00.000Z\"" \
+		"}"
+
+static gboolean
+mirror_handle_message_cb (UhmServer *server, SoupMessage *message, SoupClientContext *client, gpointer user_data)
+{
+	const gchar *body =
+		"{"
+			"\"kind\": \"drive#fileList\","
+			"\"items\": ["
+				MIRROR_FILE_JSON ","
+				"{"
+					"\"kind\": \"drive#file\","
+					"\"id\": \"mirror-other\","
+					"\"title\": \"Old.txt\","
+					"\"mimeType\": \"text/plain\","
+					"\"modifiedDate\": \"2012-01-01T00:00:00.000Z\","
+					"\"parents\": [{ \"kind\": \"drive#parentReference\", \"id\": \"folder1\","
+					              "\"parentLink\": \"https://www.googleapis.com/drive/v2/files/folder1\" }]"
+				"}"
+			"]"
+		"}";
+
+	g_assert_cmpstr (soup_uri_get_path (soup_message_get_uri (message)), ==, "/drive/v2/files");
+
+	soup_message_set_status (message, SOUP_STATUS_OK);
+	soup_message_headers_set_content_type (message->response_headers, "application/json", NULL);
+	soup_message_body_append (message->response_body, SOUP_MEMORY_STATIC, body, strlen (body));
+
+	return TRUE;
+}
+
+/* Check that Drive entries fetched by a refresh survive being saved to and loaded from a mirror, including everything which isn't in the
+ * GDataEntry JSON */
+static void
+test_mirror (gconstpointer service)
+{
+	GDataEntryMirror *mirror, *mirror2;
+	GDataDocumentsEntry *entry;
+	GDataDocumentsQuery *query;
+	GDataEntry *loaded;
+	GDataAuthor *author;
+	GList *authors, *children, *categories;
+	GFile *file;
+	GFileIOStream *stream;
+	gboolean starred, viewed, shared;
+	gchar *path, *loaded_path;
+	gulong handler_id;
+	GError *error = NULL;
+
+	/* The responses refer to files which don't exist on the real server */
+	if (uhm_server_get_enable_online (mock_server)) {
+		g_test_skip ("Test uses canned responses");
+		return;
+	}
+
+	handler_id = g_signal_connect (mock_server, "handle-message", (GCallback) mirror_handle_message_cb, NULL);
+	uhm_server_run (mock_server);
+	gdata_test_set_https_port (mock_server);
+
+	mirror = gdata_entry_mirror_new (GDATA_TYPE_DOCUMENTS_ENTRY);
+	query = gdata_documents_query_new (NULL);
+
+	g_assert (gdata_entry_mirror_refresh (mirror, GDATA_SERVICE (service), gdata_documents_service_get_primary_authorization_domain (),
+	                                      "https://www.googleapis.com/drive/v2/files", GDATA_QUERY (query), TRUE, NULL, &error) == TRUE);
+	g_assert_no_error (error);
+
+	uhm_server_stop (mock_server);
+	g_signal_handler_disconnect (mock_server, handler_id);
+
+	/* Save the mirror and load it into a new one, so the entries are parsed from the saved JSON */
+	file = g_file_new_tmp ("gdata-documents-mirror-XXXXXX", &stream, &error);
+	g_assert_no_error (error);
+	g_object_unref (stream);
+
+	g_assert (gdata_entry_mirror_save (mirror, file, NULL, &error) == TRUE);
+	g_assert_no_error (error);
+
+	mirror2 = gdata_entry_mirror_new (GDATA_TYPE_DOCUMENTS_ENTRY);
+	g_assert (gdata_entry_mirror_load (mirror2, file, NULL, &error) == TRUE);
+	g_assert_no_error (error);
+
+	g_assert_cmpuint (gdata_entry_mirror_get_n_entries (mirror2), ==, 2);
+
+	/* The parents are indexed by their parsed IDs */
+	children = gdata_entry_mirror_list_children (mirror2, "folder1");
+	g_assert_cmpuint (g_list_length (children), ==, 2);
+	g_assert_cmpstr (gdata_entry_get_id (GDATA_ENTRY (children->data)), ==, "mirror-other");
+	g_assert_cmpstr (gdata_entry_get_id (GDATA_ENTRY (children->next->data)), ==, "mirror-file");
+	g_list_free_full (children, g_object_unref);
+
+	children = gdata_entry_mirror_list_children (mirror2, "folder2");
+	g_assert_cmpuint (g_list_length (children), ==, 1);
+	g_assert_cmpstr (gdata_entry_get_id (GDATA_ENTRY (children->data)), ==, "mirror-file");
+	g_list_free_full (children, g_object_unref);
+
+	/* Everything parsed from Drive comes back */
+	loaded = gdata_entry_mirror_lookup (mirror2, "mirror-file");
+	g_assert (GDATA_IS_DOCUMENTS_DOCUMENT (loaded));
+	g_assert_cmpstr (gdata_entry_get_title (loaded), ==, "Report.txt");
+	g_assert_cmpstr (gdata_entry_get_etag (loaded), ==, "\"etag-mirror-file\"");
+	g_assert_cmpint (gdata_entry_get_updated (loaded), ==, 1328054400);
+	g_assert_cmpint (gdata_entry_get_published (loaded), ==, 1325376000);
+	g_assert_cmpstr (gdata_entry_get_content_uri (loaded), ==, "https://www.googleapis.com/drive/v2/files/mirror-file?alt=media");
+	g_assert_cmpstr (gdata_link_get_uri (gdata_entry_look_up_link (loaded, GDATA_LINK_ALTERNATE)), ==,
+	                 "https://docs.google.com/file/d/mirror-file/edit");
+	g_assert_cmpstr (gdata_documents_entry_get_md5_checksum (GDATA_DOCUMENTS_ENTRY (loaded)), ==, "d41d8cd98f00b204e9800998ecf8427e");
+	g_assert_cmpint (gdata_documents_entry_get_file_size (GDATA_DOCUMENTS_ENTRY (loaded)), ==, 1234);
+	g_assert_cmpint (gdata_documents_entry_get_quota_used (GDATA_DOCUMENTS_ENTRY (loaded)), ==, 2048);
+	g_assert_cmpint (gdata_documents_entry_get_last_viewed (GDATA_DOCUMENTS_ENTRY (loaded)), ==, 1328140800);
+	g_assert (gdata_documents_entry_can_edit (GDATA_DOCUMENTS_ENTRY (loaded)) == TRUE);
+	g_assert (gdata_documents_entry_is_deleted (GDATA_DOCUMENTS_ENTRY (loaded)) == FALSE);
+	g_assert_cmpint (gdata_documents_entry_get_shared_with_me_date (GDATA_DOCUMENTS_ENTRY (loaded)), ==, 1328140800);
+
+	starred = viewed = shared = FALSE;
+	for (categories = gdata_entry_get_categories (loaded); categories != NULL; categories = categories->next) {
+		const gchar *term = gdata_category_get_term (GDATA_CATEGORY (categories->data));
+
+		starred = starred || (g_strcmp0 (term, GDATA_CATEGORY_SCHEMA_LABELS_STARRED) == 0);
+		viewed = viewed || (g_strcmp0 (term, GDATA_CATEGORY_SCHEMA_LABELS_VIEWED) == 0);
+		shared = shared || (g_strcmp0 (term, GDATA_CATEGORY_SCHEMA_LABELS_SHARED) == 0);
+	}
+	g_assert (starred == TRUE);
+	g_assert (viewed == TRUE);
+	g_assert (shared == TRUE);
+
+	authors = gdata_entry_get_authors (loaded);
+	g_assert_cmpuint (g_list_length (authors), ==, 1);
+	author = GDATA_AUTHOR (authors->data);
+	g_assert_cmpstr (gdata_author_get_name (author), ==, "libgdata.documents");
+	g_assert_cmpstr (gdata_author_get_email_address (author), ==, "libgdata.documents@gmail.com");
+
+	/* The parents come back in the same order */
+	entry = GDATA_DOCUMENTS_ENTRY (gdata_parsable_new_from_json (GDATA_TYPE_DOCUMENTS_DOCUMENT, MIRROR_FILE_JSON, -1, &error));
+	g_assert_no_error (error);
+
+	path = gdata_documents_entry_get_path (entry);
+	loaded_path = gdata_documents_entry_get_path (GDATA_DOCUMENTS_ENTRY (loaded));
+	g_assert_cmpstr (loaded_path, ==, path);
+	g_free (loaded_path);
+	g_free (path);
+
+	g_object_unref (entry);
+	g_object_unref (loaded);
+	g_object_unref (mirror2);
+
+	g_file_delete (file, NULL, NULL);
+	g_object_unref (file);
+	g_object_unref (query);
+	g_object_unref (mirror);
+}
+
+typedef struct {
+	guint phase; /* index into mirror_refresh_pages[] of the responses to serve */
+	guint n_requests;
+} MirrorRefreshData;
+
+/* Responses served by mirror_refresh_handle_message_cb(): an initial listing split over two pages, an incremental listing which renames one
+ * file and trashes the other, and a full listing which no longer has the remaining file */
+static const gchar *mirror_refresh_pages[][2] = {
+	{
+		"{"
+			"\"kind\": \"drive#fileList\","
+			"\"nextPageToken\": \"page-2\","
+			"\"items\": ["
+				"{"
+					"\"kind\": \"drive#file\","
+					"\"id\": \"mirror-folder\","
+					"\"title\": \"Folder\","
+					"\"mimeType\": \"application/vnd.google-apps.folder\","
+					"\"modifiedDate\": \"2011-01-01T00:00:00.000Z\""
+				"},"
+				"{"
+					"\"kind\": \"drive#file\","
+					"\"id\": \"mirror-file-1\","
+					"\"title\": \"b.txt\","
+					"\"mimeType\": \"text/plain\","
+					"\"modifiedDate\": \"2012-01-01T00:00:00.000Z\","
+					"\"parents\": [{ \"kind\": \"drive#parentReference\", \"id\": \"mirror-folder\","
+					              "\"parentLink\": \"https://www.googleapis.com/drive/v2/files/mirror-folder\" }]"
+				"}"
+			"]"
+		"}",
+		"{"
+			"\"kind\": \"drive#fileList\","
+			"\"items\": ["
+				"{"
+					"\"kind\": \"drive#file\","
+					"\"id\": \"mirror-file-2\","
+					"\"title\": \"a.txt\","
+					"\"mimeType\": \"text/plain\","
+					"\"modifiedDate\": \"2012-02-01T00:00:00.000Z\","
+					"\"parents\": [{ \"kind\": \"drive#parentReference\", \"id\": \"mirror-folder\","
+					              "\"parentLink\": \"https://www.googleapis.com/drive/v2/files/mirror-folder\" }]"
+				"}"
+			"]"
+		"}",
+	},
+	{
+		"{"
+			"\"kind\": \"drive#fileList\","
+			"\"items\": ["
+				"{"
+					"\"kind\": \"drive#file\","
+					"\"id\": \"mirror-file-1\","
+					"\"title\": \"c.txt\","
+					"\"mimeType\": \"text/plain\","
+					"\"modifiedDate\": \"2012-03-01T00:00:00.000Z\","
+					"\"parents\": [{ \"kind\": \"drive#parentReference\", \"id\": \"mirror-folder\","
+					              "\"parentLink\": \"https://www.googleapis.com/drive/v2/files/mirror-folder\" }]"
+				"},"
+				"{"
+					"\"kind\": \"drive#file\","
+					"\"id\": \"mirror-file-2\","
+					"\"title\": \"a.txt\","
+					"\"labels\": { \"trashed\": true },"
+					"\"mimeType\": \"text/plain\","
+					"\"modifiedDate\": \"2012-03-01T00:00:00.000Z\","
+					"\"parents\": [{ \"kind\": \"drive#parentReference\", \"id\": \"mirror-folder\","
+					              "\"parentLink\": \"https://www.googleapis.com/drive/v2/files/mirror-folder\" }]"
+				"}"
+			"]"
+		"}",
+		NULL,
+	},
+	{
+		"{"
+			"\"kind\": \"drive#fileList\","
+			"\"items\": ["
+				"{"
+					"\"kind\": \"drive#file\","
+					"\"id\": \"mirror-folder\","
+					"\"title\": \"Folder\","
+					"\"mimeType\": \"application/vnd.google-apps.folder\","
+					"\"modifiedDate\": \"2011-01-01T00:00:00.000Z\""
+				"}"
+			"]"
+		"}",
+		NULL,
+	},
+};
+
+static gboolean
+mirror_refresh_handle_message_cb (UhmServer *server, SoupMessage *message, SoupClientContext *client, MirrorRefreshData *data)
+{
+	SoupURI *uri;
+	GHashTable *params;
+	const gchar *page_token, *q, *body;
+
+	uri = soup_message_get_uri (message);
+	g_assert_cmpstr (soup_uri_get_path (uri), ==, "/drive/v2/files");
+
+	params = soup_form_decode (soup_uri_get_query (uri));
+	q = g_hash_table_lookup (params, "q");
+
+	/* Only the incremental refresh should be limited to recently modified files; the bound is the newest mirrored modification time */
+	if (data->phase == 1)
+		g_assert (q != NULL && strstr (q, "modifiedDate >= '2012-02-01T00:00:00Z'") != NULL);
+	else
+		g_assert (q == NULL || strstr (q, "modifiedDate") == NULL);
+
+	page_token = g_hash_table_lookup (params, "pageToken");
+	g_assert (page_token == NULL || (data->phase == 0 && g_strcmp0 (page_token, "page-2") == 0));
+	body = mirror_refresh_pages[data->phase][(page_token == NULL) ? 0 : 1];
+
+	g_hash_table_unref (params);
+
+	soup_message_set_status (message, SOUP_STATUS_OK);
+	soup_message_headers_set_content_type (message->response_headers, "application/json", NULL);
+	soup_message_body_append (message->response_body, SOUP_MEMORY_STATIC, body, strlen (body));
+
+	data->n_requests++;
+
+	return TRUE;
+}
+
+/* Test that refreshing a mirror follows every page, then only fetches changes, removes trashed files, and drops missing files on a full refresh */
+static void
+test_mirror_refresh (gconstpointer service)
+{
+	GDataEntryMirror *mirror;
+	GDataDocumentsQuery *query;
+	GDataEntry *entry;
+	GList *children;
+	MirrorRefreshData data = { 0, 0 };
+	gulong handler_id;
+	GError *error = NULL;
+
+	/* The responses refer to files which don't exist on the real server */
+	if (uhm_server_get_enable_online (mock_server)) {
+		g_test_skip ("Test uses canned responses");
+		return;
+	}
+
+	handler_id = g_signal_connect (mock_server, "handle-message", (GCallback) mirror_refresh_handle_message_cb, &data);
+	uhm_server_run (mock_server);
+	gdata_test_set_https_port (mock_server);
+
+	mirror = gdata_entry_mirror_new (GDATA_TYPE_DOCUMENTS_ENTRY);
+	query = gdata_documents_query_new (NULL);
+	gdata_documents_query_set_show_folders (query, TRUE);
+	gdata_documents_query_set_show_deleted (query, TRUE);
+
+	/* The mirror's empty, so even an incremental refresh fetches everything */
+	g_assert (gdata_entry_mirror_refresh (mirror, GDATA_SERVICE (service), gdata_documents_service_get_primary_authorization_domain (),
+	                                      "https://www.googleapis.com/drive/v2/files", GDATA_QUERY (query), FALSE, NULL, &error) == TRUE);
+	g_assert_no_error (error);
+
+	g_assert_cmpuint (data.n_requests, ==, 2);
+	g_assert_cmpuint (gdata_entry_mirror_get_n_entries (mirror), ==, 3);
+	g_assert_cmpint (gdata_entry_mirror_get_last_updated (mirror), ==, 1328054400);
+
+	children = gdata_entry_mirror_list_children (mirror, "mirror-folder");
+	g_assert_cmpuint (g_list_length (children), ==, 2);
+	g_assert_cmpstr (gdata_entry_get_id (GDATA_ENTRY (children->data)), ==, "mirror-file-2");
+	g_assert_cmpstr (gdata_entry_get_id (GDATA_ENTRY (children->next->data)), ==, "mirror-file-1");
+	g_list_free_full (children, g_object_unref);
+
+	/* Only the changes are fetched, and the trashed file is removed */
+	data.phase = 1;
+	data.n_requests = 0;
+
+	g_assert (gdata_entry_mirror_refresh (mirror, GDATA_SERVICE (service), gdata_documents_service_get_primary_authorization_domain (),
+	                                      "https://www.googleapis.com/drive/v2/files", GDATA_QUERY (query), FALSE, NULL, &error) == TRUE);
+	g_assert_no_error (error);
+
+	g_assert_cmpuint (data.n_requests, ==, 1);
+	g_assert_cmpuint (gdata_entry_mirror_get_n_entries (mirror), ==, 2);
+	g_assert_cmpint (gdata_entry_mirror_get_last_updated (mirror), ==, 1330560000);
+	g_assert (gdata_entry_mirror_lookup (mirror, "mirror-file-2") == NULL);
+
+	entry = gdata_entry_mirror_lookup (mirror, "mirror-file-1");
+	g_assert (GDATA_IS_DOCUMENTS_DOCUMENT (entry));
+	g_assert_cmpstr (gdata_entry_get_title (entry), ==, "c.txt");
+	g_object_unref (entry);
+
+	/* The query is left as it was */
+	g_assert_cmpint (gdata_query_get_updated_min (GDATA_QUERY (query)), ==, -1);
+
+	/* A full refresh removes the file which is no longer listed */
+	data.phase = 2;
+	data.n_requests = 0;
+
+	g_assert (gdata_entry_mirror_refresh (mirror, GDATA_SERVICE (service), gdata_documents_service_get_primary_authorization_domain (),
+	                                      "https://www.googleapis.com/drive/v2/files", GDATA_QUERY (query), TRUE, NULL, &error) == TRUE);
+	g_assert_no_error (error);
+
+	g_assert_cmpuint (data.n_requests, ==, 1);
+	g_assert_cmpuint (gdata_entry_mirror_get_n_entries (mirror), ==, 1);
+	g_assert (gdata_entry_mirror_lookup (mirror, "mirror-file-1") == NULL);
+
+	children = gdata_entry_mirror_list_children (mirror, "mirror-folder");
+	g_assert (children == NULL);
+
+	g_object_unref (query);
+	g_object_unref (mirror);
+
+	uhm_server_stop (mock_server);
+	g_signal_handler_disconnect (mock_server, handler_id);
+}
+
 static void
 test_folder_parser_normal (void)
 {
@@ -2045,6 +2990,7 @@ mock_server_notify_resolver_cb (GObject *object, GParamSpec *pspec, gpointer use
 
 		uhm_resolver_add_A (resolver, "www.google.com", ip_address);
 		uhm_resolver_add_A (resolver, "docs.google.com", ip_address);
+		uhm_resolver_add_A (resolver, "www.googleapis.com", ip_address);
 		uhm_resolver_add_A (resolver, "lh3.googleusercontent.com", ip_address);
 		uhm_resolver_add_A (resolver, "lh5.googleusercontent.com", ip_address);
 		uhm_resolver_add_A (resolver, "lh6.googleusercontent.com", ip_address);
@@ -2267,6 +3213,14 @@ main (int argc, char *argv[])
 	            tear_down_batch_async);
 
 	g_test_add_func ("/documents/folder/parser/normal", test_folder_parser_normal);
+	g_test_add_func ("/documents/document/matches-file", test_document_matches_file);
+	g_test_add_func ("/documents/document/path", test_document_path);
+	g_test_add_func ("/documents/document/parse_json/handled_members", test_document_parse_json_handled_members);
+	g_test_add_data_func ("/documents/index-folder", service, test_index_folder);
+	g_test_add_func ("/documents/crawl-folder/unauthenticated", test_crawl_folder_unauthenticated);
+	g_test_add_data_func ("/documents/crawl-folder", service, test_crawl_folder);
+	g_test_add_data_func ("/documents/mirror", service, test_mirror);
+	g_test_add_data_func ("/documents/mirror/refresh", service, test_mirror_refresh);
 	g_test_add_func ("/documents/query/etag", test_query_etag);
 	g_test_add_func ("/documents/upload-query/properties/convert", test_upload_query_properties_convert);
 
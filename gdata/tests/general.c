@@ -19,6 +19,7 @@
 
 #include <glib.h>
 #include <locale.h>
+#include <string.h>
 
 #include "gdata.h"
 #include "common.h"
@@ -632,6 +633,122 @@ test_entry_parse_xml (void)
 	g_object_unref (entry);
 }
 
+/* Check that parsing @timestamp as an entry's <updated> element gives the same result as GDateTime, and that it's output the same way */
+static void
+check_entry_timestamp (const gchar *timestamp)
+{
+	GDataEntry *entry;
+	GDateTime *expected;
+	gchar *xml;
+	GError *error = NULL;
+
+	expected = g_date_time_new_from_iso8601 (timestamp, NULL);
+
+	xml = g_strdup_printf ("<entry xmlns='http://www.w3.org/2005/Atom'><title>Timestamp</title><updated>%s</updated></entry>", timestamp);
+	entry = GDATA_ENTRY (gdata_parsable_new_from_xml (GDATA_TYPE_ENTRY, xml, -1, &error));
+	g_free (xml);
+
+	if (expected == NULL) {
+		g_assert_error (error, GDATA_SERVICE_ERROR, GDATA_SERVICE_ERROR_PROTOCOL_ERROR);
+		g_assert (entry == NULL);
+		g_clear_error (&error);
+		return;
+	}
+
+	g_assert_no_error (error);
+	g_assert (GDATA_IS_ENTRY (entry));
+	g_assert_cmpint (gdata_entry_get_updated (entry), ==, g_date_time_to_unix (expected));
+
+	/* GDateTime doesn't zero-pad years before 1000, and can't represent years after 9999 in UTC */
+	if (g_date_time_get_year (expected) >= 1000 && g_date_time_get_year (expected) < 9999) {
+		GDateTime *utc;
+		gchar *expected_string, *expected_element;
+
+		utc = g_date_time_new_from_unix_utc (g_date_time_to_unix (expected));
+		expected_string = g_date_time_format_iso8601 (utc);
+		expected_element = g_strdup_printf ("<updated>%s</updated>", expected_string);
+
+		xml = gdata_parsable_get_xml (GDATA_PARSABLE (entry));
+		g_assert (g_strstr_len (xml, -1, expected_element) != NULL);
+
+		g_free (xml);
+		g_free (expected_element);
+		g_free (expected_string);
+		g_date_time_unref (utc);
+	}
+
+	g_date_time_unref (expected);
+	g_object_unref (entry);
+}
+
+static void
+test_entry_parse_xml_timestamps (void)
+{
+	static const gchar *fixed_timestamps[] = {
+		"2009-01-25T14:07:37Z",
+		"2009-01-25T14:07:37.880Z",
+		"2009-02-25T14:07:37.880860Z",
+		"1970-01-01T00:00:00Z",
+		"1969-12-31T23:59:59Z",
+		"1969-12-31T23:59:59.999Z",
+		"0001-01-01T00:00:00Z",
+		"9999-12-31T23:59:59Z",
+		"2000-02-29T12:00:00+01:00",
+		"2100-02-28T12:00:00-08:00",
+		"2010-06-30T23:30:00+0530",
+		"2010-06-30T23:30:00+05",
+		"20100630T233000Z",
+		"2010-06-30 23:30:00Z",
+		"2010-06-30T23:30:00",
+		/* Invalid */
+		"2009-02-29T00:00:00Z",
+		"2100-02-29T00:00:00Z",
+		"2009-13-01T00:00:00Z",
+		"2009-00-01T00:00:00Z",
+		"2009-01-32T00:00:00Z",
+		"2009-01-01T25:00:00Z",
+		"2009-01-01T00:60:00Z",
+		"2009-01-01T00:00:00.Z",
+		"2009-01-01T00:00:00+05:",
+		"2009-01-01T00:00:00Zjunk",
+		"2009-01-01",
+		"not a timestamp",
+	};
+	guint i;
+
+	for (i = 0; i < G_N_ELEMENTS (fixed_timestamps); i++)
+		check_entry_timestamp (fixed_timestamps[i]);
+
+	/* Check a load of random timestamps in the forms the servers use */
+	for (i = 0; i < 1000; i++) {
+		gchar *timestamp, *offset;
+		gint offset_hours = g_test_rand_int_range (-12, 15);
+
+		switch (g_test_rand_int_range (0, 3)) {
+			case 0:
+				offset = g_strdup ("Z");
+				break;
+			case 1:
+				offset = g_strdup_printf ("%c%02d:%02d", (offset_hours < 0) ? '-' : '+', ABS (offset_hours),
+				                          g_test_rand_int_range (0, 4) * 15);
+				break;
+			default:
+				offset = g_strdup_printf ("%c%02d%02d", (offset_hours < 0) ? '-' : '+', ABS (offset_hours),
+				                          g_test_rand_int_range (0, 4) * 15);
+				break;
+		}
+
+		timestamp = g_strdup_printf ("%04d-%02d-%02dT%02d:%02d:%02d%s%s",
+		                             g_test_rand_int_range (1, 10000), g_test_rand_int_range (1, 13), g_test_rand_int_range (1, 32),
+		                             g_test_rand_int_range (0, 24), g_test_rand_int_range (0, 60), g_test_rand_int_range (0, 60),
+		                             g_test_rand_bit () ? ".000" : ".123456", offset);
+		check_entry_timestamp (timestamp);
+
+		g_free (timestamp);
+		g_free (offset);
+	}
+}
+
 static void
 test_entry_parse_xml_kind_category (void)
 {
@@ -923,6 +1040,268 @@ test_entry_links_remove (void)
 	g_object_unref (entry);
 }
 
+static void
+test_entry_links_look_up (void)
+{
+	GDataEntry *entry, *entry2;
+	GDataLink *link_, *link2_;
+	GDataCategory *category;
+	GList *links;
+	GError *error = NULL;
+
+	entry = GDATA_ENTRY (gdata_parsable_new_from_xml (GDATA_TYPE_ENTRY,
+		"<?xml version='1.0' encoding='UTF-8'?>"
+		"<entry xmlns='http://www.w3.org/2005/Atom'>"
+			"<title type='text'>Title</title>"
+			"<id>http://example.com/id</id>"
+			"<updated>2010-12-10T17:21:24Z</updated>"
+			"<published>2010-12-10T17:21:24Z</published>"
+			"<link rel='related' href='http://example.com/1'/>"
+			"<link rel='self' href='http://example.com/self'/>"
+			"<link rel='related' href='http://example.com/2'/>"
+			"<link rel='related' href='http://example.com/1'/>"
+			"<category term='foo'/>"
+			"<category term='bar'/>"
+			"<category term='foo'/>"
+		"</entry>", -1, &error));
+	g_assert_no_error (error);
+	g_assert (GDATA_IS_ENTRY (entry));
+
+	/* Duplicates should have been dropped, and document order preserved. */
+	g_assert_cmpuint (g_list_length (gdata_entry_get_categories (entry)), ==, 2);
+	links = gdata_entry_look_up_links (entry, GDATA_LINK_RELATED);
+	g_assert_cmpuint (g_list_length (links), ==, 2);
+	g_assert_cmpstr (gdata_link_get_uri (GDATA_LINK (links->data)), ==, "http://example.com/1");
+	g_assert_cmpstr (gdata_link_get_uri (GDATA_LINK (links->next->data)), ==, "http://example.com/2");
+	g_assert (gdata_entry_look_up_link (entry, GDATA_LINK_RELATED) == links->data);
+	g_list_free (links);
+
+	g_assert (gdata_entry_look_up_link (entry, "http://example.com/never-seen-before") == NULL);
+	g_assert (gdata_entry_look_up_links (entry, "http://example.com/never-seen-before") == NULL);
+
+	/* Changing the relation type of a link which is already in the entry should be reflected in look-ups. */
+	link_ = gdata_entry_look_up_link (entry, GDATA_LINK_SELF);
+	g_assert (link_ != NULL);
+	gdata_link_set_relation_type (link_, GDATA_LINK_EDIT);
+	g_assert (gdata_entry_look_up_link (entry, GDATA_LINK_SELF) == NULL);
+	g_assert (gdata_entry_look_up_link (entry, GDATA_LINK_EDIT) == link_);
+
+	/* …as should de-duplication against it. */
+	link2_ = gdata_link_new ("http://example.com/self", GDATA_LINK_EDIT);
+	gdata_entry_add_link (entry, link2_);
+	links = gdata_entry_look_up_links (entry, GDATA_LINK_EDIT);
+	g_assert_cmpuint (g_list_length (links), ==, 1);
+	g_assert (links->data == link_);
+	g_list_free (links);
+	g_object_unref (link2_);
+
+	/* Same for categories. */
+	category = GDATA_CATEGORY (gdata_entry_get_categories (entry)->data);
+	gdata_category_set_term (category, "baz");
+	category = gdata_category_new ("foo", NULL, NULL);
+	gdata_entry_add_category (entry, category);
+	g_assert_cmpuint (g_list_length (gdata_entry_get_categories (entry)), ==, 3);
+	g_object_unref (category);
+
+	/* A link shared between two entries should be re-indexed in both, and in neither once it's been removed from them. */
+	entry2 = gdata_entry_new (NULL);
+	gdata_entry_add_link (entry2, link_);
+	gdata_link_set_relation_type (link_, GDATA_LINK_ALTERNATE);
+	g_assert (gdata_entry_look_up_link (entry, GDATA_LINK_ALTERNATE) == link_);
+	g_assert (gdata_entry_look_up_link (entry2, GDATA_LINK_ALTERNATE) == link_);
+	g_assert (gdata_entry_look_up_link (entry2, GDATA_LINK_EDIT) == NULL);
+
+	g_object_ref (link_);
+	g_assert (gdata_entry_remove_link (entry, link_) == TRUE);
+	g_object_unref (entry2);
+	gdata_link_set_relation_type (link_, GDATA_LINK_EDIT);
+	g_assert (gdata_entry_look_up_link (entry, GDATA_LINK_EDIT) == NULL);
+	g_object_unref (link_);
+
+	/* Indexing, looking up and removing a link with an arbitrary relation type shouldn't intern it, as it would never be freed. */
+	link_ = gdata_link_new ("http://example.com/unknown", "http://example.com/never-interned-relation-type");
+	gdata_entry_add_link (entry, link_);
+	g_assert (gdata_entry_look_up_link (entry, "http://example.com/never-interned-relation-type") == link_);
+	g_assert (gdata_entry_look_up_link (entry, "http://example.com/never-interned-missing-type") == NULL);
+	g_assert (gdata_entry_remove_link (entry, link_) == TRUE);
+	g_assert (gdata_entry_look_up_link (entry, "http://example.com/never-interned-relation-type") == NULL);
+	g_object_unref (link_);
+
+	g_assert_cmpuint (g_quark_try_string ("http://example.com/never-interned-relation-type"), ==, 0);
+	g_assert_cmpuint (g_quark_try_string ("http://example.com/never-interned-missing-type"), ==, 0);
+
+	g_object_unref (entry);
+}
+
+static GDataEntry *
+build_mirror_entry (const gchar *id, const gchar *title, gint64 updated, const gchar *parent_id)
+{
+	GDataEntry *entry;
+	GDateTime *updated_date_time;
+	gchar *json, *updated_str;
+	GError *error = NULL;
+
+	updated_date_time = g_date_time_new_from_unix_utc (updated);
+	updated_str = g_date_time_format (updated_date_time, "%Y-%m-%dT%H:%M:%SZ");
+	g_date_time_unref (updated_date_time);
+	json = g_strdup_printf ("{\"id\":\"%s\",\"title\":\"%s\",\"updated\":\"%s\",\"etag\":\"\\\"etag-%s\\\"\"}", id, title, updated_str, id);
+	entry = GDATA_ENTRY (gdata_parsable_new_from_json (GDATA_TYPE_ENTRY, json, -1, &error));
+	g_assert_no_error (error);
+	g_free (json);
+	g_free (updated_str);
+
+	if (parent_id != NULL) {
+		GDataLink *_link;
+		gchar *uri;
+
+		uri = g_strconcat ("https://www.googleapis.com/drive/v2/files/", parent_id, NULL);
+		_link = gdata_link_new (uri, GDATA_LINK_PARENT);
+		gdata_entry_add_link (entry, _link);
+		g_object_unref (_link);
+		g_free (uri);
+	}
+
+	return entry;
+}
+
+static void
+check_mirror_entries (GList *entries, ...)
+{
+	va_list ap;
+	const gchar *id;
+	GList *i;
+
+	va_start (ap, entries);
+
+	for (i = entries; i != NULL; i = i->next) {
+		id = va_arg (ap, const gchar *);
+		g_assert_cmpstr (gdata_entry_get_id (GDATA_ENTRY (i->data)), ==, id);
+	}
+
+	g_assert (va_arg (ap, const gchar *) == NULL);
+	va_end (ap);
+
+	g_list_free_full (entries, g_object_unref);
+}
+
+static void
+check_mirror_queries (GDataEntryMirror *mirror)
+{
+	GDataEntry *entry;
+
+	g_assert_cmpuint (gdata_entry_mirror_get_n_entries (mirror), ==, 4);
+	g_assert_cmpint (gdata_entry_mirror_get_last_updated (mirror), ==, 1300000000);
+
+	/* Look up by ID */
+	entry = gdata_entry_mirror_lookup (mirror, "file2");
+	g_assert (GDATA_IS_ENTRY (entry));
+	g_assert_cmpstr (gdata_entry_get_title (entry), ==, "Report 2011");
+	g_assert_cmpstr (gdata_entry_get_etag (entry), ==, "\"etag-file2\"");
+	g_assert_cmpint (gdata_entry_get_updated (entry), ==, 1200000000);
+	g_object_unref (entry);
+
+	g_assert (gdata_entry_mirror_lookup (mirror, "missing") == NULL);
+	g_assert_cmpstr (gdata_entry_mirror_get_etag (mirror, "file1"), ==, "\"etag-file1\"");
+	g_assert (gdata_entry_mirror_get_etag (mirror, "missing") == NULL);
+
+	/* By parent, ordered by title */
+	check_mirror_entries (gdata_entry_mirror_list_children (mirror, "folder1"), "file1", "file2", NULL);
+	check_mirror_entries (gdata_entry_mirror_list_children (mirror, "folder2"), "file3", NULL);
+	check_mirror_entries (gdata_entry_mirror_list_children (mirror, "missing"), NULL);
+
+	/* By title prefix */
+	check_mirror_entries (gdata_entry_mirror_list_by_title_prefix (mirror, "Report"), "file1", "file2", NULL);
+	check_mirror_entries (gdata_entry_mirror_list_by_title_prefix (mirror, "Report 2011"), "file2", NULL);
+	check_mirror_entries (gdata_entry_mirror_list_by_title_prefix (mirror, ""), "file4", "file1", "file2", "file3", NULL);
+	check_mirror_entries (gdata_entry_mirror_list_by_title_prefix (mirror, "Zebra"), NULL);
+
+	/* By updated time; the lower bound is inclusive and the upper one exclusive */
+	check_mirror_entries (gdata_entry_mirror_list_by_updated (mirror, -1, -1), "file3", "file1", "file2", "file4", NULL);
+	check_mirror_entries (gdata_entry_mirror_list_by_updated (mirror, 1100000000, 1300000000), "file1", "file2", NULL);
+	check_mirror_entries (gdata_entry_mirror_list_by_updated (mirror, 1200000000, -1), "file2", "file4", NULL);
+	check_mirror_entries (gdata_entry_mirror_list_by_updated (mirror, 1300000000, 1200000000), NULL);
+}
+
+static void
+test_entry_mirror (void)
+{
+	GDataEntryMirror *mirror, *mirror2;
+	GDataEntry *entry;
+	GFile *file;
+	GFileIOStream *stream;
+	GError *error = NULL;
+
+	mirror = gdata_entry_mirror_new (GDATA_TYPE_ENTRY);
+	g_assert_cmpuint (gdata_entry_mirror_get_n_entries (mirror), ==, 0);
+	g_assert_cmpint (gdata_entry_mirror_get_last_updated (mirror), ==, -1);
+
+	entry = build_mirror_entry ("file1", "Report 2010", 1100000000, "folder1");
+	gdata_entry_mirror_add_entry (mirror, entry);
+	g_object_unref (entry);
+
+	/* This one's replaced below */
+	entry = build_mirror_entry ("file2", "Old report", 1000000000, "folder2");
+	gdata_entry_mirror_add_entry (mirror, entry);
+	g_object_unref (entry);
+
+	entry = build_mirror_entry ("file2", "Report 2011", 1200000000, "folder1");
+	gdata_entry_mirror_add_entry (mirror, entry);
+	g_object_unref (entry);
+
+	entry = build_mirror_entry ("file3", "Spreadsheet", 1000000000, "folder2");
+	gdata_entry_mirror_add_entry (mirror, entry);
+	g_object_unref (entry);
+
+	entry = build_mirror_entry ("file4", "Notes", 1300000000, NULL);
+	gdata_entry_mirror_add_entry (mirror, entry);
+	g_object_unref (entry);
+
+	entry = build_mirror_entry ("file5", "Removed", 1400000000, "folder1");
+	gdata_entry_mirror_add_entry (mirror, entry);
+	g_object_unref (entry);
+
+	g_assert (gdata_entry_mirror_remove_entry (mirror, "file5") == TRUE);
+	g_assert (gdata_entry_mirror_remove_entry (mirror, "file5") == FALSE);
+
+	check_mirror_queries (mirror);
+
+	/* Save the mirror and load it into a new one; the entries are parsed again as they're returned */
+	file = g_file_new_tmp ("gdata-mirror-XXXXXX", &stream, &error);
+	g_assert_no_error (error);
+	g_object_unref (stream);
+
+	g_assert (gdata_entry_mirror_save (mirror, file, NULL, &error) == TRUE);
+	g_assert_no_error (error);
+
+	mirror2 = gdata_entry_mirror_new (GDATA_TYPE_ENTRY);
+	g_assert (gdata_entry_mirror_load (mirror2, file, NULL, &error) == TRUE);
+	g_assert_no_error (error);
+
+	check_mirror_queries (mirror2);
+	g_object_unref (mirror2);
+
+	/* Mirrors of a different entry type can't load the file, and are left untouched */
+	mirror2 = gdata_entry_mirror_new (GDATA_TYPE_ACCESS_RULE);
+	g_assert (gdata_entry_mirror_load (mirror2, file, NULL, &error) == FALSE);
+	g_assert_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA);
+	g_clear_error (&error);
+	g_assert_cmpuint (gdata_entry_mirror_get_n_entries (mirror2), ==, 0);
+	g_object_unref (mirror2);
+
+	/* Nor can anything which isn't a mirror */
+	g_assert (g_file_replace_contents (file, "not a mirror", 12, NULL, FALSE, G_FILE_CREATE_NONE, NULL, NULL, &error) == TRUE);
+	g_assert_no_error (error);
+
+	g_assert (gdata_entry_mirror_load (mirror, file, NULL, &error) == FALSE);
+	g_assert_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA);
+	g_clear_error (&error);
+	check_mirror_queries (mirror);
+
+	g_file_delete (file, NULL, NULL);
+	g_object_unref (file);
+	g_object_unref (mirror);
+}
+
 static void
 test_feed_parse_xml (void)
 {
@@ -1177,6 +1556,132 @@ test_feed_error_handling (void)
 #undef TEST_XML_ERROR_HANDLING
 }
 
+static void
+assert_feed_entries_in_order (GDataFeed *feed, guint n_entries)
+{
+	GList *entries;
+	guint i;
+
+	entries = gdata_feed_get_entries (feed);
+	g_assert_cmpuint (g_list_length (entries), ==, n_entries);
+
+	for (i = 0; entries != NULL; entries = entries->next, i++) {
+		gchar *id = g_strdup_printf ("http://example.com/entry/%u", i);
+		g_assert_cmpstr (gdata_entry_get_id (GDATA_ENTRY (entries->data)), ==, id);
+		g_free (id);
+	}
+}
+
+static void
+test_feed_parse_many_entries (void)
+{
+	GDataFeed *feed;
+	GString *xml, *json;
+	guint i;
+	GError *error = NULL;
+
+	/* Enough entries that, on a machine with more than one CPU, they're built in parallel; they must still come out in document order */
+	xml = g_string_new ("<feed xmlns='http://www.w3.org/2005/Atom'>"
+	                    "<id>http://example.com/id</id>"
+	                    "<updated>2009-02-25T14:07:37.880860Z</updated>"
+	                    "<title type='text'>Test feed</title>");
+	json = g_string_new ("{\"kind\": \"test#feed\", \"items\": [");
+
+	for (i = 0; i < 500; i++) {
+		g_string_append_printf (xml, "<entry><id>http://example.com/entry/%u</id><title type='text'>Entry %u</title>"
+		                             "<updated>2009-02-25T14:07:37.880860Z</updated></entry>", i, i);
+		g_string_append_printf (json, "%s{\"id\": \"http://example.com/entry/%u\", \"title\": \"Entry %u\", "
+		                              "\"updated\": \"2009-02-25T14:07:37.880860Z\"}", (i == 0) ? "" : ", ", i, i);
+	}
+
+	g_string_append (xml, "</feed>");
+	g_string_append (json, "]}");
+
+	feed = GDATA_FEED (gdata_parsable_new_from_xml (GDATA_TYPE_FEED, xml->str, -1, &error));
+	g_assert_no_error (error);
+	g_assert (GDATA_IS_FEED (feed));
+	assert_feed_entries_in_order (feed, 500);
+	g_object_unref (feed);
+
+	feed = GDATA_FEED (gdata_parsable_new_from_json (GDATA_TYPE_FEED, json->str, -1, &error));
+	g_assert_no_error (error);
+	g_assert (GDATA_IS_FEED (feed));
+	assert_feed_entries_in_order (feed, 500);
+	g_object_unref (feed);
+
+	g_string_free (json, TRUE);
+
+	/* An invalid entry part way through must fail the whole feed, however the entries are built */
+	g_string_truncate (xml, xml->len - strlen ("</feed>"));
+	g_string_append (xml, "<entry><id>http://example.com/entry/bad</id><updated>this isn't a date</updated></entry>");
+	for (i = 0; i < 100; i++)
+		g_string_append_printf (xml, "<entry><id>http://example.com/entry/%u</id><updated>2009-02-25T14:07:37Z</updated></entry>", i);
+	g_string_append (xml, "</feed>");
+
+	feed = GDATA_FEED (gdata_parsable_new_from_xml (GDATA_TYPE_FEED, xml->str, -1, &error));
+	g_assert_error (error, GDATA_SERVICE_ERROR, GDATA_SERVICE_ERROR_PROTOCOL_ERROR);
+	g_assert (feed == NULL);
+	g_clear_error (&error);
+
+	g_string_free (xml, TRUE);
+}
+
+static void
+test_feed_unhandled_namespaces (void)
+{
+	GDataFeed *feed;
+	GString *xml;
+	GList *entries;
+	guint i;
+	GError *error = NULL;
+
+	/* Enough entries that they're built in parallel, each with an unhandled element using a namespace declared on the feed. The last entry
+	 * redeclares the prefix. */
+	xml = g_string_new ("<feed xmlns='http://www.w3.org/2005/Atom' xmlns:ex='http://example.com/ex'>"
+	                    "<id>http://example.com/id</id>"
+	                    "<updated>2009-02-25T14:07:37.880860Z</updated>"
+	                    "<title type='text'>Test feed</title>");
+
+	for (i = 0; i < 100; i++) {
+		g_string_append_printf (xml, "<entry><id>http://example.com/entry/%u</id><title type='text'>Entry %u</title>"
+		                             "<updated>2009-02-25T14:07:37.880860Z</updated><ex:thing>%u</ex:thing></entry>", i, i, i);
+	}
+
+	g_string_append (xml, "<entry xmlns:ex='http://example.com/other'><id>http://example.com/entry/other</id>"
+	                      "<updated>2009-02-25T14:07:37.880860Z</updated><ex:thing>other</ex:thing><ex:more/></entry>"
+	                      "</feed>");
+
+	feed = GDATA_FEED (gdata_parsable_new_from_xml (GDATA_TYPE_FEED, xml->str, -1, &error));
+	g_assert_no_error (error);
+	g_assert (GDATA_IS_FEED (feed));
+	g_string_free (xml, TRUE);
+
+	/* Each entry's XML should declare the namespace which was in scope for its unhandled element, and still be valid once the feed's
+	 * document has gone */
+	for (i = 0, entries = gdata_feed_get_entries (feed); entries != NULL; entries = entries->next, i++) {
+		gchar *entry_xml, *expected;
+
+		entry_xml = gdata_parsable_get_xml (GDATA_PARSABLE (entries->data));
+
+		if (i < 100) {
+			g_assert (strstr (entry_xml, " xmlns:ex='http://example.com/ex'") != NULL);
+			expected = g_strdup_printf ("<ex:thing>%u</ex:thing>", i);
+			g_assert (strstr (entry_xml, expected) != NULL);
+			g_free (expected);
+		} else {
+			g_assert (strstr (entry_xml, " xmlns:ex='http://example.com/other'") != NULL);
+			g_assert (strstr (entry_xml, "http://example.com/ex'") == NULL);
+			g_assert (strstr (entry_xml, "<ex:thing>other</ex:thing><ex:more/>") != NULL);
+		}
+
+		g_free (entry_xml);
+	}
+
+	g_assert_cmpuint (i, ==, 101);
+
+	g_object_unref (feed);
+}
+
 static void
 test_feed_escaping (void)
 {
@@ -1530,6 +2035,70 @@ test_service_network_error (void)
 	g_object_unref (service);
 }
 
+static void
+request_metrics_cb (GDataService *service, const GDataServiceRequestMetrics *metrics, gpointer user_data)
+{
+	GDataServiceRequestMetrics *out = user_data;
+
+	g_assert (GDATA_IS_SERVICE (service));
+	g_assert_cmpuint (out->status, ==, SOUP_STATUS_NONE);
+
+	*out = *metrics;
+	out->method = NULL;
+	out->uri = NULL;
+	out->authorization_domain = NULL;
+
+	g_assert_cmpstr (metrics->method, ==, SOUP_METHOD_GET);
+	g_assert_cmpstr (metrics->uri, ==, "https://thisshouldnotexist.invalid/");
+}
+
+static void
+request_metrics_destroy_cb (gpointer user_data)
+{
+	guint *destroy_count = user_data;
+
+	(*destroy_count)++;
+}
+
+static void
+test_service_request_metrics (void)
+{
+	GDataService *service;
+	GDataServiceRequestMetrics metrics = { 0, };
+	guint destroy_count = 0;
+	GError *error = NULL;
+
+	/* This is a little hacky, but it should work */
+	service = g_object_new (GDATA_TYPE_SERVICE, NULL);
+
+	/* Replacing and unsetting the callback should destroy the user data each time */
+	gdata_service_set_request_metrics_callback (service, request_metrics_cb, &destroy_count, request_metrics_destroy_cb);
+	gdata_service_set_request_metrics_callback (service, NULL, NULL, NULL);
+	g_assert_cmpuint (destroy_count, ==, 1);
+
+	gdata_service_set_request_metrics_callback (service, request_metrics_cb, &metrics, NULL);
+
+	/* Skip the rest of this test unless explicitly asked for, so that we don’t do network accesses on build machines by default. */
+	if (g_test_slow ()) {
+		g_assert (gdata_service_query (service, NULL, "https://thisshouldnotexist.invalid/?q=secret", NULL, GDATA_TYPE_ENTRY,
+		                               NULL, NULL, NULL, &error) == NULL);
+		g_assert_error (error, GDATA_SERVICE_ERROR, GDATA_SERVICE_ERROR_NETWORK_ERROR);
+		g_clear_error (&error);
+
+		/* The metrics should have been reported by the time the query returns */
+		g_assert_cmpuint (metrics.status, ==, SOUP_STATUS_CANT_RESOLVE);
+		g_assert_cmpint (metrics.operation_type, ==, GDATA_OPERATION_QUERY);
+		g_assert_cmpuint (metrics.response_bytes, ==, 0);
+		g_assert_cmpuint (metrics.redirects, ==, 0);
+		g_assert_cmpuint (metrics.authorization_retries, ==, 0);
+		g_assert_cmpint (metrics.time_to_first_byte, ==, -1);
+		g_assert_cmpint (metrics.parse_time, ==, -1);
+		g_assert_cmpint (metrics.total_time, >=, 0);
+	}
+
+	g_object_unref (service);
+}
+
 static void
 test_service_locale (void)
 {
@@ -1551,6 +2120,190 @@ test_service_locale (void)
 	g_object_unref (service);
 }
 
+typedef struct {
+	GMainLoop *main_loop;
+	guint n_pending;
+} QueryExecutorData;
+
+static void
+query_executor_cancelled_cb (GDataQueryExecutor *executor, GAsyncResult *result, QueryExecutorData *data)
+{
+	GDataFeed *feed;
+	GError *error = NULL;
+
+	feed = gdata_query_executor_query_finish (executor, result, &error);
+	g_assert_error (error, G_IO_ERROR, G_IO_ERROR_CANCELLED);
+	g_assert (feed == NULL);
+	g_clear_error (&error);
+
+	if (--data->n_pending == 0)
+		g_main_loop_quit (data->main_loop);
+}
+
+static void
+test_service_query_executor (void)
+{
+	GDataQueryExecutor *executor;
+	GDataService *service1, *service2;
+	GCancellable *cancellable;
+	QueryExecutorData data;
+	guint i;
+
+	executor = gdata_query_executor_new (2);
+	g_assert (GDATA_IS_QUERY_EXECUTOR (executor));
+	g_assert_cmpuint (gdata_query_executor_get_max_concurrent_queries (executor), ==, 2);
+
+	g_assert_cmpfloat (gdata_query_executor_get_max_queries_per_second (executor), ==, 0.0);
+	gdata_query_executor_set_max_queries_per_second (executor, 1000.0);
+	g_assert_cmpfloat (gdata_query_executor_get_max_queries_per_second (executor), ==, 1000.0);
+
+	/* This is a little hacky, but it should work */
+	service1 = g_object_new (GDATA_TYPE_SERVICE, NULL);
+	service2 = g_object_new (GDATA_TYPE_SERVICE, NULL);
+
+	/* Services added to the executor share their connection settings */
+	gdata_query_executor_add_service (executor, service1);
+	gdata_query_executor_add_service (executor, service2);
+	gdata_service_set_timeout (service1, 30);
+	g_assert_cmpuint (gdata_service_get_timeout (service2), ==, 30);
+
+	/* Queue more queries than can run at once; they've all been cancelled, so they finish without any network activity */
+	cancellable = g_cancellable_new ();
+	g_cancellable_cancel (cancellable);
+
+	data.main_loop = g_main_loop_new (NULL, FALSE);
+	data.n_pending = 10;
+
+	for (i = 0; i < data.n_pending; i++) {
+		gdata_query_executor_query_async (executor, (i % 2 == 0) ? service1 : service2, NULL, "https://thisshouldnotexist.invalid/", NULL,
+		                                  GDATA_TYPE_ENTRY, cancellable, NULL, NULL, NULL,
+		                                  (GAsyncReadyCallback) query_executor_cancelled_cb, &data);
+	}
+
+	/* The queries keep the executor alive */
+	g_object_unref (executor);
+
+	g_main_loop_run (data.main_loop);
+	g_main_loop_unref (data.main_loop);
+
+	g_object_unref (cancellable);
+
+	/* The shared session outlives the executor */
+	gdata_service_set_timeout (service2, 60);
+	g_assert_cmpuint (gdata_service_get_timeout (service1), ==, 60);
+
+	g_object_unref (service1);
+	g_object_unref (service2);
+}
+
+static gboolean
+query_executor_cancel_cb (GCancellable *cancellable)
+{
+	g_cancellable_cancel (cancellable);
+	return G_SOURCE_REMOVE;
+}
+
+/* Test that a query waiting for its turn under the rate limit can be cancelled without waiting out the limit */
+static void
+test_service_query_executor_rate_limit_cancellation (void)
+{
+	GDataQueryExecutor *executor;
+	GDataService *service;
+	GCancellable *cancelled, *cancellable;
+	QueryExecutorData data;
+	gint64 start_time;
+
+	executor = gdata_query_executor_new (2);
+	gdata_query_executor_set_max_queries_per_second (executor, 0.01);
+
+	/* This is a little hacky, but it should work */
+	service = g_object_new (GDATA_TYPE_SERVICE, NULL);
+
+	data.main_loop = g_main_loop_new (NULL, FALSE);
+	data.n_pending = 2;
+
+	/* The first query takes the first start time, so the second has to wait 100 seconds for its own */
+	cancelled = g_cancellable_new ();
+	g_cancellable_cancel (cancelled);
+	cancellable = g_cancellable_new ();
+
+	start_time = g_get_monotonic_time ();
+
+	gdata_query_executor_query_async (executor, service, NULL, "https://thisshouldnotexist.invalid/", NULL, GDATA_TYPE_ENTRY, cancelled,
+	                                  NULL, NULL, NULL, (GAsyncReadyCallback) query_executor_cancelled_cb, &data);
+	gdata_query_executor_query_async (executor, service, NULL, "https://thisshouldnotexist.invalid/", NULL, GDATA_TYPE_ENTRY, cancellable,
+	                                  NULL, NULL, NULL, (GAsyncReadyCallback) query_executor_cancelled_cb, &data);
+	g_object_unref (executor);
+
+	g_timeout_add (100, (GSourceFunc) query_executor_cancel_cb, cancellable);
+
+	g_main_loop_run (data.main_loop);
+	g_main_loop_unref (data.main_loop);
+
+	g_assert_cmpint (g_get_monotonic_time () - start_time, <, 10 * G_USEC_PER_SEC);
+
+	g_object_unref (cancellable);
+	g_object_unref (cancelled);
+	g_object_unref (service);
+}
+
+/* Test that a query cancelled while it's queued finishes straight away, even though every thread in the pool is busy */
+static void
+test_service_query_executor_queued_cancellation (void)
+{
+	GDataQueryExecutor *executor;
+	GDataService *service;
+	GCancellable *cancelled, *waiting_cancellable, *queued_cancellable;
+	QueryExecutorData data;
+	gint64 start_time;
+
+	/* Only one query can run at once */
+	executor = gdata_query_executor_new (1);
+	gdata_query_executor_set_max_queries_per_second (executor, 0.01);
+
+	/* This is a little hacky, but it should work */
+	service = g_object_new (GDATA_TYPE_SERVICE, NULL);
+
+	data.main_loop = g_main_loop_new (NULL, FALSE);
+	data.n_pending = 3;
+
+	/* The first query takes the first start time, so the second holds the pool's only thread for 100 seconds while it waits for its own, and
+	 * the third stays queued behind it */
+	cancelled = g_cancellable_new ();
+	g_cancellable_cancel (cancelled);
+	waiting_cancellable = g_cancellable_new ();
+	queued_cancellable = g_cancellable_new ();
+
+	start_time = g_get_monotonic_time ();
+
+	gdata_query_executor_query_async (executor, service, NULL, "https://thisshouldnotexist.invalid/", NULL, GDATA_TYPE_ENTRY, cancelled,
+	                                  NULL, NULL, NULL, (GAsyncReadyCallback) query_executor_cancelled_cb, &data);
+	gdata_query_executor_query_async (executor, service, NULL, "https://thisshouldnotexist.invalid/", NULL, GDATA_TYPE_ENTRY,
+	                                  waiting_cancellable, NULL, NULL, NULL, (GAsyncReadyCallback) query_executor_cancelled_cb, &data);
+	gdata_query_executor_query_async (executor, service, NULL, "https://thisshouldnotexist.invalid/", NULL, GDATA_TYPE_ENTRY,
+	                                  queued_cancellable, NULL, NULL, NULL, (GAsyncReadyCallback) query_executor_cancelled_cb, &data);
+	g_object_unref (executor);
+
+	/* Cancelling the queued query finishes it without freeing the thread */
+	g_timeout_add (100, (GSourceFunc) query_executor_cancel_cb, queued_cancellable);
+
+	while (data.n_pending > 1)
+		g_main_context_iteration (NULL, TRUE);
+
+	g_assert_cmpint (g_get_monotonic_time () - start_time, <, 10 * G_USEC_PER_SEC);
+
+	/* Then let the waiting query go too */
+	g_cancellable_cancel (waiting_cancellable);
+
+	g_main_loop_run (data.main_loop);
+	g_main_loop_unref (data.main_loop);
+
+	g_object_unref (queued_cancellable);
+	g_object_unref (waiting_cancellable);
+	g_object_unref (cancelled);
+	g_object_unref (service);
+}
+
 static void
 test_access_rule_get_xml (void)
 {
@@ -2238,6 +2991,13 @@ test_atom_link (void)
 	gdata_link_set_length (link2, 2000);
 	g_assert_cmpint (gdata_comparable_compare (GDATA_COMPARABLE (link1), GDATA_COMPARABLE (link2)), ==, 0);
 
+	/* Known relation types are shared between links; arbitrary ones are copied */
+	gdata_link_set_relation_type (link2, "self");
+	g_assert_cmpstr (gdata_link_get_relation_type (link2), ==, GDATA_LINK_SELF);
+	gdata_link_set_relation_type (link2, "http://test.com#link-type");
+	g_assert_cmpstr (gdata_link_get_relation_type (link2), ==, "http://test.com#link-type");
+	g_assert (gdata_link_get_relation_type (link1) != gdata_link_get_relation_type (link2));
+
 	/* Try with a dissimilar link */
 	gdata_link_set_uri (link2, "http://gnome.org/");
 	g_assert_cmpint (gdata_comparable_compare (GDATA_COMPARABLE (link1), GDATA_COMPARABLE (link2)), !=, 0);
@@ -2342,6 +3102,7 @@ static void
 test_atom_link_escaping (void)
 {
 	GDataLink *_link;
+	gchar *xml;
 
 	_link = gdata_link_new ("http://foo.com?foo&bar", "http://foo.com?foo&relation=bar");
 	gdata_link_set_content_type (_link, "<content type>");
@@ -2355,6 +3116,16 @@ test_atom_link_escaping (void)
 	                 "<link xmlns='http://www.w3.org/2005/Atom' href='http://foo.com?foo&amp;bar' title='Title &amp; stuff' "
 				"rel='http://foo.com?foo&amp;relation=bar' type='&lt;content type&gt;' hreflang='&lt;language&gt;'/>");
 	g_object_unref (_link);
+
+	/* Check that control characters are escaped as character references, but other non-ASCII characters (including U+0085) aren't */
+	_link = gdata_link_new ("http://foo.com/", NULL);
+	gdata_link_set_title (_link, "Control\x01\x1f\x7f and C1\xc2\x80\xc2\x85\xc2\x9f\xc2\xa0 and \xc3\xa9 & \"quotes\"");
+
+	xml = gdata_parsable_get_xml (GDATA_PARSABLE (_link));
+	g_assert (g_strstr_len (xml, -1, "title='Control&#x1;&#x1f;&#x7f; and C1&#x80;\xc2\x85&#x9f;\xc2\xa0 and \xc3\xa9 &amp; &quot;quotes&quot;'") != NULL);
+	g_free (xml);
+
+	g_object_unref (_link);
 }
 
 static void
@@ -4873,19 +5644,29 @@ main (int argc, char *argv[])
 
 	g_test_add_func ("/service/network_error", test_service_network_error);
 	g_test_add_func ("/service/locale", test_service_locale);
+	g_test_add_func ("/service/request_metrics", test_service_request_metrics);
+	g_test_add_func ("/service/query_executor", test_service_query_executor);
+	g_test_add_func ("/service/query_executor/rate_limit_cancellation", test_service_query_executor_rate_limit_cancellation);
+	g_test_add_func ("/service/query_executor/queued_cancellation", test_service_query_executor_queued_cancellation);
+
 
 	g_test_add_func ("/entry/get_xml", test_entry_get_xml);
 	g_test_add_func ("/entry/get_json", test_entry_get_json);
 	g_test_add_func ("/entry/parse_xml", test_entry_parse_xml);
 	g_test_add_func ("/entry/parse_xml/kind_category", test_entry_parse_xml_kind_category);
+	g_test_add_func ("/entry/parse_xml/timestamps", test_entry_parse_xml_timestamps);
 	g_test_add_func ("/entry/parse_json", test_entry_parse_json);
 	g_test_add_func ("/entry/error_handling/xml", test_entry_error_handling_xml);
 	g_test_add_func ("/entry/error_handling/json", test_entry_error_handling_json);
 	g_test_add_func ("/entry/escaping", test_entry_escaping);
 	g_test_add_func ("/entry/links/remove", test_entry_links_remove);
+	g_test_add_func ("/entry/links/look_up", test_entry_links_look_up);
+	g_test_add_func ("/entry/mirror", test_entry_mirror);
 
 	g_test_add_func ("/feed/parse_xml", test_feed_parse_xml);
 	g_test_add_func ("/feed/error_handling", test_feed_error_handling);
+	g_test_add_func ("/feed/parse_many_entries", test_feed_parse_many_entries);
+	g_test_add_func ("/feed/unhandled_namespaces", test_feed_unhandled_namespaces);
 	g_test_add_func ("/feed/escaping", test_feed_escaping);
 
 	g_test_add_func ("/query/categories", test_query_categories);
@@ -385,6 +385,119 @@ test_oauth2_authorizer_properties_proxy_resolver (OAuth2AuthorizerData *data, gc
 	g_assert (gdata_oauth2_authorizer_get_proxy_resolver (data->authorizer) != NULL);
 }
 
+/* Test sharing the session property with services */
+static void
+test_oauth2_authorizer_properties_session (OAuth2AuthorizerData *data, gconstpointer user_data)
+{
+	SoupSession *session, *service_session;
+	GDataService *service1, *service2;
+
+	/* The authorizer builds its own session by default */
+	g_object_get (data->authorizer, "session", &session, NULL);
+	g_assert (SOUP_IS_SESSION (session));
+
+	/* Services constructed with the authorizer's session share it, and its settings */
+	service1 = g_object_new (GDATA_TYPE_TASKS_SERVICE, "authorizer", data->authorizer, "session", session, NULL);
+	service2 = g_object_new (GDATA_TYPE_TASKS_SERVICE, "authorizer", data->authorizer, "session", session, NULL);
+
+	g_object_get (service1, "session", &service_session, NULL);
+	g_assert (service_session == session);
+	g_object_unref (service_session);
+
+	gdata_oauth2_authorizer_set_timeout (data->authorizer, 30);
+	g_assert_cmpuint (data->timeout_notification_count, ==, 1);
+	g_assert_cmpuint (gdata_service_get_timeout (service1), ==, 30);
+	g_assert_cmpuint (gdata_service_get_timeout (service2), ==, 30);
+
+	gdata_service_set_timeout (service2, 15);
+	g_assert_cmpuint (gdata_oauth2_authorizer_get_timeout (data->authorizer), ==, 15);
+	g_assert_cmpuint (data->timeout_notification_count, ==, 2);
+
+	/* Services without a session still get one of their own */
+	g_object_unref (service2);
+	service2 = GDATA_SERVICE (gdata_tasks_service_new (GDATA_AUTHORIZER (data->authorizer)));
+
+	g_object_get (service2, "session", &service_session, NULL);
+	g_assert (SOUP_IS_SESSION (service_session));
+	g_assert (service_session != session);
+	g_object_unref (service_session);
+
+	/* The session outlives the service */
+	g_object_unref (service1);
+	gdata_oauth2_authorizer_set_timeout (data->authorizer, 0);
+	g_assert_cmpuint (data->timeout_notification_count, ==, 3);
+
+	g_object_unref (service2);
+	g_object_unref (session);
+}
+
+/* Test that the timeout and proxy resolver can be set at construction time,
+ * before the authorizer’s or service’s session has been set up, both with
+ * and without a shared session */
+static void
+test_oauth2_authorizer_properties_construct_time (void)
+{
+	GDataOAuth2Authorizer *authorizer;
+	GDataService *service;
+	GProxyResolver *proxy_resolver, *session_proxy_resolver;
+	SoupSession *session;
+	guint session_timeout;
+
+	proxy_resolver = g_simple_proxy_resolver_new (NULL, NULL);
+
+	authorizer = g_object_new (GDATA_TYPE_OAUTH2_AUTHORIZER,
+	                           "client-id", CLIENT_ID,
+	                           "client-secret", CLIENT_SECRET,
+	                           "redirect-uri", REDIRECT_URI,
+	                           "timeout", 30,
+	                           "proxy-resolver", proxy_resolver,
+	                           NULL);
+
+	g_assert_cmpuint (gdata_oauth2_authorizer_get_timeout (authorizer), ==, 30);
+	g_assert (gdata_oauth2_authorizer_get_proxy_resolver (authorizer) == proxy_resolver);
+
+	g_object_get (authorizer, "session", &session, NULL);
+	g_object_get (session,
+	              SOUP_SESSION_TIMEOUT, &session_timeout,
+	              SOUP_SESSION_PROXY_RESOLVER, &session_proxy_resolver,
+	              NULL);
+	g_assert_cmpuint (session_timeout, ==, 30);
+	g_assert (session_proxy_resolver == proxy_resolver);
+	g_object_unref (session_proxy_resolver);
+	g_object_unref (session);
+
+	/* A service with its own session */
+	service = g_object_new (GDATA_TYPE_TASKS_SERVICE,
+	                        "authorizer", authorizer,
+	                        "timeout", 15,
+	                        "proxy-resolver", proxy_resolver,
+	                        NULL);
+
+	g_assert_cmpuint (gdata_service_get_timeout (service), ==, 15);
+	g_assert (gdata_service_get_proxy_resolver (service) == proxy_resolver);
+	g_assert_cmpuint (gdata_oauth2_authorizer_get_timeout (authorizer), ==, 30);
+
+	g_object_unref (service);
+
+	/* A service sharing the authorizer’s session takes on the settings it
+	 * was constructed with */
+	g_object_get (authorizer, "session", &session, NULL);
+	service = g_object_new (GDATA_TYPE_TASKS_SERVICE,
+	                        "authorizer", authorizer,
+	                        "session", session,
+	                        "timeout", 45,
+	                        NULL);
+	g_object_unref (session);
+
+	g_assert_cmpuint (gdata_service_get_timeout (service), ==, 45);
+	g_assert_cmpuint (gdata_oauth2_authorizer_get_timeout (authorizer), ==, 45);
+	g_assert (gdata_service_get_proxy_resolver (service) == proxy_resolver);
+
+	g_object_unref (service);
+	g_object_unref (authorizer);
+	g_object_unref (proxy_resolver);
+}
+
 /* Test that gdata_authorizer_refresh_authorization() is a no-op when
  * unauthenticated. */
 static void
@@ -959,6 +1072,9 @@ main (int argc, char *argv[])
 	            test_oauth2_authorizer_properties_timeout, tear_down_oauth2_authorizer_data);
 	g_test_add ("/oauth2-authorizer/properties/proxy-resolver", OAuth2AuthorizerData, NULL, set_up_oauth2_authorizer_data,
 	            test_oauth2_authorizer_properties_proxy_resolver, tear_down_oauth2_authorizer_data);
+	g_test_add ("/oauth2-authorizer/properties/session", OAuth2AuthorizerData, NULL, set_up_oauth2_authorizer_data,
+	            test_oauth2_authorizer_properties_session, tear_down_oauth2_authorizer_data);
+	g_test_add_func ("/oauth2-authorizer/properties/construct-time", test_oauth2_authorizer_properties_construct_time);
 
 	g_test_add ("/oauth2-authorizer/refresh-authorization/unauthenticated", OAuth2AuthorizerData, NULL,
 	            set_up_oauth2_authorizer_data, test_oauth2_authorizer_refresh_authorization_unauthenticated, tear_down_oauth2_authorizer_data);
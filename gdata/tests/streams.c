@@ -313,6 +313,79 @@ test_download_stream_download_content_length (void)
 	g_main_loop_unref (main_loop);
 }
 
+/* Test that a download stream checksums the data as it's read, and verifies it against the expected checksum when it's closed. */
+static void
+test_download_stream_download_checksum (void)
+{
+	SoupServer *server;
+	GMainLoop *main_loop;
+	GThread *thread;
+	gchar *download_uri, *test_string, *expected_checksum;
+	GDataService *service;
+	GInputStream *download_stream;
+	GChecksumType checksum_type;
+	gssize length_read;
+	guint8 buffer[20];
+	guint i;
+	gboolean success;
+	GError *error = NULL;
+
+	/* Create and run the server */
+	server = create_server ((SoupServerCallback) test_download_stream_download_server_content_length_handler_cb, NULL, &main_loop);
+	thread = run_server (server, main_loop);
+
+	test_string = get_test_string (1, 1000);
+	expected_checksum = g_compute_checksum_for_data (G_CHECKSUM_MD5, (const guchar *) test_string, strlen (test_string) + 1);
+
+	download_uri = build_server_uri (server);
+	service = GDATA_SERVICE (gdata_youtube_service_new ("developer-key", NULL));
+
+	/* Download the data twice: once with the correct checksum, and once with an incorrect one */
+	for (i = 0; i < 2; i++) {
+		download_stream = gdata_download_stream_new (service, NULL, download_uri, NULL);
+		gdata_download_stream_set_checksum (GDATA_DOWNLOAD_STREAM (download_stream), G_CHECKSUM_MD5,
+		                                    (i == 0) ? expected_checksum : "00000000000000000000000000000000");
+
+		while ((length_read = g_input_stream_read (download_stream, buffer, sizeof (buffer), NULL, &error)) > 0) {
+			/* The checksum isn't available until all the data has been read */
+			g_assert (gdata_download_stream_get_checksum (GDATA_DOWNLOAD_STREAM (download_stream), NULL) == NULL);
+		}
+
+		g_assert_no_error (error);
+		g_assert_cmpint (length_read, ==, 0);
+
+		g_assert_cmpstr (gdata_download_stream_get_checksum (GDATA_DOWNLOAD_STREAM (download_stream), &checksum_type), ==,
+		                 expected_checksum);
+		g_assert_cmpint (checksum_type, ==, G_CHECKSUM_MD5);
+
+		/* Closing the stream should verify the checksum */
+		success = g_input_stream_close (download_stream, NULL, &error);
+
+		if (i == 0) {
+			g_assert_no_error (error);
+			g_assert (success == TRUE);
+		} else {
+			g_assert_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA);
+			g_assert (success == FALSE);
+			g_clear_error (&error);
+		}
+
+		g_object_unref (download_stream);
+	}
+
+	g_object_unref (service);
+	g_free (download_uri);
+	g_free (expected_checksum);
+	g_free (test_string);
+
+	/* Kill the server and wait for it to die */
+	stop_server (server, main_loop);
+	g_thread_join (thread);
+
+	g_object_unref (server);
+	g_main_loop_unref (main_loop);
+}
+
 static void
 test_download_stream_download_server_seek_handler_cb (SoupServer *server, SoupMessage *message, const char *path, GHashTable *query,
                                                       SoupClientContext *client, gpointer user_data)
@@ -676,6 +749,107 @@ test_upload_stream_upload_no_entry_content_length (void)
 	g_main_loop_unref (main_loop);
 }
 
+static void
+test_upload_stream_upload_checksum_server_handler_cb (SoupServer *server, SoupMessage *message, const char *path, GHashTable *query,
+                                                      SoupClientContext *client, const gchar **reported_checksum)
+{
+	gchar *response;
+
+	/* Respond with a Drive file whose checksum is whatever the test wants the server to report */
+	response = g_strdup_printf ("{"
+		"\"kind\": \"drive#file\","
+		"\"id\": \"some-file-id\","
+		"\"title\": \"slug\","
+		"\"mimeType\": \"text/plain\","
+		"\"md5Checksum\": \"%s\""
+	"}", *reported_checksum);
+
+	soup_message_set_status (message, SOUP_STATUS_OK);
+	soup_message_headers_set_content_type (message->response_headers, "application/json", NULL);
+	soup_message_body_append (message->response_body, SOUP_MEMORY_TAKE, response, strlen (response));
+}
+
+/* Test that an upload stream checksums the data as it's written, and that gdata_documents_service_finish_upload() verifies it against the
+ * checksum reported by the server. */
+static void
+test_upload_stream_upload_checksum (void)
+{
+	SoupServer *server;
+	GMainLoop *main_loop;
+	GThread *thread;
+	gchar *upload_uri, *test_string, *expected_checksum;
+	const gchar *reported_checksum;
+	GDataService *service;
+	GOutputStream *upload_stream;
+	GDataDocumentsDocument *document;
+	GChecksumType checksum_type;
+	gsize length_written;
+	guint i;
+	gboolean success;
+	GError *error = NULL;
+
+	/* Create and run the server */
+	server = create_server ((SoupServerCallback) test_upload_stream_upload_checksum_server_handler_cb, &reported_checksum, &main_loop);
+	thread = run_server (server, main_loop);
+
+	test_string = get_test_string (1, 1000);
+	expected_checksum = g_compute_checksum_for_data (G_CHECKSUM_MD5, (const guchar *) test_string, strlen (test_string) + 1);
+
+	upload_uri = build_server_uri (server);
+	service = GDATA_SERVICE (gdata_documents_service_new (NULL));
+
+	/* Upload the data twice: once with the server reporting the correct checksum, and once with an incorrect one */
+	for (i = 0; i < 2; i++) {
+		reported_checksum = (i == 0) ? expected_checksum : "00000000000000000000000000000000";
+
+		upload_stream = gdata_upload_stream_new (service, NULL, SOUP_METHOD_POST, upload_uri, NULL, "slug", "text/plain", NULL);
+		gdata_upload_stream_set_checksum_type (GDATA_UPLOAD_STREAM (upload_stream), G_CHECKSUM_MD5);
+
+		success = g_output_stream_write_all (upload_stream, test_string, strlen (test_string) + 1, &length_written, NULL, &error);
+		g_assert_no_error (error);
+		g_assert (success == TRUE);
+		g_assert_cmpuint (length_written, ==, strlen (test_string) + 1);
+
+		/* The checksum isn't available until the upload has finished */
+		g_assert (gdata_upload_stream_get_checksum (GDATA_UPLOAD_STREAM (upload_stream), NULL) == NULL);
+
+		success = g_output_stream_close (upload_stream, NULL, &error);
+		g_assert_no_error (error);
+		g_assert (success == TRUE);
+
+		g_assert_cmpstr (gdata_upload_stream_get_checksum (GDATA_UPLOAD_STREAM (upload_stream), &checksum_type), ==, expected_checksum);
+		g_assert_cmpint (checksum_type, ==, G_CHECKSUM_MD5);
+
+		/* Finishing the upload should verify the checksum */
+		document = gdata_documents_service_finish_upload (GDATA_DOCUMENTS_SERVICE (service), GDATA_UPLOAD_STREAM (upload_stream), &error);
+
+		if (i == 0) {
+			g_assert_no_error (error);
+			g_assert (GDATA_IS_DOCUMENTS_DOCUMENT (document));
+			g_assert_cmpstr (gdata_documents_entry_get_md5_checksum (GDATA_DOCUMENTS_ENTRY (document)), ==, expected_checksum);
+			g_object_unref (document);
+		} else {
+			g_assert_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA);
+			g_assert (document == NULL);
+			g_clear_error (&error);
+		}
+
+		g_object_unref (upload_stream);
+	}
+
+	g_object_unref (service);
+	g_free (upload_uri);
+	g_free (expected_checksum);
+	g_free (test_string);
+
+	/* Kill the server and wait for it to die */
+	stop_server (server, main_loop);
+	g_thread_join (thread);
+
+	g_object_unref (server);
+	g_main_loop_unref (main_loop);
+}
+
 /* Test parameters for a run of test_upload_stream_resumable(). */
 typedef struct {
 	enum {
@@ -1050,11 +1224,13 @@ main (int argc, char *argv[])
 	g_setenv ("LIBGDATA_DEBUG", "2" /* GDATA_LOG_HEADERS */, TRUE);
 
 	g_test_add_func ("/download-stream/download_content_length", test_download_stream_download_content_length);
+	g_test_add_func ("/download-stream/download_checksum", test_download_stream_download_checksum);
 	g_test_add_func ("/download-stream/download_seek/before_start", test_download_stream_download_seek_before_start);
 	g_test_add_func ("/download-stream/download_seek/after_start_forwards", test_download_stream_download_seek_after_start_forwards);
 	g_test_add_func ("/download-stream/download_seek/after_start_backwards", test_download_stream_download_seek_after_start_backwards);
 
 	g_test_add_func ("/upload-stream/upload_no_entry_content_length", test_upload_stream_upload_no_entry_content_length);
+	g_test_add_func ("/upload-stream/upload_checksum", test_upload_stream_upload_checksum);
 
 	/* Test all possible combinations of conditions for resumable uploads. */
 	{
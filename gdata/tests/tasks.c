@@ -1353,6 +1353,680 @@ skip_test:
 	return GDATA_AUTHORIZER (authorizer);
 }
 
+/* Test that batch operations can't mix JSON tasks with XML entries, as they use different batch protocols. This doesn't touch the network. */
+static void
+test_batch_mixed_formats (gconstpointer service)
+{
+	GDataBatchOperation *operation;
+	GDataTasksTask *task;
+	GDataEntry *entry;
+	GError *error = NULL;
+
+	g_assert (GDATA_IS_BATCHABLE (service));
+
+	operation = gdata_batchable_create_operation (GDATA_BATCHABLE (service), gdata_tasks_service_get_primary_authorization_domain (),
+	                                              "https://www.googleapis.com/batch/tasks/v1");
+
+	task = gdata_tasks_task_new (NULL);
+	g_assert_cmpuint (gdata_batch_operation_add_insertion_to_uri (operation, GDATA_ENTRY (task),
+	                                                              "https://www.googleapis.com/tasks/v1/lists/some-list/tasks",
+	                                                              NULL, NULL), !=, 0);
+	g_object_unref (task);
+
+	entry = gdata_entry_new (NULL);
+	g_assert_cmpuint (gdata_batch_operation_add_insertion (operation, entry, NULL, NULL), !=, 0);
+	g_object_unref (entry);
+
+	g_assert (gdata_batch_operation_run (operation, NULL, &error) == FALSE);
+	g_assert_error (error, GDATA_SERVICE_ERROR, GDATA_SERVICE_ERROR_WITH_BATCH_OPERATION);
+	g_clear_error (&error);
+
+	g_object_unref (operation);
+}
+
+typedef struct {
+	guint n_calls;
+	GDataEntry *entry;  /* owned */
+	GError *error;  /* owned */
+} BatchJsonResult;
+
+static void
+batch_json_cb (guint operation_id, GDataBatchOperationType operation_type, GDataEntry *entry, GError *error, gpointer user_data)
+{
+	BatchJsonResult *result = user_data;
+
+	result->n_calls++;
+	result->entry = (entry != NULL) ? g_object_ref (entry) : NULL;
+	result->error = (error != NULL) ? g_error_copy (error) : NULL;
+}
+
+static GDataTasksTask *
+batch_json_task_new (const gchar *id)
+{
+	GDataTasksTask *task;
+	gchar *json;
+	GError *error = NULL;
+
+	json = g_strdup_printf ("{"
+		"\"kind\": \"tasks#task\","
+		"\"id\": \"%s\","
+		"\"etag\": \"\\\"etag-%s\\\"\","
+		"\"title\": \"Task %s\","
+		"\"selfLink\": \"https://www.googleapis.com/tasks/v1/lists/some-list/tasks/%s\""
+	"}", id, id, id, id);
+	task = GDATA_TASKS_TASK (gdata_parsable_new_from_json (GDATA_TYPE_TASKS_TASK, json, -1, &error));
+	g_assert_no_error (error);
+	g_free (json);
+
+	return task;
+}
+
+/* Test that a mixed JSON batch operation is sent as a multipart/mixed request, and that each part of the response is matched back to its
+ * operation by Content-ID. One operation has no URI and so isn't sent, and the server doesn't respond to another. */
+static void
+test_batch_json (gconstpointer service)
+{
+	GDataBatchOperation *operation;
+	GDataTasksTask *task, *updated_task, *deleted_task, *unanswered_task, *unsent_task;
+	BatchJsonResult results[5];
+	guint op_ids[5], i;
+	GError *error = NULL;
+
+	/* The trace refers to tasks which don't exist on the real server */
+	if (uhm_server_get_enable_online (mock_server)) {
+		g_test_skip ("Test uses a canned batch response");
+		return;
+	}
+
+	memset (results, 0, sizeof (results));
+
+	/* A batch where no operation has a URI shouldn't be sent at all; there's no trace loaded, so any request would fail */
+	operation = gdata_batchable_create_operation (GDATA_BATCHABLE (service), gdata_tasks_service_get_primary_authorization_domain (),
+	                                              "https://www.googleapis.com/batch/tasks/v1");
+
+	unsent_task = gdata_tasks_task_new (NULL);
+	gdata_batch_operation_add_update (operation, GDATA_ENTRY (unsent_task), batch_json_cb, &results[0]);
+
+	g_assert (gdata_batch_operation_run (operation, NULL, &error) == TRUE);
+	g_assert_no_error (error);
+	g_assert_cmpuint (results[0].n_calls, ==, 1);
+	g_assert (results[0].entry == NULL);
+	g_assert_error (results[0].error, GDATA_SERVICE_ERROR, GDATA_SERVICE_ERROR_WITH_BATCH_OPERATION);
+	g_clear_error (&results[0].error);
+
+	g_object_unref (operation);
+	memset (results, 0, sizeof (results));
+
+	/* Now a mixed batch */
+	gdata_test_mock_server_start_trace (mock_server, "batch-json");
+
+	operation = gdata_batchable_create_operation (GDATA_BATCHABLE (service), gdata_tasks_service_get_primary_authorization_domain (),
+	                                              "https://www.googleapis.com/batch/tasks/v1");
+
+	task = gdata_tasks_task_new (NULL);
+	gdata_entry_set_title (GDATA_ENTRY (task), "New task");
+	updated_task = batch_json_task_new ("task-1");
+	gdata_entry_set_title (GDATA_ENTRY (updated_task), "Updated task");
+	deleted_task = batch_json_task_new ("task-2");
+	unanswered_task = batch_json_task_new ("task-3");
+
+	op_ids[0] = gdata_batch_operation_add_insertion_to_uri (operation, GDATA_ENTRY (task),
+	                                                        "https://www.googleapis.com/tasks/v1/lists/some-list/tasks",
+	                                                        batch_json_cb, &results[0]);
+	op_ids[1] = gdata_batch_operation_add_update (operation, GDATA_ENTRY (updated_task), batch_json_cb, &results[1]);
+	op_ids[2] = gdata_batch_operation_add_deletion (operation, GDATA_ENTRY (deleted_task), batch_json_cb, &results[2]);
+	op_ids[3] = gdata_batch_operation_add_deletion (operation, GDATA_ENTRY (unanswered_task), batch_json_cb, &results[3]);
+	op_ids[4] = gdata_batch_operation_add_update (operation, GDATA_ENTRY (unsent_task), batch_json_cb, &results[4]);
+
+	/* The trace's response parts are labelled with these IDs */
+	for (i = 0; i < G_N_ELEMENTS (op_ids); i++)
+		g_assert_cmpuint (op_ids[i], ==, i + 1);
+
+	g_assert (gdata_batch_operation_run (operation, NULL, &error) == TRUE);
+	g_assert_no_error (error);
+
+	for (i = 0; i < G_N_ELEMENTS (results); i++)
+		g_assert_cmpuint (results[i].n_calls, ==, 1);
+
+	/* Insertion */
+	g_assert_no_error (results[0].error);
+	g_assert (GDATA_IS_TASKS_TASK (results[0].entry));
+	g_assert_cmpstr (gdata_entry_get_id (results[0].entry), ==, "task-new");
+	g_assert_cmpstr (gdata_entry_get_title (results[0].entry), ==, "New task");
+
+	/* Update */
+	g_assert_no_error (results[1].error);
+	g_assert (GDATA_IS_TASKS_TASK (results[1].entry));
+	g_assert_cmpstr (gdata_entry_get_id (results[1].entry), ==, "task-1");
+	g_assert_cmpstr (gdata_entry_get_title (results[1].entry), ==, "Updated task");
+	g_assert_cmpstr (gdata_entry_get_etag (results[1].entry), ==, "\"etag-task-1-updated\"");
+
+	/* Deletion */
+	g_assert_no_error (results[2].error);
+	g_assert (results[2].entry == NULL);
+
+	/* Deletion with no response part */
+	g_assert (results[3].entry == NULL);
+	g_assert_error (results[3].error, GDATA_SERVICE_ERROR, GDATA_SERVICE_ERROR_PROTOCOL_ERROR);
+
+	/* Update with no URI */
+	g_assert (results[4].entry == NULL);
+	g_assert_error (results[4].error, GDATA_SERVICE_ERROR, GDATA_SERVICE_ERROR_WITH_BATCH_OPERATION);
+
+	for (i = 0; i < G_N_ELEMENTS (results); i++) {
+		g_clear_object (&results[i].entry);
+		g_clear_error (&results[i].error);
+	}
+
+	g_object_unref (operation);
+	g_object_unref (unsent_task);
+	g_object_unref (unanswered_task);
+	g_object_unref (deleted_task);
+	g_object_unref (updated_task);
+	g_object_unref (task);
+
+	uhm_server_end_trace (mock_server);
+}
+
+static void
+mutations_unexpected_cb (const GDataTasksMutation *mutation, GDataTasksTask *task, GError *error, gpointer user_data)
+{
+	g_assert_not_reached ();
+}
+
+/* Test that bulk mutations which can't be ordered are rejected before anything is sent. This doesn't touch the network. */
+static void
+test_mutations_invalid (gconstpointer service)
+{
+	GDataTasksTasklist *tasklist;
+	GDataTasksTask *task1, *task2, *existing;
+	GDataTasksMutation mutations[3];
+	GError *error = NULL;
+
+	tasklist = gdata_tasks_tasklist_new ("some-list");
+	task1 = gdata_tasks_task_new (NULL);
+	task2 = gdata_tasks_task_new (NULL);
+	existing = gdata_tasks_task_new ("some-task");
+
+	/* Two insertions, each placed under the other */
+	memset (mutations, 0, sizeof (mutations));
+	mutations[0].type = GDATA_TASKS_MUTATION_INSERTION;
+	mutations[0].task = task1;
+	mutations[0].key = "one";
+	mutations[0].parent = "two";
+	mutations[1].type = GDATA_TASKS_MUTATION_INSERTION;
+	mutations[1].task = task2;
+	mutations[1].key = "two";
+	mutations[1].previous = "one";
+
+	g_assert (gdata_tasks_service_run_mutations (GDATA_TASKS_SERVICE (service), tasklist, mutations, 2, 0, NULL,
+	                                             mutations_unexpected_cb, NULL, &error) == FALSE);
+	g_assert_error (error, GDATA_SERVICE_ERROR, GDATA_SERVICE_ERROR_WITH_BATCH_OPERATION);
+	g_clear_error (&error);
+
+	/* A task moved after itself */
+	memset (mutations, 0, sizeof (mutations));
+	mutations[0].type = GDATA_TASKS_MUTATION_MOVE;
+	mutations[0].task = existing;
+	mutations[0].previous = "some-task";
+
+	g_assert (gdata_tasks_service_run_mutations (GDATA_TASKS_SERVICE (service), tasklist, mutations, 1, 0, NULL,
+	                                             mutations_unexpected_cb, NULL, &error) == FALSE);
+	g_assert_error (error, GDATA_SERVICE_ERROR, GDATA_SERVICE_ERROR_WITH_BATCH_OPERATION);
+	g_clear_error (&error);
+
+	/* An insertion whose key clashes with the ID of a task being deleted */
+	memset (mutations, 0, sizeof (mutations));
+	mutations[0].type = GDATA_TASKS_MUTATION_DELETION;
+	mutations[0].task = existing;
+	mutations[1].type = GDATA_TASKS_MUTATION_INSERTION;
+	mutations[1].task = task1;
+	mutations[1].key = "some-task";
+
+	g_assert (gdata_tasks_service_run_mutations (GDATA_TASKS_SERVICE (service), tasklist, mutations, 2, 0, NULL,
+	                                             mutations_unexpected_cb, NULL, &error) == FALSE);
+	g_assert_error (error, GDATA_SERVICE_ERROR, GDATA_SERVICE_ERROR_WITH_BATCH_OPERATION);
+	g_clear_error (&error);
+
+	/* An insertion placed after a task which is being deleted */
+	memset (mutations, 0, sizeof (mutations));
+	mutations[0].type = GDATA_TASKS_MUTATION_DELETION;
+	mutations[0].task = existing;
+	mutations[1].type = GDATA_TASKS_MUTATION_INSERTION;
+	mutations[1].task = task1;
+	mutations[1].previous = "some-task";
+
+	g_assert (gdata_tasks_service_run_mutations (GDATA_TASKS_SERVICE (service), tasklist, mutations, 2, 0, NULL,
+	                                             mutations_unexpected_cb, NULL, &error) == FALSE);
+	g_assert_error (error, GDATA_SERVICE_ERROR, GDATA_SERVICE_ERROR_WITH_BATCH_OPERATION);
+	g_clear_error (&error);
+
+	g_object_unref (existing);
+	g_object_unref (task2);
+	g_object_unref (task1);
+	g_object_unref (tasklist);
+}
+
+/* A fake tasks server for the bulk mutation tests, which records which request each task arrived in and what it was placed relative to */
+typedef struct {
+	guint n_requests;
+	GHashTable *requests;  /* owned; task title or ID → owned description of the request it arrived in */
+} MutationsServerData;
+
+/* Handle one insertion or move, whether it arrived on its own or as part of a batch. Returns the response's status, and its body in @response_body. */
+static guint
+mutations_handle_request (MutationsServerData *data, const gchar *kind, const gchar *method, const gchar *path, const gchar *body, gsize body_length,
+                          gchar **response_body)
+{
+	const gchar *query;
+	gchar *task_path, *id, *title;
+	GHashTable *params;
+	guint status = SOUP_STATUS_OK;
+
+	g_assert_cmpstr (method, ==, "POST");
+
+	/* Split off the parent and previous parameters */
+	query = strchr (path, '?');
+	task_path = (query != NULL) ? g_strndup (path, query - path) : g_strdup (path);
+	params = (query != NULL) ? soup_form_decode (query + 1) : g_hash_table_new (g_str_hash, g_str_equal);
+
+	if (g_strcmp0 (task_path, "/tasks/v1/lists/some-list/tasks") == 0) {
+		GDataTasksTask *task;
+		GError *error = NULL;
+
+		/* Insertion; new tasks get IDs derived from their titles */
+		task = GDATA_TASKS_TASK (gdata_parsable_new_from_json (GDATA_TYPE_TASKS_TASK, body, body_length, &error));
+		g_assert_no_error (error);
+
+		title = g_strdup (gdata_entry_get_title (GDATA_ENTRY (task)));
+		id = g_strconcat ("task-", title, NULL);
+
+		g_object_unref (task);
+	} else {
+		/* Move */
+		g_assert (g_str_has_prefix (task_path, "/tasks/v1/lists/some-list/tasks/") == TRUE);
+		g_assert (g_str_has_suffix (task_path, "/move") == TRUE);
+		g_assert_cmpuint (body_length, ==, 0);
+
+		id = g_strndup (task_path + strlen ("/tasks/v1/lists/some-list/tasks/"),
+		                strlen (task_path) - strlen ("/tasks/v1/lists/some-list/tasks/") - strlen ("/move"));
+		title = g_strdup (id);
+		kind = "move";
+	}
+
+	g_assert (g_hash_table_contains (data->requests, title) == FALSE);
+	g_hash_table_insert (data->requests, g_strdup (title),
+	                     g_strdup_printf ("%u %s parent=%s previous=%s", data->n_requests, kind,
+	                                      (const gchar *) g_hash_table_lookup (params, "parent"),
+	                                      (const gchar *) g_hash_table_lookup (params, "previous")));
+
+	if (g_strcmp0 (title, "Failing") == 0) {
+		status = SOUP_STATUS_BAD_REQUEST;
+		*response_body = g_strdup ("Invalid task");
+	} else {
+		*response_body = g_strdup_printf ("{"
+			"\"kind\": \"tasks#task\","
+			"\"id\": \"%s\","
+			"\"etag\": \"\\\"etag-%s\\\"\","
+			"\"title\": \"%s\","
+			"\"selfLink\": \"https://www.googleapis.com/tasks/v1/lists/some-list/tasks/%s\""
+		"}", id, id, title, id);
+	}
+
+	g_hash_table_unref (params);
+	g_free (title);
+	g_free (id);
+	g_free (task_path);
+
+	return status;
+}
+
+/* Called in the mock server's thread, one message at a time */
+static gboolean
+mutations_handle_message_cb (UhmServer *server, SoupMessage *message, SoupClientContext *client, MutationsServerData *data)
+{
+	SoupURI *uri;
+	SoupMessageBody *request_body;
+	SoupBuffer *request_buffer;
+	gchar *response_body;
+	guint status;
+
+	data->n_requests++;
+
+	uri = soup_message_get_uri (message);
+	request_body = message->request_body;
+	request_buffer = soup_message_body_flatten (request_body);
+
+	if (g_strcmp0 (soup_uri_get_path (uri), "/batch/tasks/v1") == 0) {
+		SoupMultipart *request_multipart, *response_multipart;
+		gint i;
+
+		/* Handle each part of the batch as if it were a request of its own, and label its response with its Content-ID */
+		request_multipart = soup_multipart_new_from_message (message->request_headers, request_body);
+		g_assert (request_multipart != NULL);
+		g_assert_cmpint (soup_multipart_get_length (request_multipart), >, 1);
+
+		response_multipart = soup_multipart_new ("multipart/mixed");
+
+		for (i = 0; i < soup_multipart_get_length (request_multipart); i++) {
+			SoupMessageHeaders *part_headers, *request_headers, *response_part_headers;
+			SoupBuffer *part_body, *response_part_body;
+			const gchar *header_end, *content_id;
+			gchar *method, *path, *response_content_id, *response;
+
+			g_assert (soup_multipart_get_part (request_multipart, i, &part_headers, &part_body) == TRUE);
+
+			content_id = soup_message_headers_get_one (part_headers, "Content-ID");
+			g_assert (g_str_has_prefix (content_id, "<item") == TRUE);
+
+			header_end = g_strstr_len (part_body->data, part_body->length, "\r\n\r\n");
+			g_assert (header_end != NULL);
+
+			request_headers = soup_message_headers_new (SOUP_MESSAGE_HEADERS_REQUEST);
+			g_assert_cmpuint (soup_headers_parse_request (part_body->data, header_end + 4 - part_body->data, request_headers,
+			                                              &method, &path, NULL), ==, SOUP_STATUS_OK);
+			soup_message_headers_free (request_headers);
+
+			status = mutations_handle_request (data, "batch", method, path, header_end + 4,
+			                                   part_body->data + part_body->length - (header_end + 4), &response_body);
+
+			response = g_strdup_printf ("HTTP/1.1 %u %s\r\nContent-Type: %s\r\n\r\n%s", status, soup_status_get_phrase (status),
+			                            (status == SOUP_STATUS_OK) ? "application/json; charset=UTF-8" : "text/plain", response_body);
+			response_part_body = soup_buffer_new (SOUP_MEMORY_TAKE, response, strlen (response));
+
+			response_part_headers = soup_message_headers_new (SOUP_MESSAGE_HEADERS_MULTIPART);
+			soup_message_headers_replace (response_part_headers, "Content-Type", "application/http");
+			response_content_id = g_strconcat ("<response-", content_id + 1, NULL);
+			soup_message_headers_replace (response_part_headers, "Content-ID", response_content_id);
+			g_free (response_content_id);
+
+			soup_multipart_append_part (response_multipart, response_part_headers, response_part_body);
+
+			soup_message_headers_free (response_part_headers);
+			soup_buffer_free (response_part_body);
+			g_free (response_body);
+			g_free (path);
+			g_free (method);
+		}
+
+		soup_message_set_status (message, SOUP_STATUS_OK);
+		soup_multipart_to_message (response_multipart, message->response_headers, message->response_body);
+
+		soup_multipart_free (response_multipart);
+		soup_multipart_free (request_multipart);
+	} else {
+		gchar *path;
+
+		path = soup_uri_to_string (uri, TRUE);
+		status = mutations_handle_request (data, "single", message->method, path, request_buffer->data, request_buffer->length,
+		                                   &response_body);
+		g_free (path);
+
+		soup_message_set_status (message, status);
+		soup_message_headers_set_content_type (message->response_headers, (status == SOUP_STATUS_OK) ? "application/json" : "text/plain",
+		                                       NULL);
+		soup_message_body_append (message->response_body, SOUP_MEMORY_TAKE, response_body, strlen (response_body));
+	}
+
+	soup_buffer_free (request_buffer);
+
+	return TRUE;
+}
+
+typedef struct {
+	guint n_calls;
+	GHashTable *ids;  /* owned; mutation key → owned ID of the resulting task */
+	GHashTable *errors;  /* owned; mutation key → owned GError */
+	GCancellable *cancellable;  /* unowned; cancelled by each callback, if set */
+} MutationsResults;
+
+static void
+mutations_results_init (MutationsResults *results)
+{
+	results->n_calls = 0;
+	results->ids = g_hash_table_new_full (g_str_hash, g_str_equal, NULL, g_free);
+	results->errors = g_hash_table_new_full (g_str_hash, g_str_equal, NULL, (GDestroyNotify) g_error_free);
+	results->cancellable = NULL;
+}
+
+static void
+mutations_results_clear (MutationsResults *results)
+{
+	g_hash_table_unref (results->errors);
+	g_hash_table_unref (results->ids);
+}
+
+static void
+mutations_cb (const GDataTasksMutation *mutation, GDataTasksTask *task, GError *error, MutationsResults *results)
+{
+	/* Each mutation is only reported once, with either its task or its error */
+	g_assert ((task == NULL) != (error == NULL));
+	g_assert (g_hash_table_contains (results->ids, mutation->key) == FALSE);
+	g_assert (g_hash_table_contains (results->errors, mutation->key) == FALSE);
+
+	results->n_calls++;
+
+	if (task != NULL)
+		g_hash_table_insert (results->ids, (gpointer) mutation->key, g_strdup (gdata_entry_get_id (GDATA_ENTRY (task))));
+	else
+		g_hash_table_insert (results->errors, (gpointer) mutation->key, g_error_copy (error));
+
+	if (results->cancellable != NULL)
+		g_cancellable_cancel (results->cancellable);
+}
+
+static void
+mutations_insertion_init (GDataTasksMutation *mutation, const gchar *title, const gchar *key, const gchar *parent, const gchar *previous)
+{
+	memset (mutation, 0, sizeof (*mutation));
+	mutation->type = GDATA_TASKS_MUTATION_INSERTION;
+	mutation->task = gdata_tasks_task_new (NULL);
+	gdata_entry_set_title (GDATA_ENTRY (mutation->task), title);
+	mutation->key = key;
+	mutation->parent = parent;
+	mutation->previous = previous;
+}
+
+static void
+mutations_clear (GDataTasksMutation *mutations, guint n_mutations)
+{
+	guint i;
+
+	for (i = 0; i < n_mutations; i++)
+		g_object_unref (mutations[i].task);
+}
+
+/* Test importing a small tree of tasks: each insertion and move is only sent once the tasks it's placed relative to exist, independent ones are
+ * batched together, and keys are replaced by the server-side IDs of the tasks they refer to. */
+static void
+test_mutations_tree (gconstpointer service)
+{
+	GDataTasksTasklist *tasklist;
+	GDataTasksMutation mutations[6];
+	MutationsServerData server_data;
+	MutationsResults results;
+	gulong handler_id;
+	GError *error = NULL;
+
+	/* The responses refer to tasks which don't exist on the real server */
+	if (uhm_server_get_enable_online (mock_server)) {
+		g_test_skip ("Test uses canned responses");
+		return;
+	}
+
+	server_data.n_requests = 0;
+	server_data.requests = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
+	mutations_results_init (&results);
+
+	handler_id = g_signal_connect (mock_server, "handle-message", (GCallback) mutations_handle_message_cb, &server_data);
+	uhm_server_run (mock_server);
+	gdata_test_set_https_port (mock_server);
+
+	tasklist = gdata_tasks_tasklist_new ("some-list");
+
+	/* A and B are top-level tasks, A1 and A2 are subtasks of A, B1 is a subtask of B, and an existing task is moved to be the last subtask of B */
+	mutations_insertion_init (&mutations[0], "A", "a", NULL, NULL);
+	mutations_insertion_init (&mutations[1], "B", "b", NULL, "a");
+	mutations_insertion_init (&mutations[2], "A1", "a1", "a", NULL);
+	mutations_insertion_init (&mutations[3], "A2", "a2", "a", "a1");
+	mutations_insertion_init (&mutations[4], "B1", "b1", "b", NULL);
+
+	memset (&mutations[5], 0, sizeof (mutations[5]));
+	mutations[5].type = GDATA_TASKS_MUTATION_MOVE;
+	mutations[5].task = gdata_tasks_task_new ("existing");
+	mutations[5].key = "existing";
+	mutations[5].parent = "b";
+	mutations[5].previous = "b1";
+
+	/* With only one request at a time, each request contains all of the mutations which are ready to be sent */
+	g_assert (gdata_tasks_service_run_mutations (GDATA_TASKS_SERVICE (service), tasklist, mutations, G_N_ELEMENTS (mutations), 1, NULL,
+	                                             (GDataTasksMutationCallback) mutations_cb, &results, &error) == TRUE);
+	g_assert_no_error (error);
+
+	g_assert_cmpuint (server_data.n_requests, ==, 4);
+	g_assert_cmpuint (g_hash_table_size (server_data.requests), ==, G_N_ELEMENTS (mutations));
+	g_assert_cmpstr (g_hash_table_lookup (server_data.requests, "A"), ==, "1 single parent=(null) previous=(null)");
+	g_assert_cmpstr (g_hash_table_lookup (server_data.requests, "B"), ==, "2 batch parent=(null) previous=task-A");
+	g_assert_cmpstr (g_hash_table_lookup (server_data.requests, "A1"), ==, "2 batch parent=task-A previous=(null)");
+	g_assert_cmpstr (g_hash_table_lookup (server_data.requests, "A2"), ==, "3 batch parent=task-A previous=task-A1");
+	g_assert_cmpstr (g_hash_table_lookup (server_data.requests, "B1"), ==, "3 batch parent=task-B previous=(null)");
+	g_assert_cmpstr (g_hash_table_lookup (server_data.requests, "existing"), ==, "4 move parent=task-B previous=task-B1");
+
+	g_assert_cmpuint (results.n_calls, ==, G_N_ELEMENTS (mutations));
+	g_assert_cmpstr (g_hash_table_lookup (results.ids, "a"), ==, "task-A");
+	g_assert_cmpstr (g_hash_table_lookup (results.ids, "b"), ==, "task-B");
+	g_assert_cmpstr (g_hash_table_lookup (results.ids, "a1"), ==, "task-A1");
+	g_assert_cmpstr (g_hash_table_lookup (results.ids, "a2"), ==, "task-A2");
+	g_assert_cmpstr (g_hash_table_lookup (results.ids, "b1"), ==, "task-B1");
+	g_assert_cmpstr (g_hash_table_lookup (results.ids, "existing"), ==, "existing");
+
+	mutations_clear (mutations, G_N_ELEMENTS (mutations));
+	mutations_results_clear (&results);
+	g_hash_table_unref (server_data.requests);
+	g_object_unref (tasklist);
+
+	uhm_server_stop (mock_server);
+	g_signal_handler_disconnect (mock_server, handler_id);
+}
+
+/* Test that a failed insertion is passed to the callback, that mutations which depend on it fail without being sent, and that the others carry on */
+static void
+test_mutations_failure (gconstpointer service)
+{
+	GDataTasksTasklist *tasklist;
+	GDataTasksMutation mutations[4];
+	MutationsServerData server_data;
+	MutationsResults results;
+	gulong handler_id;
+	GError *error = NULL;
+
+	/* The responses refer to tasks which don't exist on the real server */
+	if (uhm_server_get_enable_online (mock_server)) {
+		g_test_skip ("Test uses canned responses");
+		return;
+	}
+
+	server_data.n_requests = 0;
+	server_data.requests = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
+	mutations_results_init (&results);
+
+	handler_id = g_signal_connect (mock_server, "handle-message", (GCallback) mutations_handle_message_cb, &server_data);
+	uhm_server_run (mock_server);
+	gdata_test_set_https_port (mock_server);
+
+	tasklist = gdata_tasks_tasklist_new ("some-list");
+
+	/* The server rejects the second task, which the third is placed under */
+	mutations_insertion_init (&mutations[0], "A", "a", NULL, NULL);
+	mutations_insertion_init (&mutations[1], "Failing", "failing", "a", NULL);
+	mutations_insertion_init (&mutations[2], "C", "c", "failing", NULL);
+	mutations_insertion_init (&mutations[3], "D", "d", "a", NULL);
+
+	g_assert (gdata_tasks_service_run_mutations (GDATA_TASKS_SERVICE (service), tasklist, mutations, G_N_ELEMENTS (mutations), 1, NULL,
+	                                             (GDataTasksMutationCallback) mutations_cb, &results, &error) == TRUE);
+	g_assert_no_error (error);
+
+	g_assert_cmpuint (server_data.n_requests, ==, 2);
+	g_assert_cmpstr (g_hash_table_lookup (server_data.requests, "A"), ==, "1 single parent=(null) previous=(null)");
+	g_assert_cmpstr (g_hash_table_lookup (server_data.requests, "Failing"), ==, "2 batch parent=task-A previous=(null)");
+	g_assert_cmpstr (g_hash_table_lookup (server_data.requests, "D"), ==, "2 batch parent=task-A previous=(null)");
+	g_assert (g_hash_table_contains (server_data.requests, "C") == FALSE);
+
+	g_assert_cmpuint (results.n_calls, ==, G_N_ELEMENTS (mutations));
+	g_assert_cmpstr (g_hash_table_lookup (results.ids, "a"), ==, "task-A");
+	g_assert_error ((GError *) g_hash_table_lookup (results.errors, "failing"), GDATA_SERVICE_ERROR, GDATA_SERVICE_ERROR_PROTOCOL_ERROR);
+	g_assert_error ((GError *) g_hash_table_lookup (results.errors, "c"), GDATA_SERVICE_ERROR, GDATA_SERVICE_ERROR_WITH_BATCH_OPERATION);
+	g_assert_cmpstr (g_hash_table_lookup (results.ids, "d"), ==, "task-D");
+
+	mutations_clear (mutations, G_N_ELEMENTS (mutations));
+	mutations_results_clear (&results);
+	g_hash_table_unref (server_data.requests);
+	g_object_unref (tasklist);
+
+	uhm_server_stop (mock_server);
+	g_signal_handler_disconnect (mock_server, handler_id);
+}
+
+/* Test that cancelling part-way through stops any more mutations from being sent, and that those left over are cancelled, including those which
+ * were waiting for others */
+static void
+test_mutations_cancellation (gconstpointer service)
+{
+	GDataTasksTasklist *tasklist;
+	GDataTasksMutation mutations[3];
+	MutationsServerData server_data;
+	MutationsResults results;
+	GCancellable *cancellable;
+	gulong handler_id;
+	GError *error = NULL;
+
+	/* The responses refer to tasks which don't exist on the real server */
+	if (uhm_server_get_enable_online (mock_server)) {
+		g_test_skip ("Test uses canned responses");
+		return;
+	}
+
+	server_data.n_requests = 0;
+	server_data.requests = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
+	mutations_results_init (&results);
+
+	/* Cancel as soon as the first mutation has finished */
+	cancellable = g_cancellable_new ();
+	results.cancellable = cancellable;
+
+	handler_id = g_signal_connect (mock_server, "handle-message", (GCallback) mutations_handle_message_cb, &server_data);
+	uhm_server_run (mock_server);
+	gdata_test_set_https_port (mock_server);
+
+	tasklist = gdata_tasks_tasklist_new ("some-list");
+
+	mutations_insertion_init (&mutations[0], "A", "a", NULL, NULL);
+	mutations_insertion_init (&mutations[1], "B", "b", "a", NULL);
+	mutations_insertion_init (&mutations[2], "C", "c", "b", NULL);
+
+	g_assert (gdata_tasks_service_run_mutations (GDATA_TASKS_SERVICE (service), tasklist, mutations, G_N_ELEMENTS (mutations), 1, cancellable,
+	                                             (GDataTasksMutationCallback) mutations_cb, &results, &error) == FALSE);
+	g_assert_error (error, G_IO_ERROR, G_IO_ERROR_CANCELLED);
+	g_clear_error (&error);
+
+	g_assert_cmpuint (server_data.n_requests, ==, 1);
+	g_assert_cmpstr (g_hash_table_lookup (server_data.requests, "A"), ==, "1 single parent=(null) previous=(null)");
+
+	g_assert_cmpuint (results.n_calls, ==, G_N_ELEMENTS (mutations));
+	g_assert_cmpstr (g_hash_table_lookup (results.ids, "a"), ==, "task-A");
+	g_assert_error ((GError *) g_hash_table_lookup (results.errors, "b"), G_IO_ERROR, G_IO_ERROR_CANCELLED);
+	g_assert_error ((GError *) g_hash_table_lookup (results.errors, "c"), G_IO_ERROR, G_IO_ERROR_CANCELLED);
+
+	mutations_clear (mutations, G_N_ELEMENTS (mutations));
+	mutations_results_clear (&results);
+	g_hash_table_unref (server_data.requests);
+	g_object_unref (tasklist);
+	g_object_unref (cancellable);
+
+	uhm_server_stop (mock_server);
+	g_signal_handler_disconnect (mock_server, handler_id);
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -1432,6 +2106,13 @@ main (int argc, char *argv[])
 	g_test_add_func ("/tasks/query/etag", test_query_etag);
 	g_test_add_func ("/tasks/query/properties", test_query_properties);
 
+	g_test_add_data_func ("/tasks/batch/mixed-formats", service, test_batch_mixed_formats);
+	g_test_add_data_func ("/tasks/batch/json", service, test_batch_json);
+	g_test_add_data_func ("/tasks/mutations/invalid", service, test_mutations_invalid);
+	g_test_add_data_func ("/tasks/mutations/tree", service, test_mutations_tree);
+	g_test_add_data_func ("/tasks/mutations/failure", service, test_mutations_failure);
+	g_test_add_data_func ("/tasks/mutations/cancellation", service, test_mutations_cancellation);
+
 	retval = g_test_run ();
 
 	g_clear_object (&unauthorised_service);